@@ -37,27 +37,10 @@ proc lwip_elite_hw_drc {libhandle emac} {
 			lwIP operates only in interrupt mode, so please connect the interrupt port to \
 			the interrupt controller.\n" "" "MDT_ERROR"
 	}
-	set tx_csum [common::get_property CONFIG.tcp_tx_checksum_offload $libhandle]
-	set rx_csum [common::get_property CONFIG.tcp_rx_checksum_offload $libhandle]
-
-	set tx_full_csum [common::get_property CONFIG.tcp_ip_tx_checksum_offload $libhandle]
-	set rx_full_csum [common::get_property CONFIG.tcp_ip_rx_checksum_offload $libhandle]
-
+	# checksum offload options apply to the other MACs only, the emaclite
+	# netif keeps software checksums (LWIP_CHECKSUM_CTRL_PER_NETIF)
 	set igmp_val [common::get_property CONFIG.igmp_options $libhandle]
 
-	if {$tx_full_csum} {
-		error "ERROR: Full TCP/IP checksum offload on Tx path is not supported for emaclite" "" "MDT_ERROR"
-	}
-
-	if {$rx_full_csum} {
-		error "ERROR: Full TCP/IP checksum offload on Rx path is not supported for emaclite" "" "MDT_ERROR"
-	}
-	if {$tx_csum} {
-		error "ERROR: Partial TCP checksum offload on Tx path is not supported for emaclite" "" "MDT_ERROR"
-	}
-	if {$rx_csum} {
-		error "ERROR: Partial TCP checksum offload on Rx path is not supported for emaclite" "" "MDT_ERROR"
-	}
 	if {$igmp_val == true} {
 		error "ERROR: IGMP is not supported for emaclite" "" "MDT_ERROR"
 	}
@@ -701,6 +684,7 @@ proc generate_lwip_opts {libhandle} {
 	set tcp_maxrtx          [common::get_property CONFIG.tcp_maxrtx $libhandle]
 	set tcp_synmaxrtx       [common::get_property CONFIG.tcp_synmaxrtx $libhandle]
 	set tcp_queue_ooseq     [common::get_property CONFIG.tcp_queue_ooseq $libhandle]
+	set tcp_large_send_size [common::get_property CONFIG.tcp_large_send_size $libhandle]
 
 	puts $lwipopts_fd "\#define LWIP_TCP $lwip_tcp"
 	puts $lwipopts_fd "\#define TCP_MSS $tcp_mss"
@@ -711,6 +695,13 @@ proc generate_lwip_opts {libhandle} {
 	puts $lwipopts_fd "\#define TCP_SYNMAXRTX $tcp_synmaxrtx"
 	puts $lwipopts_fd "\#define TCP_QUEUE_OOSEQ $tcp_queue_ooseq"
 	puts $lwipopts_fd "\#define TCP_SND_QUEUELEN   16 * TCP_SND_BUF/TCP_MSS"
+	if {$tcp_large_send_size > 0} {
+		if {$tcp_large_send_size < 2 * $tcp_mss || $tcp_large_send_size > 65000} {
+			error "ERROR: tcp_large_send_size must be between 2 * tcp_mss and 65000 bytes" "" "MDT_ERROR"
+		}
+		puts $lwipopts_fd "\#define LWIP_TCP_LARGE_SEND 1"
+		puts $lwipopts_fd "\#define TCP_LARGE_SEND_SIZE $tcp_large_send_size"
+	}
 
 	set have_ethonzynq 0
 	foreach emac $emac_periphs_list {
@@ -731,7 +722,7 @@ proc generate_lwip_opts {libhandle} {
 				error "ERROR: Wrong Tx cheksum options. The selected Tx checksum does not match with the HW supported Tx csum offload option"
 				"" "mdt_error"
 			} else {
-				set tx_full_csum [expr ![common::get_property CONFIG.tcp_ip_tx_checksum_offload $libhandle]]
+				set tx_full_csum [expr $have_emaclite == 1]
 				puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP $tx_full_csum"
 				puts $lwipopts_fd "\#define CHECKSUM_GEN_UDP $tx_full_csum"
 				puts $lwipopts_fd "\#define CHECKSUM_GEN_IP $tx_full_csum"
@@ -743,7 +734,7 @@ proc generate_lwip_opts {libhandle} {
 				error "ERROR: Wrong Rx cheksum options. The selected Rx checksum does not match with the HW supported Rx csum offload option"
 				"" "mdt_error"
 			} else {
-				set rx_full_csum [expr ![common::get_property CONFIG.tcp_ip_rx_checksum_offload $libhandle]]
+				set rx_full_csum [expr $have_emaclite == 1]
 				puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP $rx_full_csum"
 				puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP $rx_full_csum"
 				puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP $rx_full_csum"
@@ -756,7 +747,7 @@ proc generate_lwip_opts {libhandle} {
 				error "ERROR: Wrong Tx cheksum options. The selected Tx checksum does not match with the HW supported Tx csum offload option"
 				"" "mdt_error"
 			} else {
-				set tx_csum [expr ![common::get_property CONFIG.tcp_tx_checksum_offload $libhandle]]
+				set tx_csum [expr $have_emaclite == 1]
 				puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP $tx_csum"
 			}
 		}
@@ -766,7 +757,7 @@ proc generate_lwip_opts {libhandle} {
 				error "ERROR: Wrong Rx cheksum options. The selected Rx checksum does not match with the HW supported Rx csum offload option"
 				"" "mdt_error"
 			} else {
-				set rx_csum [expr ![common::get_property CONFIG.tcp_rx_checksum_offload $libhandle]]
+				set rx_csum [expr $have_emaclite == 1]
 				puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP $rx_csum"
 			}
 		}
@@ -794,15 +785,23 @@ proc generate_lwip_opts {libhandle} {
 		if {$rx_csum_temp == true} {
 			puts $lwipopts_fd "\#define LWIP_PARTIAL_CSUM_OFFLOAD_RX  1"
 		}
+		# emaclite needs software checksums, the AXI Ethernet netif turns
+		# off the offloaded ones for itself only
+		if {$have_emaclite == 1 && ($tx_full_csum_temp == true || $rx_full_csum_temp == true || \
+				$tx_csum_temp == true || $rx_csum_temp == true)} {
+			puts $lwipopts_fd "\#define LWIP_CHECKSUM_CTRL_PER_NETIF 1"
+		}
 
 	} else {
 		if {$have_emaclite == 1} {
+			# the GEM netif turns off the checksums it offloads
 			puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP 	1"
 			puts $lwipopts_fd "\#define CHECKSUM_GEN_UDP 	1"
 			puts $lwipopts_fd "\#define CHECKSUM_GEN_IP  	1"
 			puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP  1"
 			puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP  1"
 			puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP 	1"
+			puts $lwipopts_fd "\#define LWIP_CHECKSUM_CTRL_PER_NETIF 1"
 		} else {
 			puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP 	0"
 			puts $lwipopts_fd "\#define CHECKSUM_GEN_UDP 	0"
@@ -1476,9 +1475,22 @@ proc generate_adapterconfig_include {libhandle} {
 		puts $fd "\#define XLWIP_CONFIG_N_TX_DESC $ndesc"
 		set ndesc [common::get_property CONFIG.n_rx_descriptors $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_DESC $ndesc"
+		set rxbudget [common::get_property CONFIG.emac_rx_poll_budget $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_EMAC_RX_POLL_BUDGET $rxbudget"
+		set txthreshold [common::get_property CONFIG.emac_tx_complete_threshold $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_EMAC_TX_COMPLETE_THRESHOLD $txthreshold"
+		set rxq1desc [common::get_property CONFIG.emac_rxq1_descriptors $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_EMAC_RXQ1_DESC $rxq1desc"
 		puts $fd ""
 	}
 
+	set pqsize [common::get_property CONFIG.pq_queue_size $libhandle]
+	if {$pqsize < 2 || ($pqsize & ($pqsize - 1)) != 0} {
+		error "ERROR: pq_queue_size must be a power of two" "" "MDT_ERROR"
+	}
+	puts $fd "\#define XLWIP_CONFIG_PQ_QUEUE_SIZE $pqsize"
+	puts $fd ""
+
 	puts $fd "\#endif"
 
 	close $fd
@@ -0,0 +1,408 @@
+/*
+ * Copyright (C) 2019 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+
+/*
+ * lsendtest.c
+ *
+ * Loopback test of the large send segmentation of the Xilinx lwIP port
+ * (netif/xlargesend.c) for a Linux host build.
+ *
+ * Two lwIP netifs are connected back to back in one process. Netif A has
+ * NETIF_FLAG_LARGE_SEND and splits the large TCP segments with
+ * xlargesend_output(), netif B receives the frames as a normal netif. The
+ * link output of A stands in for the MAC:
+ *	- it keeps a reference on every frame for a while, as the DMA does
+ *	- it inserts the IP and TCP checksums, the TCP checksum must be left 0
+ *	- it drops every <n>th frame when asked to
+ * and checks that no frame exceeds the MTU and that every frame split from
+ * a segment has DF set and the IP ID of the segment.
+ *
+ * A TCP connection from A to B then carries LSEND_TOTAL bytes of a known
+ * pattern; the test passes when all of them arrive intact and at least one
+ * segment was split.
+ *
+ * usage: lsendtest [-l <drop every n-th frame>]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lwip/init.h"
+#include "lwip/stats.h"
+#include "lwip/netif.h"
+#include "lwip/etharp.h"
+#include "lwip/tcp.h"
+#include "lwip/timeouts.h"
+#include "lwip/inet_chksum.h"
+#include "lwip/prot/ip4.h"
+#include "lwip/prot/tcp.h"
+#include "netif/ethernet.h"
+#include "netif/xlargesend.h"
+
+#define LSEND_TOTAL	(16U * 1024 * 1024)
+#define LSEND_QUEUE	4096
+#define LSEND_HELD	64
+#define LSEND_MAX_ITER	2000000
+#define LSEND_PORT	5001
+
+struct link {
+	struct pbuf *frames[LSEND_QUEUE];
+	int n;
+};
+
+static struct netif NetifA, NetifB;
+static struct link ToA, ToB;
+static struct pbuf *Held[LSEND_HELD];
+static int NumHeld;
+
+static u32_t Now;
+static unsigned LossEvery;
+static unsigned Segments, Frames, Drops, Errors;
+static u16_t SegmentId;
+static int InSegment;
+
+static struct tcp_pcb *Client;
+static u32_t Sent, Received, Corrupt;
+
+u32_t sys_now(void)
+{
+	return Now;
+}
+
+static void Fail(const char *What)
+{
+	printf("FAIL %s\n", What);
+	Errors++;
+}
+
+static void LinkPut(struct link *l, struct pbuf *p)
+{
+	struct pbuf *c;
+
+	if (l->n == LSEND_QUEUE) {
+		Fail("link queue full");
+		return;
+	}
+	c = pbuf_alloc(PBUF_RAW, p->tot_len, PBUF_RAM);
+	if (c == NULL) {
+		Fail("out of pbufs");
+		return;
+	}
+	pbuf_copy(c, p);
+	l->frames[l->n++] = c;
+}
+
+static void LinkDeliver(struct link *l, struct netif *netif)
+{
+	int i, n = l->n;
+
+	for (i = 0; i < n; i++) {
+		netif->input(l->frames[i], netif);
+	}
+	memmove(l->frames, l->frames + n, (l->n - n) * sizeof(l->frames[0]));
+	l->n -= n;
+}
+
+static void ReleaseHeld(void)
+{
+	int i;
+
+	for (i = 0; i < NumHeld; i++) {
+		pbuf_free(Held[i]);
+	}
+	NumHeld = 0;
+}
+
+/* insert the checksums in the copy of the frame, as the MAC does */
+static void MacChecksum(struct pbuf *c)
+{
+	struct ip_hdr *ip = (struct ip_hdr *)((u8_t *)c->payload + SIZEOF_ETH_HDR);
+	struct tcp_hdr *tcp;
+	struct pbuf seg;
+	ip_addr_t src, dest;
+	u16_t iphlen, len;
+
+	if (((struct eth_hdr *)c->payload)->type != PP_HTONS(ETHTYPE_IP)) {
+		return;
+	}
+	iphlen = IPH_HL_BYTES(ip);
+	IPH_CHKSUM_SET(ip, 0);
+	IPH_CHKSUM_SET(ip, inet_chksum(ip, iphlen));
+	if (IPH_PROTO(ip) != IP_PROTO_TCP) {
+		return;
+	}
+
+	tcp = (struct tcp_hdr *)((u8_t *)ip + iphlen);
+	if (tcp->chksum != 0) {
+		Fail("TCP checksum not left to the MAC");
+	}
+	len = lwip_ntohs(IPH_LEN(ip)) - iphlen;
+	ip_addr_copy_from_ip4(src, ip->src);
+	ip_addr_copy_from_ip4(dest, ip->dest);
+	seg = *c;
+	seg.payload = tcp;
+	seg.len = seg.tot_len = len;
+	seg.next = NULL;
+	tcp->chksum = ip_chksum_pseudo(&seg, IP_PROTO_TCP, len, &src, &dest);
+}
+
+static void CheckSplitFrame(struct pbuf *p)
+{
+	struct ip_hdr *ip = (struct ip_hdr *)((u8_t *)p->payload + SIZEOF_ETH_HDR);
+
+	if ((IPH_OFFSET(ip) & PP_HTONS(IP_DF)) == 0) {
+		Fail("split frame without DF");
+	}
+	if (lwip_ntohs(IPH_ID(ip)) != SegmentId) {
+		Fail("split frame with another IP ID");
+	}
+}
+
+static err_t OutputA(struct netif *netif, struct pbuf *p)
+{
+	struct ip_hdr *ip;
+	err_t err;
+
+	if (XLARGESEND_NEEDED(netif, p)) {
+		ip = (struct ip_hdr *)((u8_t *)p->payload + SIZEOF_ETH_HDR);
+		SegmentId = lwip_ntohs(IPH_ID(ip));
+		Segments++;
+		InSegment = 1;
+		err = xlargesend_output(netif, p, OutputA);
+		InSegment = 0;
+		return err;
+	}
+
+	if (p->tot_len > netif->mtu + SIZEOF_ETH_HDR) {
+		Fail("frame larger than the MTU");
+		return ERR_OK;
+	}
+	if (InSegment) {
+		CheckSplitFrame(p);
+	}
+	Frames++;
+
+	/* the DMA holds on to the frame until it is sent */
+	if (NumHeld == LSEND_HELD) {
+		ReleaseHeld();
+	}
+	pbuf_ref(p);
+	Held[NumHeld++] = p;
+
+	if (LossEvery && (Frames % LossEvery) == 0) {
+		Drops++;
+		return ERR_OK;
+	}
+	LinkPut(&ToB, p);
+	if (ToB.n > 0) {
+		MacChecksum(ToB.frames[ToB.n - 1]);
+	}
+	return ERR_OK;
+}
+
+static err_t OutputB(struct netif *netif, struct pbuf *p)
+{
+	LWIP_UNUSED_ARG(netif);
+	LinkPut(&ToA, p);
+	return ERR_OK;
+}
+
+static err_t InitA(struct netif *netif)
+{
+	static const u8_t mac[6] = { 0x00, 0x0a, 0x35, 0x00, 0x00, 0x01 };
+
+	netif->linkoutput = OutputA;
+	netif->output = etharp_output;
+	netif->mtu = 1500;
+	netif->hwaddr_len = 6;
+	memcpy(netif->hwaddr, mac, 6);
+	netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP |
+		       NETIF_FLAG_ETHERNET | NETIF_FLAG_LINK_UP |
+		       NETIF_FLAG_LARGE_SEND;
+	/* the MAC inserts the IP, TCP and UDP checksums */
+	NETIF_SET_CHECKSUM_CTRL(netif, NETIF_CHECKSUM_GEN_ICMP |
+				NETIF_CHECKSUM_CHECK_IP | NETIF_CHECKSUM_CHECK_TCP |
+				NETIF_CHECKSUM_CHECK_UDP | NETIF_CHECKSUM_CHECK_ICMP);
+	xlargesend_init();
+	return ERR_OK;
+}
+
+static err_t InitB(struct netif *netif)
+{
+	static const u8_t mac[6] = { 0x00, 0x0a, 0x35, 0x00, 0x00, 0x02 };
+
+	netif->linkoutput = OutputB;
+	netif->output = etharp_output;
+	netif->mtu = 1500;
+	netif->hwaddr_len = 6;
+	memcpy(netif->hwaddr, mac, 6);
+	netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP |
+		       NETIF_FLAG_ETHERNET | NETIF_FLAG_LINK_UP;
+	return ERR_OK;
+}
+
+static u8_t Pattern(u32_t Offset)
+{
+	return (u8_t)(Offset * 7);
+}
+
+static void Pump(void)
+{
+	u8_t buf[4096];
+	u32_t n, i;
+
+	while (Sent < LSEND_TOTAL) {
+		n = LWIP_MIN(tcp_sndbuf(Client), sizeof(buf));
+		n = LWIP_MIN(n, LSEND_TOTAL - Sent);
+		if (n == 0) {
+			break;
+		}
+		for (i = 0; i < n; i++) {
+			buf[i] = Pattern(Sent + i);
+		}
+		if (tcp_write(Client, buf, (u16_t)n, TCP_WRITE_FLAG_COPY) != ERR_OK) {
+			break;
+		}
+		Sent += n;
+	}
+	tcp_output(Client);
+}
+
+static err_t ClientSent(void *Arg, struct tcp_pcb *Pcb, u16_t Len)
+{
+	LWIP_UNUSED_ARG(Arg);
+	LWIP_UNUSED_ARG(Pcb);
+	LWIP_UNUSED_ARG(Len);
+	Pump();
+	return ERR_OK;
+}
+
+static err_t ClientConnected(void *Arg, struct tcp_pcb *Pcb, err_t Err)
+{
+	LWIP_UNUSED_ARG(Arg);
+	LWIP_UNUSED_ARG(Pcb);
+	LWIP_UNUSED_ARG(Err);
+	Pump();
+	return ERR_OK;
+}
+
+static err_t ServerRecv(void *Arg, struct tcp_pcb *Pcb, struct pbuf *p,
+			err_t Err)
+{
+	struct pbuf *q;
+	u16_t i;
+
+	LWIP_UNUSED_ARG(Arg);
+	LWIP_UNUSED_ARG(Err);
+	if (p == NULL) {
+		return ERR_OK;
+	}
+	for (q = p; q != NULL; q = q->next) {
+		for (i = 0; i < q->len; i++, Received++) {
+			if (((u8_t *)q->payload)[i] != Pattern(Received)) {
+				Corrupt++;
+			}
+		}
+	}
+	tcp_recved(Pcb, p->tot_len);
+	pbuf_free(p);
+	return ERR_OK;
+}
+
+static err_t ServerAccept(void *Arg, struct tcp_pcb *Pcb, err_t Err)
+{
+	LWIP_UNUSED_ARG(Arg);
+	LWIP_UNUSED_ARG(Err);
+	tcp_recv(Pcb, ServerRecv);
+	return ERR_OK;
+}
+
+int main(int argc, char *argv[])
+{
+	ip4_addr_t ipa, ipb, mask, gw;
+	struct tcp_pcb *listener;
+	int iter;
+
+	if (argc == 3 && strcmp(argv[1], "-l") == 0) {
+		LossEvery = (unsigned)strtoul(argv[2], NULL, 0);
+	} else if (argc != 1) {
+		printf("usage: lsendtest [-l <drop every n-th frame>]\n");
+		return 2;
+	}
+
+	lwip_init();
+	IP4_ADDR(&ipa, 10, 0, 0, 1);
+	IP4_ADDR(&ipb, 10, 0, 0, 2);
+	IP4_ADDR(&mask, 255, 255, 255, 0);
+	IP4_ADDR(&gw, 0, 0, 0, 0);
+	netif_add(&NetifA, &ipa, &mask, &gw, NULL, InitA, ethernet_input);
+	netif_set_up(&NetifA);
+	netif_add(&NetifB, &ipb, &mask, &gw, NULL, InitB, ethernet_input);
+	netif_set_up(&NetifB);
+
+	listener = tcp_new();
+	tcp_bind(listener, &ipb, LSEND_PORT);
+	listener = tcp_listen(listener);
+	tcp_accept(listener, ServerAccept);
+
+	Client = tcp_new();
+	tcp_bind(Client, &ipa, 0);
+	tcp_bind_netif(Client, &NetifA);
+	tcp_sent(Client, ClientSent);
+	tcp_connect(Client, &ipb, LSEND_PORT, ClientConnected);
+
+	for (iter = 0; Received < LSEND_TOTAL && iter < LSEND_MAX_ITER; iter++) {
+		ReleaseHeld();
+		LinkDeliver(&ToB, &NetifB);
+		LinkDeliver(&ToA, &NetifA);
+		if (ToA.n == 0 && ToB.n == 0) {
+			/* idle link, let the TCP timers run */
+			Now += 10;
+			sys_check_timeouts();
+		}
+		if (Sent < LSEND_TOTAL && Client->state == ESTABLISHED) {
+			Pump();
+		}
+	}
+
+	printf("loss 1/%u: %u/%u bytes, %u corrupt, %u segments split, "
+	       "%u frames, %u dropped, %u ms\n", LossEvery, Received,
+	       LSEND_TOTAL, Corrupt, Segments, Frames, Drops, Now);
+	if (Received != LSEND_TOTAL || Corrupt != 0) {
+		Fail("data lost or corrupted");
+	}
+	if (Segments == 0) {
+		Fail("no segment split");
+	}
+	if (lwip_stats.tcp.chkerr != 0 || lwip_stats.ip.chkerr != 0) {
+		Fail("checksum errors");
+	}
+
+	return Errors != 0;
+}
@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2019 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+/*
+ * pqbench.c
+ *
+ * Unit test and benchmark of the receive queue of the Xilinx lwIP port
+ * (netif/xpqueue.c) for a Linux host build.
+ *
+ * The program first checks the queue in one thread: empty and full queue,
+ * FIFO order, batch dequeue, wrap around of the free running head and tail
+ * and more queues than interfaces of the old static pool. It then runs a
+ * producer thread (the RX interrupt) against a consumer thread (the input
+ * thread), checks that every entry arrives once and in order, and reports
+ * ns per entry for
+ *	locked	pq_dequeue() with a lock around every queue access, as the
+ *		adapters did with SYS_ARCH_PROTECT
+ *	single	pq_dequeue() without lock
+ *	batch	pq_dequeue_batch() of up to 16 entries without lock
+ * A thread that finds the queue full or empty yields, so the numbers are
+ * also meaningful on a single CPU.
+ *
+ * usage: pqbench [-n <entries>]
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "netif/xpqueue.h"
+
+#define BENCH_BATCH	16
+#define BENCH_RUNS	5
+
+enum { MODE_LOCKED, MODE_SINGLE, MODE_BATCH, MODE_COUNT };
+
+static const char *ModeName[MODE_COUNT] = { "locked", "single", "batch" };
+
+struct bench {
+	pq_queue_t *q;
+	unsigned long n;
+	int mode;
+	int err;
+	pthread_mutex_t lock;
+};
+
+static double Now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int Fail(const char *What)
+{
+	printf("FAIL %s\n", What);
+	return 1;
+}
+
+static int SelfTest(void)
+{
+	pq_queue_t *q, *qs[8];
+	void *p[BENCH_BATCH];
+	unsigned long i, next;
+	int k, n;
+
+	q = pq_create_queue();
+	if (!q)
+		return Fail("create");
+	if (((unsigned long)q & (PQ_CACHELINE_SIZE - 1)) != 0)
+		return Fail("alignment");
+	if (pq_dequeue(q) != NULL || pq_dequeue_batch(q, p, BENCH_BATCH) != 0)
+		return Fail("empty queue");
+
+	for (i = 0; i < PQ_QUEUE_SIZE; i++) {
+		if (pq_enqueue(q, (void *)(i + 1)) != 0)
+			return Fail("enqueue");
+	}
+	if (pq_enqueue(q, (void *)1) != -1 || pq_qlength(q) != PQ_QUEUE_SIZE)
+		return Fail("full queue");
+
+	for (i = 0; i < PQ_QUEUE_SIZE; i += n) {
+		n = pq_dequeue_batch(q, p, (int)(i % BENCH_BATCH) + 1);
+		if (n != (int)(i % BENCH_BATCH) + 1 && i + n != PQ_QUEUE_SIZE)
+			return Fail("batch length");
+		for (k = 0; k < n; k++) {
+			if (p[k] != (void *)(i + k + 1))
+				return Fail("batch order");
+		}
+	}
+	if (pq_qlength(q) != 0)
+		return Fail("drained queue");
+
+	pq_enqueue(q, (void *)1);
+	if (pq_dequeue_batch(q, p, 0) != 0 || pq_dequeue_batch(q, p, -1) != 0 ||
+	    pq_qlength(q) != 1 || pq_dequeue(q) != (void *)1)
+		return Fail("batch of no entries");
+
+	/* head and tail wrap around at 2^32 */
+	q->head = q->tail = 0xFFFFFF00U;
+	for (i = 0, next = 1; i < 0x200; i++) {
+		if (pq_enqueue(q, (void *)(i + 1)) != 0)
+			return Fail("enqueue across wrap");
+		if (i % 3 == 2) {
+			if (pq_dequeue(q) != (void *)next++)
+				return Fail("dequeue across wrap");
+		}
+	}
+	if (pq_qlength(q) != 0x200 - 0x200 / 3)
+		return Fail("length across wrap");
+	pq_destroy_queue(q);
+
+	for (k = 0; k < 8; k++) {
+		qs[k] = pq_create_queue();
+		if (!qs[k])
+			return Fail("more than two queues");
+		pq_enqueue(qs[k], (void *)(unsigned long)(k + 1));
+	}
+	for (k = 0; k < 8; k++) {
+		if (pq_dequeue(qs[k]) != (void *)(unsigned long)(k + 1))
+			return Fail("independent queues");
+		pq_destroy_queue(qs[k]);
+	}
+
+	return 0;
+}
+
+static void *Producer(void *Arg)
+{
+	struct bench *b = Arg;
+	unsigned long i;
+	int ret;
+
+	for (i = 1; i <= b->n; i++) {
+		do {
+			if (b->mode == MODE_LOCKED)
+				pthread_mutex_lock(&b->lock);
+			ret = pq_enqueue(b->q, (void *)i);
+			if (b->mode == MODE_LOCKED)
+				pthread_mutex_unlock(&b->lock);
+			if (ret != 0)
+				sched_yield();
+		} while (ret != 0);
+	}
+
+	return NULL;
+}
+
+static void *Consumer(void *Arg)
+{
+	struct bench *b = Arg;
+	void *p[BENCH_BATCH];
+	unsigned long next = 1;
+	int k, n;
+
+	while (next <= b->n) {
+		if (b->mode == MODE_BATCH) {
+			n = pq_dequeue_batch(b->q, p, BENCH_BATCH);
+		} else {
+			if (b->mode == MODE_LOCKED)
+				pthread_mutex_lock(&b->lock);
+			n = 0;
+			if (pq_qlength(b->q) != 0) {
+				p[0] = pq_dequeue(b->q);
+				n = 1;
+			}
+			if (b->mode == MODE_LOCKED)
+				pthread_mutex_unlock(&b->lock);
+		}
+		if (n == 0)
+			sched_yield();
+		for (k = 0; k < n; k++) {
+			if (p[k] != (void *)next++) {
+				b->err = 1;
+				return NULL;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+static double Run(unsigned long N, int Mode, int *Err)
+{
+	struct bench b;
+	pthread_t prod, cons;
+	double start;
+
+	memset(&b, 0, sizeof(b));
+	b.q = pq_create_queue();
+	b.n = N;
+	b.mode = Mode;
+	pthread_mutex_init(&b.lock, NULL);
+
+	start = Now();
+	pthread_create(&cons, NULL, Consumer, &b);
+	pthread_create(&prod, NULL, Producer, &b);
+	pthread_join(prod, NULL);
+	pthread_join(cons, NULL);
+	start = Now() - start;
+
+	pthread_mutex_destroy(&b.lock);
+	pq_destroy_queue(b.q);
+	*Err |= b.err;
+	return start / N;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long n = 4000000;
+	double t, best;
+	int mode, run, err = 0;
+
+	if (argc == 3 && strcmp(argv[1], "-n") == 0) {
+		n = strtoul(argv[2], NULL, 0);
+	}
+	if (n < 1 || argc == 2 || argc > 3) {
+		printf("usage: pqbench [-n <entries>]\n");
+		return 2;
+	}
+
+	if (SelfTest() != 0) {
+		return 1;
+	}
+
+	for (mode = 0; mode < MODE_COUNT; mode++) {
+		best = 0;
+		for (run = 0; run < BENCH_RUNS; run++) {
+			t = Run(n, mode, &err);
+			if (err) {
+				printf("FAIL %s: entry lost or out of order\n",
+				       ModeName[mode]);
+				return 1;
+			}
+			if (run == 0 || t < best)
+				best = t;
+		}
+		printf("%-8s %8.2f ns/entry\n", ModeName[mode], best);
+	}
+
+	return 0;
+}
@@ -78,6 +78,10 @@ struct netif *	xemac_add(struct netif *netif,
 	unsigned mac_baseaddr);
 #if defined (__arm__) || defined (__aarch64__)
 void xemacpsif_resetrx_on_no_rxdata(struct netif *netif);
+err_t xemacpsif_add_rx_screen_udp(struct netif *netif, u16_t port, u8_t queue);
+err_t xemacpsif_add_rx_screen_dstc(struct netif *netif, u8_t dstc, u8_t queue);
+err_t xemacpsif_add_rx_screen_ethertype(struct netif *netif, u16_t type,
+								u8_t queue);
 #endif
 
 /* global lwip debug variable used for debugging */
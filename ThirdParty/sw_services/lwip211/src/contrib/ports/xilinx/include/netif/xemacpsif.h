@@ -85,6 +85,51 @@ extern "C" {
 
 #define MAX_FRAME_SIZE_JUMBO (XEMACPS_MTU_JUMBO + XEMACPS_HDR_SIZE + XEMACPS_TRL_SIZE)
 
+/* RX poll mode: when non zero, the RX interrupt only masks itself and wakes
+ * up the input path, which then processes at most this many BDs per call to
+ * xemacpsif_input(). The RX interrupt is unmasked again once the RX ring is
+ * empty. 0 keeps the RX ring processing in the interrupt handler.
+ */
+#ifndef XLWIP_CONFIG_EMAC_RX_POLL_BUDGET
+#define XLWIP_CONFIG_EMAC_RX_POLL_BUDGET 0
+#endif
+
+/* TX completion batching: when non zero, the TX done interrupt reclaims
+ * completed BDs only once at least this many BDs are in flight. Smaller
+ * batches are reclaimed from the transmit path, so up to this many sent
+ * frames may keep their pbufs until the next transmit. 0 reclaims on every
+ * TX done interrupt.
+ */
+#ifndef XLWIP_CONFIG_EMAC_TX_COMPLETE_THRESHOLD
+#define XLWIP_CONFIG_EMAC_TX_COMPLETE_THRESHOLD 0
+#endif
+
+/* RX priority queue 1 (ZynqMP GEM): number of RX BDs. Frames steered to the
+ * queue by the RX screeners are received with buffers from a separate pool
+ * and are passed to lwIP ahead of the frames of queue 0. 0 leaves queue 1
+ * parked.
+ */
+#ifndef XLWIP_CONFIG_EMAC_RXQ1_DESC
+#define XLWIP_CONFIG_EMAC_RXQ1_DESC 0
+#endif
+
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+#define XEMACPSIF_RX_QUEUES	2
+/* Buffers in the queue 1 pool of each GEM */
+#ifndef XEMACPSIF_RXQ1_PBUFS
+#define XEMACPSIF_RXQ1_PBUFS	(2 * XLWIP_CONFIG_EMAC_RXQ1_DESC)
+#endif
+#else
+#define XEMACPSIF_RX_QUEUES	1
+#endif
+
+/* per RX queue statistics */
+typedef struct {
+	u32_t frames;		/* frames moved to the receive queue */
+	u32_t drops;		/* frames dropped, receive queue full */
+	u32_t nobuf;		/* ring refills stopped for lack of buffers */
+} xemacpsif_rxq_stats;
+
 void 	xemacpsif_setmac(u32_t index, u8_t *addr);
 u8_t*	xemacpsif_getmac(u32_t index);
 err_t 	xemacpsif_init(struct netif *netif);
@@ -107,8 +152,43 @@ typedef struct {
 	void *rx_bdspace;
 	void *tx_bdspace;
 
+	/* bumped whenever the TX BD ring is reset, see emacps_sgsend() */
+	volatile u32_t tx_ring_gen;
+
 	unsigned int last_rx_frms_cntr;
 
+#if XLWIP_CONFIG_EMAC_RX_POLL_BUDGET > 0
+	/* RX poll mode statistics, times are in XTime counts */
+	volatile u32_t rx_isr_count;
+	u64_t rx_isr_time;
+	u32_t rx_isr_time_max;
+	u32_t rx_poll_count;
+	u32_t rx_poll_frames;
+	u32_t rx_poll_frames_max;
+	u32_t rx_poll_budget_exhausted;
+#endif
+
+#if XLWIP_CONFIG_EMAC_TX_COMPLETE_THRESHOLD > 0
+	/* TX completion batching statistics */
+	u32_t tx_reclaim_count;
+	u32_t tx_reclaim_bds;
+	u32_t tx_reclaim_bds_max;
+	u32_t tx_complete_deferred;
+#endif
+
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+	/* RX priority queue 1, NULL rxq1_bdspace when the GEM has none */
+	XEmacPs_BdRing rxq1_ring;
+	void *rxq1_bdspace;
+	pq_queue_t *rxq1_recv_q;
+#endif
+	xemacpsif_rxq_stats rxq_stats[XEMACPSIF_RX_QUEUES];
+
+	/* RX screening registers in use */
+	u8_t rx_screen_t1_used;
+	u8_t rx_screen_t2_used;
+	u8_t rx_screen_etht_used;
+
 } xemacpsif_s;
 
 extern xemacpsif_s xemacpsif;
@@ -123,6 +203,12 @@ void detect_phy(XEmacPs *xemacpsp);
 void emacps_send_handler(void *arg);
 XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p);
 void emacps_recv_handler(void *arg);
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+void emacps_recv_q1_handler(void *arg);
+#endif
+#if XLWIP_CONFIG_EMAC_RX_POLL_BUDGET > 0
+s32_t emacps_rx_poll(struct xemac_s *xemac, s32_t budget);
+#endif
 void emacps_error_handler(void *arg,u8 Direction, u32 ErrorWord);
 void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring);
 void HandleTxErrors(struct xemac_s *xemac);
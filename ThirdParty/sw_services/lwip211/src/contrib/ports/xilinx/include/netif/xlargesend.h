@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+#ifndef __NETIF_XLARGESEND_H__
+#define __NETIF_XLARGESEND_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lwip/opt.h"
+#include "lwip/netif.h"
+#include "lwip/pbuf.h"
+#include "lwip/prot/ethernet.h"
+
+#if LWIP_TCP_LARGE_SEND
+
+/* Frame headers in flight at once, shared by all netifs */
+#ifndef XLARGESEND_NUM_HDRS
+#define XLARGESEND_NUM_HDRS	128
+#endif
+
+/* Largest link, IP and TCP header copied into a frame header */
+#define XLARGESEND_HDR_MAX	(SIZEOF_ETH_HDR + 60 + 60)
+
+/* Does p have to go through xlargesend_output() on this netif? */
+#define XLARGESEND_NEEDED(netif, p)	\
+		((p)->tot_len > (netif)->mtu + SIZEOF_ETH_HDR)
+
+/*
+ * Large send: lwIP queues TCP segments of up to TCP_LARGE_SEND_SIZE bytes
+ * on netifs with NETIF_FLAG_LARGE_SEND, and the netif's linkoutput hands
+ * them to xlargesend_output(). Each frame is a copy of the segment headers,
+ * patched for the frame, chained to PBUF_REF pbufs pointing at the frame's
+ * part of the segment payload. The frame header holds a reference on the
+ * segment until the frame is freed, so the driver must not free any pbuf of
+ * a frame before the hardware is done with all of it.
+ */
+void xlargesend_init(void);
+err_t xlargesend_output(struct netif *netif, struct pbuf *p,
+						netif_linkoutput_fn frame_output);
+
+#endif /* LWIP_TCP_LARGE_SEND */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NETIF_XLARGESEND_H__ */
@@ -31,20 +31,45 @@
 #ifndef __LWIP_PBUF_QUEUE_H_
 #define __LWIP_PBUF_QUEUE_H_
 
+#include "xlwipconfig.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#define PQ_QUEUE_SIZE 4096
+/* Number of entries of a queue, must be a power of two. Set with the
+ * pq_queue_size library parameter; each queue is malloc()ed.
+ */
+#ifdef XLWIP_CONFIG_PQ_QUEUE_SIZE
+#define PQ_QUEUE_SIZE XLWIP_CONFIG_PQ_QUEUE_SIZE
+#else
+#define PQ_QUEUE_SIZE 1024
+#endif
+
+/* head and tail are kept in separate cache lines */
+#define PQ_CACHELINE_SIZE 64
 
+/*
+ * Single producer, single consumer ring. The producer only writes head and
+ * the consumer only writes tail; both are free running and the number of
+ * queued entries is head - tail. One producer (e.g. the RX interrupt) and
+ * one consumer (e.g. the input thread) need no lock. Queues with more than
+ * one producer or consumer need the callers to serialize them.
+ */
 typedef struct {
+	volatile unsigned int head;
+	char pad0[PQ_CACHELINE_SIZE - sizeof(unsigned int)];
+	volatile unsigned int tail;
+	char pad1[PQ_CACHELINE_SIZE - sizeof(unsigned int)];
 	void *data[PQ_QUEUE_SIZE];
-	int head, tail, len;
+	void *mem;
 } pq_queue_t;
 
 pq_queue_t*	pq_create_queue();
+void		pq_destroy_queue(pq_queue_t *q);
 int 		pq_enqueue(pq_queue_t *q, void *p);
 void*		pq_dequeue(pq_queue_t *q);
+int		pq_dequeue_batch(pq_queue_t *q, void **p, int n);
 int		pq_qlength(pq_queue_t *q);
 
 #ifdef __cplusplus
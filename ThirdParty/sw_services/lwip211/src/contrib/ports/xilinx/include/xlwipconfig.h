@@ -36,4 +36,6 @@
 
 #define XLWIP_CONFIG_INCLUDE_EMACLITE 1
 
+#define XLWIP_CONFIG_PQ_QUEUE_SIZE 1024
+
 #endif
@@ -46,6 +46,7 @@
 #include "netif/xaxiemacif.h"
 #include "netif/xadapter.h"
 #include "netif/xpqueue.h"
+#include "netif/xlargesend.h"
 
 #include "xaxiemacif_fifo.h"
 #include "xaxiemacif_hw.h"
@@ -65,6 +66,40 @@
 #define IFNAME0 't'
 #define IFNAME1 'e'
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+/* Checksums lwIP still handles for this netif, the rest is offloaded */
+#if LWIP_FULL_CSUM_OFFLOAD_TX==1
+#define XAXIEMACIF_CHECKSUM_GEN	(NETIF_CHECKSUM_GEN_ICMP | \
+					 NETIF_CHECKSUM_GEN_ICMP6)
+#elif LWIP_PARTIAL_CSUM_OFFLOAD_TX==1
+#define XAXIEMACIF_CHECKSUM_GEN	(NETIF_CHECKSUM_GEN_IP | \
+					 NETIF_CHECKSUM_GEN_UDP | \
+					 NETIF_CHECKSUM_GEN_ICMP | \
+					 NETIF_CHECKSUM_GEN_ICMP6)
+#else
+#define XAXIEMACIF_CHECKSUM_GEN	(NETIF_CHECKSUM_GEN_IP | \
+					 NETIF_CHECKSUM_GEN_UDP | \
+					 NETIF_CHECKSUM_GEN_TCP | \
+					 NETIF_CHECKSUM_GEN_ICMP | \
+					 NETIF_CHECKSUM_GEN_ICMP6)
+#endif
+#if LWIP_FULL_CSUM_OFFLOAD_RX==1
+#define XAXIEMACIF_CHECKSUM_CHECK	(NETIF_CHECKSUM_CHECK_ICMP | \
+					 NETIF_CHECKSUM_CHECK_ICMP6)
+#elif LWIP_PARTIAL_CSUM_OFFLOAD_RX==1
+#define XAXIEMACIF_CHECKSUM_CHECK	(NETIF_CHECKSUM_CHECK_IP | \
+					 NETIF_CHECKSUM_CHECK_UDP | \
+					 NETIF_CHECKSUM_CHECK_ICMP | \
+					 NETIF_CHECKSUM_CHECK_ICMP6)
+#else
+#define XAXIEMACIF_CHECKSUM_CHECK	(NETIF_CHECKSUM_CHECK_IP | \
+					 NETIF_CHECKSUM_CHECK_UDP | \
+					 NETIF_CHECKSUM_CHECK_TCP | \
+					 NETIF_CHECKSUM_CHECK_ICMP | \
+					 NETIF_CHECKSUM_CHECK_ICMP6)
+#endif
+#endif
+
 #if LWIP_IGMP
 static err_t xaxiemacif_mac_filter_update (struct netif *netif,
 								ip_addr_t *group, u8_t action);
@@ -151,6 +186,12 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
 #endif
         int count = 100;
 
+#if LWIP_TCP_LARGE_SEND
+	if (XLARGESEND_NEEDED(netif, p)) {
+		return xlargesend_output(netif, p, low_level_output);
+	}
+#endif
+
         SYS_ARCH_PROTECT(lev);
 
         while (count) {
@@ -341,6 +382,11 @@ static err_t low_level_init(struct netif *netif)
 	netif->flags |= NETIF_FLAG_IGMP;
 #endif
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+	NETIF_SET_CHECKSUM_CTRL(netif, XAXIEMACIF_CHECKSUM_GEN |
+					XAXIEMACIF_CHECKSUM_CHECK);
+#endif
+
 #if !NO_SYS
 	sys_sem_new(&xemac->sem_rx_data_available, 0);
 #endif
@@ -356,6 +402,11 @@ static err_t low_level_init(struct netif *netif)
 #ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA
 		/* initialize the DMA engine */
 		init_axi_dma(xemac);
+#if LWIP_TCP_LARGE_SEND && (LWIP_FULL_CSUM_OFFLOAD_TX==1 || LWIP_PARTIAL_CSUM_OFFLOAD_TX==1)
+		/* axidma_sgsend() has the TCP checksum of each frame inserted */
+		xlargesend_init();
+		netif->flags |= NETIF_FLAG_LARGE_SEND;
+#endif
 #endif
 	} else if (XAxiEthernet_IsFifo(&xaxiemacif->axi_ethernet)) {
 #ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_FIFO
@@ -83,6 +83,13 @@
 /* Byte alignment of BDs */
 #define BD_ALIGNMENT (XAXIDMA_BD_MINIMUM_ALIGNMENT*2)
 
+/* Full checksum offload status in RX status word 2: 5 means a bad IP header
+ * checksum, 6 and 7 a bad TCP or UDP checksum
+ */
+#define FULL_CSUM_STATUS_MASK	0x00000038
+#define FULL_CSUM_STATUS_SHIFT	3
+#define FULL_CSUM_BAD		5
+
 #if XPAR_INTC_0_HAS_FAST == 1
 /*********** Function Prototypes *********************************************/
 /*
@@ -174,8 +181,9 @@ s32_t is_checksum_valid(XAxiDma_Bd *rxbd, struct pbuf *p) {
 	struct ethip_hdr *ehdr = p->payload;
 	u8_t proto = IPH_PROTO(&ehdr->ip);
 
-	/* check if it is a TCP packet */
-	if (htons(ehdr->eth.type) == ETHTYPE_IP && proto == IP_PROTO_TCP) {
+	/* check if it is a TCP packet, fragments are left to the stack */
+	if (htons(ehdr->eth.type) == ETHTYPE_IP && proto == IP_PROTO_TCP &&
+		(IPH_OFFSET(&ehdr->ip) & PP_HTONS(IP_OFFMASK | IP_MF)) == 0) {
 		u32_t iphdr_len;
 		u16_t csum_in_rxbd, pseudo_csum, iphdr_csum, padding_csum;
 		u16_t tcp_payload_offset;
@@ -234,6 +242,14 @@ s32_t is_checksum_valid(XAxiDma_Bd *rxbd, struct pbuf *p) {
 	}
 }
 
+static inline s32_t is_full_csum_valid(XAxiDma_Bd *rxbd)
+{
+	u32_t status = (XAxiDma_BdRead(rxbd, XAXIDMA_BD_USR2_OFFSET) &
+				FULL_CSUM_STATUS_MASK) >> FULL_CSUM_STATUS_SHIFT;
+
+	return status < FULL_CSUM_BAD;
+}
+
 static inline void *alloc_bdspace(int n_desc)
 {
 	int space = XAxiDma_BdRingMemCalc(BD_ALIGNMENT, n_desc);
@@ -442,6 +458,26 @@ static void axidma_recv_handler(void *arg)
 			/* Verify for partial checksum offload case */
 			if (!is_checksum_valid(rxbd, p)) {
 				LWIP_DEBUGF(NETIF_DEBUG, ("Incorrect csum as calculated by the hw\r\n"));
+#if LINK_STATS
+				lwip_stats.link.chkerr++;
+				lwip_stats.link.drop++;
+#endif
+				pbuf_free(p);
+				rxbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(rxring, rxbd);
+				continue;
+			}
+#endif
+#if LWIP_FULL_CSUM_OFFLOAD_RX==1
+			/* lwIP doesn't check what the hw found to be bad */
+			if (!is_full_csum_valid(rxbd)) {
+				LWIP_DEBUGF(NETIF_DEBUG, ("Bad csum reported by the hw\r\n"));
+#if LINK_STATS
+				lwip_stats.link.chkerr++;
+				lwip_stats.link.drop++;
+#endif
+				pbuf_free(p);
+				rxbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(rxring, rxbd);
+				continue;
 			}
 #endif
 			/* store it in the receive queue,
@@ -491,10 +527,12 @@ s32_t process_sent_bds(XAxiDma_BdRing *txring)
 	if (n_bds == 0) {
 		return XST_FAILURE;
 	}
-	/* free the pbuf associated with each BD */
+	/* free the pbuf of each frame, kept by its last BD */
 	for (i = 0, txbd = txbdset; i < n_bds; i++) {
 		struct pbuf *p = (struct pbuf *)(UINTPTR)XAxiDma_BdGetId(txbd);
-		pbuf_free(p);
+		if (p != NULL) {
+			pbuf_free(p);
+		}
 		txbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(txring, txbd);
 	}
 	/* free the processed BD's */
@@ -541,16 +579,18 @@ XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 		else {
 			XAxiDma_BdSetLength(txbd, q->len, txring->MaxTransferLen);
 		}
-		XAxiDma_BdSetId(txbd, (void *)q);
+		XAxiDma_BdSetId(txbd, NULL);
 		XAxiDma_BdSetCtrl(txbd, 0);
 		XCACHE_FLUSH_DCACHE_RANGE(q->payload, q->len);
 
-		pbuf_ref(q);
-
 		last_txbd = txbd;
 		txbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(txring, txbd);
 	}
 
+	/* the whole chain is freed once the last BD of the frame is done */
+	pbuf_ref(p);
+	XAxiDma_BdSetId(last_txbd, (void *)p);
+
 	if (n_pbufs == 1) {
 		XAxiDma_BdSetCtrl(txbdset, XAXIDMA_BD_CTRL_TXSOF_MASK
 				| XAXIDMA_BD_CTRL_TXEOF_MASK);
@@ -46,6 +46,7 @@
 #include "netif/xemacpsif.h"
 #include "netif/xadapter.h"
 #include "netif/xpqueue.h"
+#include "netif/xlargesend.h"
 #include "xparameters.h"
 #include "xuartps.h"
 #include "xscugic.h"
@@ -60,6 +61,9 @@
 #define IFNAME0 't'
 #define IFNAME1 'e'
 
+/* Packets taken from the receive queue at once by xemacpsif_input() */
+#define XEMACPSIF_INPUT_BATCH	16
+
 #if LWIP_IGMP
 static err_t xemacpsif_mac_filter_update (struct netif *netif,
 							ip_addr_t *group, u8_t action);
@@ -83,8 +87,7 @@ int32_t lExpireCounter = 0;
 #endif
 
 /*
- * this function is always called with interrupts off
- * this function also assumes that there are available BD's
+ * this function assumes that there are available BD's
  */
 static err_t _unbuffered_low_level_output(xemacpsif_s *xemacpsif,
 													struct pbuf *p)
@@ -132,16 +135,31 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
 	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 
-	SYS_ARCH_PROTECT(lev);
+	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
+
+#if LWIP_TCP_LARGE_SEND
+	if (XLARGESEND_NEEDED(netif, p)) {
+		return xlargesend_output(netif, p, low_level_output);
+	}
+#endif
 
-	/* check if space is available to send */
+	/* Reclaim sent BDs with interrupts off. emacps_sgsend() keeps
+	 * interrupts disabled only around its own ring updates.
+	 */
+	SYS_ARCH_PROTECT(lev);
     freecnt = is_tx_space_available(xemacpsif);
+#if XLWIP_CONFIG_EMAC_TX_COMPLETE_THRESHOLD > 0
+    if ((freecnt <= 5) ||
+		(txring->HwCnt >= XLWIP_CONFIG_EMAC_TX_COMPLETE_THRESHOLD)) {
+#else
     if (freecnt <= 5) {
-	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
+#endif
 		process_sent_bds(xemacpsif, txring);
+		freecnt = is_tx_space_available(xemacpsif);
 	}
+	SYS_ARCH_UNPROTECT(lev);
 
-    if (is_tx_space_available(xemacpsif)) {
+    if (freecnt) {
 		_unbuffered_low_level_output(xemacpsif, p);
 		err = ERR_OK;
 	} else {
@@ -152,7 +170,6 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
 		err = ERR_MEM;
 	}
 
-	SYS_ARCH_UNPROTECT(lev);
 	return err;
 }
 
@@ -162,20 +179,29 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
  * Should allocate a pbuf and transfer the bytes of the incoming
  * packet from the interface into the pbuf.
  *
+ * Takes up to n packets from the receive queue. The RX interrupt (or the
+ * RX poll) is the only producer and the input thread the only consumer of
+ * the queue, so it needs no lock.
+ *
  */
-static struct pbuf * low_level_input(struct netif *netif)
+static s32_t low_level_input(struct netif *netif, struct pbuf **p, s32_t n)
 {
 	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
-	struct pbuf *p;
 
-	/* see if there is data to process */
-	if (pq_qlength(xemacpsif->recv_q) == 0)
-		return NULL;
+	s32_t n_q1 = 0;
 
-	/* return one packet from receive q */
-	p = (struct pbuf *)pq_dequeue(xemacpsif->recv_q);
-	return p;
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+	/* frames of the priority queue go first */
+	if (xemacpsif->rxq1_bdspace != NULL) {
+		n_q1 = pq_dequeue_batch(xemacpsif->rxq1_recv_q, (void **)p, n);
+		if (n_q1 == n) {
+			return n_q1;
+		}
+	}
+#endif
+	return n_q1 + pq_dequeue_batch(xemacpsif->recv_q, (void **)(p + n_q1),
+								n - n_q1);
 }
 
 /*
@@ -202,67 +228,81 @@ static err_t xemacpsif_output(struct netif *netif, struct pbuf *p,
  * should handle the actual reception of bytes from the network
  * interface.
  *
- * Returns the number of packets read (max 1 packet on success,
- * 0 if there are no packets)
+ * Returns the number of packets read (max XEMACPSIF_INPUT_BATCH packets
+ * per call, 0 if there are no packets)
+ *
+ * In RX poll mode (XLWIP_CONFIG_EMAC_RX_POLL_BUDGET) it first moves up to
+ * XLWIP_CONFIG_EMAC_RX_POLL_BUDGET frames from the RX ring to the receive
+ * queue.
  *
  */
 
 s32_t xemacpsif_input(struct netif *netif)
 {
 	struct eth_hdr *ethhdr;
+	struct pbuf *pkts[XEMACPSIF_INPUT_BATCH];
 	struct pbuf *p;
-	SYS_ARCH_DECL_PROTECT(lev);
+	s32_t n_pkts, k;
+	s32_t n_read = 0;
+
+#if XLWIP_CONFIG_EMAC_RX_POLL_BUDGET > 0
+	emacps_rx_poll((struct xemac_s *)(netif->state),
+			XLWIP_CONFIG_EMAC_RX_POLL_BUDGET);
+#endif
 
 #ifdef OS_IS_FREERTOS
 	while (1)
 #endif
 	{
-		/* move received packet into a new pbuf */
-		SYS_ARCH_PROTECT(lev);
-		p = low_level_input(netif);
-		SYS_ARCH_UNPROTECT(lev);
+		/* move received packets into new pbufs */
+		n_pkts = low_level_input(netif, pkts, XEMACPSIF_INPUT_BATCH);
 
 		/* no packet could be read, silently ignore this */
-		if (p == NULL) {
-			return 0;
+		if (n_pkts == 0) {
+			return n_read;
 		}
 
-		/* points to packet payload, which starts with an Ethernet header */
-		ethhdr = p->payload;
-
-	#if LINK_STATS
-		lwip_stats.link.recv++;
-	#endif /* LINK_STATS */
-
-		switch (htons(ethhdr->type)) {
-			/* IP or ARP packet? */
-			case ETHTYPE_IP:
-			case ETHTYPE_ARP:
-	#if LWIP_IPV6
-			/*IPv6 Packet?*/
-			case ETHTYPE_IPV6:
-	#endif
-	#if PPPOE_SUPPORT
-				/* PPPoE packet? */
-			case ETHTYPE_PPPOEDISC:
-			case ETHTYPE_PPPOE:
-	#endif /* PPPOE_SUPPORT */
-				/* full packet send to tcpip_thread to process */
-				if (netif->input(p, netif) != ERR_OK) {
-					LWIP_DEBUGF(NETIF_DEBUG, ("xemacpsif_input: IP input error\r\n"));
+		for (k = 0; k < n_pkts; k++) {
+			p = pkts[k];
+
+			/* points to packet payload, which starts with an Ethernet header */
+			ethhdr = p->payload;
+
+		#if LINK_STATS
+			lwip_stats.link.recv++;
+		#endif /* LINK_STATS */
+
+			switch (htons(ethhdr->type)) {
+				/* IP or ARP packet? */
+				case ETHTYPE_IP:
+				case ETHTYPE_ARP:
+		#if LWIP_IPV6
+				/*IPv6 Packet?*/
+				case ETHTYPE_IPV6:
+		#endif
+		#if PPPOE_SUPPORT
+					/* PPPoE packet? */
+				case ETHTYPE_PPPOEDISC:
+				case ETHTYPE_PPPOE:
+		#endif /* PPPOE_SUPPORT */
+					/* full packet send to tcpip_thread to process */
+					if (netif->input(p, netif) != ERR_OK) {
+						LWIP_DEBUGF(NETIF_DEBUG, ("xemacpsif_input: IP input error\r\n"));
+						pbuf_free(p);
+						p = NULL;
+					}
+					break;
+
+				default:
 					pbuf_free(p);
 					p = NULL;
-				}
-				break;
-
-			default:
-				pbuf_free(p);
-				p = NULL;
-				break;
+					break;
+			}
 		}
+		n_read += n_pkts;
 	}
 
-	return 1;
+	return n_read;
 }
 
 
@@ -313,6 +353,27 @@ static err_t low_level_init(struct netif *netif)
 	if (!xemacpsif->recv_q)
 		return ERR_MEM;
 
+#if XLWIP_CONFIG_EMAC_RX_POLL_BUDGET > 0
+	xemacpsif->rx_isr_count = 0;
+	xemacpsif->rx_isr_time = 0;
+	xemacpsif->rx_isr_time_max = 0;
+	xemacpsif->rx_poll_count = 0;
+	xemacpsif->rx_poll_frames = 0;
+	xemacpsif->rx_poll_frames_max = 0;
+	xemacpsif->rx_poll_budget_exhausted = 0;
+#endif
+
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+	xemacpsif->rxq1_bdspace = NULL;
+	xemacpsif->rxq1_recv_q = pq_create_queue();
+	if (!xemacpsif->rxq1_recv_q)
+		return ERR_MEM;
+#endif
+	memset(xemacpsif->rxq_stats, 0, sizeof(xemacpsif->rxq_stats));
+	xemacpsif->rx_screen_t1_used = 0;
+	xemacpsif->rx_screen_t2_used = 0;
+	xemacpsif->rx_screen_etht_used = 0;
+
 	/* maximum transfer unit */
 #ifdef ZYNQMP_USE_JUMBO
 	netif->mtu = XEMACPS_MTU_JUMBO - XEMACPS_HDR_SIZE;
@@ -339,6 +400,19 @@ static err_t low_level_init(struct netif *netif)
 	netif->flags |= NETIF_FLAG_IGMP;
 #endif
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+	/* IP, UDP and TCP checksums are generated and checked by the GEM */
+	NETIF_SET_CHECKSUM_CTRL(netif, NETIF_CHECKSUM_GEN_ICMP |
+			NETIF_CHECKSUM_GEN_ICMP6 | NETIF_CHECKSUM_CHECK_ICMP |
+			NETIF_CHECKSUM_CHECK_ICMP6);
+#endif
+
+#if LWIP_TCP_LARGE_SEND && (!CHECKSUM_GEN_TCP || LWIP_CHECKSUM_CTRL_PER_NETIF)
+	/* the GEM inserts the TCP checksum of each frame */
+	xlargesend_init();
+	netif->flags |= NETIF_FLAG_LARGE_SEND;
+#endif
+
 #if !NO_SYS
 	sys_sem_new(&xemac->sem_rx_data_available, 0);
 #endif
@@ -733,3 +807,107 @@ void xemacpsif_resetrx_on_no_rxdata(struct netif *netif)
 
 	resetrx_on_no_rxdata(xemacpsif);
 }
+
+static s32_t xemacpsif_rx_queue_valid(xemacpsif_s *xemacpsif, u8_t queue)
+{
+	if (queue == 0) {
+		return 1;
+	}
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+	if ((queue == 1) && (xemacpsif->rxq1_bdspace != NULL)) {
+		return 1;
+	}
+#endif
+	return 0;
+}
+
+static err_t xemacpsif_add_rx_screen_t1(struct netif *netif, u32_t match,
+								u8_t queue)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	UINTPTR baseaddr = xemacpsif->emacps.Config.BaseAddress;
+	u32_t n_regs;
+
+	if (!xemacpsif_rx_queue_valid(xemacpsif, queue)) {
+		return ERR_ARG;
+	}
+	n_regs = (XEmacPs_ReadReg(baseaddr, XEMACPS_DCFG8_OFFSET) &
+			XEMACPS_DCFG8_T1SCR_MASK) >> XEMACPS_DCFG8_T1SCR_SHIFT;
+	if (xemacpsif->rx_screen_t1_used >= n_regs) {
+		return ERR_MEM;
+	}
+
+	XEmacPs_WriteReg(baseaddr, XEMACPS_SCREENT1_OFFSET +
+			(4 * xemacpsif->rx_screen_t1_used),
+			match | (queue & XEMACPS_SCREEN_QUEUE_MASK));
+	xemacpsif->rx_screen_t1_used++;
+	return ERR_OK;
+}
+
+/*
+ * xemacpsif_add_rx_screen_udp():
+ *
+ * Steers received UDP frames with destination port "port" (e.g. 319 and
+ * 320 for PTP) to RX queue "queue". Uses a screening type 1 register.
+ * Returns ERR_ARG if the queue is not set up (see emac_rxq1_descriptors)
+ * and ERR_MEM if all type 1 registers are in use.
+ */
+err_t xemacpsif_add_rx_screen_udp(struct netif *netif, u16_t port, u8_t queue)
+{
+	return xemacpsif_add_rx_screen_t1(netif, XEMACPS_SCREENT1_UDPE_MASK |
+			(((u32_t)port << XEMACPS_SCREENT1_UDP_SHIFT) &
+			XEMACPS_SCREENT1_UDP_MASK), queue);
+}
+
+/*
+ * xemacpsif_add_rx_screen_dstc():
+ *
+ * Steers received IP frames whose DS (IPv4) or traffic class (IPv6) field
+ * is "dstc" to RX queue "queue". Uses a screening type 1 register.
+ */
+err_t xemacpsif_add_rx_screen_dstc(struct netif *netif, u8_t dstc, u8_t queue)
+{
+	return xemacpsif_add_rx_screen_t1(netif, XEMACPS_SCREENT1_DSTCE_MASK |
+			(((u32_t)dstc << XEMACPS_SCREENT1_DSTC_SHIFT) &
+			XEMACPS_SCREENT1_DSTC_MASK), queue);
+}
+
+/*
+ * xemacpsif_add_rx_screen_ethertype():
+ *
+ * Steers received frames with EtherType "type" (e.g. 0x88F7 for PTP over
+ * Ethernet) to RX queue "queue". Uses a screening type 2 register and a
+ * screening EtherType register.
+ */
+err_t xemacpsif_add_rx_screen_ethertype(struct netif *netif, u16_t type,
+								u8_t queue)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	UINTPTR baseaddr = xemacpsif->emacps.Config.BaseAddress;
+	u32_t dcfg8;
+	u32_t etht;
+
+	if (!xemacpsif_rx_queue_valid(xemacpsif, queue)) {
+		return ERR_ARG;
+	}
+	dcfg8 = XEmacPs_ReadReg(baseaddr, XEMACPS_DCFG8_OFFSET);
+	if ((xemacpsif->rx_screen_t2_used >= ((dcfg8 & XEMACPS_DCFG8_T2SCR_MASK) >>
+			XEMACPS_DCFG8_T2SCR_SHIFT)) ||
+		(xemacpsif->rx_screen_etht_used >= ((dcfg8 & XEMACPS_DCFG8_SCR2ETH_MASK) >>
+			XEMACPS_DCFG8_SCR2ETH_SHIFT))) {
+		return ERR_MEM;
+	}
+
+	etht = xemacpsif->rx_screen_etht_used;
+	XEmacPs_WriteReg(baseaddr, XEMACPS_SCREENT2_ETHT_OFFSET + (4 * etht), type);
+	XEmacPs_WriteReg(baseaddr, XEMACPS_SCREENT2_OFFSET +
+			(4 * xemacpsif->rx_screen_t2_used),
+			XEMACPS_SCREENT2_ETHTE_MASK |
+			((etht << XEMACPS_SCREENT2_ETHT_SHIFT) & XEMACPS_SCREENT2_ETHT_MASK) |
+			(queue & XEMACPS_SCREEN_QUEUE_MASK));
+	xemacpsif->rx_screen_etht_used++;
+	xemacpsif->rx_screen_t2_used++;
+	return ERR_OK;
+}
@@ -53,6 +53,9 @@
 #include "semphr.h"
 #include "timers.h"
 #endif
+#if XLWIP_CONFIG_EMAC_RX_POLL_BUDGET > 0
+#include "xtime_l.h"
+#endif
 
 
 #define INTC_BASE_ADDR		XPAR_SCUGIC_0_CPU_BASEADDR
@@ -67,6 +70,41 @@ static UINTPTR rx_pbufs_storage[4*XLWIP_CONFIG_N_RX_DESC];
 
 static s32_t emac_intr_num;
 
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error "RX queue 1 needs LWIP_SUPPORT_CUSTOM_PBUF"
+#endif
+
+/* RX queue 1 buffers: the queue 1 buffer size register is in 64 byte units */
+#ifdef ZYNQMP_USE_JUMBO
+#define EMACPS_RXQ1_BUF_SIZE	((MAX_FRAME_SIZE_JUMBO + 63) & ~63)
+#else
+#define EMACPS_RXQ1_BUF_SIZE	((XEMACPS_MAX_FRAME_SIZE + 63) & ~63)
+#endif
+
+struct rxq1_pool;
+
+typedef struct rxq1_pbuf {
+	u8_t payload[EMACPS_RXQ1_BUF_SIZE];
+	struct pbuf_custom pc;
+	struct rxq1_pbuf *next;
+	struct rxq1_pool *pool;
+} __attribute__ ((aligned (64))) rxq1_pbuf_t;
+
+/* Buffer pool of one GEM, claimed by the GEM when queue 1 is set up */
+typedef struct rxq1_pool {
+	rxq1_pbuf_t pbufs[XEMACPSIF_RXQ1_PBUFS];
+	xemacpsif_s *owner;
+	rxq1_pbuf_t *free_list;
+	u8_t refill_busy;
+} rxq1_pool_t;
+
+static UINTPTR rxq1_pbufs_storage[4*XLWIP_CONFIG_EMAC_RXQ1_DESC];
+static rxq1_pool_t rxq1_pools[XPAR_XEMACPS_NUM_INSTANCES];
+
+static void setup_rxq1_bds(xemacpsif_s *xemacpsif);
+#endif
+
 /******************************************************************************
  * Each BD is of 8 bytes of size and the BDs (BD chain) need to be  put
  * at uncached memory location. If they are not put at uncached
@@ -123,6 +161,26 @@ long xInsideISR = 0;
 #define XEMACPS_BD_TO_INDEX(ringptr, bdptr)				\
 	(((UINTPTR)bdptr - (UINTPTR)(ringptr)->BaseBdAddr) / (ringptr)->Separation)
 
+/* Payloads of a TX pbuf chain that are at most this many bytes apart are
+ * flushed from the D-cache with one call. The bytes in between are flushed
+ * too, which is harmless.
+ */
+#define EMACPS_TX_FLUSH_MERGE_GAP	64
+
+#if XLWIP_CONFIG_EMAC_RX_POLL_BUDGET > 0
+/* The R5 has a global time base only when a sleep timer is configured */
+#if defined (ARMR5) && !defined (SLEEP_TIMER_BASEADDR)
+#define EMACPS_RX_TIMESTAMP(t)	((t) = 0)
+#else
+#define EMACPS_RX_TIMESTAMP(t)	XTime_GetTime(&(t))
+#endif
+
+/* Frames emacps_rx_poll() takes off the RX ring per interrupt masked
+ * section. The frames are passed on with interrupts enabled.
+ */
+#define EMACPS_RX_POLL_BATCH	16
+#endif
+
 
 s32_t is_tx_space_available(xemacpsif_s *emac)
 {
@@ -191,13 +249,111 @@ u32_t get_base_index_rxpbufsstorage (xemacpsif_s *xemacpsif)
 	return index;
 }
 
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+static inline
+u32_t get_base_index_rxq1pbufsstorage (xemacpsif_s *xemacpsif)
+{
+	return (get_base_index_rxpbufsstorage(xemacpsif) / XLWIP_CONFIG_N_RX_DESC) *
+				XLWIP_CONFIG_EMAC_RXQ1_DESC;
+}
+
+/*
+ * rxq1_pool_get():
+ *
+ * Returns the queue 1 buffer pool of the GEM. With claim set, a GEM without
+ * a pool yet takes a free one, filled with all its buffers. The pool stays
+ * with the GEM, also across a reset by the error handler, as its buffers
+ * may still be held by the stack.
+ */
+static rxq1_pool_t *rxq1_pool_get(xemacpsif_s *xemacpsif, s32_t claim)
+{
+	rxq1_pool_t *pool;
+	s32_t i, k;
+
+	for (i = 0; i < XPAR_XEMACPS_NUM_INSTANCES; i++) {
+		if (rxq1_pools[i].owner == xemacpsif) {
+			return &rxq1_pools[i];
+		}
+	}
+	if (!claim) {
+		return NULL;
+	}
+	for (i = 0; i < XPAR_XEMACPS_NUM_INSTANCES; i++) {
+		pool = &rxq1_pools[i];
+		if (pool->owner == NULL) {
+			pool->free_list = NULL;
+			for (k = 0; k < XEMACPSIF_RXQ1_PBUFS; k++) {
+				pool->pbufs[k].pool = pool;
+				pool->pbufs[k].next = pool->free_list;
+				pool->free_list = &pool->pbufs[k];
+			}
+			pool->refill_busy = 0;
+			pool->owner = xemacpsif;
+			return pool;
+		}
+	}
+	return NULL;
+}
+
+/*
+ * rxq1_pbuf_free():
+ *
+ * pbuf_custom free function of the RX queue 1 buffers. The buffer goes
+ * back to the pool of its GEM and is posted to the ring straight away if
+ * the ring has free BDs: once all buffers are held by the stack, queue 1
+ * receives nothing, so the receive path would never refill it.
+ */
+static void rxq1_pbuf_free(struct pbuf *p)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+	rxq1_pbuf_t *buf = (rxq1_pbuf_t *)((u8_t *)p - offsetof(rxq1_pbuf_t, pc));
+	rxq1_pool_t *pool = buf->pool;
+
+	SYS_ARCH_PROTECT(lev);
+	buf->next = pool->free_list;
+	pool->free_list = buf;
+	if (!pool->refill_busy && (pool->owner->rxq1_bdspace != NULL)) {
+		setup_rxq1_bds(pool->owner);
+	}
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+static struct pbuf *rxq1_pbuf_alloc(rxq1_pool_t *pool)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+	rxq1_pbuf_t *buf;
+
+	SYS_ARCH_PROTECT(lev);
+	buf = pool->free_list;
+	if (buf != NULL) {
+		pool->free_list = buf->next;
+	}
+	SYS_ARCH_UNPROTECT(lev);
+	if (buf == NULL) {
+		return NULL;
+	}
+
+	buf->pc.custom_free_function = rxq1_pbuf_free;
+	return pbuf_alloced_custom(PBUF_RAW, EMACPS_RXQ1_BUF_SIZE, PBUF_REF,
+			&buf->pc, buf->payload, EMACPS_RXQ1_BUF_SIZE);
+}
+#endif
+
+/*
+ * process_sent_bds():
+ *
+ * Reclaims the TX BDs completed by the hardware. The BDs of a batch are put
+ * back in their initial state with a single barrier for the whole batch.
+ * Only the last BD of a frame holds a pbuf reference, see emacps_sgsend().
+ * Must be called with interrupts disabled.
+ */
 void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 {
 	XEmacPs_Bd *txbdset;
 	XEmacPs_Bd *curbdpntr;
 	s32_t n_bds;
 	XStatus status;
-	s32_t n_pbufs_freed = 0;
+	s32_t k;
 	u32_t bdindex;
 	struct pbuf *p;
 	u32 *temp;
@@ -213,9 +369,8 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 			return;
 		}
 		/* free the processed BD's */
-		n_pbufs_freed = n_bds;
 		curbdpntr = txbdset;
-		while (n_pbufs_freed > 0) {
+		for (k = 0; k < n_bds; k++) {
 			bdindex = XEMACPS_BD_TO_INDEX(txring, curbdpntr);
 			temp = (u32 *)curbdpntr;
 			*temp = 0;
@@ -225,21 +380,26 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 			} else {
 				*temp = 0x80000000;
 			}
-			dsb();
 			p = (struct pbuf *)tx_pbufs_storage[index + bdindex];
 			if (p != NULL) {
 				pbuf_free(p);
+				tx_pbufs_storage[index + bdindex] = 0;
 			}
-			tx_pbufs_storage[index + bdindex] = 0;
 			curbdpntr = XEmacPs_BdRingNext(txring, curbdpntr);
-			n_pbufs_freed--;
-			dsb();
 		}
+		dsb();
 
 		status = XEmacPs_BdRingFree(txring, n_bds, txbdset);
 		if (status != XST_SUCCESS) {
 			LWIP_DEBUGF(NETIF_DEBUG, ("Failure while freeing in Tx Done ISR\r\n"));
 		}
+#if XLWIP_CONFIG_EMAC_TX_COMPLETE_THRESHOLD > 0
+		xemacpsif->tx_reclaim_count++;
+		xemacpsif->tx_reclaim_bds += n_bds;
+		if ((u32_t)n_bds > xemacpsif->tx_reclaim_bds_max) {
+			xemacpsif->tx_reclaim_bds_max = n_bds;
+		}
+#endif
 	}
 	return;
 }
@@ -259,6 +419,16 @@ void emacps_send_handler(void *arg)
 	regval = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_TXSR_OFFSET);
 	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress,XEMACPS_TXSR_OFFSET, regval);
 
+#if XLWIP_CONFIG_EMAC_TX_COMPLETE_THRESHOLD > 0
+	/* Leave small batches to the transmit path, see low_level_output() */
+	if (txringptr->HwCnt < XLWIP_CONFIG_EMAC_TX_COMPLETE_THRESHOLD) {
+		xemacpsif->tx_complete_deferred++;
+#ifdef OS_IS_FREERTOS
+		xInsideISR--;
+#endif
+		return;
+	}
+#endif
 	/* If Transmit done interrupt is asserted, process completed BD's */
 	process_sent_bds(xemacpsif, txringptr);
 #ifdef OS_IS_FREERTOS
@@ -266,34 +436,63 @@ void emacps_send_handler(void *arg)
 #endif
 }
 
+/*
+ * emacps_sgsend():
+ *
+ * Queues the pbuf chain p as one frame, one BD per pbuf, without copying.
+ * Interrupts are disabled only while BDs are allocated from the ring and
+ * while the filled BDs are handed to the hardware. In between, the BDs
+ * belong to the caller only: the TX done handler looks at BDs committed to
+ * the hardware, and calls to this function are serialised by lwIP. The
+ * error handler may reset the whole ring meanwhile; it bumps tx_ring_gen,
+ * and the frame is then dropped at the commit. The reset has returned its
+ * BDs to the ring already, and p is referenced only once the commit is
+ * certain.
+ *
+ * The D-cache is flushed once per run of pbufs whose payloads are adjacent
+ * in memory, instead of once per pbuf. A single reference on the head of
+ * the chain, stored with the last BD of the frame, keeps the whole chain
+ * alive until the frame has been sent.
+ */
 XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 {
 	struct pbuf *q;
 	s32_t n_pbufs;
 	XEmacPs_Bd *txbdset, *txbd, *last_txbd = NULL;
-	XEmacPs_Bd *temp_txbd;
 	XStatus status;
 	XEmacPs_BdRing *txring;
 	u32_t bdindex;
+	u32_t last_bdindex = 0;
 	u32_t lev;
 	u32_t index;
 	u32_t max_fr_size;
-
-	lev = mfcpsr();
-	mtcpsr(lev | 0x000000C0);
+	u32_t ring_gen;
+	UINTPTR flush_start = 0;
+	UINTPTR flush_end = 0;
+	s32_t cache_flush;
 
 	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
 
 	index = get_base_index_txpbufsstorage (xemacpsif);
+	cache_flush = (xemacpsif->emacps.Config.IsCacheCoherent == 0);
+
+#ifdef ZYNQMP_USE_JUMBO
+	max_fr_size = MAX_FRAME_SIZE_JUMBO - 18;
+#else
+	max_fr_size = XEMACPS_MAX_FRAME_SIZE - 18;
+#endif
 
 	/* first count the number of pbufs */
 	for (q = p, n_pbufs = 0; q != NULL; q = q->next)
 		n_pbufs++;
 
 	/* obtain as many BD's */
+	lev = mfcpsr();
+	mtcpsr(lev | 0x000000C0);
 	status = XEmacPs_BdRingAlloc(txring, n_pbufs, &txbdset);
+	ring_gen = xemacpsif->tx_ring_gen;
+	mtcpsr(lev);
 	if (status != XST_SUCCESS) {
-		mtcpsr(lev);
 		LWIP_DEBUGF(NETIF_DEBUG, ("sgsend: Error allocating TxBD\r\n"));
 		return XST_FAILURE;
 	}
@@ -301,6 +500,11 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 	for(q = p, txbd = txbdset; q != NULL; q = q->next) {
 		bdindex = XEMACPS_BD_TO_INDEX(txring, txbd);
 		if (tx_pbufs_storage[index + bdindex] != 0) {
+			lev = mfcpsr();
+			mtcpsr(lev | 0x000000C0);
+			if (xemacpsif->tx_ring_gen == ring_gen) {
+				XEmacPs_BdRingUnAlloc(txring, n_pbufs, txbdset);
+			}
 			mtcpsr(lev);
 			LWIP_DEBUGF(NETIF_DEBUG, ("PBUFS not available\r\n"));
 			return XST_FAILURE;
@@ -309,44 +513,58 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 		/* Send the data from the pbuf to the interface, one pbuf at a
 		   time. The size of the data in each pbuf is kept in the ->len
 		   variable. */
-		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheFlushRange((UINTPTR)q->payload, (UINTPTR)q->len);
+		if (cache_flush) {
+			if ((flush_end != 0) && ((UINTPTR)q->payload >= flush_start) &&
+				((UINTPTR)q->payload <= flush_end + EMACPS_TX_FLUSH_MERGE_GAP)) {
+				if ((UINTPTR)q->payload + q->len > flush_end) {
+					flush_end = (UINTPTR)q->payload + q->len;
+				}
+			} else {
+				if (flush_end != 0) {
+					Xil_DCacheFlushRange(flush_start, flush_end - flush_start);
+				}
+				flush_start = (UINTPTR)q->payload;
+				flush_end = flush_start + q->len;
+			}
 		}
 
 		XEmacPs_BdSetAddressTx(txbd, (UINTPTR)q->payload);
 
-#ifdef ZYNQMP_USE_JUMBO
-		max_fr_size = MAX_FRAME_SIZE_JUMBO - 18;
-#else
-		max_fr_size = XEMACPS_MAX_FRAME_SIZE - 18;
-#endif
 		if (q->len > max_fr_size)
 			XEmacPs_BdSetLength(txbd, max_fr_size & 0x3FFF);
 		else
 			XEmacPs_BdSetLength(txbd, q->len & 0x3FFF);
 
-		tx_pbufs_storage[index + bdindex] = (UINTPTR)q;
-
-		pbuf_ref(q);
 		last_txbd = txbd;
+		last_bdindex = bdindex;
 		XEmacPs_BdClearLast(txbd);
 		txbd = XEmacPs_BdRingNext(txring, txbd);
 	}
 	XEmacPs_BdSetLast(last_txbd);
-	/* For fragmented packets, remember the 1st BD allocated for the 1st
-	   packet fragment. The used bit for this BD should be cleared at the end
-	   after clearing out used bits for other fragments. For packets without
-	   just remember the allocated BD. */
-	temp_txbd = txbdset;
-	txbd = txbdset;
-	txbd = XEmacPs_BdRingNext(txring, txbd);
-	q = p->next;
-	for(; q != NULL; q = q->next) {
+	if (flush_end != 0) {
+		Xil_DCacheFlushRange(flush_start, flush_end - flush_start);
+	}
+
+	/* Commit the frame. For fragmented packets the used bit of the 1st BD
+	   is cleared last, after the used bits of the other fragments, so the
+	   hardware never sees a partial frame. */
+	lev = mfcpsr();
+	mtcpsr(lev | 0x000000C0);
+	if (xemacpsif->tx_ring_gen != ring_gen) {
+		mtcpsr(lev);
+		LWIP_DEBUGF(NETIF_DEBUG, ("sgsend: TxBD ring reset, frame dropped\r\n"));
+		return XST_FAILURE;
+	}
+	pbuf_ref(p);
+	tx_pbufs_storage[index + last_bdindex] = (UINTPTR)p;
+
+	txbd = XEmacPs_BdRingNext(txring, txbdset);
+	for (q = p->next; q != NULL; q = q->next) {
 		XEmacPs_BdClearTxUsed(txbd);
-		dsb();
 		txbd = XEmacPs_BdRingNext(txring, txbd);
 	}
-	XEmacPs_BdClearTxUsed(temp_txbd);
+	dsb();
+	XEmacPs_BdClearTxUsed(txbdset);
 	dsb();
 
 	status = XEmacPs_BdRingToHw(txring, n_pbufs, txbdset);
@@ -374,6 +592,7 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 	u32_t bdindex;
 	u32 *temp;
 	u32_t index;
+	u32_t lev;
 
 	index = get_base_index_rxpbufsstorage (xemacpsif);
 
@@ -390,17 +609,39 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 			lwip_stats.link.memerr++;
 			lwip_stats.link.drop++;
 #endif
+			xemacpsif->rxq_stats[0].nobuf++;
 			printf("unable to alloc pbuf in recv_handler\r\n");
 			return;
 		}
+		/* The BD is handed to the GEM only by the address write below,
+		 * so the buffer can be invalidated before the BD is taken.
+		 */
+#ifdef ZYNQMP_USE_JUMBO
+		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
+			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)MAX_FRAME_SIZE_JUMBO);
+		}
+#else
+		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
+			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)XEMACPS_MAX_FRAME_SIZE);
+		}
+#endif
+
+		/* Only the ring update races with a ring reset by the error
+		 * handler; in the interrupt handlers this is a no-op.
+		 */
+		lev = mfcpsr();
+		mtcpsr(lev | 0x000000C0);
 		status = XEmacPs_BdRingAlloc(rxring, 1, &rxbd);
 		if (status != XST_SUCCESS) {
+			mtcpsr(lev);
 			LWIP_DEBUGF(NETIF_DEBUG, ("setup_rx_bds: Error allocating RxBD\r\n"));
 			pbuf_free(p);
 			return;
 		}
 		status = XEmacPs_BdRingToHw(rxring, 1, rxbd);
 		if (status != XST_SUCCESS) {
+			XEmacPs_BdRingUnAlloc(rxring, 1, rxbd);
+			mtcpsr(lev);
 			LWIP_DEBUGF(NETIF_DEBUG, ("Error committing RxBD to hardware: "));
 			if (status == XST_DMA_SG_LIST_ERROR) {
 				LWIP_DEBUGF(NETIF_DEBUG, ("XST_DMA_SG_LIST_ERROR: this function was called out of sequence with XEmacPs_BdRingAlloc()\r\n"));
@@ -410,18 +651,8 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 			}
 
 			pbuf_free(p);
-			XEmacPs_BdRingUnAlloc(rxring, 1, rxbd);
 			return;
 		}
-#ifdef ZYNQMP_USE_JUMBO
-		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)MAX_FRAME_SIZE_JUMBO);
-		}
-#else
-		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)XEMACPS_MAX_FRAME_SIZE);
-		}
-#endif
 		bdindex = XEMACPS_BD_TO_INDEX(rxring, rxbd);
 		temp = (u32 *)rxbd;
 		if (bdindex == (XLWIP_CONFIG_N_RX_DESC - 1)) {
@@ -435,33 +666,114 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 
 		XEmacPs_BdSetAddressRx(rxbd, (UINTPTR)p->payload);
 		rx_pbufs_storage[index + bdindex] = (UINTPTR)p;
+		mtcpsr(lev);
 	}
 }
 
-void emacps_recv_handler(void *arg)
+/*
+ * take_recv_bd():
+ *
+ * Takes the pbuf of a received BD off the ring storage and returns it with
+ * the frame length in rx_bytes.
+ */
+static struct pbuf *take_recv_bd(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring,
+		XEmacPs_Bd *rxbd, UINTPTR *pbufs_storage, s32_t *rx_bytes)
 {
 	struct pbuf *p;
-	XEmacPs_Bd *rxbdset, *curbdptr;
+	u32_t bdindex;
+
+	bdindex = XEMACPS_BD_TO_INDEX(rxring, rxbd);
+	p = (struct pbuf *)pbufs_storage[bdindex];
+	pbufs_storage[bdindex] = 0;
+
+#ifdef ZYNQMP_USE_JUMBO
+	*rx_bytes = XEmacPs_GetRxFrameSize(&xemacpsif->emacps, rxbd);
+#else
+	(void)xemacpsif;
+	*rx_bytes = XEmacPs_BdGetLength(rxbd);
+#endif
+
+	return p;
+}
+
+/*
+ * pass_recv_frame():
+ *
+ * Trims a received pbuf to the frame length and queues it for the input
+ * path.
+ */
+static void pass_recv_frame(struct pbuf *p, s32_t rx_bytes, pq_queue_t *recv_q,
+		xemacpsif_rxq_stats *stats)
+{
+	/*
+	 * Adjust the buffer size to the actual number of bytes received.
+	 */
+	pbuf_realloc(p, rx_bytes);
+
+	/* Invalidate RX frame before queuing to handle
+	 * L1 cache prefetch conditions on any architecture.
+	 */
+	Xil_DCacheInvalidateRange((UINTPTR)p->payload, rx_bytes);
+
+	/* store it in the receive queue,
+	 * where it'll be processed by a different handler
+	 */
+	if (pq_enqueue(recv_q, (void*)p) < 0) {
+#if LINK_STATS
+		lwip_stats.link.memerr++;
+		lwip_stats.link.drop++;
+#endif
+		stats->drops++;
+		pbuf_free(p);
+	} else {
+		stats->frames++;
+	}
+}
+
+static void process_recv_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring,
+		XEmacPs_Bd *rxbdset, s32_t bd_processed, UINTPTR *pbufs_storage,
+		pq_queue_t *recv_q, xemacpsif_rxq_stats *stats)
+{
+	struct pbuf *p;
+	XEmacPs_Bd *curbdptr;
+	s32_t rx_bytes, k;
+
+	for (k = 0, curbdptr=rxbdset; k < bd_processed; k++) {
+		p = take_recv_bd(xemacpsif, rxring, curbdptr, pbufs_storage,
+				&rx_bytes);
+		pass_recv_frame(p, rx_bytes, recv_q, stats);
+		curbdptr = XEmacPs_BdRingNext( rxring, curbdptr);
+	}
+	/* free up the BD's */
+	XEmacPs_BdRingFree(rxring, bd_processed, rxbdset);
+}
+
+void emacps_recv_handler(void *arg)
+{
 	struct xemac_s *xemac;
 	xemacpsif_s *xemacpsif;
+	u32_t regval;
+	u32_t gigeversion;
+#if XLWIP_CONFIG_EMAC_RX_POLL_BUDGET > 0
+	XTime tstart, tend;
+#else
+	XEmacPs_Bd *rxbdset;
 	XEmacPs_BdRing *rxring;
 	volatile s32_t bd_processed;
-	s32_t rx_bytes, k;
-	u32_t bdindex;
-	u32_t regval;
 	u32_t index;
-	u32_t gigeversion;
+#endif
 
 	xemac = (struct xemac_s *)(arg);
 	xemacpsif = (xemacpsif_s *)(xemac->state);
-	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
 
 #ifdef OS_IS_FREERTOS
 	xInsideISR++;
 #endif
+#if XLWIP_CONFIG_EMAC_RX_POLL_BUDGET > 0
+	EMACPS_RX_TIMESTAMP(tstart);
+#endif
 
 	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
-	index = get_base_index_rxpbufsstorage (xemacpsif);
 	/*
 	 * If Reception done interrupt is asserted, call RX call back function
 	 * to handle the processed BDs and then raise the according flag.
@@ -472,6 +784,25 @@ void emacps_recv_handler(void *arg)
 			resetrx_on_no_rxdata(xemacpsif);
 	}
 
+#if XLWIP_CONFIG_EMAC_RX_POLL_BUDGET > 0
+	/* Poll mode: leave the RX ring to emacps_rx_poll(), which unmasks the
+	 * interrupt again once it has emptied the ring.
+	 */
+	XEmacPs_IntDisable(&xemacpsif->emacps, XEMACPS_IXR_FRAMERX_MASK);
+#if !NO_SYS
+	sys_sem_signal(&xemac->sem_rx_data_available);
+#endif
+
+	EMACPS_RX_TIMESTAMP(tend);
+	xemacpsif->rx_isr_count++;
+	xemacpsif->rx_isr_time += tend - tstart;
+	if ((u32_t)(tend - tstart) > xemacpsif->rx_isr_time_max) {
+		xemacpsif->rx_isr_time_max = (u32_t)(tend - tstart);
+	}
+#else
+	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
+	index = get_base_index_rxpbufsstorage (xemacpsif);
+
 	while(1) {
 
 		bd_processed = XEmacPs_BdRingFromHwRx(rxring, XLWIP_CONFIG_N_RX_DESC, &rxbdset);
@@ -479,52 +810,265 @@ void emacps_recv_handler(void *arg)
 			break;
 		}
 
-		for (k = 0, curbdptr=rxbdset; k < bd_processed; k++) {
-
-			bdindex = XEMACPS_BD_TO_INDEX(rxring, curbdptr);
-			p = (struct pbuf *)rx_pbufs_storage[index + bdindex];
+		process_recv_bds(xemacpsif, rxring, rxbdset, bd_processed,
+				&rx_pbufs_storage[index], xemacpsif->recv_q,
+				&xemacpsif->rxq_stats[0]);
+		setup_rx_bds(xemacpsif, rxring);
+#if !NO_SYS
+		sys_sem_signal(&xemac->sem_rx_data_available);
+#endif
+	}
+#endif
 
-			/*
-			 * Adjust the buffer size to the actual number of bytes received.
-			 */
-#ifdef ZYNQMP_USE_JUMBO
-			rx_bytes = XEmacPs_GetRxFrameSize(&xemacpsif->emacps, curbdptr);
-#else
-			rx_bytes = XEmacPs_BdGetLength(curbdptr);
+#ifdef OS_IS_FREERTOS
+	xInsideISR--;
 #endif
-			pbuf_realloc(p, rx_bytes);
+	return;
+}
 
-			/* Invalidate RX frame before queuing to handle
-			 * L1 cache prefetch conditions on any architecture.
-			 */
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, rx_bytes);
+#if XLWIP_CONFIG_EMAC_RX_POLL_BUDGET > 0
+/*
+ * emacps_rx_poll():
+ *
+ * Moves at most budget received frames from the RX ring to the receive
+ * queue and refills the ring once. When the ring is found empty the RX
+ * interrupt is unmasked again. Frames that arrive meanwhile are latched in
+ * the interrupt status register, so they raise the interrupt as soon as it
+ * is unmasked. When the budget is used up the interrupt stays masked and the
+ * input thread is woken up again to continue.
+ *
+ * Interrupts are masked only while BDs are taken off the ring, in batches
+ * of EMACPS_RX_POLL_BATCH, and while each BD is refilled, as the error
+ * handler may reset the ring. Trimming, cache maintenance and queuing of
+ * the frames and the pbuf allocation run with interrupts enabled.
+ *
+ * Returns the number of frames moved to the receive queue.
+ */
+s32_t emacps_rx_poll(struct xemac_s *xemac, s32_t budget)
+{
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	XEmacPs_BdRing *rxring;
+	XEmacPs_Bd *rxbdset, *curbdptr;
+	struct pbuf *frames[EMACPS_RX_POLL_BATCH];
+	s32_t lens[EMACPS_RX_POLL_BATCH];
+	s32_t bd_processed;
+	s32_t n_frames = 0;
+	s32_t k;
+	u32_t index;
+	u32_t lev;
 
-			/* store it in the receive queue,
-			 * where it'll be processed by a different handler
-			 */
-			if (pq_enqueue(xemacpsif->recv_q, (void*)p) < 0) {
-#if LINK_STATS
-				lwip_stats.link.memerr++;
-				lwip_stats.link.drop++;
-#endif
-				pbuf_free(p);
-			}
-			curbdptr = XEmacPs_BdRingNext( rxring, curbdptr);
+	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
+	index = get_base_index_rxpbufsstorage (xemacpsif);
+
+	while (n_frames < budget) {
+		lev = mfcpsr();
+		mtcpsr(lev | 0x000000C0);
+		bd_processed = XEmacPs_BdRingFromHwRx(rxring,
+				LWIP_MIN(budget - n_frames, EMACPS_RX_POLL_BATCH),
+				&rxbdset);
+		if (bd_processed <= 0) {
+			mtcpsr(lev);
+			break;
+		}
+		for (k = 0, curbdptr = rxbdset; k < bd_processed; k++) {
+			frames[k] = take_recv_bd(xemacpsif, rxring, curbdptr,
+					&rx_pbufs_storage[index], &lens[k]);
+			curbdptr = XEmacPs_BdRingNext(rxring, curbdptr);
 		}
-		/* free up the BD's */
 		XEmacPs_BdRingFree(rxring, bd_processed, rxbdset);
+		mtcpsr(lev);
+
+		for (k = 0; k < bd_processed; k++) {
+			pass_recv_frame(frames[k], lens[k], xemacpsif->recv_q,
+					&xemacpsif->rxq_stats[0]);
+		}
+		n_frames += bd_processed;
+	}
+	if (n_frames > 0) {
 		setup_rx_bds(xemacpsif, rxring);
+	}
+
+	xemacpsif->rx_poll_count++;
+	xemacpsif->rx_poll_frames += n_frames;
+	if ((u32_t)n_frames > xemacpsif->rx_poll_frames_max) {
+		xemacpsif->rx_poll_frames_max = n_frames;
+	}
+
+	if (n_frames < budget) {
+		XEmacPs_IntEnable(&xemacpsif->emacps, XEMACPS_IXR_FRAMERX_MASK);
+	} else {
+		xemacpsif->rx_poll_budget_exhausted++;
 #if !NO_SYS
 		sys_sem_signal(&xemac->sem_rx_data_available);
 #endif
 	}
 
+	return n_frames;
+}
+#endif
+
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+static void fill_rxq1_bds(xemacpsif_s *xemacpsif, rxq1_pool_t *pool)
+{
+	XEmacPs_BdRing *rxring = &xemacpsif->rxq1_ring;
+	XEmacPs_Bd *rxbd;
+	XStatus status;
+	struct pbuf *p;
+	u32_t freebds;
+	u32_t bdindex;
+	u32 *temp;
+	u32_t index;
+
+	index = get_base_index_rxq1pbufsstorage (xemacpsif);
+
+	freebds = XEmacPs_BdRingGetFreeCnt (rxring);
+	while (freebds > 0) {
+		freebds--;
+		p = rxq1_pbuf_alloc(pool);
+		if (!p) {
+#if LINK_STATS
+			lwip_stats.link.memerr++;
+#endif
+			/* refilled again when a buffer is freed */
+			xemacpsif->rxq_stats[1].nobuf++;
+			return;
+		}
+		status = XEmacPs_BdRingAlloc(rxring, 1, &rxbd);
+		if (status != XST_SUCCESS) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("setup_rxq1_bds: Error allocating RxBD\r\n"));
+			pbuf_free(p);
+			return;
+		}
+		status = XEmacPs_BdRingToHw(rxring, 1, rxbd);
+		if (status != XST_SUCCESS) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("setup_rxq1_bds: Error committing RxBD to hardware\r\n"));
+			pbuf_free(p);
+			XEmacPs_BdRingUnAlloc(rxring, 1, rxbd);
+			return;
+		}
+		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
+			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)EMACPS_RXQ1_BUF_SIZE);
+		}
+		bdindex = XEMACPS_BD_TO_INDEX(rxring, rxbd);
+		temp = (u32 *)rxbd;
+		if (bdindex == (XLWIP_CONFIG_EMAC_RXQ1_DESC - 1)) {
+			*temp = 0x00000002;
+		} else {
+			*temp = 0;
+		}
+		temp++;
+		*temp = 0;
+		dsb();
+
+		XEmacPs_BdSetAddressRx(rxbd, (UINTPTR)p->payload);
+		rxq1_pbufs_storage[index + bdindex] = (UINTPTR)p;
+	}
+}
+
+/* Must be called with interrupts disabled */
+static void setup_rxq1_bds(xemacpsif_s *xemacpsif)
+{
+	rxq1_pool_t *pool = rxq1_pool_get(xemacpsif, 0);
+
+	/* A buffer freed while filling must not start another fill */
+	if ((pool == NULL) || pool->refill_busy) {
+		return;
+	}
+	pool->refill_busy = 1;
+	fill_rxq1_bds(xemacpsif, pool);
+	pool->refill_busy = 0;
+}
+
+/*
+ * emacps_recv_q1_handler():
+ *
+ * RX queue 1 complete interrupt. Moves the received frames to the queue 1
+ * receive queue. RX poll mode applies to queue 0 only.
+ */
+void emacps_recv_q1_handler(void *arg)
+{
+	struct xemac_s *xemac;
+	xemacpsif_s *xemacpsif;
+	XEmacPs_Bd *rxbdset;
+	XEmacPs_BdRing *rxring;
+	s32_t bd_processed;
+	u32_t index;
+
+	xemac = (struct xemac_s *)(arg);
+	xemacpsif = (xemacpsif_s *)(xemac->state);
+
+#ifdef OS_IS_FREERTOS
+	xInsideISR++;
+#endif
+	rxring = &xemacpsif->rxq1_ring;
+	index = get_base_index_rxq1pbufsstorage (xemacpsif);
+
+	while(1) {
+		bd_processed = XEmacPs_BdRingFromHwRx(rxring,
+				XLWIP_CONFIG_EMAC_RXQ1_DESC, &rxbdset);
+		if (bd_processed <= 0) {
+			break;
+		}
+
+		process_recv_bds(xemacpsif, rxring, rxbdset, bd_processed,
+				&rxq1_pbufs_storage[index], xemacpsif->rxq1_recv_q,
+				&xemacpsif->rxq_stats[1]);
+		setup_rxq1_bds(xemacpsif);
+#if !NO_SYS
+		sys_sem_signal(&xemac->sem_rx_data_available);
+#endif
+	}
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
 #endif
-	return;
 }
 
+/*
+ * init_rxq1():
+ *
+ * Creates the RX queue 1 BD ring in bdspace, fills it and points the GEM
+ * at it. Fails if the GEM has no queue 1, the caller then parks the queue.
+ */
+static XStatus init_rxq1(xemacpsif_s *xemacpsif, void *bdspace)
+{
+	XEmacPs_Bd bdtemplate;
+	XEmacPs_BdRing *rxring = &xemacpsif->rxq1_ring;
+	UINTPTR baseaddr = xemacpsif->emacps.Config.BaseAddress;
+	XStatus status;
+
+	if ((XEmacPs_ReadReg(baseaddr, XEMACPS_DCFG6_OFFSET) &
+			XEMACPS_DCFG6_Q1_MASK) == 0) {
+		xil_printf("%s: GEM has no RX queue 1\r\n", __func__);
+		return XST_FAILURE;
+	}
+	if (rxq1_pool_get(xemacpsif, 1) == NULL) {
+		xil_printf("%s: no RX queue 1 buffer pool left\r\n", __func__);
+		return XST_FAILURE;
+	}
+
+	XEmacPs_BdClear(&bdtemplate);
+	status = XEmacPs_BdRingCreate(rxring, (UINTPTR)bdspace, (UINTPTR)bdspace,
+				BD_ALIGNMENT, XLWIP_CONFIG_EMAC_RXQ1_DESC);
+	if (status != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("Error setting up RX queue 1 BD space\r\n"));
+		return status;
+	}
+	status = XEmacPs_BdRingClone(rxring, &bdtemplate, XEMACPS_RECV);
+	if (status != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("Error initializing RX queue 1 BD space\r\n"));
+		return status;
+	}
+	xemacpsif->rxq1_bdspace = bdspace;
+	setup_rxq1_bds(xemacpsif);
+
+	XEmacPs_WriteReg(baseaddr, XEMACPS_RXQ1BUFSIZE_OFFSET,
+				EMACPS_RXQ1_BUF_SIZE / 64);
+	XEmacPs_WriteReg(baseaddr, XEMACPS_RXQ1BASE_OFFSET,
+				(UINTPTR)bdspace & ULONG64_LO_MASK);
+	return XST_SUCCESS;
+}
+#endif
+
 void clean_dma_txdescs(struct xemac_s *xemac)
 {
 	XEmacPs_Bd bdtemplate;
@@ -543,6 +1087,7 @@ void clean_dma_txdescs(struct xemac_s *xemac)
 			(UINTPTR) xemacpsif->tx_bdspace, BD_ALIGNMENT,
 				 XLWIP_CONFIG_N_TX_DESC);
 	XEmacPs_BdRingClone(txringptr, &bdtemplate, XEMACPS_SEND);
+	xemacpsif->tx_ring_gen++;
 }
 
 XStatus init_dma(struct xemac_s *xemac)
@@ -661,6 +1206,7 @@ XStatus init_dma(struct xemac_s *xemac)
 	if (status != XST_SUCCESS) {
 		return ERR_IF;
 	}
+	xemacpsif->tx_ring_gen++;
 
 	/*
 	 * Allocate RX descriptors, 1 RxBD at a time.
@@ -730,13 +1276,19 @@ XStatus init_dma(struct xemac_s *xemac)
 		 * packet transmit and receive. The below code ensure that the
 		 * other queue pointers are parked to known state for avoiding
 		 * the controller to malfunction by fetching the descriptors
-		 * from these queues.
+		 * from these queues. When configured, rx queue 1 gets a BD ring
+		 * of its own in the space of its terminating BD instead.
 		 */
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+		if (init_rxq1(xemacpsif, (void *)bdrxterminate) != XST_SUCCESS)
+#endif
+		{
 		XEmacPs_BdClear(bdrxterminate);
 		XEmacPs_BdSetAddressRx(bdrxterminate, (XEMACPS_RXBUF_NEW_MASK |
 						XEMACPS_RXBUF_WRAP_MASK));
 		XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_RXQ1BASE_OFFSET),
 				   (UINTPTR)bdrxterminate);
+		}
 		XEmacPs_BdClear(bdtxterminate);
 		XEmacPs_BdSetStatus(bdtxterminate, (XEMACPS_TXBUF_USED_MASK |
 						XEMACPS_TXBUF_WRAP_MASK));
@@ -803,6 +1355,9 @@ void free_txrx_pbufs(xemacpsif_s *xemacpsif)
 	s32_t index;
 	s32_t index1;
 	struct pbuf *p;
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+	rxq1_pool_t *pool;
+#endif
 
 	index1 = get_base_index_txpbufsstorage (xemacpsif);
 
@@ -816,9 +1371,32 @@ void free_txrx_pbufs(xemacpsif_s *xemacpsif)
 
 	for (index = index1; index < (index1 + XLWIP_CONFIG_N_TX_DESC); index++) {
 		p = (struct pbuf *)rx_pbufs_storage[index];
-		pbuf_free(p);
+		if (p != NULL) {
+			pbuf_free(p);
+		}
 
 	}
+
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+	/* The ring is set up again afterwards, don't refill it from the
+	 * free function meanwhile.
+	 */
+	pool = rxq1_pool_get(xemacpsif, 0);
+	if (pool != NULL) {
+		pool->refill_busy = 1;
+	}
+	index1 = get_base_index_rxq1pbufsstorage (xemacpsif);
+	for (index = index1; index < (index1 + XLWIP_CONFIG_EMAC_RXQ1_DESC); index++) {
+		if (rxq1_pbufs_storage[index] != 0) {
+			p = (struct pbuf *)rxq1_pbufs_storage[index];
+			rxq1_pbufs_storage[index] = 0;
+			pbuf_free(p);
+		}
+	}
+	if (pool != NULL) {
+		pool->refill_busy = 0;
+	}
+#endif
 }
 
 void free_onlytx_pbufs(xemacpsif_s *xemacpsif)
@@ -848,6 +1426,7 @@ void reset_dma(struct xemac_s *xemac)
 
 	XEmacPs_BdRingPtrReset(txringptr, xemacpsif->tx_bdspace);
 	XEmacPs_BdRingPtrReset(rxringptr, xemacpsif->rx_bdspace);
+	xemacpsif->tx_ring_gen++;
 
 	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
 	if (gigeversion > 2) {
@@ -858,6 +1437,14 @@ void reset_dma(struct xemac_s *xemac)
 
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr, 0, XEMACPS_RECV);
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, txqueuenum, XEMACPS_SEND);
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+	if (xemacpsif->rxq1_bdspace != NULL) {
+		XEmacPs_BdRingPtrReset(&xemacpsif->rxq1_ring, xemacpsif->rxq1_bdspace);
+		XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress,
+				XEMACPS_RXQ1BASE_OFFSET,
+				(UINTPTR)xemacpsif->rxq1_bdspace & ULONG64_LO_MASK);
+	}
+#endif
 }
 
 void emac_disable_intr(void)
@@ -189,12 +189,24 @@ void setup_isr (struct xemac_s *xemac)
 	XEmacPs_SetHandler(&xemacpsif->emacps, XEMACPS_HANDLER_ERROR,
 				    (void *) emacps_error_handler,
 				    (void *) xemac);
+
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+	XEmacPs_SetHandler(&xemacpsif->emacps, XEMACPS_HANDLER_DMARECVQ1,
+				    (void *) emacps_recv_q1_handler,
+				    (void *) xemac);
+#endif
 }
 
 void start_emacps (xemacpsif_s *xemacps)
 {
 	/* start the temac */
 	XEmacPs_Start(&xemacps->emacps);
+#if XLWIP_CONFIG_EMAC_RXQ1_DESC > 0
+	if (xemacps->rxq1_bdspace != NULL) {
+		XEmacPs_WriteReg(xemacps->emacps.Config.BaseAddress,
+				XEMACPS_INTQ1_IER_OFFSET, XEMACPS_INTQ1SR_RXCOMPL_MASK);
+	}
+#endif
 }
 
 void restart_emacps_transmitter (xemacpsif_s *xemacps) {
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2026 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+#include <string.h>
+
+#include "lwip/opt.h"
+
+#if LWIP_TCP_LARGE_SEND
+
+#include "lwip/def.h"
+#include "lwip/pbuf.h"
+#include "lwip/sys.h"
+#include "lwip/stats.h"
+#include "lwip/inet_chksum.h"
+#include "lwip/prot/ip.h"
+#include "lwip/prot/ip4.h"
+#include "lwip/prot/tcp.h"
+
+#include "netif/xlargesend.h"
+
+typedef struct xlargesend_hdr {
+	struct pbuf_custom pc;
+	struct pbuf *seg;
+	struct xlargesend_hdr *next;
+	u32_t data[(XLARGESEND_HDR_MAX + 3) / 4];
+} xlargesend_hdr_t;
+
+static xlargesend_hdr_t hdrs[XLARGESEND_NUM_HDRS];
+static xlargesend_hdr_t *hdr_free_list;
+static u8_t hdr_pool_ready;
+
+static void hdr_free(struct pbuf *p)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+	xlargesend_hdr_t *hdr = (xlargesend_hdr_t *)p;
+	struct pbuf *seg = hdr->seg;
+
+	SYS_ARCH_PROTECT(lev);
+	hdr->next = hdr_free_list;
+	hdr_free_list = hdr;
+	SYS_ARCH_UNPROTECT(lev);
+
+	/* the frame is sent, drop its reference on the segment */
+	pbuf_free(seg);
+}
+
+static struct pbuf *hdr_alloc(struct pbuf *seg, const void *data, u16_t len)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+	xlargesend_hdr_t *hdr;
+	struct pbuf *p;
+
+	SYS_ARCH_PROTECT(lev);
+	hdr = hdr_free_list;
+	if (hdr != NULL) {
+		hdr_free_list = hdr->next;
+	}
+	SYS_ARCH_UNPROTECT(lev);
+	if (hdr == NULL) {
+		return NULL;
+	}
+
+	MEMCPY(hdr->data, data, len);
+	hdr->pc.custom_free_function = hdr_free;
+	p = pbuf_alloced_custom(PBUF_RAW, len, PBUF_REF, &hdr->pc, hdr->data,
+							sizeof(hdr->data));
+	hdr->seg = seg;
+	pbuf_ref(seg);
+	return p;
+}
+
+void xlargesend_init(void)
+{
+	s32_t i;
+
+	if (hdr_pool_ready) {
+		return;
+	}
+	hdr_free_list = NULL;
+	for (i = 0; i < XLARGESEND_NUM_HDRS; i++) {
+		hdrs[i].next = hdr_free_list;
+		hdr_free_list = &hdrs[i];
+	}
+	hdr_pool_ready = 1;
+}
+
+/*
+ * xlargesend_output():
+ *
+ * Splits the TCP segment p, larger than the MTU of netif, into frames that
+ * fit the MTU and passes them to frame_output() one at a time. Only the IP
+ * length and header checksum, the TCP sequence number and the FIN/PSH flags
+ * differ between the frames, the TCP checksum is left to the MAC.
+ *
+ * lwIP reserves a single IP ID for the segment, so all frames carry it with
+ * DF set: they are atomic datagrams (RFC 6864) and are never reassembled,
+ * so the shared ID does not matter.
+ */
+err_t xlargesend_output(struct netif *netif, struct pbuf *p,
+						netif_linkoutput_fn frame_output)
+{
+	u32_t hdr[(XLARGESEND_HDR_MAX + 3) / 4];
+	struct eth_hdr *ethhdr = (struct eth_hdr *)hdr;
+	struct ip_hdr *iphdr = (struct ip_hdr *)((u8_t *)hdr + SIZEOF_ETH_HDR);
+	struct tcp_hdr *tcphdr;
+	struct pbuf *frame, *ref, *q;
+	u16_t copied, iphlen, hdrlen, frame_len, len, n, q_off;
+	u32_t left, seqno;
+	u8_t flags;
+	err_t err;
+
+	copied = pbuf_copy_partial(p, hdr, XLARGESEND_HDR_MAX, 0);
+	if ((copied < SIZEOF_ETH_HDR + IP_HLEN + TCP_HLEN) ||
+		(ethhdr->type != PP_HTONS(ETHTYPE_IP)) ||
+		(IPH_V(iphdr) != 4) || (IPH_PROTO(iphdr) != IP_PROTO_TCP) ||
+		(IPH_HL_BYTES(iphdr) < IP_HLEN)) {
+		goto drop;
+	}
+	iphlen = IPH_HL_BYTES(iphdr);
+	if (copied < SIZEOF_ETH_HDR + iphlen + TCP_HLEN) {
+		goto drop;
+	}
+	tcphdr = (struct tcp_hdr *)((u8_t *)iphdr + iphlen);
+	hdrlen = SIZEOF_ETH_HDR + iphlen + TCPH_HDRLEN_BYTES(tcphdr);
+	if ((copied < hdrlen) || (hdrlen >= p->tot_len) ||
+		(netif->mtu <= hdrlen - SIZEOF_ETH_HDR)) {
+		goto drop;
+	}
+	left = (u32_t)lwip_ntohs(IPH_LEN(iphdr)) + SIZEOF_ETH_HDR - hdrlen;
+	if (left > (u32_t)(p->tot_len - hdrlen)) {
+		goto drop;
+	}
+
+	frame_len = netif->mtu - (hdrlen - SIZEOF_ETH_HDR);
+	IPH_OFFSET_SET(iphdr, IPH_OFFSET(iphdr) | PP_HTONS(IP_DF));
+	seqno = lwip_ntohl(tcphdr->seqno);
+	flags = TCPH_FLAGS(tcphdr);
+
+	/* find the first payload byte */
+	q = p;
+	q_off = hdrlen;
+	while (q_off >= q->len) {
+		q_off -= q->len;
+		q = q->next;
+	}
+
+	while (left > 0) {
+		len = (left > frame_len) ? frame_len : (u16_t)left;
+		left -= len;
+
+		IPH_LEN_SET(iphdr, lwip_htons(hdrlen - SIZEOF_ETH_HDR + len));
+		IPH_CHKSUM_SET(iphdr, 0);
+#if CHECKSUM_GEN_IP
+		IF__NETIF_CHECKSUM_ENABLED(netif, NETIF_CHECKSUM_GEN_IP) {
+			IPH_CHKSUM_SET(iphdr, inet_chksum(iphdr, iphlen));
+		}
+#endif
+		tcphdr->seqno = lwip_htonl(seqno);
+		TCPH_FLAGS_SET(tcphdr, (left > 0) ?
+				(flags & ~(TCP_FIN | TCP_PSH)) : flags);
+
+		frame = hdr_alloc(p, hdr, hdrlen);
+		if (frame == NULL) {
+			goto memerr;
+		}
+		for (n = len; n > 0; ) {
+			u16_t chunk = LWIP_MIN(n, q->len - q_off);
+
+			ref = pbuf_alloc_reference((u8_t *)q->payload + q_off, chunk,
+										PBUF_REF);
+			if (ref == NULL) {
+				pbuf_free(frame);
+				goto memerr;
+			}
+			pbuf_cat(frame, ref);
+			n -= chunk;
+			q_off += chunk;
+			if (q_off == q->len) {
+				q = q->next;
+				q_off = 0;
+			}
+		}
+
+		err = frame_output(netif, frame);
+		pbuf_free(frame);
+		if (err != ERR_OK) {
+			return err;
+		}
+		seqno += len;
+	}
+	return ERR_OK;
+
+memerr:
+#if LINK_STATS
+	lwip_stats.link.memerr++;
+	lwip_stats.link.drop++;
+#endif
+	return ERR_MEM;
+
+drop:
+#if LINK_STATS
+	lwip_stats.link.drop++;
+#endif
+	return ERR_VAL;
+}
+
+#endif /* LWIP_TCP_LARGE_SEND */
@@ -33,40 +33,54 @@
 #include "netif/xpqueue.h"
 #include "xil_printf.h"
 
-#define NUM_QUEUES	2
+#if (PQ_QUEUE_SIZE & (PQ_QUEUE_SIZE - 1)) != 0
+#error "PQ_QUEUE_SIZE must be a power of two"
+#endif
 
-pq_queue_t pq_queue[NUM_QUEUES];
+#define PQ_QUEUE_MASK	(PQ_QUEUE_SIZE - 1)
+
+/* Orders the accesses to data against the update of head or tail */
+#define PQ_BARRIER()	__sync_synchronize()
 
 pq_queue_t *
 pq_create_queue()
 {
-	static int i;
-	pq_queue_t *q = NULL;
+	pq_queue_t *q;
+	void *mem;
 
-	if (i >= NUM_QUEUES) {
-		xil_printf("ERR: Max Queues allocated\n\r");
-		return q;
+	/* one queue per interface, aligned for the padding of head and tail */
+	mem = malloc(sizeof(pq_queue_t) + PQ_CACHELINE_SIZE);
+	if (!mem) {
+		xil_printf("ERR: Unable to allocate queue\n\r");
+		return NULL;
 	}
 
-	q = &pq_queue[i++];
-
-	if (!q)
-		return q;
-
-	q->head = q->tail = q->len = 0;
+	q = (pq_queue_t *)(((UINTPTR)mem + PQ_CACHELINE_SIZE - 1) &
+			~((UINTPTR)PQ_CACHELINE_SIZE - 1));
+	q->mem = mem;
+	q->head = q->tail = 0;
 
 	return q;
 }
 
+void
+pq_destroy_queue(pq_queue_t *q)
+{
+	if (q)
+		free(q->mem);
+}
+
 int
 pq_enqueue(pq_queue_t *q, void *p)
 {
-	if (q->len == PQ_QUEUE_SIZE)
+	unsigned int head = q->head;
+
+	if (head - q->tail == PQ_QUEUE_SIZE)
 		return -1;
 
-	q->data[q->head] = p;
-	q->head = (q->head + 1)%PQ_QUEUE_SIZE;
-	q->len++;
+	q->data[head & PQ_QUEUE_MASK] = p;
+	PQ_BARRIER();
+	q->head = head + 1;
 
 	return 0;
 }
@@ -74,20 +88,39 @@ pq_enqueue(pq_queue_t *q, void *p)
 void*
 pq_dequeue(pq_queue_t *q)
 {
-	int ptail;
+	void *p;
 
-	if (q->len == 0)
+	if (pq_dequeue_batch(q, &p, 1) == 0)
 		return NULL;
 
-	ptail = q->tail;
-	q->tail = (q->tail + 1)%PQ_QUEUE_SIZE;
-	q->len--;
+	return p;
+}
 
-	return q->data[ptail];
+int
+pq_dequeue_batch(pq_queue_t *q, void **p, int n)
+{
+	unsigned int tail = q->tail;
+	unsigned int len = q->head - tail;
+	int i;
+
+	if (n <= 0)
+		return 0;
+	if ((unsigned int)n > len)
+		n = len;
+	if (n == 0)
+		return 0;
+
+	PQ_BARRIER();
+	for (i = 0; i < n; i++)
+		p[i] = q->data[(tail + i) & PQ_QUEUE_MASK];
+	PQ_BARRIER();
+	q->tail = tail + n;
+
+	return n;
 }
 
 int
 pq_qlength(pq_queue_t *q)
 {
-	return q->len;
+	return q->head - q->tail;
 }
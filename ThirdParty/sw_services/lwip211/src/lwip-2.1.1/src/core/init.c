@@ -160,6 +160,9 @@ PACK_STRUCT_END
 #if (LWIP_TCP && (TCP_SND_QUEUELEN > 0xffff))
 #error "If you want to use TCP, TCP_SND_QUEUELEN must fit in an u16_t, so, you have to reduce it in your lwipopts.h"
 #endif
+#if (LWIP_TCP && LWIP_TCP_LARGE_SEND && (TCP_LARGE_SEND_SIZE > (0xffff - IP_HLEN - TCP_HLEN - 40)))
+#error "TCP_LARGE_SEND_SIZE must leave room for the IP and TCP headers in an u16_t, so, you have to reduce it in your lwipopts.h"
+#endif
 #if (LWIP_TCP && (TCP_SND_QUEUELEN < 2))
 #error "TCP_SND_QUEUELEN must be at least 2 for no-copy TCP writes to work"
 #endif
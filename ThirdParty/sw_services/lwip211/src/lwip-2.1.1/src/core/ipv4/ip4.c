@@ -998,7 +998,13 @@ ip4_output_if_opt_src(struct pbuf *p, const ip4_addr_t *src, const ip4_addr_t *d
 #endif /* ENABLE_LOOPBACK */
 #if IP_FRAG
   /* don't fragment if interface has mtu set to 0 [loopif] */
-  if (netif->mtu && (p->tot_len > netif->mtu)) {
+  if (netif->mtu && (p->tot_len > netif->mtu)
+#if LWIP_TCP_LARGE_SEND
+      /* nor if the netif splits this TCP segment itself */
+      && !((p->flags & PBUF_FLAG_TCP_LARGE_SEND) &&
+           (netif->flags & NETIF_FLAG_LARGE_SEND))
+#endif /* LWIP_TCP_LARGE_SEND */
+     ) {
     return ip4_frag(p, netif, dest);
   }
 #endif /* IP_FRAG */
@@ -145,6 +145,85 @@ tcp_route(const struct tcp_pcb *pcb, const ip_addr_t *src, const ip_addr_t *dst)
   }
 }
 
+#if LWIP_TCP_LARGE_SEND
+/**
+ * Calculate the segment size tcp_write() may use on a connection that goes
+ * out through a netif with NETIF_FLAG_LARGE_SEND: a whole number of frames
+ * of (pcb->mss - optlen) payload bytes, up to TCP_LARGE_SEND_SIZE.
+ * The netif cuts frames to fit its MTU, so this is only done when the MSS
+ * is limited by that MTU and not by the remote host.
+ *
+ * @param pcb the tcp_pcb that data is written to
+ * @param mss_local the segment size tcp_write() would use otherwise
+ * @param optlen length of the TCP options in a data segment
+ * @return the segment size to use (payload plus options)
+ */
+static u16_t
+tcp_large_send_mss(const struct tcp_pcb *pcb, u16_t mss_local, u8_t optlen)
+{
+  struct netif *netif;
+  u16_t frame_len;
+  u32_t limit;
+
+  if ((mss_local != pcb->mss) || (mss_local <= optlen) || !IP_IS_V4(&pcb->remote_ip)) {
+    return mss_local;
+  }
+  netif = tcp_route(pcb, &pcb->local_ip, &pcb->remote_ip);
+  if ((netif == NULL) || ((netif->flags & NETIF_FLAG_LARGE_SEND) == 0) ||
+      (netif->mtu != pcb->mss + IP_HLEN + TCP_HLEN)) {
+    return mss_local;
+  }
+  frame_len = (u16_t)(mss_local - optlen);
+  /* don't allocate segments bigger than half the maximum window we ever received */
+  limit = LWIP_MIN(TCP_LARGE_SEND_SIZE, TCPWND_MIN16(pcb->snd_wnd_max / 2));
+  if (limit < 2U * frame_len) {
+    return mss_local;
+  }
+  return (u16_t)((limit / frame_len) * frame_len + optlen);
+}
+
+/**
+ * Split a large send segment at the head of the unsent queue to what the
+ * send window allows, so it doesn't wait for the window to open up to the
+ * whole segment. Without data in flight no ACK will open the window, so at
+ * least one frame is split off then. After a retransmission timeout the
+ * segment may already be partly acknowledged, the split then counts from
+ * the acknowledged part on.
+ *
+ * @param pcb the tcp_pcb to send data for
+ * @param wnd the usable window (minimum of snd_wnd and cwnd)
+ */
+static void
+tcp_large_send_fit(struct tcp_pcb *pcb, u32_t wnd)
+{
+  struct tcp_seg *seg = pcb->unsent;
+  u8_t optlen = LWIP_TCP_OPT_LENGTH_SEGMENT(seg->flags, pcb);
+  u32_t seqno = lwip_ntohl(seg->tcphdr->seqno);
+  u32_t acked, inflight, avail;
+  u16_t frame_len;
+
+  frame_len = (u16_t)(pcb->mss - optlen);
+  if (TCP_SEQ_LT(seqno, pcb->lastack)) {
+    acked = pcb->lastack - seqno;
+    inflight = 0;
+  } else {
+    acked = 0;
+    inflight = seqno - pcb->lastack;
+  }
+  if ((seg->len <= acked + frame_len) || (inflight + seg->len - acked <= wnd)) {
+    return;
+  }
+  avail = (wnd > inflight) ? (wnd - inflight) : 0;
+  if (avail < frame_len) {
+    if (pcb->unacked != NULL) {
+      return;
+    }
+    avail = frame_len;
+  }
+  tcp_split_unsent_seg(pcb, (u16_t)(acked + avail - (avail % frame_len)));
+}
+#endif /* LWIP_TCP_LARGE_SEND */
+
 /**
  * Create a TCP segment with prefilled header.
  *
@@ -453,6 +532,9 @@ tcp_write(struct tcp_pcb *pcb, const void *arg, u16_t len, u8_t apiflags)
   {
     optlen = LWIP_TCP_OPT_LENGTH_SEGMENT(0, pcb);
   }
+#if LWIP_TCP_LARGE_SEND
+  mss_local = tcp_large_send_mss(pcb, mss_local, optlen);
+#endif /* LWIP_TCP_LARGE_SEND */
 
 
   /*
@@ -488,6 +570,10 @@ tcp_write(struct tcp_pcb *pcb, const void *arg, u16_t len, u8_t apiflags)
 
     /* Usable space at the end of the last unsent segment */
     unsent_optlen = LWIP_TCP_OPT_LENGTH_SEGMENT(last_unsent->flags, pcb);
+#if LWIP_TCP_LARGE_SEND
+    /* a large send segment queued earlier is never cut back here */
+    mss_local = LWIP_MAX(mss_local, (u16_t)(last_unsent->len + unsent_optlen));
+#endif /* LWIP_TCP_LARGE_SEND */
     LWIP_ASSERT("mss_local is too small", mss_local >= last_unsent->len + unsent_optlen);
     space = mss_local - (last_unsent->len + unsent_optlen);
 
@@ -861,7 +947,12 @@ tcp_split_unsent_seg(struct tcp_pcb *pcb, u16_t split)
     return ERR_OK;
   }
 
+#if LWIP_TCP_LARGE_SEND
+  /* large send segments are split at a multiple of the frame size */
+  LWIP_ASSERT("split <= mss", (split <= pcb->mss) || (useg->len > pcb->mss));
+#else
   LWIP_ASSERT("split <= mss", split <= pcb->mss);
+#endif /* LWIP_TCP_LARGE_SEND */
   LWIP_ASSERT("useg->len > 0", useg->len > 0);
 
   /* We should check that we don't exceed TCP_SND_QUEUELEN but we need
@@ -1306,6 +1397,11 @@ tcp_output(struct tcp_pcb *pcb)
     ip_addr_copy(pcb->local_ip, *local_ip);
   }
 
+#if LWIP_TCP_LARGE_SEND
+  tcp_large_send_fit(pcb, wnd);
+  seg = pcb->unsent;
+#endif /* LWIP_TCP_LARGE_SEND */
+
   /* Handle the current segment not fitting within the window */
   if (lwip_ntohl(seg->tcphdr->seqno) - pcb->lastack + seg->len > wnd) {
     /* We need to start the persistent timer when the next unsent segment does not fit
@@ -1561,6 +1657,15 @@ tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb, struct netif *netif
 
   seg->p->payload = seg->tcphdr;
 
+#if LWIP_TCP_LARGE_SEND
+  /* tell IP not to fragment a segment the netif splits itself */
+  if (seg->p->tot_len - TCP_HLEN > pcb->mss) {
+    seg->p->flags |= PBUF_FLAG_TCP_LARGE_SEND;
+  } else {
+    seg->p->flags &= (u8_t)~PBUF_FLAG_TCP_LARGE_SEND;
+  }
+#endif /* LWIP_TCP_LARGE_SEND */
+
   seg->tcphdr->chksum = 0;
 
 #ifdef LWIP_HOOK_TCP_OUT_ADD_TCPOPTS
@@ -105,6 +105,10 @@ extern "C" {
 /** If set, the netif has MLD6 capability.
  * Set by the netif driver in its init function. */
 #define NETIF_FLAG_MLD6         0x40U
+/** If set, the netif splits IPv4 TCP segments larger than its MTU into
+ * MSS sized frames (see LWIP_TCP_LARGE_SEND).
+ * Set by the netif driver in its init function. */
+#define NETIF_FLAG_LARGE_SEND   0x80U
 
 /**
  * @}
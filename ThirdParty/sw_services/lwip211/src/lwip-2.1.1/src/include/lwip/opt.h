@@ -1424,6 +1424,25 @@
 #define TCP_OVERSIZE                    TCP_MSS
 #endif
 
+/**
+ * LWIP_TCP_LARGE_SEND==1: Let tcp_write() queue IPv4 segments of up to
+ * TCP_LARGE_SEND_SIZE bytes on connections that go out through a netif
+ * flagged with NETIF_FLAG_LARGE_SEND. Such a netif splits the segments into
+ * MSS sized frames itself, so it must not need lwIP to generate the TCP
+ * checksum.
+ */
+#if !defined LWIP_TCP_LARGE_SEND || defined __DOXYGEN__
+#define LWIP_TCP_LARGE_SEND             0
+#endif
+
+/**
+ * TCP_LARGE_SEND_SIZE: The largest segment (TCP payload plus options)
+ * tcp_write() queues when LWIP_TCP_LARGE_SEND is enabled.
+ */
+#if !defined TCP_LARGE_SEND_SIZE || defined __DOXYGEN__
+#define TCP_LARGE_SEND_SIZE             (16 * TCP_MSS)
+#endif
+
 /**
  * LWIP_TCP_TIMESTAMPS==1: support the TCP timestamp option.
  * The timestamp option is currently only used to help remote hosts, it is not
@@ -181,6 +181,9 @@ typedef enum {
 #define PBUF_FLAG_LLMCAST   0x10U
 /** indicates this pbuf includes a TCP FIN flag */
 #define PBUF_FLAG_TCP_FIN   0x20U
+/** indicates this pbuf holds a TCP segment larger than the MSS that a
+    NETIF_FLAG_LARGE_SEND netif splits itself (IP must not fragment it) */
+#define PBUF_FLAG_TCP_LARGE_SEND 0x40U
 
 /** Main packet buffer struct */
 struct pbuf {
@@ -455,6 +455,7 @@ extern "C" {
 #define XEMACPS_HANDLER_DMASEND 1U
 #define XEMACPS_HANDLER_DMARECV 2U
 #define XEMACPS_HANDLER_ERROR   3U
+#define XEMACPS_HANDLER_DMARECVQ1 4U
 /*@}*/
 
 /* Constants to determine the configuration of the hardware device. They are
@@ -548,8 +549,10 @@ typedef struct XEmacPs_Instance {
 
 	XEmacPs_Handler SendHandler;
 	XEmacPs_Handler RecvHandler;
+	XEmacPs_Handler RecvQ1Handler;
 	void *SendRef;
 	void *RecvRef;
+	void *RecvQ1Ref;
 
 	XEmacPs_ErrHandler ErrorHandler;
 	void *ErrorRef;
@@ -296,12 +296,18 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_PTPP_RXNANOSEC_OFFSET 0x000001FCU /**< 1588 PTP peer receive
 						      nanosecond counter */
 
+#define XEMACPS_DCFG6_OFFSET         0x00000294U /**< Design config 6
+							reg */
+#define XEMACPS_DCFG8_OFFSET         0x0000029CU /**< Design config 8
+							reg */
 #define XEMACPS_INTQ1_STS_OFFSET     0x00000400U /**< Interrupt Q1 Status
 							reg */
 #define XEMACPS_TXQ1BASE_OFFSET	     0x00000440U /**< TX Q1 Base address
 							reg */
 #define XEMACPS_RXQ1BASE_OFFSET	     0x00000480U /**< RX Q1 Base address
 							reg */
+#define XEMACPS_RXQ1BUFSIZE_OFFSET   0x000004A0U /**< RX Q1 buffer size
+							reg */
 #define XEMACPS_MSBBUF_TXQBASE_OFFSET  0x000004C8U /**< MSB Buffer TX Q Base
 							reg */
 #define XEMACPS_MSBBUF_RXQBASE_OFFSET  0x000004D4U /**< MSB Buffer RX Q Base
@@ -312,6 +318,12 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 							reg */
 #define XEMACPS_INTQ1_IMR_OFFSET     0x00000640U /**< Interrupt Q1 Mask
 							reg */
+#define XEMACPS_SCREENT1_OFFSET      0x00000500U /**< Screening type 1
+							reg 0 */
+#define XEMACPS_SCREENT2_OFFSET      0x00000540U /**< Screening type 2
+							reg 0 */
+#define XEMACPS_SCREENT2_ETHT_OFFSET 0x000006E0U /**< Screening type 2
+							EtherType reg 0 */
 
 /* Define some bit positions for registers. */
 
@@ -463,12 +475,49 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
  */
 #define XEMACPS_INTQ1SR_TXCOMPL_MASK	0x00000080U /**< Transmit completed OK */
 #define XEMACPS_INTQ1SR_TXERR_MASK	0x00000040U /**< Transmit AMBA Error */
+#define XEMACPS_INTQ1SR_RXCOMPL_MASK	0x00000002U /**< Receive completed OK */
 
 #define XEMACPS_INTQ1_IXR_ALL_MASK	((u32)XEMACPS_INTQ1SR_TXCOMPL_MASK | \
 					 (u32)XEMACPS_INTQ1SR_TXERR_MASK)
 
 /*@}*/
 
+/**
+ * @name Design config registers bit definitions
+ * @{
+ */
+#define XEMACPS_DCFG6_Q1_MASK		0x00000002U /**< Queue 1 present */
+#define XEMACPS_DCFG8_T1SCR_MASK	0xFF000000U /**< Number of screening
+							 type 1 regs */
+#define XEMACPS_DCFG8_T1SCR_SHIFT	24U
+#define XEMACPS_DCFG8_T2SCR_MASK	0x00FF0000U /**< Number of screening
+							 type 2 regs */
+#define XEMACPS_DCFG8_T2SCR_SHIFT	16U
+#define XEMACPS_DCFG8_SCR2ETH_MASK	0x0000FF00U /**< Number of screening
+							 EtherType regs */
+#define XEMACPS_DCFG8_SCR2ETH_SHIFT	8U
+/*@}*/
+
+/**
+ * @name Screening registers bit definitions
+ * These registers steer received frames to the RX priority queues.
+ * @{
+ */
+#define XEMACPS_SCREEN_QUEUE_MASK	0x0000000FU /**< Destination RX queue */
+#define XEMACPS_SCREENT1_DSTC_MASK	0x00000FF0U /**< DS/TC field to match */
+#define XEMACPS_SCREENT1_DSTC_SHIFT	4U
+#define XEMACPS_SCREENT1_UDP_MASK	0x0FFFF000U /**< UDP port to match */
+#define XEMACPS_SCREENT1_UDP_SHIFT	12U
+#define XEMACPS_SCREENT1_DSTCE_MASK	0x10000000U /**< Enable DS/TC match */
+#define XEMACPS_SCREENT1_UDPE_MASK	0x20000000U /**< Enable UDP port
+							 match */
+#define XEMACPS_SCREENT2_ETHT_MASK	0x00000E00U /**< EtherType register
+							 index */
+#define XEMACPS_SCREENT2_ETHT_SHIFT	9U
+#define XEMACPS_SCREENT2_ETHTE_MASK	0x00001000U /**< Enable EtherType
+							 match */
+/*@}*/
+
 /**
  * @name interrupts bit definitions
  * Bits definitions are same in XEMACPS_ISR_OFFSET,
@@ -0,0 +1,240 @@
+/******************************************************************************
+*
+* Copyright (C) 2018 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file aesbench.c
+*		AES benchmark for the Linux host build of the HDCP 2.2 common
+*		crypto code.
+*
+*		The program first checks the build against the FIPS-197 and
+*		NIST SP 800-38A test vectors and cross checks multi-block and
+*		CTR encryption against single block encryption for random
+*		lengths. It then measures:
+*		- block: XHdcp22Cmn_Aes128Encrypt() of one block, including
+*		  the key schedule (one dkey derivation)
+*		- kd: XHdcp22Cmn_Aes128EncryptBlocks() of two blocks (dkey0 and
+*		  dkey1 of a session)
+*		- ctr: XHdcp22Cmn_Aes128Ctr() of a 4 KB buffer
+*
+*		Every result is reported in cycles per byte (TSC cycles on x86,
+*		nanoseconds elsewhere) as the minimum over several runs. Build
+*		the program once per implementation to compare them, see the
+*		Makefile.
+*
+* <pre>
+* usage: aesbench [-n <iterations>]
+* </pre>
+*
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "xil_types.h"
+#include "xhdcp22_common.h"
+#if defined (__i386__) || defined (__x86_64__)
+#include <x86intrin.h>
+#define BENCH_UNIT	"cycles"
+#else
+#define BENCH_UNIT	"ns"
+#endif
+
+#ifndef XHDCP22_AES_IMPL
+#define XHDCP22_AES_IMPL 1
+#endif
+
+#define BENCH_RUNS		7
+#define BENCH_CTR_SIZE	4096
+
+static const char *ImplName[] = { "byte", "ttable", "bitsliced" };
+
+static u64 Ticks(void)
+{
+#if defined (__i386__) || defined (__x86_64__)
+	return __rdtsc();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+#endif
+}
+
+static void Hex(const char *Str, u8 *Out, int Len)
+{
+	int Idx;
+
+	for (Idx = 0; Idx < Len; Idx++) {
+		sscanf(&Str[2 * Idx], "%2hhx", &Out[Idx]);
+	}
+}
+
+static int Check(const char *Name, const u8 *Got, const char *Expected, int Len)
+{
+	u8 Exp[64];
+
+	Hex(Expected, Exp, Len);
+	if (memcmp(Got, Exp, Len) != 0) {
+		printf("FAIL %s\n", Name);
+		return 1;
+	}
+	return 0;
+}
+
+static int SelfTest(void)
+{
+	u8 Key[16], Iv[16], Pt[64], Ct[64], Buf[64];
+	u8 Ref[1024], Out[1024], Ctr[16];
+	int Err = 0, Run, Len, Idx;
+
+	/* FIPS-197 appendix C.1 */
+	Hex("000102030405060708090a0b0c0d0e0f", Key, 16);
+	Hex("00112233445566778899aabbccddeeff", Pt, 16);
+	XHdcp22Cmn_Aes128Encrypt(Pt, Key, Ct);
+	Err |= Check("FIPS-197 encrypt", Ct, "69c4e0d86a7b0430d8cdb78070b4c55a", 16);
+	XHdcp22Cmn_Aes128Decrypt(Ct, Key, Buf);
+	Err |= Check("FIPS-197 decrypt", Buf, "00112233445566778899aabbccddeeff", 16);
+
+	/* SP 800-38A F.1.1 (ECB) and F.5.1 (CTR) */
+	Hex("2b7e151628aed2a6abf7158809cf4f3c", Key, 16);
+	Hex("6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+	    "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710", Pt, 64);
+	XHdcp22Cmn_Aes128EncryptBlocks(Pt, 4, Key, Ct);
+	Err |= Check("SP 800-38A ECB", Ct,
+	    "3ad77bb40d7a3660a89ecaf32466ef97f5d3d58503b9699de785895a96fdbaaf"
+	    "43b1cd7f598ece23881b00e3ed0306887b0c785e27e8ad3f8223207104725dd4", 64);
+	Hex("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff", Iv, 16);
+	XHdcp22Cmn_Aes128Ctr(Pt, 64, Key, Iv, Ct);
+	Err |= Check("SP 800-38A CTR", Ct,
+	    "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+	    "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee", 64);
+	XHdcp22Cmn_Aes128Ctr(Ct, 64, Key, Iv, Ct);
+	if (memcmp(Ct, Pt, 64) != 0) {
+		printf("FAIL SP 800-38A CTR in place\n");
+		Err = 1;
+	}
+
+	/* Multi-block and CTR against single blocks, random lengths */
+	srand(1);
+	for (Run = 0; Run < 200 && !Err; Run++) {
+		for (Idx = 0; Idx < 16; Idx++) {
+			Key[Idx] = (u8)rand();
+			Iv[Idx] = (u8)rand();
+		}
+		Iv[15] = (u8)(0xF0 | rand());	/* Let the counter carry */
+		Len = rand() % (int)sizeof(Ref);
+		for (Idx = 0; Idx < Len; Idx++) {
+			Ref[Idx] = (u8)rand();
+		}
+
+		XHdcp22Cmn_Aes128EncryptBlocks(Ref, Len / 16, Key, Out);
+		for (Idx = 0; Idx + 16 <= Len; Idx += 16) {
+			XHdcp22Cmn_Aes128Encrypt(&Ref[Idx], Key, Buf);
+			if (memcmp(Buf, &Out[Idx], 16) != 0) {
+				printf("FAIL multi-block, run %d block %d\n", Run, Idx / 16);
+				Err = 1;
+				break;
+			}
+		}
+
+		XHdcp22Cmn_Aes128Ctr(Ref, Len, Key, Iv, Out);
+		memcpy(Ctr, Iv, 16);
+		for (Idx = 0; Idx < Len && !Err; Idx++) {
+			if (Idx % 16 == 0) {
+				int Pos;
+
+				XHdcp22Cmn_Aes128Encrypt(Ctr, Key, Buf);
+				for (Pos = 15; Pos >= 0 && ++Ctr[Pos] == 0; Pos--)
+					;
+			}
+			if (Out[Idx] != (Ref[Idx] ^ Buf[Idx % 16])) {
+				printf("FAIL CTR, run %d length %d byte %d\n", Run, Len, Idx);
+				Err = 1;
+			}
+		}
+	}
+
+	return Err;
+}
+
+int main(int argc, char *argv[])
+{
+	static u8 Data[BENCH_CTR_SIZE];
+	u8 Key[16], Iv[16], Out[32];
+	u64 Start, Best[3] = { ~0ULL, ~0ULL, ~0ULL };
+	int Iter = 2000, Run, Idx;
+
+	if (argc == 3 && strcmp(argv[1], "-n") == 0) {
+		Iter = atoi(argv[2]);
+	}
+	if (Iter < 1 || argc == 2 || argc > 3) {
+		printf("usage: aesbench [-n <iterations>]\n");
+		return 2;
+	}
+
+	if (SelfTest() != 0) {
+		return 1;
+	}
+
+	memset(Key, 0x5A, sizeof(Key));
+	memset(Iv, 0xA5, sizeof(Iv));
+	memset(Data, 0x3C, sizeof(Data));
+
+	for (Run = 0; Run < BENCH_RUNS; Run++) {
+		Start = Ticks();
+		for (Idx = 0; Idx < Iter; Idx++) {
+			XHdcp22Cmn_Aes128Encrypt(Iv, Key, Out);
+			Key[0] ^= Out[0];
+		}
+		Start = Ticks() - Start;
+		if (Start < Best[0]) Best[0] = Start;
+
+		Start = Ticks();
+		for (Idx = 0; Idx < Iter; Idx++) {
+			XHdcp22Cmn_Aes128EncryptBlocks(Data, 2, Key, Out);
+			Key[0] ^= Out[0];
+		}
+		Start = Ticks() - Start;
+		if (Start < Best[1]) Best[1] = Start;
+
+		Start = Ticks();
+		for (Idx = 0; Idx < Iter / 64 + 1; Idx++) {
+			XHdcp22Cmn_Aes128Ctr(Data, BENCH_CTR_SIZE, Key, Iv, Data);
+		}
+		Start = Ticks() - Start;
+		if (Start < Best[2]) Best[2] = Start;
+	}
+
+	printf("%-10s block %8.1f %s/byte  kd %8.1f %s/byte  ctr %8.1f %s/byte\n",
+	       ImplName[XHDCP22_AES_IMPL],
+	       (double)Best[0] / Iter / 16, BENCH_UNIT,
+	       (double)Best[1] / Iter / 32, BENCH_UNIT,
+	       (double)Best[2] / (Iter / 64 + 1) / BENCH_CTR_SIZE, BENCH_UNIT);
+	return 0;
+}
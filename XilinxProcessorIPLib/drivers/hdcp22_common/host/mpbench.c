@@ -0,0 +1,204 @@
+/******************************************************************************
+*
+* Copyright (C) 2018 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file mpbench.c
+*		Multiprecision multiply and square benchmark for the Linux host
+*		build of the HDCP 2.2 common crypto code (bigdigits.c).
+*
+*		The program first checks mpMultiply() and mpSquare() against a
+*		plain schoolbook product for every size up to MAX_FIXED_DIGITS,
+*		with random operands and with all digits set to the maximum
+*		value. It then reports the cycles per mpMultiply() and
+*		mpSquare() call (TSC cycles on x86, nanoseconds elsewhere) for
+*		512 to 4096-bit operands as the minimum over several runs.
+*		Build with -DMP_NO_COMBA for the original loops and with
+*		-DMP_NO_ACC128 for the 32-bit host accumulator, see the Makefile.
+*
+* <pre>
+* usage: mpbench [-n <iterations>]
+* </pre>
+*
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "xil_types.h"
+#include "bigdigits.h"
+#if defined (__i386__) || defined (__x86_64__)
+#include <x86intrin.h>
+#define BENCH_UNIT	"cycles"
+#else
+#define BENCH_UNIT	"ns"
+#endif
+
+#define BENCH_RUNS		5
+
+#if defined(MP_NO_COMBA)
+#define BENCH_NAME	"school"
+#elif defined(MP_NO_ACC128) || !defined(__SIZEOF_INT128__)
+#define BENCH_NAME	"comba32"
+#else
+#define BENCH_NAME	"comba"
+#endif
+
+static const size_t BenchDigits[] = { 16, 32, 64, 96, 128 };
+
+static u64 Ticks(void)
+{
+#if defined (__i386__) || defined (__x86_64__)
+	return __rdtsc();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+#endif
+}
+
+static void Reference(u32 *W, const u32 *U, const u32 *V, size_t N)
+{
+	u64 T;
+	u32 K;
+	size_t I, J;
+
+	memset(W, 0, 2 * N * sizeof(u32));
+	for (J = 0; J < N; J++) {
+		K = 0;
+		for (I = 0; I < N; I++) {
+			T = (u64)U[I] * V[J] + W[I + J] + K;
+			W[I + J] = (u32)T;
+			K = (u32)(T >> 32);
+		}
+		W[J + N] = K;
+	}
+}
+
+static void Random(u32 *X, size_t N)
+{
+	size_t I;
+
+	for (I = 0; I < N; I++) {
+		X[I] = ((u32)rand() << 16) ^ (u32)rand();
+	}
+}
+
+static int SelfTest(void)
+{
+	static u32 U[MAX_FIXED_DIGITS], V[MAX_FIXED_DIGITS];
+	static u32 W[2 * MAX_FIXED_DIGITS], Ref[2 * MAX_FIXED_DIGITS];
+	size_t N;
+	int Run;
+
+	srand(1);
+	for (N = 1; N <= MAX_FIXED_DIGITS; N++) {
+		for (Run = 0; Run < 8; Run++) {
+			if (Run == 0) {
+				memset(U, 0xFF, sizeof(U));
+				memset(V, 0xFF, sizeof(V));
+			}
+			else {
+				Random(U, N);
+				Random(V, N);
+				if (Run == 1) {
+					/* Equal halves, zero differences in Karatsuba */
+					memcpy(U + N / 2, U, (N / 2) * sizeof(u32));
+				}
+			}
+
+			Reference(Ref, U, V, N);
+			mpMultiply(W, U, V, N);
+			if (memcmp(W, Ref, 2 * N * sizeof(u32)) != 0) {
+				printf("FAIL mpMultiply, %d digits run %d\n", (int)N, Run);
+				return 1;
+			}
+
+			Reference(Ref, U, U, N);
+			mpSquare(W, U, N);
+			if (memcmp(W, Ref, 2 * N * sizeof(u32)) != 0) {
+				printf("FAIL mpSquare, %d digits run %d\n", (int)N, Run);
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	static u32 U[MAX_FIXED_DIGITS], V[MAX_FIXED_DIGITS], W[2 * MAX_FIXED_DIGITS];
+	u64 Start, BestMul, BestSqr;
+	int Iter = 1000, Run, Idx;
+	size_t Size, N;
+
+	if (argc == 3 && strcmp(argv[1], "-n") == 0) {
+		Iter = atoi(argv[2]);
+	}
+	if (Iter < 1 || argc == 2 || argc > 3) {
+		printf("usage: mpbench [-n <iterations>]\n");
+		return 2;
+	}
+
+	if (SelfTest() != 0) {
+		return 1;
+	}
+
+	Random(U, MAX_FIXED_DIGITS);
+	Random(V, MAX_FIXED_DIGITS);
+
+	printf("%-10s", BENCH_NAME);
+	for (Size = 0; Size < sizeof(BenchDigits) / sizeof(BenchDigits[0]); Size++) {
+		N = BenchDigits[Size];
+		BestMul = BestSqr = ~0ULL;
+		for (Run = 0; Run < BENCH_RUNS; Run++) {
+			Start = Ticks();
+			for (Idx = 0; Idx < Iter; Idx++) {
+				mpMultiply(W, U, V, N);
+				U[0] ^= W[N];
+			}
+			Start = Ticks() - Start;
+			if (Start < BestMul) BestMul = Start;
+
+			Start = Ticks();
+			for (Idx = 0; Idx < Iter; Idx++) {
+				mpSquare(W, U, N);
+				U[0] ^= W[N];
+			}
+			Start = Ticks() - Start;
+			if (Start < BestSqr) BestSqr = Start;
+		}
+		printf("  %4d bit mul %7.0f sqr %7.0f", (int)(N * 32),
+		       (double)BestMul / Iter, (double)BestSqr / Iter);
+	}
+	printf("  %s/call\n", BENCH_UNIT);
+	return 0;
+}
@@ -0,0 +1,353 @@
+/******************************************************************************
+*
+* Copyright (C) 2018 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file rsabench.c
+*		RSA benchmark for the Linux host build of the HDCP 2.2 common
+*		crypto code (bigdigits.c).
+*
+*		The program first checks mpMontMult() against mpModMult(), an
+*		RSA-1024 encrypt/decrypt round trip with a fixed test key and
+*		3072-bit mpModExp() and mpMontExp() against mpModExp_ct(). It
+*		then measures:
+*		- pub: mpModExp() with e = 65537 (signature verification and
+*		  Km encryption on the transmitter)
+*		- priv: mpModExp() with the full private exponent d
+*		- crt: decryption with dP, dQ and qInv as done by the receiver
+*		  for Km (two 512-bit exponentiations and the recombination)
+*		- dcp: mpModExp() with a 3072-bit modulus and e = 3, the DCP LLC
+*		  signature check of the transmitter
+*		- ctx: the same with mpMontExp() and R^2 mod n computed once
+*
+*		Every result is reported in cycles per operation (TSC cycles on
+*		x86, nanoseconds elsewhere) as the minimum over several runs.
+*		Build with -DMP_NO_MONT_EXP for the binary square and multiply
+*		method, see the Makefile.
+*
+* <pre>
+* usage: rsabench [-n <iterations>]
+* </pre>
+*
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "xil_types.h"
+#include "bigdigits.h"
+#if defined (__i386__) || defined (__x86_64__)
+#include <x86intrin.h>
+#define BENCH_UNIT	"cycles"
+#else
+#define BENCH_UNIT	"ns"
+#endif
+
+#define BENCH_RUNS		5
+#define RSA_N_DIGITS	(1024 / 32)
+#define RSA_P_DIGITS	(512 / 32)
+#define DCP_N_DIGITS	(3072 / 32)
+
+/* RSA-1024 test key, not used anywhere else */
+static const char *KeyN =
+	"9c00b8ea5c56fb4bb939d3003e721ab14bb877475ff4dfd399e77568b9fc18f6"
+	"e27e90ea60041012c2cc0bc3785a12565fd8c1057dd7d4a2b11a44dae0566a63"
+	"84b233499084cbdce56176c5090f25726a580f69b903a725efbcc8751998f242"
+	"c5b1777e565b28d716c3edc78ed01e658dc7049ddadfd38bbeab00d6362c1299";
+static const char *KeyD =
+	"0ba0ce27c1ec45dcf618864ecd58c9fe8f2b57d0bd294e89c23e0b755bef9b98"
+	"c37735ac12ae1ad89b268475f4819a3e4ff4a3269aa3bcd8c7a4b29f31fb9f00"
+	"6037812a99e2db2e72a93dd3eaecd1d4a9a3739214ddc04d11160ee03690b6c8"
+	"7e2376e28ff460336784667cb8b23b7edd0554eb720aefd40c3fc57df754e201";
+static const char *KeyP =
+	"ca0b23f8de882fe8da1fdf0bf69615ef57869e0d5764219df6795b458c7a722b"
+	"6e8dac169902194d51ecadc196ed5c879375f4932a39a3c4ada0877c7df0c2d9";
+static const char *KeyQ =
+	"c5a9f974e792cc9f353fc9072b463d7fa47fbb61b42b979edac1c7195c556722"
+	"a9feb0bac2114f46491f4138e58bdbf5be25266e35afadc2c3e8e551b5fc75c1";
+static const char *KeyDP =
+	"c6708ab4345cae31958b181737e9d1417245d59664ef03d591ef3fa5df83a3fe"
+	"e466614f1098ef20f205f3e2dfc9e1c7871da349a77f554a26fe341421de0681";
+static const char *KeyDQ =
+	"aa1d7e5ed98a62e6c67a4df6088d5c1245add4c3e2befdafaecfc51d9374c0dd"
+	"797683fd475684669639faf50fc18d9df276a09b8b42d605e07bc918c8ca2d41";
+static const char *KeyQInv =
+	"c61f5aba92a7be4fb5d75eb33601d17d1107f83a4f4566f130b15e26fb4145f8"
+	"5a35d97c048dcc7e429ab3d02fa57bfcdcdfe1e2db5b7b4a47f44ef161eafd22";
+
+typedef struct {
+	u32 N[DCP_N_DIGITS];
+	u32 E[DCP_N_DIGITS];
+	u32 RR[DCP_N_DIGITS];
+	u32 Minv;
+} DcpKey;
+
+typedef struct {
+	u32 N[RSA_N_DIGITS];
+	u32 E[RSA_N_DIGITS];
+	u32 D[RSA_N_DIGITS];
+	u32 P[RSA_P_DIGITS];
+	u32 Q[RSA_P_DIGITS];
+	u32 DP[RSA_P_DIGITS];
+	u32 DQ[RSA_P_DIGITS];
+	u32 QInv[RSA_P_DIGITS];
+} RsaKey;
+
+static u64 Ticks(void)
+{
+#if defined (__i386__) || defined (__x86_64__)
+	return __rdtsc();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+#endif
+}
+
+static void Load(u32 *Out, size_t NDigits, const char *Hex)
+{
+	u8 Buf[RSA_N_DIGITS * 4];
+	size_t Len = strlen(Hex) / 2, Idx;
+
+	for (Idx = 0; Idx < Len; Idx++) {
+		sscanf(&Hex[2 * Idx], "%2hhx", &Buf[Idx]);
+	}
+	mpConvFromOctets(Out, NDigits, Buf, Len);
+}
+
+static void RsaCrt(RsaKey *Key, u32 *M, const u32 *C)
+{
+	u32 Cp[RSA_P_DIGITS], M1[RSA_P_DIGITS], M2[RSA_P_DIGITS];
+	u32 H[RSA_P_DIGITS], Qh[RSA_N_DIGITS];
+
+	/* m1 = c^dP mod p, m2 = c^dQ mod q */
+	mpModulo(Cp, C, RSA_N_DIGITS, Key->P, RSA_P_DIGITS);
+	mpModExp(M1, Cp, Key->DP, Key->P, RSA_P_DIGITS);
+	mpModulo(Cp, C, RSA_N_DIGITS, Key->Q, RSA_P_DIGITS);
+	mpModExp(M2, Cp, Key->DQ, Key->Q, RSA_P_DIGITS);
+
+	/* h = (m1 - m2) * qInv mod p */
+	if (mpSubtract(H, M1, M2, RSA_P_DIGITS)) {
+		mpAdd(H, H, Key->P, RSA_P_DIGITS);
+	}
+	mpModMult(H, H, Key->QInv, Key->P, RSA_P_DIGITS);
+
+	/* m = m2 + q * h */
+	mpMultiply(Qh, Key->Q, H, RSA_P_DIGITS);
+	mpSetZero(M, RSA_N_DIGITS);
+	mpSetEqual(M, M2, RSA_P_DIGITS);
+	mpAdd(M, M, Qh, RSA_N_DIGITS);
+}
+
+static void Random(u32 *Out, size_t NDigits)
+{
+	size_t Idx;
+
+	for (Idx = 0; Idx < NDigits; Idx++) {
+		Out[Idx] = ((u32)rand() << 16) ^ (u32)rand();
+	}
+}
+
+static int SelfTest(RsaKey *Key)
+{
+	u32 X[RSA_N_DIGITS], Y[RSA_N_DIGITS], W[RSA_N_DIGITS], Z[RSA_N_DIGITS];
+	u32 R2[2 * RSA_N_DIGITS + 1], Minv;
+	int Run, Idx;
+
+	/* MontMult(x*R, y*R) * R^-1 == x*y mod n, with R^2 mod n from mpModulo */
+	Minv = mpMontInv(Key->N[0]);
+	mpSetZero(R2, 2 * RSA_N_DIGITS + 1);
+	R2[2 * RSA_N_DIGITS] = 1;
+	mpModulo(R2, R2, 2 * RSA_N_DIGITS + 1, Key->N, RSA_N_DIGITS);
+	srand(1);
+	for (Run = 0; Run < 100; Run++) {
+		for (Idx = 0; Idx < RSA_N_DIGITS; Idx++) {
+			X[Idx] = ((u32)rand() << 16) ^ (u32)rand();
+			Y[Idx] = ((u32)rand() << 16) ^ (u32)rand();
+		}
+		X[RSA_N_DIGITS - 1] &= 0x7FFFFFFF;
+		Y[RSA_N_DIGITS - 1] &= 0x7FFFFFFF;
+		mpModMult(Z, X, Y, Key->N, RSA_N_DIGITS);
+		mpMontMult(W, X, R2, Key->N, Minv, RSA_N_DIGITS);
+		mpMontMult(W, W, Y, Key->N, Minv, RSA_N_DIGITS);
+		if (mpCompare(W, Z, RSA_N_DIGITS) != 0) {
+			printf("FAIL mpMontMult, run %d\n", Run);
+			return 1;
+		}
+	}
+
+	/* Encrypt and decrypt with d and with CRT */
+	for (Run = 0; Run < 10; Run++) {
+		for (Idx = 0; Idx < RSA_N_DIGITS; Idx++) {
+			X[Idx] = ((u32)rand() << 16) ^ (u32)rand();
+		}
+		X[RSA_N_DIGITS - 1] &= 0x7FFFFFFF;
+		mpModExp(Y, X, Key->E, Key->N, RSA_N_DIGITS);
+		mpModExp(Z, Y, Key->D, Key->N, RSA_N_DIGITS);
+		if (mpCompare(Z, X, RSA_N_DIGITS) != 0) {
+			printf("FAIL RSA decrypt, run %d\n", Run);
+			return 1;
+		}
+		RsaCrt(Key, Z, Y);
+		if (mpCompare(Z, X, RSA_N_DIGITS) != 0) {
+			printf("FAIL RSA CRT decrypt, run %d\n", Run);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static int SelfTestDcp(DcpKey *Key)
+{
+	u32 X[DCP_N_DIGITS], Y[DCP_N_DIGITS], Z[DCP_N_DIGITS], W[DCP_N_DIGITS];
+	u32 E[DCP_N_DIGITS];
+	int Run;
+
+	for (Run = 0; Run < 10; Run++) {
+		Random(X, DCP_N_DIGITS);
+		X[DCP_N_DIGITS - 1] &= 0x7FFFFFFF;
+		Random(E, DCP_N_DIGITS);
+		if (Run == 0) {
+			mpSetEqual(E, Key->E, DCP_N_DIGITS);
+		} else {
+			mpSetZero(&E[Run], DCP_N_DIGITS - Run);
+		}
+		mpModExp_ct(Z, X, E, Key->N, DCP_N_DIGITS);
+		mpModExp(Y, X, E, Key->N, DCP_N_DIGITS);
+		mpMontExp(W, X, E, Key->N, Key->RR, Key->Minv, DCP_N_DIGITS);
+		if (mpCompare(Y, Z, DCP_N_DIGITS) != 0) {
+			printf("FAIL 3072-bit mpModExp, run %d\n", Run);
+			return 1;
+		}
+		if (mpCompare(W, Z, DCP_N_DIGITS) != 0) {
+			printf("FAIL 3072-bit mpMontExp, run %d\n", Run);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	static RsaKey Key;
+	static DcpKey Dcp;
+	u32 M[RSA_N_DIGITS], C[RSA_N_DIGITS];
+	u32 S[DCP_N_DIGITS], Em[DCP_N_DIGITS];
+	u64 Start, Best[5] = { ~0ULL, ~0ULL, ~0ULL, ~0ULL, ~0ULL };
+	int Iter = 10, Run, Idx;
+
+	if (argc == 3 && strcmp(argv[1], "-n") == 0) {
+		Iter = atoi(argv[2]);
+	}
+	if (Iter < 1 || argc == 2 || argc > 3) {
+		printf("usage: rsabench [-n <iterations>]\n");
+		return 2;
+	}
+
+	Load(Key.N, RSA_N_DIGITS, KeyN);
+	mpSetDigit(Key.E, 65537, RSA_N_DIGITS);
+	Load(Key.D, RSA_N_DIGITS, KeyD);
+	Load(Key.P, RSA_P_DIGITS, KeyP);
+	Load(Key.Q, RSA_P_DIGITS, KeyQ);
+	Load(Key.DP, RSA_P_DIGITS, KeyDP);
+	Load(Key.DQ, RSA_P_DIGITS, KeyDQ);
+	Load(Key.QInv, RSA_P_DIGITS, KeyQInv);
+
+	/* Random odd 3072-bit modulus, standing in for the DCP LLC key */
+	Random(Dcp.N, DCP_N_DIGITS);
+	Dcp.N[DCP_N_DIGITS - 1] |= 0x80000000;
+	Dcp.N[0] |= 0x1;
+	mpSetDigit(Dcp.E, 3, DCP_N_DIGITS);
+	mpMontRR(Dcp.RR, Dcp.N, DCP_N_DIGITS);
+	Dcp.Minv = mpMontInv(Dcp.N[0]);
+
+	if (SelfTest(&Key) != 0 || SelfTestDcp(&Dcp) != 0) {
+		return 1;
+	}
+
+	Random(S, DCP_N_DIGITS);
+	S[DCP_N_DIGITS - 1] &= 0x7FFFFFFF;
+
+	memset(M, 0x5A, sizeof(M));
+	M[RSA_N_DIGITS - 1] = 0x00123456;
+	mpModExp(C, M, Key.E, Key.N, RSA_N_DIGITS);
+
+	for (Run = 0; Run < BENCH_RUNS; Run++) {
+		Start = Ticks();
+		for (Idx = 0; Idx < Iter; Idx++) {
+			mpModExp(C, M, Key.E, Key.N, RSA_N_DIGITS);
+		}
+		Start = Ticks() - Start;
+		if (Start < Best[0]) Best[0] = Start;
+
+		Start = Ticks();
+		for (Idx = 0; Idx < Iter; Idx++) {
+			mpModExp(M, C, Key.D, Key.N, RSA_N_DIGITS);
+		}
+		Start = Ticks() - Start;
+		if (Start < Best[1]) Best[1] = Start;
+
+		Start = Ticks();
+		for (Idx = 0; Idx < Iter; Idx++) {
+			RsaCrt(&Key, M, C);
+		}
+		Start = Ticks() - Start;
+		if (Start < Best[2]) Best[2] = Start;
+
+		Start = Ticks();
+		for (Idx = 0; Idx < Iter; Idx++) {
+			mpModExp(Em, S, Dcp.E, Dcp.N, DCP_N_DIGITS);
+		}
+		Start = Ticks() - Start;
+		if (Start < Best[3]) Best[3] = Start;
+
+		Start = Ticks();
+		for (Idx = 0; Idx < Iter; Idx++) {
+			mpMontExp(Em, S, Dcp.E, Dcp.N, Dcp.RR, Dcp.Minv, DCP_N_DIGITS);
+		}
+		Start = Ticks() - Start;
+		if (Start < Best[4]) Best[4] = Start;
+	}
+
+#ifdef MP_NO_MONT_EXP
+	printf("%-10s", "binary");
+#else
+	printf("%-10s", "mont");
+#endif
+	printf(" pub %10.0f %s  priv %10.0f %s  crt %10.0f %s"
+	       "  dcp %8.0f %s  ctx %8.0f %s\n",
+	       (double)Best[0] / Iter, BENCH_UNIT,
+	       (double)Best[1] / Iter, BENCH_UNIT,
+	       (double)Best[2] / Iter, BENCH_UNIT,
+	       (double)Best[3] / Iter, BENCH_UNIT,
+	       (double)Best[4] / Iter, BENCH_UNIT);
+	return 0;
+}
@@ -0,0 +1,235 @@
+/******************************************************************************
+*
+* Copyright (C) 2018 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file shabench.c
+*		SHA256 and HMAC-SHA256 benchmark for the Linux host build of the
+*		HDCP 2.2 common crypto code.
+*
+*		The program first checks the build against the FIPS 180-2 and
+*		RFC 4231 test vectors and cross checks the streaming API
+*		against one-shot hashing for random lengths, split points and
+*		alignments. It then measures:
+*		- sha: XHdcp22Cmn_Sha256Hash() of a 4 KB buffer
+*		- hmac: XHdcp22Cmn_HmacSha256Hash() of a 16 byte message with
+*		  a 32 byte key (one H' computation)
+*		- ctx: XHdcp22Cmn_HmacSha256Compute() of the same message with
+*		  a key prepared once by XHdcp22Cmn_HmacSha256Init()
+*
+*		sha is reported in cycles per byte, hmac and ctx in cycles per
+*		call (TSC cycles on x86, nanoseconds elsewhere) as the minimum
+*		over several runs.
+*
+* <pre>
+* usage: shabench [-n <iterations>]
+* </pre>
+*
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "xil_types.h"
+#include "xstatus.h"
+#include "xhdcp22_common.h"
+#if defined (__i386__) || defined (__x86_64__)
+#include <x86intrin.h>
+#define BENCH_UNIT	"cycles"
+#else
+#define BENCH_UNIT	"ns"
+#endif
+
+#define BENCH_RUNS		7
+#define BENCH_SHA_SIZE	4096
+#define BENCH_MSG_SIZE	16
+
+static u64 Ticks(void)
+{
+#if defined (__i386__) || defined (__x86_64__)
+	return __rdtsc();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+#endif
+}
+
+static void Hex(const char *Str, u8 *Out, int Len)
+{
+	int Idx;
+
+	for (Idx = 0; Idx < Len; Idx++) {
+		sscanf(&Str[2 * Idx], "%2hhx", &Out[Idx]);
+	}
+}
+
+static int Check(const char *Name, const u8 *Got, const char *Expected)
+{
+	u8 Exp[32];
+
+	Hex(Expected, Exp, 32);
+	if (memcmp(Got, Exp, 32) != 0) {
+		printf("FAIL %s\n", Name);
+		return 1;
+	}
+	return 0;
+}
+
+static int SelfTest(void)
+{
+	static u8 Buf[1 << 16];
+	XHdcp22_Sha256Ctx Ctx;
+	XHdcp22_HmacSha256Ctx Hmac;
+	u8 Key[131], Ref[32], Out[32];
+	const char *Msg;
+	int Err = 0, Run, Len, Off, Cut, Idx;
+
+	/* FIPS 180-2 appendix B */
+	XHdcp22Cmn_Sha256Hash((const u8 *)"abc", 3, Out);
+	Err |= Check("FIPS 180-2 B.1", Out,
+	    "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+	Msg = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+	XHdcp22Cmn_Sha256Hash((const u8 *)Msg, strlen(Msg), Out);
+	Err |= Check("FIPS 180-2 B.2", Out,
+	    "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+	memset(Buf, 'a', 1000);
+	XHdcp22Cmn_Sha256Init(&Ctx);
+	for (Idx = 0; Idx < 1000; Idx++) {
+		XHdcp22Cmn_Sha256Update(&Ctx, Buf, 1000);
+	}
+	XHdcp22Cmn_Sha256Final(&Ctx, Out);
+	Err |= Check("FIPS 180-2 B.3", Out,
+	    "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+	/* RFC 4231 test cases 1, 2 and 6 (key longer than a block) */
+	memset(Key, 0x0b, 20);
+	XHdcp22Cmn_HmacSha256Hash((const u8 *)"Hi There", 8, Key, 20, Out);
+	Err |= Check("RFC 4231 case 1", Out,
+	    "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7");
+	Msg = "what do ya want for nothing?";
+	XHdcp22Cmn_HmacSha256Hash((const u8 *)Msg, strlen(Msg), (const u8 *)"Jefe", 4, Out);
+	Err |= Check("RFC 4231 case 2", Out,
+	    "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+	memset(Key, 0xaa, 131);
+	Msg = "Test Using Larger Than Block-Size Key - Hash Key First";
+	XHdcp22Cmn_HmacSha256Init(&Hmac, Key, 131);
+	XHdcp22Cmn_HmacSha256Compute(&Hmac, (const u8 *)Msg, strlen(Msg), Out);
+	Err |= Check("RFC 4231 case 6", Out,
+	    "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+
+	/* Streaming against one-shot, random lengths, splits and alignments */
+	srand(1);
+	for (Idx = 0; Idx < (int)sizeof(Buf); Idx++) {
+		Buf[Idx] = (u8)rand();
+	}
+	for (Run = 0; Run < 500 && !Err; Run++) {
+		Len = rand() % 1024;
+		Off = rand() % 8;
+		Cut = Len ? rand() % Len : 0;
+
+		XHdcp22Cmn_Sha256Hash(&Buf[Off], Len, Ref);
+		XHdcp22Cmn_Sha256Init(&Ctx);
+		XHdcp22Cmn_Sha256Update(&Ctx, &Buf[Off], Cut);
+		XHdcp22Cmn_Sha256Update(&Ctx, &Buf[Off + Cut], 0);
+		XHdcp22Cmn_Sha256Update(&Ctx, &Buf[Off + Cut], Len - Cut);
+		XHdcp22Cmn_Sha256Final(&Ctx, Out);
+		if (memcmp(Ref, Out, 32) != 0) {
+			printf("FAIL streaming, run %d length %d split %d\n", Run, Len, Cut);
+			Err = 1;
+		}
+
+		XHdcp22Cmn_HmacSha256Hash(&Buf[Off], Len, &Buf[Len], Cut % 100, Ref);
+		XHdcp22Cmn_HmacSha256Init(&Hmac, &Buf[Len], Cut % 100);
+		XHdcp22Cmn_HmacSha256Compute(&Hmac, &Buf[Off], Len, Out);
+		if (memcmp(Ref, Out, 32) != 0) {
+			printf("FAIL HMAC context, run %d length %d\n", Run, Len);
+			Err = 1;
+		}
+	}
+
+	return Err;
+}
+
+int main(int argc, char *argv[])
+{
+	static u8 Data[BENCH_SHA_SIZE];
+	XHdcp22_HmacSha256Ctx Hmac;
+	u8 Key[32], Out[32];
+	u64 Start, Best[3] = { ~0ULL, ~0ULL, ~0ULL };
+	int Iter = 2000, Run, Idx;
+
+	if (argc == 3 && strcmp(argv[1], "-n") == 0) {
+		Iter = atoi(argv[2]);
+	}
+	if (Iter < 1 || argc == 2 || argc > 3) {
+		printf("usage: shabench [-n <iterations>]\n");
+		return 2;
+	}
+
+	if (SelfTest() != 0) {
+		return 1;
+	}
+
+	memset(Key, 0x5A, sizeof(Key));
+	memset(Data, 0x3C, sizeof(Data));
+
+	for (Run = 0; Run < BENCH_RUNS; Run++) {
+		Start = Ticks();
+		for (Idx = 0; Idx < Iter / 64 + 1; Idx++) {
+			XHdcp22Cmn_Sha256Hash(Data, BENCH_SHA_SIZE, Out);
+			Data[0] ^= Out[0];
+		}
+		Start = Ticks() - Start;
+		if (Start < Best[0]) Best[0] = Start;
+
+		Start = Ticks();
+		for (Idx = 0; Idx < Iter; Idx++) {
+			XHdcp22Cmn_HmacSha256Hash(Data, BENCH_MSG_SIZE, Key, sizeof(Key), Out);
+			Data[0] ^= Out[0];
+		}
+		Start = Ticks() - Start;
+		if (Start < Best[1]) Best[1] = Start;
+
+		XHdcp22Cmn_HmacSha256Init(&Hmac, Key, sizeof(Key));
+		Start = Ticks();
+		for (Idx = 0; Idx < Iter; Idx++) {
+			XHdcp22Cmn_HmacSha256Compute(&Hmac, Data, BENCH_MSG_SIZE, Out);
+			Data[0] ^= Out[0];
+		}
+		Start = Ticks() - Start;
+		if (Start < Best[2]) Best[2] = Start;
+	}
+
+	printf("sha %8.1f %s/byte  hmac %8.0f %s/call  ctx %8.0f %s/call\n",
+	       (double)Best[0] / (Iter / 64 + 1) / BENCH_SHA_SIZE, BENCH_UNIT,
+	       (double)Best[1] / Iter, BENCH_UNIT,
+	       (double)Best[2] / Iter, BENCH_UNIT);
+	return 0;
+}
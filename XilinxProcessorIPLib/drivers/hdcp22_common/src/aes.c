@@ -49,6 +49,21 @@
 * 1.01  MH   01/28/17 Fixed warnings and errors.
 *</pre>
 *
+* The implementation is selected at build time by defining XHDCP22_AES_IMPL
+* in the compiler flags of the driver, e.g. -DXHDCP22_AES_IMPL=2:
+* - 0 (XHDCP22_AES_IMPL_BYTE): byte oriented implementation with separate
+*   SubBytes, ShiftRows and MixColumns passes over a 4x4 state. Smallest.
+* - 1 (XHDCP22_AES_IMPL_TTABLE, default): 32-bit implementation that merges
+*   SubBytes, ShiftRows and MixColumns into lookups in one 1 KB table.
+*   The table lookups are indexed by secret data, so the timing depends on
+*   the data cache.
+* - 2 (XHDCP22_AES_IMPL_BITSLICED): constant time implementation without
+*   secret dependent lookups. It computes two blocks at a time, so it pays
+*   off for multi-block and CTR encryption.
+*
+* Decryption always uses the byte oriented implementation. HDCP 2.2 only
+* needs the forward cipher.
+*
 *****************************************************************************/
 
 /***************************** Include Files *********************************/
@@ -234,10 +249,96 @@ static const u8 Aes_GfMul[256][6] = {
 	{0xe7,0x19,0x4f,0xa8,0x9a,0x83},{0xe5,0x1a,0x46,0xa3,0x97,0x8d}
 };
 
+#define XHDCP22_AES_IMPL_BYTE		0
+#define XHDCP22_AES_IMPL_TTABLE		1
+#define XHDCP22_AES_IMPL_BITSLICED	2
+
+#ifndef XHDCP22_AES_IMPL
+#define XHDCP22_AES_IMPL XHDCP22_AES_IMPL_TTABLE
+#endif
+
+#if XHDCP22_AES_IMPL == XHDCP22_AES_IMPL_TTABLE
+/* Combined SubBytes and MixColumns table. Entry x holds the column
+   {02}.S[x], S[x], S[x], {03}.S[x] (most significant byte first). The tables
+   for the other three rows are the same entries rotated right by 8, 16 and
+   24 bits, they are not stored to keep the footprint at 1 KB. The S-box
+   value is the second byte of an entry. */
+static const u32 Aes_Te0[256] = {
+	0xC66363A5,0xF87C7C84,0xEE777799,0xF67B7B8D,0xFFF2F20D,0xD66B6BBD,0xDE6F6FB1,0x91C5C554,
+	0x60303050,0x02010103,0xCE6767A9,0x562B2B7D,0xE7FEFE19,0xB5D7D762,0x4DABABE6,0xEC76769A,
+	0x8FCACA45,0x1F82829D,0x89C9C940,0xFA7D7D87,0xEFFAFA15,0xB25959EB,0x8E4747C9,0xFBF0F00B,
+	0x41ADADEC,0xB3D4D467,0x5FA2A2FD,0x45AFAFEA,0x239C9CBF,0x53A4A4F7,0xE4727296,0x9BC0C05B,
+	0x75B7B7C2,0xE1FDFD1C,0x3D9393AE,0x4C26266A,0x6C36365A,0x7E3F3F41,0xF5F7F702,0x83CCCC4F,
+	0x6834345C,0x51A5A5F4,0xD1E5E534,0xF9F1F108,0xE2717193,0xABD8D873,0x62313153,0x2A15153F,
+	0x0804040C,0x95C7C752,0x46232365,0x9DC3C35E,0x30181828,0x379696A1,0x0A05050F,0x2F9A9AB5,
+	0x0E070709,0x24121236,0x1B80809B,0xDFE2E23D,0xCDEBEB26,0x4E272769,0x7FB2B2CD,0xEA75759F,
+	0x1209091B,0x1D83839E,0x582C2C74,0x341A1A2E,0x361B1B2D,0xDC6E6EB2,0xB45A5AEE,0x5BA0A0FB,
+	0xA45252F6,0x763B3B4D,0xB7D6D661,0x7DB3B3CE,0x5229297B,0xDDE3E33E,0x5E2F2F71,0x13848497,
+	0xA65353F5,0xB9D1D168,0x00000000,0xC1EDED2C,0x40202060,0xE3FCFC1F,0x79B1B1C8,0xB65B5BED,
+	0xD46A6ABE,0x8DCBCB46,0x67BEBED9,0x7239394B,0x944A4ADE,0x984C4CD4,0xB05858E8,0x85CFCF4A,
+	0xBBD0D06B,0xC5EFEF2A,0x4FAAAAE5,0xEDFBFB16,0x864343C5,0x9A4D4DD7,0x66333355,0x11858594,
+	0x8A4545CF,0xE9F9F910,0x04020206,0xFE7F7F81,0xA05050F0,0x783C3C44,0x259F9FBA,0x4BA8A8E3,
+	0xA25151F3,0x5DA3A3FE,0x804040C0,0x058F8F8A,0x3F9292AD,0x219D9DBC,0x70383848,0xF1F5F504,
+	0x63BCBCDF,0x77B6B6C1,0xAFDADA75,0x42212163,0x20101030,0xE5FFFF1A,0xFDF3F30E,0xBFD2D26D,
+	0x81CDCD4C,0x180C0C14,0x26131335,0xC3ECEC2F,0xBE5F5FE1,0x359797A2,0x884444CC,0x2E171739,
+	0x93C4C457,0x55A7A7F2,0xFC7E7E82,0x7A3D3D47,0xC86464AC,0xBA5D5DE7,0x3219192B,0xE6737395,
+	0xC06060A0,0x19818198,0x9E4F4FD1,0xA3DCDC7F,0x44222266,0x542A2A7E,0x3B9090AB,0x0B888883,
+	0x8C4646CA,0xC7EEEE29,0x6BB8B8D3,0x2814143C,0xA7DEDE79,0xBC5E5EE2,0x160B0B1D,0xADDBDB76,
+	0xDBE0E03B,0x64323256,0x743A3A4E,0x140A0A1E,0x924949DB,0x0C06060A,0x4824246C,0xB85C5CE4,
+	0x9FC2C25D,0xBDD3D36E,0x43ACACEF,0xC46262A6,0x399191A8,0x319595A4,0xD3E4E437,0xF279798B,
+	0xD5E7E732,0x8BC8C843,0x6E373759,0xDA6D6DB7,0x018D8D8C,0xB1D5D564,0x9C4E4ED2,0x49A9A9E0,
+	0xD86C6CB4,0xAC5656FA,0xF3F4F407,0xCFEAEA25,0xCA6565AF,0xF47A7A8E,0x47AEAEE9,0x10080818,
+	0x6FBABAD5,0xF0787888,0x4A25256F,0x5C2E2E72,0x381C1C24,0x57A6A6F1,0x73B4B4C7,0x97C6C651,
+	0xCBE8E823,0xA1DDDD7C,0xE874749C,0x3E1F1F21,0x964B4BDD,0x61BDBDDC,0x0D8B8B86,0x0F8A8A85,
+	0xE0707090,0x7C3E3E42,0x71B5B5C4,0xCC6666AA,0x904848D8,0x06030305,0xF7F6F601,0x1C0E0E12,
+	0xC26161A3,0x6A35355F,0xAE5757F9,0x69B9B9D0,0x17868691,0x99C1C158,0x3A1D1D27,0x279E9EB9,
+	0xD9E1E138,0xEBF8F813,0x2B9898B3,0x22111133,0xD26969BB,0xA9D9D970,0x078E8E89,0x339494A7,
+	0x2D9B9BB6,0x3C1E1E22,0x15878792,0xC9E9E920,0x87CECE49,0xAA5555FF,0x50282878,0xA5DFDF7A,
+	0x038C8C8F,0x59A1A1F8,0x09898980,0x1A0D0D17,0x65BFBFDA,0xD7E6E631,0x844242C6,0xD06868B8,
+	0x824141C3,0x299999B0,0x5A2D2D77,0x1E0F0F11,0x7BB0B0CB,0xA85454FC,0x6DBBBBD6,0x2C16163A
+};
+#endif
+
 /***************** Macros (Inline Functions) Definitions *********************/
 // The least significant byte of the word is rotated to the end.
 #define AES_BLOCK_SIZE 16 /* AES operates on 16 bytes at a time */
 #define KE_ROTWORD(x) (((x) << 8) | ((x) >> 24))
+#define AES_ROR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define AES_CTR_BATCH 8 /* Counter blocks encrypted per AesEncryptBlocks() call */
+
+#if XHDCP22_AES_IMPL == XHDCP22_AES_IMPL_TTABLE
+#define AES_GETU32(p) (((u32)(p)[0] << 24) | ((u32)(p)[1] << 16) | \
+                       ((u32)(p)[2] << 8) | ((u32)(p)[3]))
+#define AES_PUTU32(p, v) do { (p)[0] = (u8)((v) >> 24); (p)[1] = (u8)((v) >> 16); \
+                              (p)[2] = (u8)((v) >> 8); (p)[3] = (u8)(v); } while (0)
+/* One column of a full round: SubBytes, ShiftRows, MixColumns and AddRoundKey */
+#define AES_TROUND(s0, s1, s2, s3, k) \
+	(Aes_Te0[(s0) >> 24] ^ AES_ROR32(Aes_Te0[((s1) >> 16) & 0xFF], 8) ^ \
+	 AES_ROR32(Aes_Te0[((s2) >> 8) & 0xFF], 16) ^ AES_ROR32(Aes_Te0[(s3) & 0xFF], 24) ^ (k))
+/* One column of the last round, without MixColumns */
+#define AES_TLAST(s0, s1, s2, s3, k) \
+	(((Aes_Te0[(s0) >> 24] & 0x00FF0000) << 8) ^ \
+	 (Aes_Te0[((s1) >> 16) & 0xFF] & 0x00FF0000) ^ \
+	 (Aes_Te0[((s2) >> 8) & 0xFF] & 0x0000FF00) ^ \
+	 ((Aes_Te0[(s3) & 0xFF] >> 8) & 0x000000FF) ^ (k))
+#endif
+
+#if XHDCP22_AES_IMPL == XHDCP22_AES_IMPL_BITSLICED
+/* The bitsliced key schedule holds 8 words per round key */
+#define AES_ENC_SCHED_WORDS 120
+#define AesEncKeySetup AesBsKeySetup
+#define AES_GETU32LE(p) (((u32)(p)[3] << 24) | ((u32)(p)[2] << 16) | \
+                         ((u32)(p)[1] << 8) | ((u32)(p)[0]))
+#define AES_PUTU32LE(p, v) do { (p)[3] = (u8)((v) >> 24); (p)[2] = (u8)((v) >> 16); \
+                                (p)[1] = (u8)((v) >> 8); (p)[0] = (u8)(v); } while (0)
+/* Exchange the bits selected by Lo of X with the bits selected by Hi of Y */
+#define AES_BS_SWAP(Lo, Hi, Shift, X, Y) do { u32 A_ = (X), B_ = (Y); \
+	(X) = (A_ & (u32)(Lo)) | ((B_ & (u32)(Lo)) << (Shift)); \
+	(Y) = ((A_ & (u32)(Hi)) >> (Shift)) | (B_ & (u32)(Hi)); } while (0)
+#else
+#define AES_ENC_SCHED_WORDS 60
+#define AesEncKeySetup AesKeySetup
+#endif
 
 /**************************** Type Definitions *******************************/
 
@@ -245,22 +346,32 @@ static const u8 Aes_GfMul[256][6] = {
 static u32  AesSubWord(u32 Word);
 static void AesKeySetup(const u8 Key[], u32 W[], int KeySizeBits);
 static void AesAddRoundKey(u8 State[][4], const u32 W[]);
-static void AesSubBytes(u8 State[][4]);
 static void AesInvSubBytes(u8 State[][4]);
-static void AesShiftRows(u8 State[][4]);
 static void AesInvShiftRows(u8 State[][4]);
-static void AesMixColumns(u8 State[][4]);
 static void AesInvMixColumns(u8 State[][4]);
+#if XHDCP22_AES_IMPL == XHDCP22_AES_IMPL_BYTE
+static void AesSubBytes(u8 State[][4]);
+static void AesShiftRows(u8 State[][4]);
+static void AesMixColumns(u8 State[][4]);
+#endif
+#if XHDCP22_AES_IMPL == XHDCP22_AES_IMPL_BITSLICED
+static void AesBsOrtho(u32 Q[]);
+static void AesBsSbox(u32 Q[]);
+static void AesBsShiftRows(u32 Q[]);
+static void AesBsMixColumns(u32 Q[]);
+static u32  AesBsSubWord(u32 Word);
+static void AesBsKeySetup(const u8 Key[], u32 Skey[], int KeySizeBits);
+static void AesBsEncrypt(u32 Q[], const u32 Skey[], int KeySize);
+#else
 static void AesEncrypt(const u8 In[], u8 Out[], const u32 Key[], int KeySize);
+#endif
+static void AesEncryptBlocks(const u8 In[], u8 Out[], u32 NumBlocks,
+                             const u32 Key[], int KeySize);
 static void AesDecrypt(const u8 In[], u8 Out[], const u32 Key[], int KeySize);
-#ifdef AES_CIPHER_CTR_MODE
 static void Xor(u8 *C, const u8 *A, const u8 *B, u32 Size);
 static void AesIncrementIv(u8 Iv[], int CounterSize);
 static void AesEncryptCtr(const u8 In[], size_t InLen, u8 Out[],
 								  const u32 Key[], int KeySize, const u8 Iv[]);
-static void AesDecryptCtr(const u8 In[], size_t InLen, u8 Out[],
-								 const u32 Key[], int KeySize, const u8 Iv[]);
-#endif
 
 /************************** Variable Definitions *****************************/
 
@@ -280,12 +391,67 @@ static void AesDecryptCtr(const u8 In[], size_t InLen, u8 Out[],
 ******************************************************************************/
 void XHdcp22Cmn_Aes128Encrypt(const u8 *Data, const u8 *Key, u8 *Output)
 {
-	u32 KeySchedule[60];
+	u32 KeySchedule[AES_ENC_SCHED_WORDS];
 
 	/* Setup the AES internal key */
-	AesKeySetup(Key, KeySchedule, 128);
+	AesEncKeySetup(Key, KeySchedule, 128);
 	/* Encrypt 128-bits*/
-	AesEncrypt(Data, Output, KeySchedule, 128);
+	AesEncryptBlocks(Data, Output, 1, KeySchedule, 128);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function encrypts a number of independent 16 byte blocks with the
+* same key of size 128 bits. The key schedule is computed once for all
+* blocks, and the bitsliced implementation encrypts two blocks at a time.
+*
+* @param	Data is the plaintext, NumBlocks * 16 bytes
+* @param	NumBlocks is the number of blocks
+* @param	Key is the user supplied input key
+* @param	Output is the ciphertext, NumBlocks * 16 bytes. It can be the
+*		same buffer as Data.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XHdcp22Cmn_Aes128EncryptBlocks(const u8 *Data, u32 NumBlocks,
+                                    const u8 *Key, u8 *Output)
+{
+	u32 KeySchedule[AES_ENC_SCHED_WORDS];
+
+	AesEncKeySetup(Key, KeySchedule, 128);
+	AesEncryptBlocks(Data, Output, NumBlocks, KeySchedule, 128);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function encrypts or decrypts data in AES-CTR mode with a key of size
+* 128 bits. The whole 16 byte counter block is incremented as a big endian
+* integer. The counter blocks are encrypted in batches.
+*
+* @param	Data is the input data
+* @param	Size is the length of the data in bytes, any length
+* @param	Key is the user supplied input key
+* @param	Iv is the 16 byte initial counter block
+* @param	Output is the output data, same length as the input. It can
+*		be the same buffer as Data.
+*
+* @return	None.
+*
+* @note		CTR decryption is the same operation as encryption.
+*
+******************************************************************************/
+void XHdcp22Cmn_Aes128Ctr(const u8 *Data, u32 Size, const u8 *Key,
+                          const u8 *Iv, u8 *Output)
+{
+	u32 KeySchedule[AES_ENC_SCHED_WORDS];
+
+	AesEncKeySetup(Key, KeySchedule, 128);
+	AesEncryptCtr(Data, Size, Output, KeySchedule, 128, Iv);
 }
 
 /*****************************************************************************/
@@ -312,7 +478,6 @@ void XHdcp22Cmn_Aes128Decrypt(const u8 *Data, const u8 *Key, u8 *Output)
 	AesDecrypt(Data, Output, KeySchedule, 128);
 }
 
-#ifdef AES_CIPHER_CTR_MODE
 /****************************************************************************/
 /**
 *
@@ -338,7 +503,6 @@ static void Xor(u8 *C, const u8 *A, const u8 *B, u32 Size)
 		C[Size] = A[Size] ^ B[Size];
 	}
 }
-#endif
 
 /*****************************************************************************/
 /**
@@ -467,6 +631,7 @@ static void AesAddRoundKey(u8 State[][4], const u32 w[])
 	State[3][3] ^= subkey[3];
 }
 
+#if XHDCP22_AES_IMPL == XHDCP22_AES_IMPL_BYTE
 /*****************************************************************************/
 /**
 *
@@ -499,6 +664,7 @@ static void AesSubBytes(u8 State[][4])
 	State[3][2] = Aes_Sbox[State[3][2] >> 4][State[3][2] & 0x0F];
 	State[3][3] = Aes_Sbox[State[3][3] >> 4][State[3][3] & 0x0F];
 }
+#endif
 
 /*****************************************************************************/
 /**
@@ -532,6 +698,7 @@ static void AesInvSubBytes(u8 State[][4])
 	State[3][3] = Aes_Invsbox[State[3][3] >> 4][State[3][3] & 0x0F];
 }
 
+#if XHDCP22_AES_IMPL == XHDCP22_AES_IMPL_BYTE
 /*****************************************************************************/
 /**
 *
@@ -569,6 +736,7 @@ static void AesShiftRows(u8 State[][4])
 	State[3][2] = State[3][1];
 	State[3][1] = t;
 }
+#endif
 
 /*****************************************************************************/
 /**
@@ -607,6 +775,7 @@ static void AesInvShiftRows(u8 State[][4])
 	State[3][2] = t;
 }
 
+#if XHDCP22_AES_IMPL == XHDCP22_AES_IMPL_BYTE
 /*****************************************************************************/
 /**
 *
@@ -712,6 +881,7 @@ static void AesMixColumns(u8 State[][4])
 	State[3][3] ^= Col[2];
 	State[3][3] ^= Aes_GfMul[Col[3]][0];
 }
+#endif
 
 /*****************************************************************************/
 /**
@@ -815,7 +985,6 @@ static void AesInvMixColumns(u8 State[][4])
 	State[3][3] ^= Aes_GfMul[Col[3]][5];
 }
 
-#ifdef AES_CIPHER_CTR_MODE
 /*****************************************************************************/
 /**
 *
@@ -841,8 +1010,8 @@ static void AesIncrementIv(u8 Iv[], int CounterSize)
 			break;
 	}
 }
-#endif
 
+#if XHDCP22_AES_IMPL == XHDCP22_AES_IMPL_BYTE
 /*****************************************************************************/
 /**
 *
@@ -947,6 +1116,532 @@ static void AesEncrypt(const u8 In[], u8 Out[], const u32 Key[], int KeySize)
 	Out[14] = State[2][3];
 	Out[15] = State[3][3];
 }
+#elif XHDCP22_AES_IMPL == XHDCP22_AES_IMPL_TTABLE
+/*****************************************************************************/
+/**
+*
+* This function encrypts using the T-table implementation of AES. The state
+* is held in four 32-bit columns and each round is computed with 16 table
+* lookups.
+*
+* @param	In is 16 bytes of plaintext
+* @param	Out is 16 bytes of ciphertext
+* @param	Key is from the key setup
+* @param	KeySize is the bit length of the key, 128, 192, or 256
+*
+* @return	None.
+*
+* @note		Key setup must be done before any AES en/de-cryption functions
+* 			can be used.
+*
+******************************************************************************/
+static void AesEncrypt(const u8 In[], u8 Out[], const u32 Key[], int KeySize)
+{
+	u32 S0, S1, S2, S3, T0, T1, T2, T3;
+	int Round, Nr = KeySize / 32 + 6;
+
+	// The round key is added first.
+	S0 = AES_GETU32(&In[0]) ^ Key[0];
+	S1 = AES_GETU32(&In[4]) ^ Key[1];
+	S2 = AES_GETU32(&In[8]) ^ Key[2];
+	S3 = AES_GETU32(&In[12]) ^ Key[3];
+
+	for (Round = 1; Round < Nr; Round++) {
+		Key += 4;
+		T0 = AES_TROUND(S0, S1, S2, S3, Key[0]);
+		T1 = AES_TROUND(S1, S2, S3, S0, Key[1]);
+		T2 = AES_TROUND(S2, S3, S0, S1, Key[2]);
+		T3 = AES_TROUND(S3, S0, S1, S2, Key[3]);
+		S0 = T0;
+		S1 = T1;
+		S2 = T2;
+		S3 = T3;
+	}
+
+	// The last round does not perform the MixColumns step.
+	Key += 4;
+	T0 = AES_TLAST(S0, S1, S2, S3, Key[0]);
+	T1 = AES_TLAST(S1, S2, S3, S0, Key[1]);
+	T2 = AES_TLAST(S2, S3, S0, S1, Key[2]);
+	T3 = AES_TLAST(S3, S0, S1, S2, Key[3]);
+
+	AES_PUTU32(&Out[0], T0);
+	AES_PUTU32(&Out[4], T1);
+	AES_PUTU32(&Out[8], T2);
+	AES_PUTU32(&Out[12], T3);
+}
+#endif
+
+#if XHDCP22_AES_IMPL == XHDCP22_AES_IMPL_BITSLICED
+/*****************************************************************************/
+/**
+*
+* This function converts between the byte and the bitsliced representation
+* of two blocks. In the byte representation Q[0], Q[2], Q[4], Q[6] hold the
+* columns of the first block and Q[1], Q[3], Q[5], Q[7] the columns of the
+* second block. In the bitsliced representation Q[i] holds bit i of all 32
+* bytes. The conversion is its own inverse.
+*
+* @param	Q are the 8 words to convert.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void AesBsOrtho(u32 Q[])
+{
+	AES_BS_SWAP(0x55555555, 0xAAAAAAAA, 1, Q[0], Q[1]);
+	AES_BS_SWAP(0x55555555, 0xAAAAAAAA, 1, Q[2], Q[3]);
+	AES_BS_SWAP(0x55555555, 0xAAAAAAAA, 1, Q[4], Q[5]);
+	AES_BS_SWAP(0x55555555, 0xAAAAAAAA, 1, Q[6], Q[7]);
+
+	AES_BS_SWAP(0x33333333, 0xCCCCCCCC, 2, Q[0], Q[2]);
+	AES_BS_SWAP(0x33333333, 0xCCCCCCCC, 2, Q[1], Q[3]);
+	AES_BS_SWAP(0x33333333, 0xCCCCCCCC, 2, Q[4], Q[6]);
+	AES_BS_SWAP(0x33333333, 0xCCCCCCCC, 2, Q[5], Q[7]);
+
+	AES_BS_SWAP(0x0F0F0F0F, 0xF0F0F0F0, 4, Q[0], Q[4]);
+	AES_BS_SWAP(0x0F0F0F0F, 0xF0F0F0F0, 4, Q[1], Q[5]);
+	AES_BS_SWAP(0x0F0F0F0F, 0xF0F0F0F0, 4, Q[2], Q[6]);
+	AES_BS_SWAP(0x0F0F0F0F, 0xF0F0F0F0, 4, Q[3], Q[7]);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function performs the SubBytes step on 32 bytes in the bitsliced
+* representation. The S-box is computed with the 113 gate circuit of Boyar
+* and Peralta (a linear layer, a shared inversion in GF(2^4) and a second
+* linear layer) instead of a table, so the execution time does not depend
+* on the data.
+*
+* @param	Q are the 8 bitsliced words.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void AesBsSbox(u32 Q[])
+{
+	u32 x0, x1, x2, x3, x4, x5, x6, x7;
+	u32 y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11;
+	u32 y12, y13, y14, y15, y16, y17, y18, y19, y20, y21;
+	u32 z0, z1, z2, z3, z4, z5, z6, z7, z8, z9, z10, z11;
+	u32 z12, z13, z14, z15, z16, z17;
+	u32 t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11;
+	u32 t12, t13, t14, t15, t16, t17, t18, t19, t20, t21, t22, t23;
+	u32 t24, t25, t26, t27, t28, t29, t30, t31, t32, t33, t34, t35;
+	u32 t36, t37, t38, t39, t40, t41, t42, t43, t44, t45, t46, t47;
+	u32 t48, t49, t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+	u32 t60, t61, t62, t63, t64, t65, t66, t67;
+	u32 s0, s1, s2, s3, s4, s5, s6, s7;
+
+	x0 = Q[7];
+	x1 = Q[6];
+	x2 = Q[5];
+	x3 = Q[4];
+	x4 = Q[3];
+	x5 = Q[2];
+	x6 = Q[1];
+	x7 = Q[0];
+
+	// Top linear transformation.
+	y14 = x3 ^ x5;
+	y13 = x0 ^ x6;
+	y9 = x0 ^ x3;
+	y8 = x0 ^ x5;
+	t0 = x1 ^ x2;
+	y1 = t0 ^ x7;
+	y4 = y1 ^ x3;
+	y12 = y13 ^ y14;
+	y2 = y1 ^ x0;
+	y5 = y1 ^ x6;
+	y3 = y5 ^ y8;
+	t1 = x4 ^ y12;
+	y15 = t1 ^ x5;
+	y20 = t1 ^ x1;
+	y6 = y15 ^ x7;
+	y10 = y15 ^ t0;
+	y11 = y20 ^ y9;
+	y7 = x7 ^ y11;
+	y17 = y10 ^ y11;
+	y19 = y10 ^ y8;
+	y16 = t0 ^ y11;
+	y21 = y13 ^ y16;
+	y18 = x0 ^ y16;
+
+	// Non-linear section.
+	t2 = y12 & y15;
+	t3 = y3 & y6;
+	t4 = t3 ^ t2;
+	t5 = y4 & x7;
+	t6 = t5 ^ t2;
+	t7 = y13 & y16;
+	t8 = y5 & y1;
+	t9 = t8 ^ t7;
+	t10 = y2 & y7;
+	t11 = t10 ^ t7;
+	t12 = y9 & y11;
+	t13 = y14 & y17;
+	t14 = t13 ^ t12;
+	t15 = y8 & y10;
+	t16 = t15 ^ t12;
+	t17 = t4 ^ t14;
+	t18 = t6 ^ t16;
+	t19 = t9 ^ t14;
+	t20 = t11 ^ t16;
+	t21 = t17 ^ y20;
+	t22 = t18 ^ y19;
+	t23 = t19 ^ y21;
+	t24 = t20 ^ y18;
+
+	t25 = t21 ^ t22;
+	t26 = t21 & t23;
+	t27 = t24 ^ t26;
+	t28 = t25 & t27;
+	t29 = t28 ^ t22;
+	t30 = t23 ^ t24;
+	t31 = t22 ^ t26;
+	t32 = t31 & t30;
+	t33 = t32 ^ t24;
+	t34 = t23 ^ t33;
+	t35 = t27 ^ t33;
+	t36 = t24 & t35;
+	t37 = t36 ^ t34;
+	t38 = t27 ^ t36;
+	t39 = t29 & t38;
+	t40 = t25 ^ t39;
+
+	t41 = t40 ^ t37;
+	t42 = t29 ^ t33;
+	t43 = t29 ^ t40;
+	t44 = t33 ^ t37;
+	t45 = t42 ^ t41;
+	z0 = t44 & y15;
+	z1 = t37 & y6;
+	z2 = t33 & x7;
+	z3 = t43 & y16;
+	z4 = t40 & y1;
+	z5 = t29 & y7;
+	z6 = t42 & y11;
+	z7 = t45 & y17;
+	z8 = t41 & y10;
+	z9 = t44 & y12;
+	z10 = t37 & y3;
+	z11 = t33 & y4;
+	z12 = t43 & y13;
+	z13 = t40 & y5;
+	z14 = t29 & y2;
+	z15 = t42 & y9;
+	z16 = t45 & y14;
+	z17 = t41 & y8;
+
+	// Bottom linear transformation.
+	t46 = z15 ^ z16;
+	t47 = z10 ^ z11;
+	t48 = z5 ^ z13;
+	t49 = z9 ^ z10;
+	t50 = z2 ^ z12;
+	t51 = z2 ^ z5;
+	t52 = z7 ^ z8;
+	t53 = z0 ^ z3;
+	t54 = z6 ^ z7;
+	t55 = z16 ^ z17;
+	t56 = z12 ^ t48;
+	t57 = t50 ^ t53;
+	t58 = z4 ^ t46;
+	t59 = z3 ^ t54;
+	t60 = t46 ^ t57;
+	t61 = z14 ^ t57;
+	t62 = t52 ^ t58;
+	t63 = t49 ^ t58;
+	t64 = z4 ^ t59;
+	t65 = t61 ^ t62;
+	t66 = z1 ^ t63;
+	s0 = t59 ^ t63;
+	s6 = t56 ^ ~t62;
+	s7 = t48 ^ ~t60;
+	t67 = t64 ^ t65;
+	s3 = t53 ^ t66;
+	s4 = t51 ^ t66;
+	s5 = t47 ^ t65;
+	s1 = t64 ^ ~s3;
+	s2 = t55 ^ ~t67;
+
+	Q[7] = s0;
+	Q[6] = s1;
+	Q[5] = s2;
+	Q[4] = s3;
+	Q[3] = s4;
+	Q[2] = s5;
+	Q[1] = s6;
+	Q[0] = s7;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function performs the ShiftRows step in the bitsliced representation.
+* Each byte of a word holds one row of both blocks, so the rows are rotated
+* by moving bit pairs within the byte.
+*
+* @param	Q are the 8 bitsliced words.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void AesBsShiftRows(u32 Q[])
+{
+	int Idx;
+	u32 X;
+
+	for (Idx = 0; Idx < 8; Idx++) {
+		X = Q[Idx];
+		Q[Idx] = (X & 0x000000FF)
+			| ((X & 0x0000FC00) >> 2) | ((X & 0x00000300) << 6)
+			| ((X & 0x00F00000) >> 4) | ((X & 0x000F0000) << 4)
+			| ((X & 0xC0000000) >> 6) | ((X & 0x3F000000) << 2);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function performs the MixColumns step in the bitsliced
+* representation. The multiplication by {02} is a shift across the bit
+* planes with the reduction polynomial folded into planes 0, 1, 3 and 4.
+*
+* @param	Q are the 8 bitsliced words.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void AesBsMixColumns(u32 Q[])
+{
+	u32 q0, q1, q2, q3, q4, q5, q6, q7;
+	u32 r0, r1, r2, r3, r4, r5, r6, r7;
+
+	q0 = Q[0];
+	q1 = Q[1];
+	q2 = Q[2];
+	q3 = Q[3];
+	q4 = Q[4];
+	q5 = Q[5];
+	q6 = Q[6];
+	q7 = Q[7];
+	r0 = AES_ROR32(q0, 8);
+	r1 = AES_ROR32(q1, 8);
+	r2 = AES_ROR32(q2, 8);
+	r3 = AES_ROR32(q3, 8);
+	r4 = AES_ROR32(q4, 8);
+	r5 = AES_ROR32(q5, 8);
+	r6 = AES_ROR32(q6, 8);
+	r7 = AES_ROR32(q7, 8);
+
+	Q[0] = q7 ^ r7 ^ r0 ^ AES_ROR32(q0 ^ r0, 16);
+	Q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ AES_ROR32(q1 ^ r1, 16);
+	Q[2] = q1 ^ r1 ^ r2 ^ AES_ROR32(q2 ^ r2, 16);
+	Q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ AES_ROR32(q3 ^ r3, 16);
+	Q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ AES_ROR32(q4 ^ r4, 16);
+	Q[5] = q4 ^ r4 ^ r5 ^ AES_ROR32(q5 ^ r5, 16);
+	Q[6] = q5 ^ r5 ^ r6 ^ AES_ROR32(q6 ^ r6, 16);
+	Q[7] = q6 ^ r6 ^ r7 ^ AES_ROR32(q7 ^ r7, 16);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function substitutes the bytes of a word with the bitsliced S-box,
+* for the key schedule.
+*
+* @param	Word to substitute.
+*
+* @return	Transformation word.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 AesBsSubWord(u32 Word)
+{
+	u32 Q[8];
+
+	memset(Q, 0, sizeof(Q));
+	Q[0] = Word;
+	AesBsOrtho(Q);
+	AesBsSbox(Q);
+	AesBsOrtho(Q);
+	return Q[0];
+}
+
+/*****************************************************************************/
+/**
+*
+* This function generates the key schedule of the bitsliced implementation.
+* It is the key schedule of AesKeySetup() on little endian words, with every
+* round key duplicated for both blocks and converted to the bitsliced
+* representation.
+*
+* @param	Key is the user-supplied input key.
+* @param	Skey is the output key schedule, 8 words per round key.
+* @param	KeySize is the length in bits of "Key", must be 128, 192, or 256.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void AesBsKeySetup(const u8 Key[], u32 Skey[], int KeySizeBits)
+{
+	static const u8 Rcon[] = {0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80,0x1b,0x36};
+	int Nr, Nk, Idx, Pos, Round;
+	u32 Temp = 0;
+
+	switch (KeySizeBits) {
+		case 128: Nr = 10; Nk = 4; break;
+		case 192: Nr = 12; Nk = 6; break;
+		case 256: Nr = 14; Nk = 8; break;
+		default: return;
+	}
+
+	for (Idx = 0; Idx < Nk; ++Idx) {
+		Temp = AES_GETU32LE(&Key[4 * Idx]);
+		Skey[2 * Idx] = Temp;
+		Skey[2 * Idx + 1] = Temp;
+	}
+
+	for (Idx = Nk, Pos = 0, Round = 0; Idx < 4 * (Nr + 1); ++Idx) {
+		if (Pos == 0)
+			Temp = AesBsSubWord(AES_ROR32(Temp, 8)) ^ Rcon[Round];
+		else if (Nk > 6 && Pos == 4)
+			Temp = AesBsSubWord(Temp);
+		Temp ^= Skey[2 * (Idx - Nk)];
+		Skey[2 * Idx] = Temp;
+		Skey[2 * Idx + 1] = Temp;
+		if (++Pos == Nk) {
+			Pos = 0;
+			Round++;
+		}
+	}
+
+	for (Idx = 0; Idx < 4 * (Nr + 1); Idx += 4) {
+		AesBsOrtho(&Skey[2 * Idx]);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function encrypts two blocks in the bitsliced representation.
+*
+* @param	Q are the 8 bitsliced words of the two blocks.
+* @param	Skey is from AesBsKeySetup().
+* @param	KeySize is the bit length of the key, 128, 192, or 256
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void AesBsEncrypt(u32 Q[], const u32 Skey[], int KeySize)
+{
+	int Idx, Round, Nr = KeySize / 32 + 6;
+
+	// The round key is added first.
+	for (Idx = 0; Idx < 8; Idx++)
+		Q[Idx] ^= Skey[Idx];
+
+	for (Round = 1; Round <= Nr; Round++) {
+		AesBsSbox(Q);
+		AesBsShiftRows(Q);
+		// The last round does not perform the MixColumns step.
+		if (Round != Nr)
+			AesBsMixColumns(Q);
+		Skey += 8;
+		for (Idx = 0; Idx < 8; Idx++)
+			Q[Idx] ^= Skey[Idx];
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function encrypts a number of blocks with the bitsliced
+* implementation, two blocks at a time.
+*
+* @param	In is the plaintext, NumBlocks * 16 bytes
+* @param	Out is the ciphertext, NumBlocks * 16 bytes (can be In)
+* @param	NumBlocks is the number of blocks
+* @param	Key is from AesBsKeySetup()
+* @param	KeySize is the bit length of the key, 128, 192, or 256
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void AesEncryptBlocks(const u8 In[], u8 Out[], u32 NumBlocks,
+                             const u32 Key[], int KeySize)
+{
+	u32 Q[8];
+	int Idx;
+
+	while (NumBlocks > 0) {
+		for (Idx = 0; Idx < 4; Idx++) {
+			Q[2 * Idx] = AES_GETU32LE(&In[4 * Idx]);
+			Q[2 * Idx + 1] = (NumBlocks > 1) ?
+					AES_GETU32LE(&In[AES_BLOCK_SIZE + 4 * Idx]) : 0;
+		}
+
+		AesBsOrtho(Q);
+		AesBsEncrypt(Q, Key, KeySize);
+		AesBsOrtho(Q);
+
+		for (Idx = 0; Idx < 4; Idx++) {
+			AES_PUTU32LE(&Out[4 * Idx], Q[2 * Idx]);
+			if (NumBlocks > 1)
+				AES_PUTU32LE(&Out[AES_BLOCK_SIZE + 4 * Idx], Q[2 * Idx + 1]);
+		}
+
+		if (NumBlocks == 1)
+			break;
+		In += 2 * AES_BLOCK_SIZE;
+		Out += 2 * AES_BLOCK_SIZE;
+		NumBlocks -= 2;
+	}
+}
+#else
+/*****************************************************************************/
+/**
+*
+* This function encrypts a number of blocks, one block at a time.
+*
+* @param	In is the plaintext, NumBlocks * 16 bytes
+* @param	Out is the ciphertext, NumBlocks * 16 bytes (can be In)
+* @param	NumBlocks is the number of blocks
+* @param	Key is from the key setup
+* @param	KeySize is the bit length of the key, 128, 192, or 256
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void AesEncryptBlocks(const u8 In[], u8 Out[], u32 NumBlocks,
+                             const u32 Key[], int KeySize)
+{
+	for (; NumBlocks > 0; NumBlocks--) {
+		AesEncrypt(In, Out, Key, KeySize);
+		In += AES_BLOCK_SIZE;
+		Out += AES_BLOCK_SIZE;
+	}
+}
+#endif
 
 /*****************************************************************************/
 /**
@@ -1048,72 +1743,46 @@ static void AesDecrypt(const u8 In[], u8 Out[], const u32 Key[], int KeySize)
 }
 
 
-#ifdef AES_CIPHER_CTR_MODE
 /*****************************************************************************/
 /**
 *
-* This function encrypts using AES and a counter.
+* This function encrypts using AES and a counter. The counter blocks are
+* laid out AES_CTR_BATCH at a time and encrypted with one call to
+* AesEncryptBlocks().
 *
 * @param	In is the plaintext
 * @param	InLen is any bytes length
-* @param	Out is is the ciphertext, same length as plaintext
+* @param	Out is is the ciphertext, same length as plaintext (can be In)
 * @param	Key is from the key setup
 * @param	KeySize is the bit length of the key
 * @param	Iv must be AES_BLOCK_SIZE bytes long
 *
 * @return	None.
 *
-* @note		None.
+* @note		CTR encryption is its own inverse function.
 *
 ******************************************************************************/
 static void AesEncryptCtr(const u8 In[], size_t InLen, u8 Out[],
 								  const u32 Key[], int KeySize, const u8 Iv[])
 {
-	size_t Idx = 0, LastBlockLength;
-	u8 iv_buf[AES_BLOCK_SIZE], out_buf[AES_BLOCK_SIZE];
-
-	if (In != Out)
-		memcpy(Out, In, InLen);
+	u8 iv_buf[AES_BLOCK_SIZE], out_buf[AES_CTR_BATCH * AES_BLOCK_SIZE];
+	size_t Len;
+	u32 NumBlocks, Idx;
 
 	memcpy(iv_buf, Iv, AES_BLOCK_SIZE);
-	LastBlockLength = InLen - AES_BLOCK_SIZE;
 
-	if (InLen > AES_BLOCK_SIZE) {
-		for (Idx = 0; Idx < LastBlockLength; Idx += AES_BLOCK_SIZE) {
-			AesEncrypt(iv_buf, out_buf, Key, KeySize);
-			Xor(&Out[Idx], out_buf, &Out[Idx], AES_BLOCK_SIZE);
+	while (InLen > 0) {
+		Len = (InLen < sizeof(out_buf)) ? InLen : sizeof(out_buf);
+		NumBlocks = (Len + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+		for (Idx = 0; Idx < NumBlocks; Idx++) {
+			memcpy(&out_buf[Idx * AES_BLOCK_SIZE], iv_buf, AES_BLOCK_SIZE);
 			AesIncrementIv(iv_buf, AES_BLOCK_SIZE);
 		}
+		AesEncryptBlocks(out_buf, out_buf, NumBlocks, Key, KeySize);
+		/* Use the Most Significant bytes of the last block. */
+		Xor(Out, out_buf, In, Len);
+		In += Len;
+		Out += Len;
+		InLen -= Len;
 	}
-
-	AesEncrypt(iv_buf, out_buf, Key, KeySize);
-	/* Use the Most Significant bytes. */
-	Xor(&Out[Idx], out_buf, &Out[Idx], InLen - Idx);
 }
-#endif
-
-#ifdef AES_CIPHER_CTR_MODE
-/*****************************************************************************/
-/**
-*
-* This function does a AES-CTR decryption (is the same as encryption)
-*
-* @param	In is the ciphertext
-* @param	InLen is any byte length
-* @param	Out is the ciphertext, same length as plaintext
-* @param	Key is from the key setup
-* @param	KeySize is the bit length of the key, 128, 192, or 256
-* @param	Iv must be AES_BLOCK_SIZE bytes long
-*
-* @return	None.
-*
-* @note		None.
-*
-******************************************************************************/
-static void AesDecryptCtr(const u8 In[], size_t InLen, u8 Out[],
-								 const u32 Key[], int KeySize, const u8 Iv[])
-{
-	// CTR encryption is its own inverse function.
-	AesEncryptCtr(In, InLen, Out, Key, KeySize, Iv);
-}
-#endif
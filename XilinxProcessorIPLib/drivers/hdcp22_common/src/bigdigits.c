@@ -581,6 +581,234 @@ u32 mpSubtract(u32 w[], const u32 u[], const u32 v[], size_t ndigits)
 	return k;	/* Should be zero if u >= v */
 }
 
+/*	COMBA AND KARATSUBA KERNELS
+	mpMultiply and mpSquare compute each output column in a double-digit
+	accumulator (Comba) instead of propagating a carry per digit product,
+	and split operands of MP_KARATSUBA_CUTOFF digits or more in two halves
+	(Karatsuba, three half-size products instead of four).
+	The accumulator is 128 bits where the compiler has such a type (64-bit
+	hosts) and 64 bits plus an overflow digit otherwise (32-bit hosts, or
+	MP_NO_ACC128 defined). Define MP_NO_COMBA to use the original
+	Knuth/Menezes loops.
+*/
+#ifndef MP_NO_COMBA
+
+#ifndef MP_KARATSUBA_CUTOFF
+#define MP_KARATSUBA_CUTOFF 64
+#endif
+#if MP_KARATSUBA_CUTOFF < 8
+#error MP_KARATSUBA_CUTOFF must be 8 or more
+#endif
+
+/* Scratch digits for the Karatsuba recursion on n digits: 6h+1 per level,
+   h = (n+1)/2, for each level down to MP_KARATSUBA_CUTOFF. Six levels cover
+   MAX_FIXED_DIGITS up to 32 * 8 = 256 digits with the smallest cutoff. */
+#if MAX_FIXED_DIGITS > 256
+#error MP_KARATSUBA_SCRATCH does not cover MAX_FIXED_DIGITS
+#endif
+#define MP_KARATSUBA_LEVEL(n)	(((n) >= MP_KARATSUBA_CUTOFF) ? 6 * (((n) + 1) / 2) + 1 : 0)
+#define MP_KARATSUBA_SCRATCH(n)	(MP_KARATSUBA_LEVEL(n) + \
+								 MP_KARATSUBA_LEVEL(((n) + 1) / 2) + \
+								 MP_KARATSUBA_LEVEL(((n) + 3) / 4) + \
+								 MP_KARATSUBA_LEVEL(((n) + 7) / 8) + \
+								 MP_KARATSUBA_LEVEL(((n) + 15) / 16) + \
+								 MP_KARATSUBA_LEVEL(((n) + 31) / 32))
+
+/* The scratch lives in the frame of the Karatsuba entry points only, so
+   products below the cutoff don't carry it on the stack */
+#if defined(__GNUC__)
+#define MP_NOINLINE __attribute__((noinline))
+#else
+#define MP_NOINLINE
+#endif
+
+#if defined(__SIZEOF_INT128__) && !defined(MP_NO_ACC128)
+#define MP_ACC_DECL			unsigned __int128 acc = 0
+#define MP_ACC_ADD(x, y)	acc += (u64)(x) * (y)
+#define MP_ACC_OUT(w)		do { (w) = (u32)acc; acc >>= BITS_PER_DIGIT; } while (0)
+#else
+#define MP_ACC_DECL			u64 acc = 0, p_; u32 acc2 = 0
+#define MP_ACC_ADD(x, y)	do { p_ = (u64)(x) * (y); acc += p_; acc2 += (acc < p_); } while (0)
+#define MP_ACC_OUT(w)		do { (w) = (u32)acc; \
+								acc = (acc >> BITS_PER_DIGIT) | ((u64)acc2 << BITS_PER_DIGIT); \
+								acc2 = 0; } while (0)
+#endif
+
+static void mpCombaMultiply(u32 w[], const u32 u[], const u32 v[], size_t n)
+	/* Computes w = u * v column by column, |w| = 2n */
+{
+	size_t i, k, lo, hi;
+	MP_ACC_DECL;
+
+	for (k = 0; k < 2 * n - 1; k++)
+	{
+		lo = (k < n) ? 0 : k - n + 1;
+		hi = (k < n) ? k : n - 1;
+		for (i = lo; i <= hi; i++)
+			MP_ACC_ADD(u[i], v[k - i]);
+		MP_ACC_OUT(w[k]);
+	}
+	w[2 * n - 1] = (u32)acc;
+}
+
+static void mpCombaSquare(u32 w[], const u32 x[], size_t n)
+	/* Computes w = x * x column by column, |w| = 2n.
+	   Each cross product x_i * x_j, i < j, is computed once and added twice. */
+{
+	size_t i, j, k, lo;
+	u64 p;
+	MP_ACC_DECL;
+
+	for (k = 0; k < 2 * n - 1; k++)
+	{
+		lo = (k < n) ? 0 : k - n + 1;
+		for (i = lo, j = k - lo; i < j; i++, j--)
+		{
+			p = (u64)x[i] * x[j];
+			MP_ACC_ADD(p, 1);
+			MP_ACC_ADD(p, 1);
+		}
+		if (i == j)
+			MP_ACC_ADD(x[i], x[i]);
+		MP_ACC_OUT(w[k]);
+	}
+	w[2 * n - 1] = (u32)acc;
+}
+
+static u32 mpAddTo(u32 w[], size_t wdigits, const u32 x[], size_t xdigits)
+	/* Computes w += x, xdigits <= wdigits, returns carry out of w */
+{
+	u32 k = mpAdd(w, w, x, xdigits);
+	size_t i;
+
+	for (i = xdigits; k && i < wdigits; i++)
+		k = (++w[i] == 0);
+	return k;
+}
+
+static u32 mpSubFrom(u32 w[], size_t wdigits, const u32 x[], size_t xdigits)
+	/* Computes w -= x, xdigits <= wdigits, returns borrow out of w */
+{
+	u32 k = mpSubtract(w, w, x, xdigits);
+	size_t i;
+
+	for (i = xdigits; k && i < wdigits; i++)
+		k = (w[i]-- == 0);
+	return k;
+}
+
+static int mpAbsDiff(u32 d[], const u32 x[], const u32 y[], size_t xdigits, size_t ydigits, u32 t[])
+	/* Computes d = |x - y|, ydigits <= xdigits, t is xdigits of scratch.
+	   Returns 1 if x < y. */
+{
+	mpSetZero(t, xdigits);
+	mpSetEqual(t, y, ydigits);
+	if (mpCompare(x, t, xdigits) >= 0)
+	{
+		mpSubtract(d, x, t, xdigits);
+		return 0;
+	}
+	mpSubtract(d, t, x, xdigits);
+	return 1;
+}
+
+static void mpKaratsuba(u32 w[], const u32 u[], const u32 v[], size_t n, u32 scratch[])
+	/* Computes w = u * v, |w| = 2n.
+	   With u = u0 + B^h u1 and v = v0 + B^h v1:
+	   u0 v1 + u1 v0 = u0 v0 + u1 v1 + (u0 - u1)(v1 - v0) */
+{
+	size_t h, l;
+	u32 *du, *dv, *z1, *t;
+	int neg;
+
+	if (n < MP_KARATSUBA_CUTOFF)
+	{
+		mpCombaMultiply(w, u, v, n);
+		return;
+	}
+
+	h = (n + 1) / 2;	/* low half */
+	l = n - h;			/* high half, l <= h */
+	du = scratch;
+	dv = du + h;
+	z1 = dv + h;
+	t = z1 + 2 * h;		/* 2h + 1 digits */
+
+	/* z1 = |u0 - u1| * |v1 - v0| */
+	neg = mpAbsDiff(du, u, u + h, h, l, t);
+	neg ^= mpAbsDiff(dv, v, v + h, h, l, t);	/* sign of (u0 - u1)(v0 - v1) */
+	mpKaratsuba(z1, du, dv, h, t + 2 * h + 1);
+
+	/* w = z0 + B^2h z2 */
+	mpKaratsuba(w, u, v, h, t + 2 * h + 1);
+	mpKaratsuba(w + 2 * h, u + h, v + h, l, t + 2 * h + 1);
+
+	/* t = z0 + z2 - (u0 - u1)(v0 - v1) */
+	mpSetEqual(t, w, 2 * h);
+	t[2 * h] = 0;
+	mpAddTo(t, 2 * h + 1, w + 2 * h, 2 * l);
+	if (neg)
+		mpAddTo(t, 2 * h + 1, z1, 2 * h);
+	else
+		mpSubFrom(t, 2 * h + 1, z1, 2 * h);
+
+	/* w += B^h t */
+	mpAddTo(w + h, 2 * n - h, t, 2 * h + 1);
+}
+
+static void mpKaratsubaSquare(u32 w[], const u32 x[], size_t n, u32 scratch[])
+	/* Computes w = x * x, |w| = 2n.
+	   2 x0 x1 = x0^2 + x1^2 - (x0 - x1)^2 */
+{
+	size_t h, l;
+	u32 *dx, *z1, *t;
+
+	if (n < MP_KARATSUBA_CUTOFF)
+	{
+		mpCombaSquare(w, x, n);
+		return;
+	}
+
+	h = (n + 1) / 2;
+	l = n - h;
+	dx = scratch;
+	z1 = dx + 2 * h;	/* same layout as mpKaratsuba */
+	t = z1 + 2 * h;
+
+	mpAbsDiff(dx, x, x + h, h, l, t);
+	mpKaratsubaSquare(z1, dx, h, t + 2 * h + 1);
+
+	mpKaratsubaSquare(w, x, h, t + 2 * h + 1);
+	mpKaratsubaSquare(w + 2 * h, x + h, l, t + 2 * h + 1);
+
+	mpSetEqual(t, w, 2 * h);
+	t[2 * h] = 0;
+	mpAddTo(t, 2 * h + 1, w + 2 * h, 2 * l);
+	mpSubFrom(t, 2 * h + 1, z1, 2 * h);
+
+	mpAddTo(w + h, 2 * n - h, t, 2 * h + 1);
+}
+
+static MP_NOINLINE void mpKaratsubaMultiplyTop(u32 w[], const u32 u[], const u32 v[], size_t n)
+	/* mpKaratsuba with scratch for up to MAX_FIXED_DIGITS */
+{
+	u32 scratch[MP_KARATSUBA_SCRATCH(MAX_FIXED_DIGITS)];
+
+	mpKaratsuba(w, u, v, n, scratch);
+	mpSetZero(scratch, MP_KARATSUBA_SCRATCH(n));
+}
+
+static MP_NOINLINE void mpKaratsubaSquareTop(u32 w[], const u32 x[], size_t n)
+	/* mpKaratsubaSquare with scratch for up to MAX_FIXED_DIGITS */
+{
+	u32 scratch[MP_KARATSUBA_SCRATCH(MAX_FIXED_DIGITS)];
+
+	mpKaratsubaSquare(w, x, n, scratch);
+	mpSetZero(scratch, MP_KARATSUBA_SCRATCH(n));
+}
+
+#endif /* !MP_NO_COMBA */
+
 int mpMultiply(u32 w[], const u32 u[], const u32 v[], size_t ndigits)
 {
 	/*	Computes product w = u * v
@@ -589,6 +817,16 @@ int mpMultiply(u32 w[], const u32 u[], const u32 v[], size_t ndigits)
 
 		Ref: Knuth Vol 2 Ch 4.3.1 p 268 Algorithm M.
 	*/
+#ifndef MP_NO_COMBA
+	assert(w != u && w != v);
+	assert(ndigits != 0 && ndigits <= MAX_FIXED_DIGITS);
+
+	if (ndigits < MP_KARATSUBA_CUTOFF)
+		mpCombaMultiply(w, u, v, ndigits);
+	else
+		mpKaratsubaMultiplyTop(w, u, v, ndigits);
+	return 0;
+#else
 
 	u32 k, t[2];
 	size_t i, j, m, n;
@@ -634,6 +872,7 @@ int mpMultiply(u32 w[], const u32 u[], const u32 v[], size_t ndigits)
 	}	/* Step M6. Loop on j */
 
 	return 0;
+#endif
 }
 
 /* mpDivide */
@@ -855,7 +1094,16 @@ int mpSquare(u32 w[], const u32 x[], size_t ndigits)
 
 		Ref: Menezes p596 Algorithm 14.16 with errata.
 	*/
+#ifndef MP_NO_COMBA
+	assert(w != x);
+	assert(ndigits != 0 && ndigits <= MAX_FIXED_DIGITS);
 
+	if (ndigits < MP_KARATSUBA_CUTOFF)
+		mpCombaSquare(w, x, ndigits);
+	else
+		mpKaratsubaSquareTop(w, x, ndigits);
+	return 0;
+#else
 	u32 k, p[2], u[2], cbit, carry;
 	size_t i, j, t, i2, cpos;
 
@@ -953,6 +1201,7 @@ int mpSquare(u32 w[], const u32 x[], size_t ndigits)
 	/* Return w */
 
 	return 0;
+#endif
 }
 
 /** Returns true if a == b, else false. Not constant-time. */
@@ -1717,9 +1966,10 @@ int mpModulo(u32 r[], const u32 u[], size_t udigits,
 	size_t nn = max(udigits, vdigits);
 /* Allocate temp storage */
 #ifdef NO_ALLOCS
-	u32 qq[MAX_FIXED_DIGITS];
-	u32 rr[MAX_FIXED_DIGITS];
-	assert(nn <= MAX_FIXED_DIGITS);
+	/* Double-length so that u may be a product, as from mpModMult */
+	u32 qq[MAX_FIXED_DIGITS * 2];
+	u32 rr[MAX_FIXED_DIGITS * 2];
+	assert(nn <= MAX_FIXED_DIGITS * 2);
 #else
 	u32 *qq, *rr;
 	qq = mpAlloc(udigits);
@@ -2467,8 +2717,16 @@ u32 spSimpleRand(u32 lower, u32 upper)
 	mpModExp_1 is the earlier version [<2.2] now using macros for modular squaring & mult
 */
 
+/*	With NO_ALLOCS, odd moduli use sliding-window exponentiation in the Montgomery
+	domain (mpModExp_mont) with a fixed-size table of odd powers. Define MP_NO_MONT_EXP
+	to always use the binary method.
+*/
+
 #ifdef NO_ALLOCS
 static int mpModExp_1(u32 y[], const u32 x[], const u32 n[], u32 d[], size_t ndigits);
+#ifndef MP_NO_MONT_EXP
+static int mpModExp_mont(u32 y[], const u32 x[], const u32 n[], u32 d[], size_t ndigits);
+#endif
 #else
 static int mpModExp_windowed(u32 y[], const u32 x[], const u32 n[], u32 d[], size_t ndigits);
 #endif
@@ -2477,6 +2735,10 @@ int mpModExp(u32 y[], const u32 x[], const u32 n[], u32 d[], size_t ndigits)
 	/* Computes y = x^n mod d */
 {
 #ifdef NO_ALLOCS
+#ifndef MP_NO_MONT_EXP
+	if (d[0] & 0x1)
+		return mpModExp_mont(y, x, n, d, ndigits);
+#endif
 	return mpModExp_1(y, x, n, d, ndigits);
 #else
 	return mpModExp_windowed(y, x, n, d, ndigits);
@@ -2559,6 +2821,256 @@ done:
 	return 0;
 }
 
+/****************************/
+/* MONTGOMERY MULTIPLICATION */
+/****************************/
+
+u32 mpMontInv(u32 m0)
+	/* Returns -m0^{-1} mod 2^32 for odd m0 */
+{
+	u32 inv = m0;	/* Correct to 3 bits since m0*m0 == 1 mod 8 */
+	int i;
+
+	assert(m0 & 0x1);
+	/* Newton iteration, each step doubles the number of correct bits */
+	for (i = 0; i < 4; i++)
+		inv *= 2 - m0 * inv;
+
+	return (u32)0 - inv;
+}
+
+void mpMontMult(u32 w[], const u32 x[], const u32 y[], const u32 m[], u32 minv, size_t ndigits)
+	/* Computes w = x * y * R^{-1} mod m, R = 2^(BITS_PER_DIGIT * ndigits),
+	   using the Coarsely Integrated Operand Scanning (CIOS) method.
+	   Ref: Koc, Acar and Kaliski, "Analyzing and Comparing Montgomery
+	   Multiplication Algorithms", IEEE Micro, 16(3):26-33, June 1996.
+	   Requires m odd and x, y < m. w may be the same as x or y.
+	   The final subtraction is conditional, so this is not constant-time. */
+{
+	u32 t[MAX_FIXED_DIGITS + 2];
+	u64 p;
+	u32 c, u;
+	size_t i, j;
+
+	assert(ndigits <= MAX_FIXED_DIGITS);
+	mpSetZero(t, ndigits + 2);
+
+	for (i = 0; i < ndigits; i++)
+	{
+		/* t = t + x * y[i] */
+		c = 0;
+		for (j = 0; j < ndigits; j++)
+		{
+			p = (u64)x[j] * y[i] + t[j] + c;
+			t[j] = (u32)p;
+			c = (u32)(p >> 32);
+		}
+		p = (u64)t[ndigits] + c;
+		t[ndigits] = (u32)p;
+		t[ndigits + 1] = (u32)(p >> 32);
+
+		/* t = (t + u * m) / 2^32, u chosen so the low digit cancels */
+		u = t[0] * minv;
+		p = (u64)u * m[0] + t[0];
+		c = (u32)(p >> 32);
+		for (j = 1; j < ndigits; j++)
+		{
+			p = (u64)u * m[j] + t[j] + c;
+			t[j - 1] = (u32)p;
+			c = (u32)(p >> 32);
+		}
+		p = (u64)t[ndigits] + c;
+		t[ndigits - 1] = (u32)p;
+		t[ndigits] = t[ndigits + 1] + (u32)(p >> 32);
+	}
+
+	/* t < 2m, subtract m once if needed */
+	if (t[ndigits] || mpCompare(t, m, ndigits) >= 0)
+		mpSubtract(t, t, m, ndigits);
+
+	mpSetEqual(w, t, ndigits);
+	mpSetZero(t, ndigits + 2);
+}
+
+/*
+Optimal values of k for various exponent sizes.
+	The references on this differ in their recommendations.
+	These values reflect experiments we've done on our systems.
+	You can adjust this to suit your own situation.
+*/
+static size_t WindowLenTable[] =
+{
+/* k=1   2   3   4    5     6     7     8 */
+     5, 16, 64, 240, 768, 1024, 2048, 4096
+};
+#define WINLENTBLMAX (sizeof(WindowLenTable)/sizeof(WindowLenTable[0]))
+
+#ifdef NO_ALLOCS
+
+/*	Size in digits of the table of odd powers used by mpMontExp_1. The window
+	length is the largest that fits, up to the optimum for the exponent size:
+	the default (512 digits, 2 kB) gives a 5-bit window for 1024-bit moduli and
+	a 3-bit window for 3072-bit moduli.
+*/
+#ifndef MP_MONT_TABLE_DIGITS
+#define MP_MONT_TABLE_DIGITS 512
+#endif
+
+static void mpMontExp_1(u32 yout[], const u32 g1[], const u32 e[], const u32 m[],
+	u32 minv, size_t ndigits)
+	/* Computes y = x^e mod m for odd m and e != 0, given g1 = x * R mod m,
+	   using sliding-window exponentiation (Menezes 14.85) on Montgomery
+	   residues. Not constant-time. */
+{
+	u32 gtable[MP_MONT_TABLE_DIGITS];	/* xR, x^3R, x^5R, ... mod m, ndigits each */
+	u32 a[MAX_FIXED_DIGITS];
+	size_t nbits, winlen, ngt, i, k;
+	int bit, low, aisone;
+	u32 idx;
+
+	nbits = mpBitLength(e, ndigits);
+
+	/* Window length: the optimum for nbits, limited by the table size */
+	for (winlen = 1; winlen < WINLENTBLMAX; winlen++)
+	{
+		if (WindowLenTable[winlen] > nbits)
+			break;
+	}
+	while (winlen > 1 && ((size_t)1 << (winlen - 1)) * ndigits > MP_MONT_TABLE_DIGITS)
+		winlen--;
+	ngt = (size_t)1 << (winlen - 1);
+
+	/* g_{2i+1} = g_{2i-1} * g2, with g2 = x^2 * R mod m */
+	mpSetEqual(gtable, g1, ndigits);
+	if (ngt > 1)
+	{
+		mpMontMult(a, g1, g1, m, minv, ndigits);
+		for (i = 1; i < ngt; i++)
+			mpMontMult(gtable + i * ndigits, gtable + (i - 1) * ndigits, a, m, minv, ndigits);
+	}
+
+	/* Left to right over the bits of e */
+	aisone = 1;
+	bit = (int)nbits - 1;
+	while (bit >= 0)
+	{
+		if (!mpGetBit((u32 *)e, ndigits, bit))
+		{
+			if (!aisone)
+				mpMontMult(a, a, a, m, minv, ndigits);
+			bit--;
+			continue;
+		}
+
+		/* Longest window e_bit..e_low of at most winlen bits ending in a 1 */
+		low = bit - (int)winlen + 1;
+		if (low < 0)
+			low = 0;
+		while (!mpGetBit((u32 *)e, ndigits, low))
+			low++;
+		for (idx = 0, k = bit; (int)k >= low; k--)
+			idx = (idx << 1) | (u32)mpGetBit((u32 *)e, ndigits, k);
+
+		if (aisone)
+		{
+			mpSetEqual(a, gtable + (idx >> 1) * ndigits, ndigits);
+			aisone = 0;
+		}
+		else
+		{
+			for (k = 0; k < (size_t)(bit - low + 1); k++)
+				mpMontMult(a, a, a, m, minv, ndigits);
+			mpMontMult(a, a, gtable + (idx >> 1) * ndigits, m, minv, ndigits);
+		}
+		bit = low - 1;
+	}
+
+	/* y = a * 1 * R^{-1} mod m */
+	mpSetDigit(gtable, 1, ndigits);
+	mpMontMult(yout, a, gtable, m, minv, ndigits);
+
+	mpSetZero(gtable, ngt * ndigits);
+	mpSetZero(a, ndigits);
+}
+
+int mpMontRR(u32 rr[], u32 m[], size_t ndigits)
+	/* Computes rr = R^2 mod m, R = 2^(BITS_PER_DIGIT * ndigits) */
+{
+	u32 t[MAX_FIXED_DIGITS * 2];
+	u32 r[MAX_FIXED_DIGITS];
+
+	assert(ndigits != 0 && ndigits <= MAX_FIXED_DIGITS);
+
+	/* r = R mod m */
+	mpSetZero(t, ndigits + 1);
+	t[ndigits] = 1;
+	mpModulo(r, t, ndigits + 1, m, ndigits);
+
+	/* rr = (R mod m)^2 mod m */
+	mpSquare(t, r, ndigits);
+	mpModulo(rr, t, ndigits * 2, m, ndigits);
+
+	mpSetZero(t, ndigits * 2);
+	mpSetZero(r, ndigits);
+
+	return 0;
+}
+
+int mpMontExp(u32 y[], const u32 x[], const u32 e[], const u32 m[],
+	const u32 rr[], u32 minv, size_t ndigits)
+	/* Computes y = x^e mod m for odd m with precomputed rr = R^2 mod m and
+	   minv = mpMontInv(m[0]). Not constant-time. */
+{
+	u32 g1[MAX_FIXED_DIGITS];
+
+	assert(ndigits != 0 && ndigits <= MAX_FIXED_DIGITS);
+
+	if (mpIsZero(e, ndigits))
+	{	/* x^0 = 1 */
+		mpSetDigit(y, 1, ndigits);
+		return 0;
+	}
+
+	/* g1 = x * R mod m. The product is below 2m for any x < R */
+	mpMontMult(g1, x, rr, m, minv, ndigits);
+	mpMontExp_1(y, g1, e, m, minv, ndigits);
+
+	mpSetZero(g1, ndigits);
+
+	return 0;
+}
+
+#ifndef MP_NO_MONT_EXP
+static int mpModExp_mont(u32 yout[], const u32 x[], const u32 e[], u32 m[], size_t ndigits)
+	/* Computes y = x^e mod m for odd m on Montgomery residues */
+{
+	u32 t[MAX_FIXED_DIGITS * 2];
+	u32 g1[MAX_FIXED_DIGITS];
+
+	assert(ndigits != 0 && ndigits <= MAX_FIXED_DIGITS);
+
+	if (mpIsZero(e, ndigits))
+	{	/* x^0 = 1 */
+		mpSetDigit(yout, 1, ndigits);
+		return 0;
+	}
+
+	/* g1 = x * R mod m */
+	mpSetZero(t, ndigits);
+	mpSetEqual(t + ndigits, x, ndigits);
+	mpModulo(g1, t, ndigits * 2, m, ndigits);
+
+	mpMontExp_1(yout, g1, e, m, mpMontInv(m[0]), ndigits);
+
+	mpSetZero(t, ndigits * 2);
+	mpSetZero(g1, ndigits);
+
+	return 0;
+}
+#endif
+
+#endif /* NO_ALLOCS */
+
 /**	Computes y = x^e mod m in constant time using Coron's algorithm */
 int mpModExp_ct(u32 yout[], const u32 x[], const u32 e[], u32 m[], size_t ndigits)
 {
@@ -2672,19 +3184,6 @@ and e_l = 1, and do the following:
 4. Return(A).
 */
 
-/*
-Optimal values of k for various exponent sizes.
-	The references on this differ in their recommendations.
-	These values reflect experiments we've done on our systems.
-	You can adjust this to suit your own situation.
-*/
-static size_t WindowLenTable[] =
-{
-/* k=1   2   3   4    5     6     7     8 */
-     5, 16, 64, 240, 768, 1024, 2048, 4096
-};
-#define WINLENTBLMAX (sizeof(WindowLenTable)/sizeof(WindowLenTable[0]))
-
 /*	The process used here to read bits into the lookahead buffer could be improved slightly as
 	some bits are read in more than once. But we think this function is tricky enough without
 	adding more complexity for marginal benefit.
@@ -204,6 +204,34 @@ int mpModExp(u32 y[], const u32 x[], const u32 e[], u32 m[], size_t ndigits);
  */
 int mpModExp_ct(u32 yout[], const u32 x[], const u32 e[], u32 m[], size_t ndigits);
 
+/** Returns -m0^{-1} mod 2^32, the Montgomery constant for an odd modulus
+ *  with least significant digit `m0`
+ */
+u32 mpMontInv(u32 m0);
+
+/** Computes w = x * y * R^{-1} mod m with R = 2^(32 * ndigits)
+ *  @param minv Montgomery constant from mpMontInv(m[0])
+ *  @pre m is odd and x, y < m. `w` may be the same as `x` or `y`.
+ *  @remark Not constant-time.
+ */
+void mpMontMult(u32 w[], const u32 x[], const u32 y[], const u32 m[], u32 minv, size_t ndigits);
+
+#ifdef NO_ALLOCS
+/** Computes rr = R^2 mod m with R = 2^(32 * ndigits), the conversion
+ *  constant for mpMontExp()
+ */
+int mpMontRR(u32 rr[], u32 m[], size_t ndigits);
+
+/** Computes y = x^e mod m for odd m with a precomputed Montgomery context
+ *  @param rr R^2 mod m from mpMontRR()
+ *  @param minv Montgomery constant from mpMontInv(m[0])
+ *  @remark Saves the per-call setup of mpModExp() when many exponentiations
+ *  use the same modulus. Not constant-time.
+ */
+int mpMontExp(u32 y[], const u32 x[], const u32 e[], const u32 m[],
+	const u32 rr[], u32 minv, size_t ndigits);
+#endif
+
 /** Computes a = (x * y) mod m */
 int mpModMult(u32 a[], const u32 x[], const u32 y[], u32 m[], size_t ndigits);
 
@@ -78,58 +78,112 @@
 * @param	HashedData is the output of this function.
 *
 * @return	- XST_SUCCESS if no errors occured
-*			- XST_FAILURE if the datasize execeeds the size of the local buffer.
+*			- XST_FAILURE if the data size or key size is negative.
 *
-* @note		None.
+* @note		When the same key is used more than once, use
+*		XHdcp22Cmn_HmacSha256Init and XHdcp22Cmn_HmacSha256Compute
+*		instead, so the padded key is hashed only once.
 *
 ******************************************************************************/
 int XHdcp22Cmn_HmacSha256Hash(const u8 *Data, int DataSize, const u8 *Key, int KeySize, u8  *HashedData)
 {
-	u8 Ipad[65];   /* inner padding-key XORd with ipad */
-	u8 Opad[65];   /* outer padding-key XORd with opad */
-	u8 Ktemp[SHA256_SIZE];
-	u8 Ktemp2[SHA256_SIZE];
-	u8 BufferIn[256];
-	u8 BufferOut[256];
-	int i;
+	XHdcp22_HmacSha256Ctx Ctx;
 
-	memset(BufferIn, 0x00, 256);
-	memset(BufferOut, 0x00, 256);
-
-	/* If the input size exceeds the local buffers, return an error */
-	if(DataSize + 64 >  256) {
+	if(DataSize < 0 || KeySize < 0) {
 		return XST_FAILURE;
 	}
 
+	XHdcp22Cmn_HmacSha256Init(&Ctx, Key, KeySize);
+	XHdcp22Cmn_HmacSha256Compute(&Ctx, Data, DataSize, HashedData);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function prepares a HMAC_SHA256 key. The blocks K XOR ipad and
+* K XOR opad are hashed and the resulting states are kept in the context.
+*
+* @param	Ctx is the HMAC context to initialize.
+* @param	Key is the hash-key to use.
+* @param	KeySize is the size of the hash key.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XHdcp22Cmn_HmacSha256Init(XHdcp22_HmacSha256Ctx *Ctx, const u8 *Key, int KeySize)
+{
+	XHdcp22_Sha256Ctx Sha;
+	u8 Ktemp[SHA256_SIZE];
+	u8 Pad[64];
+	int i;
+
 	/* If key is longer than 64 bytes reset it to Key=sha256(Key) */
 	if(KeySize > 64) {
-		XHdcp22Cmn_Sha256Hash(Key, KeySize, Ktemp );
+		XHdcp22Cmn_Sha256Hash(Key, KeySize, Ktemp);
 		Key     = Ktemp;
 		KeySize = SHA256_SIZE;
 	}
 
-	/* start out by storing Key in pads */
-	memset(Ipad, 0, sizeof Ipad );
-	memset(Opad, 0, sizeof Opad );
-	memcpy(Ipad, Key, KeySize );
-	memcpy(Opad, Key, KeySize );
-
-	/* XOR Key with Ipad and Opad values */
+	/* Inner padded key */
+	memset(Pad, 0, sizeof Pad);
+	memcpy(Pad, Key, KeySize);
 	for(i = 0; i < 64; i++) {
-		Ipad[i] ^= 0x36;
-		Opad[i] ^= 0x5c;
+		Pad[i] ^= 0x36;
 	}
+	XHdcp22Cmn_Sha256Init(&Sha);
+	XHdcp22Cmn_Sha256Update(&Sha, Pad, sizeof Pad);
+	memcpy(Ctx->Inner, Sha.State, sizeof Ctx->Inner);
 
-	/* Execute inner SHA256 */
-	memcpy(BufferIn, Ipad, 64 );
-	memcpy(BufferIn + 64, Data, DataSize );
-	XHdcp22Cmn_Sha256Hash(BufferIn, 64 + DataSize, Ktemp2 );
+	/* Outer padded key, 0x36 ^ 0x5c flips ipad to opad */
+	for(i = 0; i < 64; i++) {
+		Pad[i] ^= 0x36 ^ 0x5c;
+	}
+	XHdcp22Cmn_Sha256Init(&Sha);
+	XHdcp22Cmn_Sha256Update(&Sha, Pad, sizeof Pad);
+	memcpy(Ctx->Outer, Sha.State, sizeof Ctx->Outer);
 
-	/* Execute outer SHA256 */
-	memcpy(BufferOut, Opad, 64);
-	memcpy(BufferOut + 64, Ktemp2, SHA256_SIZE );
-	XHdcp22Cmn_Sha256Hash(BufferOut, 64 + SHA256_SIZE,
-						(u8 *)HashedData );
+	memset(Pad, 0, sizeof Pad);
+}
 
-	return XST_SUCCESS;
+/*****************************************************************************/
+/**
+*
+* This function computes a HMAC_SHA256 with a key prepared by
+* XHdcp22Cmn_HmacSha256Init. The context is not modified and can be used
+* any number of times.
+*
+* @param	Ctx is the HMAC context holding the key.
+* @param	Data is the input data.
+* @param	DataSize is the size of the data buffer.
+* @param	HashedData is the output of this function.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XHdcp22Cmn_HmacSha256Compute(const XHdcp22_HmacSha256Ctx *Ctx, const u8 *Data, u32 DataSize, u8 *HashedData)
+{
+	XHdcp22_Sha256Ctx Sha;
+	u8 Inner[SHA256_SIZE];
+
+	/* Execute inner SHA256, continuing after the ipad block */
+	memcpy(Sha.State, Ctx->Inner, sizeof Sha.State);
+	Sha.BitLen[0] = 512;
+	Sha.BitLen[1] = 0;
+	Sha.DataLen = 0;
+	XHdcp22Cmn_Sha256Update(&Sha, Data, DataSize);
+	XHdcp22Cmn_Sha256Final(&Sha, Inner);
+
+	/* Execute outer SHA256, continuing after the opad block */
+	memcpy(Sha.State, Ctx->Outer, sizeof Sha.State);
+	Sha.BitLen[0] = 512;
+	Sha.BitLen[1] = 0;
+	Sha.DataLen = 0;
+	XHdcp22Cmn_Sha256Update(&Sha, Inner, SHA256_SIZE);
+	XHdcp22Cmn_Sha256Final(&Sha, HashedData);
 }
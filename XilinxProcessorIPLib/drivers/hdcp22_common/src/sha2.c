@@ -44,28 +44,37 @@
 /***************************** Include Files ********************************/
 #include "string.h"
 #include "xil_types.h"
+#include "xhdcp22_common.h"
 
 /**************************** Type Definitions ******************************/
-typedef struct {
-   u8 data[64];
-   u32 datalen;
-   u32 bitlen[2];
-   u32 state[8];
-} Sha256Type;
 
 /***************** Macros (Inline Functions) Definitions ********************/
 // DBL_INT_ADD treats two unsigned ints a and b as one 64-bit integer and adds c to it
-#define DBL_INT_ADD(a,b,c) if (a > 0xffffffff - (c)) ++b; a += c;
+#define DBL_INT_ADD(a,b,c) do { if (a > 0xffffffff - (c)) ++b; a += c; } while (0)
 #define ROTLEFT(a,b) (((a) << (b)) | ((a) >> (32-(b))))
 #define ROTRIGHT(a,b) (((a) >> (b)) | ((a) << (32-(b))))
 
-#define CH(x,y,z) (((x) & (y)) ^ (~(x) & (z)))
-#define MAJ(x,y,z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define CH(x,y,z) ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x,y,z) (((x) & (y)) | ((z) & ((x) | (y))))
 #define EP0(x) (ROTRIGHT(x,2) ^ ROTRIGHT(x,13) ^ ROTRIGHT(x,22))
 #define EP1(x) (ROTRIGHT(x,6) ^ ROTRIGHT(x,11) ^ ROTRIGHT(x,25))
 #define SIG0(x) (ROTRIGHT(x,7) ^ ROTRIGHT(x,18) ^ ((x) >> 3))
 #define SIG1(x) (ROTRIGHT(x,17) ^ ROTRIGHT(x,19) ^ ((x) >> 10))
 
+// Message schedule word i >= 16, computed in place in a 16 word window
+#define SCHED(m,i) (m[(i) & 15] += SIG1(m[((i) - 2) & 15]) + m[((i) - 7) & 15] + \
+                                   SIG0(m[((i) - 15) & 15]))
+
+// One round. Instead of moving the working variables, the caller rotates
+// the arguments, so only d and h are written.
+#define ROUND(a,b,c,d,e,f,g,h,ki,mi) do { \
+      u32 t1_ = (h) + EP1(e) + CH(e,f,g) + (ki) + (mi); \
+      (d) += t1_; \
+      (h) = t1_ + EP0(a) + MAJ(a,b,c); \
+   } while (0)
+
+#define SHA256_BLOCK_SIZE 64
+
 /************************** Variable Definitions ****************************/
 static const u32 k[64] = {
    0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
@@ -81,10 +90,7 @@ static const u32 k[64] = {
 /************************** Function Prototypes *****************************/
 
 /* SHA-256 Hashing */
-static void Sha256Transform(Sha256Type *Ctx, u8 *Data);
-static void Sha256Init(Sha256Type *Ctx);
-static void Sha256Update(Sha256Type *Ctx, const u8 *Data, u32 Len);
-static void Sha256Final(Sha256Type *Ctx, u8 *Hash);
+static void Sha256Transform(u32 *State, const u8 *Data, u32 NumBlocks);
 
 /************************** Function Implementation *****************************/
 
@@ -104,65 +110,89 @@ static void Sha256Final(Sha256Type *Ctx, u8 *Hash);
 ******************************************************************************/
 void XHdcp22Cmn_Sha256Hash(const u8 *Data, u32 DataSize, u8 *HashedData)
 {
-	Sha256Type Ctx;
+	XHdcp22_Sha256Ctx Ctx;
 
-	Sha256Init(&Ctx);
+	XHdcp22Cmn_Sha256Init(&Ctx);
 
-	Sha256Update(&Ctx, Data, DataSize);
-	Sha256Final(&Ctx, HashedData);
+	XHdcp22Cmn_Sha256Update(&Ctx, Data, DataSize);
+	XHdcp22Cmn_Sha256Final(&Ctx, HashedData);
 }
 
 /*****************************************************************************/
 /**
-* This function executes a SHA256 transformation.
+* This function executes the SHA256 compression function on a number of
+* consecutive 64 byte blocks.
 *
-* @param  Ctx is the context data for SHA256.
-* @param  Data is the data to transform.
+* @param  State is the intermediate hash value that is updated.
+* @param  Data is the data to transform, NumBlocks * 64 bytes.
+* @param  NumBlocks is the number of blocks.
 *
 * @return None.
 *
-* @note   None.
+* @note   The message schedule is kept in a 16 word window. Word aligned
+*         input is loaded a word at a time.
 *
 ******************************************************************************/
-static void Sha256Transform(Sha256Type *Ctx, u8 *Data)
+static void Sha256Transform(u32 *State, const u8 *Data, u32 NumBlocks)
 {
-   u32 a,b,c,d,e,f,g,h,i,j,t1,t2,m[64];
+   u32 a,b,c,d,e,f,g,h,i,m[16];
 
-   for (i=0,j=0; i < 16; ++i, j += 4)
-      m[i] = (Data[j] << 24) | (Data[j+1] << 16) | (Data[j+2] << 8) | (Data[j+3]);
-   for ( ; i < 64; ++i)
-      m[i] = SIG1(m[i-2]) + m[i-7] + SIG0(m[i-15]) + m[i-16];
+   for ( ; NumBlocks > 0; NumBlocks--, Data += SHA256_BLOCK_SIZE) {
+#if defined(__GNUC__) && defined(__BYTE_ORDER__)
+      if (((UINTPTR)Data & 3) == 0) {
+         memcpy(m, __builtin_assume_aligned(Data, 4), sizeof(m));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+         for (i = 0; i < 16; ++i)
+            m[i] = __builtin_bswap32(m[i]);
+#endif
+      }
+      else
+#endif
+      {
+         for (i = 0; i < 16; ++i)
+            m[i] = ((u32)Data[4*i] << 24) | ((u32)Data[4*i+1] << 16) |
+                   ((u32)Data[4*i+2] << 8) | ((u32)Data[4*i+3]);
+      }
 
-   a = Ctx->state[0];
-   b = Ctx->state[1];
-   c = Ctx->state[2];
-   d = Ctx->state[3];
-   e = Ctx->state[4];
-   f = Ctx->state[5];
-   g = Ctx->state[6];
-   h = Ctx->state[7];
+      a = State[0];
+      b = State[1];
+      c = State[2];
+      d = State[3];
+      e = State[4];
+      f = State[5];
+      g = State[6];
+      h = State[7];
 
-   for (i = 0; i < 64; ++i) {
-      t1 = h + EP1(e) + CH(e,f,g) + k[i] + m[i];
-      t2 = EP0(a) + MAJ(a,b,c);
-      h = g;
-      g = f;
-      f = e;
-      e = d + t1;
-      d = c;
-      c = b;
-      b = a;
-      a = t1 + t2;
-   }
+      for (i = 0; i < 16; i += 8) {
+         ROUND(a,b,c,d,e,f,g,h,k[i],  m[i]);
+         ROUND(h,a,b,c,d,e,f,g,k[i+1],m[i+1]);
+         ROUND(g,h,a,b,c,d,e,f,k[i+2],m[i+2]);
+         ROUND(f,g,h,a,b,c,d,e,k[i+3],m[i+3]);
+         ROUND(e,f,g,h,a,b,c,d,k[i+4],m[i+4]);
+         ROUND(d,e,f,g,h,a,b,c,k[i+5],m[i+5]);
+         ROUND(c,d,e,f,g,h,a,b,k[i+6],m[i+6]);
+         ROUND(b,c,d,e,f,g,h,a,k[i+7],m[i+7]);
+      }
+      for ( ; i < 64; i += 8) {
+         ROUND(a,b,c,d,e,f,g,h,k[i],  SCHED(m,i));
+         ROUND(h,a,b,c,d,e,f,g,k[i+1],SCHED(m,i+1));
+         ROUND(g,h,a,b,c,d,e,f,k[i+2],SCHED(m,i+2));
+         ROUND(f,g,h,a,b,c,d,e,k[i+3],SCHED(m,i+3));
+         ROUND(e,f,g,h,a,b,c,d,k[i+4],SCHED(m,i+4));
+         ROUND(d,e,f,g,h,a,b,c,k[i+5],SCHED(m,i+5));
+         ROUND(c,d,e,f,g,h,a,b,k[i+6],SCHED(m,i+6));
+         ROUND(b,c,d,e,f,g,h,a,k[i+7],SCHED(m,i+7));
+      }
 
-   Ctx->state[0] += a;
-   Ctx->state[1] += b;
-   Ctx->state[2] += c;
-   Ctx->state[3] += d;
-   Ctx->state[4] += e;
-   Ctx->state[5] += f;
-   Ctx->state[6] += g;
-   Ctx->state[7] += h;
+      State[0] += a;
+      State[1] += b;
+      State[2] += c;
+      State[3] += d;
+      State[4] += e;
+      State[5] += f;
+      State[6] += g;
+      State[7] += h;
+   }
 }
 
 /*****************************************************************************/
@@ -176,25 +206,26 @@ static void Sha256Transform(Sha256Type *Ctx, u8 *Data)
 * @note   None.
 *
 ******************************************************************************/
-static void Sha256Init(Sha256Type *Ctx)
+void XHdcp22Cmn_Sha256Init(XHdcp22_Sha256Ctx *Ctx)
 {
-   Ctx->datalen = 0;
-   Ctx->bitlen[0] = 0;
-   Ctx->bitlen[1] = 0;
-   Ctx->state[0] = 0x6a09e667;
-   Ctx->state[1] = 0xbb67ae85;
-   Ctx->state[2] = 0x3c6ef372;
-   Ctx->state[3] = 0xa54ff53a;
-   Ctx->state[4] = 0x510e527f;
-   Ctx->state[5] = 0x9b05688c;
-   Ctx->state[6] = 0x1f83d9ab;
-   Ctx->state[7] = 0x5be0cd19;
+   Ctx->DataLen = 0;
+   Ctx->BitLen[0] = 0;
+   Ctx->BitLen[1] = 0;
+   Ctx->State[0] = 0x6a09e667;
+   Ctx->State[1] = 0xbb67ae85;
+   Ctx->State[2] = 0x3c6ef372;
+   Ctx->State[3] = 0xa54ff53a;
+   Ctx->State[4] = 0x510e527f;
+   Ctx->State[5] = 0x9b05688c;
+   Ctx->State[6] = 0x1f83d9ab;
+   Ctx->State[7] = 0x5be0cd19;
 }
 
 /*****************************************************************************/
 /**
 *
-* This function updates the SHA data before adding padding data.
+* This function adds data to a SHA256 hash calculation. It can be called any
+* number of times between XHdcp22Cmn_Sha256Init and XHdcp22Cmn_Sha256Final.
 *
 * @param  Ctx is the context data for SHA256.
 * @param  Data is the input data.
@@ -202,28 +233,48 @@ static void Sha256Init(Sha256Type *Ctx)
 *
 * @return None.
 *
-* @note   None.
+* @note   Whole blocks are compressed straight from Data, only the bytes
+*         of a partial block are copied to the context.
 *
 ******************************************************************************/
-static void Sha256Update(Sha256Type *Ctx, const u8 *Data, u32 Len)
+void XHdcp22Cmn_Sha256Update(XHdcp22_Sha256Ctx *Ctx, const u8 *Data, u32 Len)
 {
-   u32 i;
+   u32 Fill, Blocks;
 
-   for (i=0; i < Len; ++i) {
-      Ctx->data[Ctx->datalen] = Data[i];
-      Ctx->datalen++;
-      if (Ctx->datalen == 64) {
-	  Sha256Transform(Ctx,Ctx->data);
-         DBL_INT_ADD(Ctx->bitlen[0],Ctx->bitlen[1],512);
-         Ctx->datalen = 0;
+   // Complete the partial block of the previous call.
+   if (Ctx->DataLen > 0) {
+      Fill = SHA256_BLOCK_SIZE - Ctx->DataLen;
+      if (Len < Fill) {
+         memcpy(&Ctx->Data[Ctx->DataLen], Data, Len);
+         Ctx->DataLen += Len;
+         return;
       }
+      memcpy(&Ctx->Data[Ctx->DataLen], Data, Fill);
+      Sha256Transform(Ctx->State, Ctx->Data, 1);
+      DBL_INT_ADD(Ctx->BitLen[0], Ctx->BitLen[1], 512);
+      Ctx->DataLen = 0;
+      Data += Fill;
+      Len -= Fill;
+   }
+
+   Blocks = Len / SHA256_BLOCK_SIZE;
+   if (Blocks > 0) {
+      Sha256Transform(Ctx->State, Data, Blocks);
+      Ctx->BitLen[1] += Blocks >> 23;
+      DBL_INT_ADD(Ctx->BitLen[0], Ctx->BitLen[1], Blocks << 9);
+      Data += Blocks * SHA256_BLOCK_SIZE;
+      Len -= Blocks * SHA256_BLOCK_SIZE;
    }
+
+   memcpy(Ctx->Data, Data, Len);
+   Ctx->DataLen = Len;
 }
 
 /*****************************************************************************/
 /**
 *
-* This function adds padding
+* This function adds padding and returns the hash. The context must be
+* initialized again before it is reused.
 *
 * @param  Ctx is the context data for SHA256.
 * @param  Hash is the calculated hash (256-bits).
@@ -233,48 +284,48 @@ static void Sha256Update(Sha256Type *Ctx, const u8 *Data, u32 Len)
 * @note   None.
 *
 ******************************************************************************/
-static void Sha256Final(Sha256Type *Ctx, u8 *Hash)
+void XHdcp22Cmn_Sha256Final(XHdcp22_Sha256Ctx *Ctx, u8 *Hash)
 {
    u32 i;
 
-   i = Ctx->datalen;
+   i = Ctx->DataLen;
 
    // Pad whatever data is left in the buffer.
-   if (Ctx->datalen < 56) {
-      Ctx->data[i++] = 0x80;
+   if (Ctx->DataLen < 56) {
+      Ctx->Data[i++] = 0x80;
       while (i < 56)
-         Ctx->data[i++] = 0x00;
+         Ctx->Data[i++] = 0x00;
    }
    else {
-      Ctx->data[i++] = 0x80;
+      Ctx->Data[i++] = 0x80;
       while (i < 64)
-         Ctx->data[i++] = 0x00;
-      Sha256Transform(Ctx,Ctx->data);
-      memset(Ctx->data,0,56);
+         Ctx->Data[i++] = 0x00;
+      Sha256Transform(Ctx->State, Ctx->Data, 1);
+      memset(Ctx->Data,0,56);
    }
 
    // Append to the padding the total message's length in bits and transform.
-   DBL_INT_ADD(Ctx->bitlen[0],Ctx->bitlen[1],Ctx->datalen * 8);
-   Ctx->data[63] = Ctx->bitlen[0];
-   Ctx->data[62] = Ctx->bitlen[0] >> 8;
-   Ctx->data[61] = Ctx->bitlen[0] >> 16;
-   Ctx->data[60] = Ctx->bitlen[0] >> 24;
-   Ctx->data[59] = Ctx->bitlen[1];
-   Ctx->data[58] = Ctx->bitlen[1] >> 8;
-   Ctx->data[57] = Ctx->bitlen[1] >> 16;
-   Ctx->data[56] = Ctx->bitlen[1] >> 24;
-   Sha256Transform(Ctx,Ctx->data);
+   DBL_INT_ADD(Ctx->BitLen[0],Ctx->BitLen[1],Ctx->DataLen * 8);
+   Ctx->Data[63] = Ctx->BitLen[0];
+   Ctx->Data[62] = Ctx->BitLen[0] >> 8;
+   Ctx->Data[61] = Ctx->BitLen[0] >> 16;
+   Ctx->Data[60] = Ctx->BitLen[0] >> 24;
+   Ctx->Data[59] = Ctx->BitLen[1];
+   Ctx->Data[58] = Ctx->BitLen[1] >> 8;
+   Ctx->Data[57] = Ctx->BitLen[1] >> 16;
+   Ctx->Data[56] = Ctx->BitLen[1] >> 24;
+   Sha256Transform(Ctx->State, Ctx->Data, 1);
 
    // Since this implementation uses little endian byte ordering and SHA uses big endian,
    // reverse all the bytes when copying the final state to the output hash.
    for (i=0; i < 4; ++i) {
-      Hash[i]    = (Ctx->state[0] >> (24-i*8)) & 0x000000ff;
-      Hash[i+4]  = (Ctx->state[1] >> (24-i*8)) & 0x000000ff;
-      Hash[i+8]  = (Ctx->state[2] >> (24-i*8)) & 0x000000ff;
-      Hash[i+12] = (Ctx->state[3] >> (24-i*8)) & 0x000000ff;
-      Hash[i+16] = (Ctx->state[4] >> (24-i*8)) & 0x000000ff;
-      Hash[i+20] = (Ctx->state[5] >> (24-i*8)) & 0x000000ff;
-      Hash[i+24] = (Ctx->state[6] >> (24-i*8)) & 0x000000ff;
-      Hash[i+28] = (Ctx->state[7] >> (24-i*8)) & 0x000000ff;
+      Hash[i]    = (Ctx->State[0] >> (24-i*8)) & 0x000000ff;
+      Hash[i+4]  = (Ctx->State[1] >> (24-i*8)) & 0x000000ff;
+      Hash[i+8]  = (Ctx->State[2] >> (24-i*8)) & 0x000000ff;
+      Hash[i+12] = (Ctx->State[3] >> (24-i*8)) & 0x000000ff;
+      Hash[i+16] = (Ctx->State[4] >> (24-i*8)) & 0x000000ff;
+      Hash[i+20] = (Ctx->State[5] >> (24-i*8)) & 0x000000ff;
+      Hash[i+24] = (Ctx->State[6] >> (24-i*8)) & 0x000000ff;
+      Hash[i+28] = (Ctx->State[7] >> (24-i*8)) & 0x000000ff;
    }
 }
@@ -56,6 +56,24 @@ extern "C" {
 /************************** Constant Definitions ****************************/
 
 /**************************** Type Definitions ******************************/
+/**
+* This typedef contains the state of a SHA256 hash calculation.
+*/
+typedef struct {
+	u32 State[8];     /**< Intermediate hash value */
+	u32 BitLen[2];    /**< Number of bits hashed, low word first */
+	u32 DataLen;      /**< Number of bytes in Data */
+	u8  Data[64];     /**< Partial block not yet hashed */
+} XHdcp22_Sha256Ctx;
+
+/**
+* This typedef contains a HMAC-SHA256 key. It holds the SHA256 state after
+* the inner and outer padded key blocks, so these are hashed only once per key.
+*/
+typedef struct {
+	u32 Inner[8];     /**< State after hashing K XOR ipad */
+	u32 Outer[8];     /**< State after hashing K XOR opad */
+} XHdcp22_HmacSha256Ctx;
 
 /***************** Macros (Inline Functions) Definitions ********************/
 
@@ -64,8 +82,15 @@ extern "C" {
 /* Cryptographic functions */
 void XHdcp22Cmn_Sha256Hash(const u8 *Data, u32 DataSize, u8 *HashedData);
 int  XHdcp22Cmn_HmacSha256Hash(const u8 *Data, int DataSize, const u8 *Key, int KeySize, u8  *HashedData);
+void XHdcp22Cmn_Sha256Init(XHdcp22_Sha256Ctx *Ctx);
+void XHdcp22Cmn_Sha256Update(XHdcp22_Sha256Ctx *Ctx, const u8 *Data, u32 DataSize);
+void XHdcp22Cmn_Sha256Final(XHdcp22_Sha256Ctx *Ctx, u8 *HashedData);
+void XHdcp22Cmn_HmacSha256Init(XHdcp22_HmacSha256Ctx *Ctx, const u8 *Key, int KeySize);
+void XHdcp22Cmn_HmacSha256Compute(const XHdcp22_HmacSha256Ctx *Ctx, const u8 *Data, u32 DataSize, u8 *HashedData);
 void XHdcp22Cmn_Aes128Encrypt(const u8 *Data, const u8 *Key, u8 *Output);
 void XHdcp22Cmn_Aes128Decrypt(const u8 *Data, const u8 *Key, u8 *Output);
+void XHdcp22Cmn_Aes128EncryptBlocks(const u8 *Data, u32 NumBlocks, const u8 *Key, u8 *Output);
+void XHdcp22Cmn_Aes128Ctr(const u8 *Data, u32 Size, const u8 *Key, const u8 *Iv, u8 *Output);
 
 #ifdef __cplusplus
 }
@@ -1765,6 +1765,7 @@ static void XHdcp22Rx_ResetParams(XHdcp22_Rx *InstancePtr)
 	memset(InstancePtr->Params.SeqNumM,      0, sizeof(InstancePtr->Params.SeqNumM));
 	memset(InstancePtr->Params.StreamIdType, 0, sizeof(InstancePtr->Params.StreamIdType));
 	memset(InstancePtr->Params.MPrime,       0, sizeof(InstancePtr->Params.MPrime));
+	memset(&InstancePtr->Params.KdCache,     0, sizeof(InstancePtr->Params.KdCache));
 }
 
 /*****************************************************************************/
@@ -3118,7 +3119,7 @@ static int XHdcp22Rx_SendMessageAKESendHPrime(XHdcp22_Rx *InstancePtr)
 
 	/* Compute H Prime */
 	XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_HPRIME);
-	XHdcp22Rx_ComputeHPrime(InstancePtr->Params.Rrx, InstancePtr->Params.RxCaps,
+	XHdcp22Rx_ComputeHPrime(InstancePtr, InstancePtr->Params.Rrx, InstancePtr->Params.RxCaps,
 			InstancePtr->Params.Rtx, InstancePtr->Params.TxCaps, InstancePtr->Params.Km,
 			MsgPtr->AKESendHPrime.HPrime);
 	XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_HPRIME_DONE);
@@ -3274,7 +3275,7 @@ static int XHdcp22Rx_SendMessageLCSendLPrime(XHdcp22_Rx *InstancePtr)
 
 	/* Compute LPrime */
 	XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_LPRIME);
-	XHdcp22Rx_ComputeLPrime(InstancePtr->Params.Rn, InstancePtr->Params.Km, InstancePtr->Params.Rrx,
+	XHdcp22Rx_ComputeLPrime(InstancePtr, InstancePtr->Params.Rn, InstancePtr->Params.Km, InstancePtr->Params.Rrx,
 		InstancePtr->Params.Rtx, MsgPtr->LCSendLPrime.LPrime);
 	XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_LPRIME_DONE);
 
@@ -3419,7 +3420,7 @@ static int XHdcp22Rx_SendMessageRepeaterAuthSendRxIdList(XHdcp22_Rx *InstancePtr
 
 		/* Compute VPrime */
 		XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_VPRIME);
-		XHdcp22Rx_ComputeVPrime((u8 *)InstancePtr->Topology.ReceiverIdList,
+		XHdcp22Rx_ComputeVPrime(InstancePtr, (u8 *)InstancePtr->Topology.ReceiverIdList,
 			InstancePtr->Topology.DeviceCnt,
 			MsgPtr->RepeaterAuthSendRxIdList.RxInfo,
 			MsgPtr->RepeaterAuthSendRxIdList.SeqNumV,
@@ -3591,7 +3592,7 @@ static int XHdcp22Rx_SendMessageRepeaterAuthStreamReady(XHdcp22_Rx *InstancePtr)
 
 	/* Compute MPrime */
 	XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_MPRIME);
-	XHdcp22Rx_ComputeMPrime(InstancePtr->Params.StreamIdType, InstancePtr->Params.SeqNumM,
+	XHdcp22Rx_ComputeMPrime(InstancePtr, InstancePtr->Params.StreamIdType, InstancePtr->Params.SeqNumM,
 		InstancePtr->Params.Km, InstancePtr->Params.Rrx, InstancePtr->Params.Rtx,
 		MsgPtr->RepeaterAuthStreamReady.MPrime);
 	XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_MPRIME_DONE);
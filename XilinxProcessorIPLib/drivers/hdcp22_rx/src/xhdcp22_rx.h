@@ -118,6 +118,7 @@ extern "C" {
 #include "xhdcp22_rng.h"
 #include "xhdcp22_mmult.h"
 #include "xhdcp22_cipher.h"
+#include "xhdcp22_common.h"
 
 /************************** Constant Definitions ****************************/
 #define XHDCP22_RX_MAX_MESSAGE_SIZE           534  /**< Maximum message size */
@@ -406,6 +407,26 @@ typedef struct
 	u8                    IsEncryptionStatusCallbackSet;
 } XHdcp22_Rx_Handles;
 
+/**
+ * This typedef caches the derived key Kd = dkey0 || dkey1 of a session and
+ * the HMAC keys made from it, so H', L', V' and M' do not derive Kd and
+ * hash the padded key again for every message. The cache is valid for the
+ * Km, Rrx and Rtx it was computed from.
+ */
+typedef struct
+{
+	u8 Km[16];
+	u8 Rrx[8];
+	u8 Rtx[8];
+	u8 Kd[32];
+	/** XHDCP22_RX_KDCACHE_* flags of the valid members */
+	u8 Flags;
+	/** HMAC key Kd, used for H' and V' */
+	XHdcp22_HmacSha256Ctx KdHmac;
+	/** HMAC key SHA256(Kd), used for M' */
+	XHdcp22_HmacSha256Ctx MHmac;
+} XHdcp22_Rx_KdCache;
+
 /**
  * This typedef is used to store temporary parameters for computations
  */
@@ -426,6 +447,7 @@ typedef struct
 	u8 SeqNumM[3];
 	u8 StreamIdType[2];
 	u8 MPrime[32];
+	XHdcp22_Rx_KdCache KdCache;
 } XHdcp22_Rx_Parameters;
 
 /**
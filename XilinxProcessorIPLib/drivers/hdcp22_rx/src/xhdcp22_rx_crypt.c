@@ -58,12 +58,19 @@
 #include "xhdcp22_common.h"
 
 /************************** Constant Definitions ****************************/
+#define XHDCP22_RX_KDCACHE_KD     0x01 /**< Kd is valid */
+#define XHDCP22_RX_KDCACHE_KDHMAC 0x02 /**< HMAC key Kd is valid */
+#define XHDCP22_RX_KDCACHE_MHMAC  0x04 /**< HMAC key SHA256(Kd) is valid */
 
 /**************************** Type Definitions ******************************/
 
 /***************** Macros (Inline Functions) Definitions ********************/
 #define XHdcp22Rx_MpSizeof(A) (sizeof(A)/sizeof(u32))
 
+/* Sliding window length of XHdcp22Rx_Pkcs1MontExp and size of its table */
+#define XHDCP22_RX_MONTEXP_WINDOW 4
+#define XHDCP22_RX_MONTEXP_TABLE  (1 << (XHDCP22_RX_MONTEXP_WINDOW - 1))
+
 /************************** Variable Definitions ****************************/
 
 /************************** Function Prototypes *****************************/
@@ -84,14 +91,17 @@ static void XHdcp22Rx_Pkcs1MontMultFios(XHdcp22_Rx *InstancePtr, u32 *U, u32 *A,
 #else
 static void XHdcp22Rx_Pkcs1MontMultFiosStub(u32 *U, u32 *A, u32 *B, u32 *N,
 	            const u32 *NPrime, int NDigits);
-static void XHdcp22Rx_Pkcs1MontMultAdd(u32 *A, u32 C, int SDigit, int NDigits);
 #endif
+static void XHdcp22Rx_Pkcs1MontMult(XHdcp22_Rx *InstancePtr, u32 *U, u32 *A,
+	            u32 *B, u32 *N, const u32 *NPrime, int NDigits);
 static int  XHdcp22Rx_Pkcs1MontExp(XHdcp22_Rx *InstancePtr, u32 *C, u32 *A, u32 *E,
 	            u32 *N, const u32 *NPrime, int NDigits);
 
 /* Functions for implementing other cryptographic tasks */
 static void XHdcp22Rx_ComputeDKey(const u8* Rrx, const u8* Rtx, const u8 *Km,
 	            const u8 *Rn, u8 *Ctr, u8 *DKey);
+static XHdcp22_Rx_KdCache *XHdcp22Rx_GetKd(XHdcp22_Rx *InstancePtr, const u8 *Km,
+	const u8 *Rrx, const u8 *Rtx);
 static void XHdcp22Rx_Xor(u8 *Cout, const u8 *Ain, const u8 *Bin, u32 Len);
 
 /*****************************************************************************/
@@ -664,65 +674,14 @@ static int XHdcp22Rx_Pkcs1EmeOaepDecode(u8 *EncodedMessage, u8 *Message, int *Me
 	return XST_SUCCESS;
 }
 
-#ifdef _XHDCP22_RX_SW_MMULT_
-/****************************************************************************/
-/**
-* This function performs a carry propagation adding C to the input
-* array A of size NDigits, given by the first argument starting from
-* the first element SDigit, and propagates it until no further carry
-* is generated.
-*
-* ADD(A[i],C)
-*
-* Reference:
-* Analyzing and Comparing Montgomery Multiplication Algorithms
-* IEEE Micro, 16(3):26-33,June 1996
-* By: Cetin Koc, Tolga Acar, and Burton Kaliski
-*
-* @param	A is an input array of size NDigits
-* @param	C is the value being added to the input A
-* @param	SDigit is the start digit
-* @param	NDigits is the integer precision of the arguments (A)
-*
-* @return	None.
-*
-* @note		None.
-*****************************************************************************/
-static void XHdcp22Rx_Pkcs1MontMultAdd(u32 *A, u32 C, int SDigit, int NDigits)
-{
-	/* Verify arguments */
-	Xil_AssertVoid(A != NULL);
-	Xil_AssertVoid(SDigit <= NDigits);
-
-	int i;
-
-	for(i=SDigit; i<NDigits; i++)
-	{
-		C = mpAdd(A+i, A+i, &C, 1);
-
-		if(C == 0)
-		{
-			return;
-		}
-	}
-}
-#endif
-
 #ifdef _XHDCP22_RX_SW_MMULT_
 /****************************************************************************/
 /**
 * This function implements the Montgomery Modular Multiplication (MMM)
-* Finely Integrated Operand Scanning (FIOS) algorithm. The FIOS method
-* interleaves multiplication and reduction operations. Requires NDigits+3
-* words of temporary storage.
+* in software for builds without the MMULT hardware.
 *
 * U = MontMult(A,B,N)
 *
-* Reference:
-* Analyzing and Comparing Montgomery Multiplication Algorithms
-* IEEE Micro, 16(3):26-33,June 1996
-* By: Cetin Koc, Tolga Acar, and Burton Kaliski
-*
 * @param	U is the MMM result
 * @param	A is the n-residue input, A' = A*R mod N
 * @param	B is the n-residue input, B' = B*R mod N
@@ -732,7 +691,8 @@ static void XHdcp22Rx_Pkcs1MontMultAdd(u32 *A, u32 C, int SDigit, int NDigits)
 *
 * @return	None.
 *
-* @note		None.
+* @note		Only the least significant word of NPrime is used, see
+*			mpMontMult in bigdigits.c.
 *****************************************************************************/
 static void XHdcp22Rx_Pkcs1MontMultFiosStub(u32 *U, u32 *A, u32 *B,
 	u32 *N, const u32 *NPrime, int NDigits)
@@ -745,69 +705,7 @@ static void XHdcp22Rx_Pkcs1MontMultFiosStub(u32 *U, u32 *A, u32 *B,
 	Xil_AssertVoid(NPrime != NULL);
 	Xil_AssertVoid(NDigits == 16);
 
-	int i, j;
-	u32 S, C, C1, C2, M[2], X[2];
-	u32 T[XHDCP22_RX_N_SIZE];
-
-	memset(T, 0, 4*(NDigits+3));
-
-	for(i=0; i<NDigits; i++)
-	{
-		// (C,S) = t[0] + a[0]*b[i], worst case 2 words
-		spMultiply(X, A[0], B[i]);	// X[Upper,Lower] = a[0]*b[i]
-		C = mpAdd(&S, T+0, X+0, 1);	// [C,S] = t[0] + X[Lower]
-		mpAdd(&C, &C, X+1, 1);		// [~,C] = C + X[Upper], No carry
-
-		// ADD(t[1],C)
-		XHdcp22Rx_Pkcs1MontMultAdd(T, C, 1, NDigits+3);
-
-		// m = S*n'[0] mod W, where W=2^32
-		// Note: X[Upper,Lower] = S*n'[0], m=X[Lower]
-		spMultiply(M, S, NPrime[0]);
-
-		// (C,S) = S + m*n[0], worst case 2 words
-		spMultiply(X, M[0], N[0]);	// X[Upper,Lower] = m*n[0]
-		C = mpAdd(&S, &S, X+0, 1);	// [C,S] = S + X[Lower]
-		mpAdd(&C, &C, X+1, 1);		// [~,C] = C + X[Upper]
-
-		for(j=1; j<NDigits; j++)
-		{
-			// (C,S) = t[j] + a[j]*b[i] + C, worst case 2 words
-			spMultiply(X, A[j], B[i]);	 	// X[Upper,Lower] = a[j]*b[i], double precision
-			C1 = mpAdd(&S, T+j, &C, 1);		// (C1,S) = t[j] + C
-			C2 = mpAdd(&S, &S, X+0, 1); 	// (C2,S) = S + X[Lower]
-			mpAdd(&C, &C1, X+1, 1);			// (~,C)  = C1 + X[Upper], doesn't produce carry
-			mpAdd(&C, &C, &C2, 1); 			// (~,C)  = C + C2, doesn't produce carry
-
-			// ADD(t[j+1],C)
-			XHdcp22Rx_Pkcs1MontMultAdd(T, C, j+1, NDigits+3);
-
-			// (C,S) = S + m*n[j]
-			spMultiply(X, M[0], N[j]);	// X[Upper,Lower] = m*n[j]
-			C = mpAdd(&S, &S, X+0, 1);	// [C,S] = S + X[Lower]
-			mpAdd(&C, &C, X+1, 1);		// [~,C] = C + X[Upper]
-
-			// t[j-1] = S
-			T[j-1] = S;
-		}
-
-		// (C,S) = t[s] + C
-		C = mpAdd(&S, T+NDigits, &C, 1);
-		// t[s-1] = S
-		T[NDigits-1] = S;
-		// t[s] = t[s+1] + C
-		mpAdd(T+NDigits, T+NDigits+1, &C, 1);
-		// t[s+1] = 0
-		T[NDigits+1] = 0;
-	}
-
-	/* Step 3: if(u>=n) return u-n else return u */
-	if(mpCompare(T, N, NDigits+3) >= 0)
-	{
-		mpSubtract(T, T, N, NDigits+3);
-	}
-
-	memcpy(U, T, 4*NDigits);
+	mpMontMult(U, A, B, N, NPrime[0], NDigits);
 }
 #endif
 
@@ -899,13 +797,51 @@ static void XHdcp22Rx_Pkcs1MontMultFios(XHdcp22_Rx *InstancePtr, u32 *U,
 }
 #endif
 
+/****************************************************************************/
+/**
+* This function runs one Montgomery multiplication on the MMULT hardware
+* or, for software builds, with XHdcp22Rx_Pkcs1MontMultFiosStub.
+*
+* U = MontMult(A,B,N)
+*
+* @param	InstancePtr is a pointer to the MMULT instance.
+* @param	U is the MMM result
+* @param	A is the n-residue input, A' = A*R mod N
+* @param	B is the n-residue input, B' = B*R mod N
+* @param	N is the modulus
+* @param	NPrime is a pre-computed constant, NPrime = (1-R*Rbar)/N
+* @param	NDigits is the integer precision of the arguments (C,A,B,N,NPrime)
+*
+* @return	None.
+*
+* @note		The hardware must have been set up with
+*			XHdcp22Rx_Pkcs1MontMultFiosInit for N.
+*****************************************************************************/
+static void XHdcp22Rx_Pkcs1MontMult(XHdcp22_Rx *InstancePtr, u32 *U, u32 *A,
+	u32 *B, u32 *N, const u32 *NPrime, int NDigits)
+{
+#ifndef _XHDCP22_RX_SW_MMULT_
+	/* N and NPrime are loaded by XHdcp22Rx_Pkcs1MontMultFiosInit */
+	(void)N;
+	(void)NPrime;
+	XHdcp22Rx_Pkcs1MontMultFios(InstancePtr, U, A, B, NDigits);
+#else
+	XHdcp22Rx_Pkcs1MontMultFiosStub(U, A, B, N, NPrime, NDigits);
+#endif
+}
+
 /****************************************************************************/
 /**
 * This function performs the modular exponentation operation using the
-* binary square and multiply method.
+* sliding window method on Montgomery residues. The odd powers
+* A^1, A^3, ..., A^(2^XHDCP22_RX_MONTEXP_WINDOW-1) are computed once and
+* every window of up to XHDCP22_RX_MONTEXP_WINDOW exponent bits then
+* costs a single multiplication.
 *
 * C = ModExp(A, E, N) = A^E*mod(N)
 *
+* Reference: Handbook of Applied Cryptography, Algorithm 14.85
+*
 * @param	C is result of the modular exponentiation
 * @param	A is the base
 * @param	E is the exponent
@@ -921,14 +857,16 @@ static void XHdcp22Rx_Pkcs1MontMultFios(XHdcp22_Rx *InstancePtr, u32 *U,
 static int XHdcp22Rx_Pkcs1MontExp(XHdcp22_Rx *InstancePtr, u32 *C, u32 *A,
 	u32 *E, u32 *N, const u32 *NPrime, int NDigits)
 {
-	int Offset;
+	int Offset, Low, Idx;
+	u32 Window;
 	u32 R[XHDCP22_RX_N_SIZE/4];
-	u32 Abar[XHDCP22_RX_N_SIZE/4];
 	u32 Xbar[XHDCP22_RX_N_SIZE/4];
+	u32 Abar[XHDCP22_RX_MONTEXP_TABLE][XHDCP22_RX_N_SIZE/4];
+	u8 IsOne = TRUE;
 
 	memset(R, 0, sizeof(R));
-	memset(Abar, 0, sizeof(Abar));
 	memset(Xbar, 0, sizeof(Xbar));
+	memset(Abar, 0, sizeof(Abar));
 
 #ifndef _XHDCP22_RX_SW_MMULT_
 	XHdcp22Rx_Pkcs1MontMultFiosInit(InstancePtr, N, NPrime, NDigits);
@@ -941,37 +879,67 @@ static int XHdcp22Rx_Pkcs1MontExp(XHdcp22_Rx *InstancePtr, u32 *C, u32 *A,
 	/* Step 1: Xbar = 1*R*mod(N) */
 	mpModulo(Xbar, R, XHDCP22_RX_N_SIZE/4, N, NDigits); // Optimization
 
-	/* Step 2: Abar = A*R*mod(N) */
-	mpModMult(Abar, A, Xbar, N, 2*NDigits);
+	/* Step 2: Abar[0] = A*R*mod(N), Abar[i] = A^(2i+1)*R*mod(N) */
+	mpModMult(Abar[0], A, Xbar, N, 2*NDigits);
+	XHdcp22Rx_Pkcs1MontMult(InstancePtr, R, Abar[0], Abar[0], N, NPrime, NDigits);
+	for(Idx=1; Idx<XHDCP22_RX_MONTEXP_TABLE; Idx++)
+	{
+		XHdcp22Rx_Pkcs1MontMult(InstancePtr, Abar[Idx], Abar[Idx-1], R, N, NPrime, NDigits);
+	}
 
-	/* Step 3: Binary square and multiply */
-	for(Offset=32*NDigits-1; Offset>=0; Offset--)
+	/* Step 3: Sliding window square and multiply */
+	Offset = mpBitLength(E, NDigits) - 1;
+	while(Offset >= 0)
 	{
-#ifndef _XHDCP22_RX_SW_MMULT_
-		XHdcp22Rx_Pkcs1MontMultFios(InstancePtr, Xbar, Xbar, Xbar, NDigits);
-#else
-		XHdcp22Rx_Pkcs1MontMultFiosStub(Xbar, Xbar, Xbar, N, NPrime, NDigits);
-#endif
+		if(mpGetBit(E, NDigits, Offset) == FALSE)
+		{
+			if(IsOne == FALSE)
+			{
+				XHdcp22Rx_Pkcs1MontMult(InstancePtr, Xbar, Xbar, Xbar, N, NPrime, NDigits);
+			}
+			Offset--;
+			continue;
+		}
 
-		if(mpGetBit(E, NDigits, Offset) == TRUE)
+		/* Longest window E[Offset:Low] ending in a set bit */
+		Low = Offset - XHDCP22_RX_MONTEXP_WINDOW + 1;
+		if(Low < 0)
 		{
-#ifndef _XHDCP22_RX_SW_MMULT_
-			XHdcp22Rx_Pkcs1MontMultFios(InstancePtr, Xbar, Xbar, Abar, NDigits);
-#else
-			XHdcp22Rx_Pkcs1MontMultFiosStub(Xbar, Xbar, Abar, N, NPrime, NDigits);
-#endif
+			Low = 0;
+		}
+		while(mpGetBit(E, NDigits, Low) == FALSE)
+		{
+			Low++;
+		}
+		Window = 0;
+		for(Idx=Offset; Idx>=Low; Idx--)
+		{
+			Window = (Window << 1) | mpGetBit(E, NDigits, Idx);
+		}
+
+		if(IsOne == TRUE)
+		{
+			memcpy(Xbar, Abar[Window >> 1], sizeof(Xbar));
+			IsOne = FALSE;
+		}
+		else
+		{
+			for(Idx=Offset; Idx>=Low; Idx--)
+			{
+				XHdcp22Rx_Pkcs1MontMult(InstancePtr, Xbar, Xbar, Xbar, N, NPrime, NDigits);
+			}
+			XHdcp22Rx_Pkcs1MontMult(InstancePtr, Xbar, Xbar, Abar[Window >> 1], N, NPrime, NDigits);
 		}
+		Offset = Low - 1;
 	}
 
 	/* Step 4: C=MonPro(Xbar,1) */
 	memset(R, 0, sizeof(R));
 	R[0] = 1;
+	XHdcp22Rx_Pkcs1MontMult(InstancePtr, C, Xbar, R, N, NPrime, NDigits);
 
-#ifndef _XHDCP22_RX_SW_MMULT_
-	XHdcp22Rx_Pkcs1MontMultFios(InstancePtr, C, Xbar, R, NDigits);
-#else
-	XHdcp22Rx_Pkcs1MontMultFiosStub(C, Xbar, R, N, NPrime, NDigits);
-#endif
+	/* Clear the powers of the secret base */
+	memset(Abar, 0, sizeof(Abar));
 
 	return XST_SUCCESS;
 }
@@ -1048,6 +1016,49 @@ static void XHdcp22Rx_ComputeDKey(const u8* Rrx, const u8* Rtx, const u8 *Km,
 	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, DKey);
 }
 
+/*****************************************************************************/
+/**
+* This function returns the derived key cache of the instance with
+* Kd = dkey0 || dkey1 valid for Km, Rrx and Rtx. Kd is only derived when
+* one of them has changed since the last call, which also drops the cached
+* HMAC keys.
+*
+* @param	InstancePtr is a pointer to the XHdcp22_Rx core instance.
+* @param	Km is the master key generated by tx.
+* @param	Rrx is the Rx random generated value.
+* @param	Rtx is the Tx random generated value.
+*
+* @return	Pointer to the derived key cache.
+*
+* @note		None.
+******************************************************************************/
+static XHdcp22_Rx_KdCache *XHdcp22Rx_GetKd(XHdcp22_Rx *InstancePtr, const u8 *Km,
+	const u8 *Rrx, const u8 *Rtx)
+{
+	XHdcp22_Rx_KdCache *Cache = &InstancePtr->Params.KdCache;
+	u8 Ctr[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
+
+	if((Cache->Flags & XHDCP22_RX_KDCACHE_KD) &&
+		memcmp(Cache->Km, Km, XHDCP22_RX_KM_SIZE) == 0 &&
+		memcmp(Cache->Rrx, Rrx, XHDCP22_RX_RRX_SIZE) == 0 &&
+		memcmp(Cache->Rtx, Rtx, XHDCP22_RX_RTX_SIZE) == 0)
+	{
+		return Cache;
+	}
+
+	/* Generate derived keys dkey0 and dkey1
+	   HashKey Kd = dkey0 || dkey1 */
+	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, NULL, Cache->Kd);
+	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, Ctr, Cache->Kd+XHDCP22_RX_AES_SIZE);
+
+	memcpy(Cache->Km, Km, XHDCP22_RX_KM_SIZE);
+	memcpy(Cache->Rrx, Rrx, XHDCP22_RX_RRX_SIZE);
+	memcpy(Cache->Rtx, Rtx, XHDCP22_RX_RTX_SIZE);
+	Cache->Flags = XHDCP22_RX_KDCACHE_KD;
+
+	return Cache;
+}
+
 /*****************************************************************************/
 /**
 * This function computes HPrime used during HDCP 2.2 authentication and key
@@ -1055,6 +1066,7 @@ static void XHdcp22Rx_ComputeDKey(const u8* Rrx, const u8* Rtx, const u8 *Km,
 *
 * Reference: HDCP v2.2, section 2.2
 *
+* @param	InstancePtr is a pointer to the XHdcp22_Rx core instance.
 * @param	Rrx is the Rx random generated value.
 * @param	RxCaps are the capabilities of the receiver.
 * @param	Rtx is the Tx random generated value.
@@ -1066,16 +1078,15 @@ static void XHdcp22Rx_ComputeDKey(const u8* Rrx, const u8* Rtx, const u8 *Km,
 *
 * @note		None.
 ******************************************************************************/
-void XHdcp22Rx_ComputeHPrime(const u8* Rrx, const u8 *RxCaps, const u8* Rtx,
-	const u8 *TxCaps, const u8 *Km, u8 *HPrime)
+void XHdcp22Rx_ComputeHPrime(XHdcp22_Rx *InstancePtr, const u8* Rrx, const u8 *RxCaps,
+	const u8* Rtx, const u8 *TxCaps, const u8 *Km, u8 *HPrime)
 {
 	u8 HashInput[XHDCP22_RX_RTX_SIZE + XHDCP22_RX_RXCAPS_SIZE + XHDCP22_RX_TXCAPS_SIZE];
 	int Idx = 0;
-	u8 Ctr[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
-	u8 Kd[2 * XHDCP22_RX_AES_SIZE]; /* dkey0 || dkey 1 */
-
+	XHdcp22_Rx_KdCache *Cache;
 
 	/* Verify arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
 	Xil_AssertVoid(Rrx != NULL);
 	Xil_AssertVoid(RxCaps != NULL);
 	Xil_AssertVoid(Rtx != NULL);
@@ -1083,10 +1094,13 @@ void XHdcp22Rx_ComputeHPrime(const u8* Rrx, const u8 *RxCaps, const u8* Rtx,
 	Xil_AssertVoid(Km != NULL);
 	Xil_AssertVoid(HPrime != NULL);
 
-	/* Generate derived keys dkey0 and dkey1
-	   HashKey Kd = dkey0 || dkey1 */
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, NULL, Kd);
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, Ctr, Kd+XHDCP22_RX_AES_SIZE);
+	/* HashKey Kd = dkey0 || dkey1 */
+	Cache = XHdcp22Rx_GetKd(InstancePtr, Km, Rrx, Rtx);
+	if(!(Cache->Flags & XHDCP22_RX_KDCACHE_KDHMAC))
+	{
+		XHdcp22Cmn_HmacSha256Init(&Cache->KdHmac, Cache->Kd, XHDCP22_RX_KD_SIZE);
+		Cache->Flags |= XHDCP22_RX_KDCACHE_KDHMAC;
+	}
 
 	/* HashInput = Rtx || RxCaps || TxCaps */
 	memcpy(HashInput, Rtx, XHDCP22_RX_RTX_SIZE);
@@ -1096,7 +1110,7 @@ void XHdcp22Rx_ComputeHPrime(const u8* Rrx, const u8 *RxCaps, const u8* Rtx,
 	memcpy(&HashInput[Idx], TxCaps, XHDCP22_RX_TXCAPS_SIZE);
 
 	/* Compute H' = HMAC-SHA256(HashInput, Kd) */
-	XHdcp22Cmn_HmacSha256Hash(HashInput, sizeof(HashInput), Kd, XHDCP22_RX_KD_SIZE, HPrime);
+	XHdcp22Cmn_HmacSha256Compute(&Cache->KdHmac, HashInput, sizeof(HashInput), HPrime);
 }
 
 /*****************************************************************************/
@@ -1139,6 +1153,7 @@ void XHdcp22Rx_ComputeEkh(const u8 *KprivRx, const u8 *Km, const u8 *M, u8 *Ekh)
 *
 * Reference: HDCP v2.2, section 2.3
 *
+* @param	InstancePtr is a pointer to the XHdcp22_Rx core instance.
 * @param	Rn is the 64-bit psuedo-random nonce generated by the transmitter.
 * @param	Km is the 128-bit master key generated by tx.
 * @param	Rrx is the 64-bit pseudo-random number generated by the receiver.
@@ -1149,23 +1164,22 @@ void XHdcp22Rx_ComputeEkh(const u8 *KprivRx, const u8 *Km, const u8 *M, u8 *Ekh)
 *
 * @note		None.
 ******************************************************************************/
-void XHdcp22Rx_ComputeLPrime(const u8 *Rn, const u8 *Km, const u8 *Rrx, const u8 *Rtx, u8 *LPrime)
+void XHdcp22Rx_ComputeLPrime(XHdcp22_Rx *InstancePtr, const u8 *Rn, const u8 *Km,
+	const u8 *Rrx, const u8 *Rtx, u8 *LPrime)
 {
 	u8 HashKey[XHDCP22_RX_KD_SIZE];
-	u8 Ctr[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
-	u8 Kd[2 * XHDCP22_RX_AES_SIZE]; /* dkey0 || dkey 1 */
+	const u8 *Kd;
 
 	/* Verify arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
 	Xil_AssertVoid(Rn != NULL);
 	Xil_AssertVoid(Km != NULL);
 	Xil_AssertVoid(Rrx != NULL);
 	Xil_AssertVoid(Rtx != NULL);
 	Xil_AssertVoid(LPrime != NULL);
 
-	/* Generate derived keys dkey0 and dkey1
-	   HashKey Kd = dkey0 || dkey1 */
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, NULL, Kd);
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, Ctr, Kd+XHDCP22_RX_AES_SIZE);
+	/* Kd = dkey0 || dkey1 */
+	Kd = XHdcp22Rx_GetKd(InstancePtr, Km, Rrx, Rtx)->Kd;
 
 	/* HashKey = Kd[256:64] || (Kd[63:0] xor Rrx) */
 	memcpy(HashKey, Kd, XHDCP22_RX_KD_SIZE);
@@ -1223,6 +1237,7 @@ void XHdcp22Rx_ComputeKs(const u8* Rrx, const u8* Rtx, const u8 *Km, const u8 *R
 *
 * Reference: HDCP v2.2, section 2.3
 *
+* @param  InstancePtr is a pointer to the XHdcp22_Rx core instance.
 * @param  ReceiverIdList is a list of downstream receivers IDs in big-endian
 *         order. Each receiver ID is 5 Bytes.
 * @param  ReceiverIdListSize is the number of receiver Ids in ReceiverIdList.
@@ -1238,9 +1253,9 @@ void XHdcp22Rx_ComputeKs(const u8* Rrx, const u8* Rtx, const u8 *Km, const u8 *R
 *
 * @note   None.
 ******************************************************************************/
-void XHdcp22Rx_ComputeVPrime(const u8 *ReceiverIdList, u32 ReceiverIdListSize,
-       const u8 *RxInfo, const u8 *SeqNumV, const u8 *Km, const u8 *Rrx,
-       const u8 *Rtx, u8 *VPrime)
+void XHdcp22Rx_ComputeVPrime(XHdcp22_Rx *InstancePtr, const u8 *ReceiverIdList,
+       u32 ReceiverIdListSize, const u8 *RxInfo, const u8 *SeqNumV, const u8 *Km,
+       const u8 *Rrx, const u8 *Rtx, u8 *VPrime)
 {
 	int Idx = 0;
 	u8 HashInput[XHDCP22_RX_SEQNUMV_SIZE +
@@ -1248,10 +1263,10 @@ void XHdcp22Rx_ComputeVPrime(const u8 *ReceiverIdList, u32 ReceiverIdListSize,
 					(XHDCP22_RX_MAX_DEVICE_COUNT*XHDCP22_RX_RCVID_SIZE)];
 	int HashInputSize = (ReceiverIdListSize*XHDCP22_RX_RCVID_SIZE) +
 					XHDCP22_RX_SEQNUMV_SIZE + XHDCP22_RX_RXINFO_SIZE;
-	u8 Ctr[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
-	u8 Kd[2 * XHDCP22_RX_AES_SIZE]; /* dkey0 || dkey 1 */
+	XHdcp22_Rx_KdCache *Cache;
 
 	/* Verify arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
 	Xil_AssertVoid(ReceiverIdList != NULL);
 	Xil_AssertVoid(ReceiverIdListSize > 0);
 	Xil_AssertVoid(RxInfo != NULL);
@@ -1261,10 +1276,13 @@ void XHdcp22Rx_ComputeVPrime(const u8 *ReceiverIdList, u32 ReceiverIdListSize,
 	Xil_AssertVoid(Rtx != NULL);
 	Xil_AssertVoid(VPrime != NULL);
 
-	/* Generate derived keys dkey0 and dkey1
-	   HashKey Kd = dkey0 || dkey1 */
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, NULL, Kd);
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, Ctr, Kd+XHDCP22_RX_AES_SIZE);
+	/* HashKey Kd = dkey0 || dkey1 */
+	Cache = XHdcp22Rx_GetKd(InstancePtr, Km, Rrx, Rtx);
+	if(!(Cache->Flags & XHDCP22_RX_KDCACHE_KDHMAC))
+	{
+		XHdcp22Cmn_HmacSha256Init(&Cache->KdHmac, Cache->Kd, XHDCP22_RX_KD_SIZE);
+		Cache->Flags |= XHDCP22_RX_KDCACHE_KDHMAC;
+	}
 
 	/* HashInput = ReceiverIdList || RxInfo || SeqNumV */
 	memcpy(HashInput, ReceiverIdList, ReceiverIdListSize*XHDCP22_RX_RCVID_SIZE);
@@ -1274,7 +1292,7 @@ void XHdcp22Rx_ComputeVPrime(const u8 *ReceiverIdList, u32 ReceiverIdListSize,
 	memcpy(&HashInput[Idx], SeqNumV, XHDCP22_RX_SEQNUMV_SIZE);
 
 	/* VPrime = HMAC-SHA256(HashInput, Kd) */
-	XHdcp22Cmn_HmacSha256Hash(HashInput, HashInputSize, Kd, XHDCP22_RX_KD_SIZE, VPrime);
+	XHdcp22Cmn_HmacSha256Compute(&Cache->KdHmac, HashInput, HashInputSize, VPrime);
 }
 
 /*****************************************************************************/
@@ -1284,6 +1302,7 @@ void XHdcp22Rx_ComputeVPrime(const u8 *ReceiverIdList, u32 ReceiverIdListSize,
 *
 * Reference: HDCP v2.2, section 2.3
 *
+* @param  InstancePtr is a pointer to the XHdcp22_Rx core instance.
 * @param  StreamIdType is the 16-bit field in the RepeaterAuth_Send_ReceiverID_List
 * 			  message.
 * @param  SeqNumM is the 24-bit field in the RepeaterAuth_Stream_Manage
@@ -1298,16 +1317,16 @@ void XHdcp22Rx_ComputeVPrime(const u8 *ReceiverIdList, u32 ReceiverIdListSize,
 *
 * @note	  None.
 ******************************************************************************/
-void XHdcp22Rx_ComputeMPrime(const u8 *StreamIdType, const u8 *SeqNumM,
-       const u8 *Km, const u8 *Rrx, const u8 *Rtx, u8 *MPrime)
+void XHdcp22Rx_ComputeMPrime(XHdcp22_Rx *InstancePtr, const u8 *StreamIdType,
+       const u8 *SeqNumM, const u8 *Km, const u8 *Rrx, const u8 *Rtx, u8 *MPrime)
 {
 	int Idx = 0;
 	u8 HashInput[XHDCP22_RX_STREAMID_SIZE + XHDCP22_RX_SEQNUMM_SIZE];
 	u8 HashKey[XHDCP22_RX_HASH_SIZE];
-	u8 Ctr[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
-	u8 Kd[2 * XHDCP22_RX_AES_SIZE]; /* dkey0 || dkey 1 */
+	XHdcp22_Rx_KdCache *Cache;
 
 	/* Verify arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
 	Xil_AssertVoid(StreamIdType != NULL);
 	Xil_AssertVoid(SeqNumM != NULL);
 	Xil_AssertVoid(Km != NULL);
@@ -1320,16 +1339,19 @@ void XHdcp22Rx_ComputeMPrime(const u8 *StreamIdType, const u8 *SeqNumM,
 	Idx += XHDCP22_RX_STREAMID_SIZE;
 	memcpy(&HashInput[Idx], SeqNumM, XHDCP22_RX_SEQNUMM_SIZE);
 
-	/* Generate derived keys dkey0 and dkey1
-	   HashKey Kd = dkey0 || dkey1 */
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, NULL, Kd);
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, Ctr, Kd+XHDCP22_RX_AES_SIZE);
-
-	/* Hashkey = SHA256(Kd) */
-	XHdcp22Cmn_Sha256Hash(Kd, XHDCP22_RX_KD_SIZE, HashKey);
+	/* Kd = dkey0 || dkey1 */
+	Cache = XHdcp22Rx_GetKd(InstancePtr, Km, Rrx, Rtx);
+	if(!(Cache->Flags & XHDCP22_RX_KDCACHE_MHMAC))
+	{
+		/* Hashkey = SHA256(Kd) */
+		XHdcp22Cmn_Sha256Hash(Cache->Kd, XHDCP22_RX_KD_SIZE, HashKey);
+		XHdcp22Cmn_HmacSha256Init(&Cache->MHmac, HashKey, XHDCP22_RX_HASH_SIZE);
+		memset(HashKey, 0, sizeof(HashKey));
+		Cache->Flags |= XHDCP22_RX_KDCACHE_MHMAC;
+	}
 
-	/* VPrime = HMAC-SHA256(HashInput, Kd) */
-	XHdcp22Cmn_HmacSha256Hash(HashInput, sizeof(HashInput), HashKey, XHDCP22_RX_HASH_SIZE, MPrime);
+	/* MPrime = HMAC-SHA256(HashInput, SHA256(Kd)) */
+	XHdcp22Cmn_HmacSha256Compute(&Cache->MHmac, HashInput, sizeof(HashInput), MPrime);
 }
 
 /** @} */
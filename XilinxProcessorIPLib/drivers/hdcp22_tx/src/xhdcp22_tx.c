@@ -188,6 +188,7 @@ static void XHdcp22Tx_GenerateRn(XHdcp22_Tx *InstancePtr, u8* RnPtr);
 static void XHdcp22Tx_GenerateRiv(XHdcp22_Tx *InstancePtr, u8* RivPtr);
 static void XHdcp22Tx_GenerateKs(XHdcp22_Tx *InstancePtr, u8* KsPtr);
 static const u8* XHdcp22Tx_GetKPubDpc(XHdcp22_Tx *InstancePtr);
+static const XHdcp22_Tx_DcpKey *XHdcp22Tx_GetDcpKey(XHdcp22_Tx *InstancePtr);
 
 /* Cryptographic functions */
 static XHdcp22_Tx_PairingInfo *XHdcp22Tx_GetPairingInfo(XHdcp22_Tx *InstancePtr,
@@ -196,6 +197,10 @@ static void XHdcp22Tx_InvalidatePairingInfo(XHdcp22_Tx *InstancePtr,
                                              const u8* ReceiverId);
 static XHdcp22_Tx_PairingInfo *XHdcp22Tx_UpdatePairingInfo(XHdcp22_Tx *InstancePtr,
                               const XHdcp22_Tx_PairingInfo *PairingInfo, u8 Ready);
+static u8 XHdcp22Tx_IsCertVerified(XHdcp22_Tx *InstancePtr,
+                                   const u8 *ReceiverId, const u8 *CertHash);
+static void XHdcp22Tx_UpdateCertInfo(XHdcp22_Tx *InstancePtr,
+                                     const u8 *ReceiverId, const u8 *CertHash);
 
 /* Timer functions */
 static void XHdcp22Tx_TimerHandler(void *CallbackRef, u8 TmrCntNumber);
@@ -391,6 +396,10 @@ int XHdcp22Tx_CfgInitialize(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_Config *CfgPtr,
 	/* Clear pairing info */
 	XHdcp22Tx_ClearPairingInfo(InstancePtr);
 
+	/* Clear verified certificates and precompute the DCP LLC key context */
+	XHdcp22Tx_ClearCertInfo(InstancePtr);
+	(void)XHdcp22Tx_GetDcpKey(InstancePtr);
+
 	/* Initialize hardware timer */
 	Result = XHdcp22Tx_InitializeTimer(InstancePtr);
 	if (Result != XST_SUCCESS) {
@@ -590,7 +599,7 @@ void XHdcp22Tx_LoadLc128(XHdcp22_Tx *InstancePtr, const u8 *Lc128Ptr)
 int XHdcp22Tx_LoadRevocationTable(XHdcp22_Tx *InstancePtr, const u8 *SrmPtr)
 {
 	int Result;
-	const u8* KPubDpcPtr = NULL;
+	const XHdcp22_Tx_DcpKey* DcpKeyPtr = NULL;
 	const u8* SrmBlockPtr = NULL;
 	u8 SrmId;
 	u16 SrmVersion;
@@ -633,15 +642,12 @@ int XHdcp22Tx_LoadRevocationTable(XHdcp22_Tx *InstancePtr, const u8 *SrmPtr)
 	/* The size of the first-generation SRM block */
 	BlockSize = LengthField + 5;
 
-	KPubDpcPtr = XHdcp22Tx_GetKPubDpc(InstancePtr);
+	DcpKeyPtr = XHdcp22Tx_GetDcpKey(InstancePtr);
 
 	/* Verify the first-generation SRM block */
 	Result = XHdcp22Tx_VerifySRM(SrmBlockPtr,
 	                             BlockSize,
-	                             KPubDpcPtr, // N
-	                             XHDCP22_TX_KPUB_DCP_LLC_N_SIZE,
-	                             &KPubDpcPtr[XHDCP22_TX_KPUB_DCP_LLC_N_SIZE], // e
-	                             XHDCP22_TX_KPUB_DCP_LLC_E_SIZE);
+	                             DcpKeyPtr);
 	if (Result != XST_SUCCESS) {
 		return XST_FAILURE;
 	}
@@ -661,10 +667,7 @@ int XHdcp22Tx_LoadRevocationTable(XHdcp22_Tx *InstancePtr, const u8 *SrmPtr)
 		/* Verify the next-generation SRM block */
 		Result = XHdcp22Tx_VerifySRM(SrmBlockPtr,
 		                             BlockSize,
-		                             KPubDpcPtr, // N
-		                             XHDCP22_TX_KPUB_DCP_LLC_N_SIZE,
-		                             &KPubDpcPtr[XHDCP22_TX_KPUB_DCP_LLC_N_SIZE], // e
-		                             XHDCP22_TX_KPUB_DCP_LLC_E_SIZE);
+		                             DcpKeyPtr);
 		if (Result != XST_SUCCESS) {
 			return XST_FAILURE;
 		}
@@ -1693,8 +1696,9 @@ XHdcp22_Tx_StateType Xhdcp22Tx_StateA1_1(XHdcp22_Tx *InstancePtr)
 	int Result = XST_SUCCESS;
 	XHdcp22_Tx_DDCMessage *MsgPtr = (XHdcp22_Tx_DDCMessage *)InstancePtr->MessageBuffer;
 	XHdcp22_Tx_PairingInfo *PairingInfoPtr = NULL;
-	const u8* KPubDpcPtr = NULL;
+	const XHdcp22_Tx_DcpKey* DcpKeyPtr = NULL;
 	XHdcp22_Tx_PairingInfo NewPairingInfo;
+	u8 CertHash[XHDCP22_TX_SHA256_HASH_SIZE];
 
 	/* receive AKE Send message, wait for 100 ms */
 	Result = XHdcp22Tx_WaitForReceiver(InstancePtr, sizeof(XHdcp22_Tx_AKESendCert), FALSE);
@@ -1716,25 +1720,33 @@ XHdcp22_Tx_StateType Xhdcp22Tx_StateA1_1(XHdcp22_Tx *InstancePtr)
 		return XHDCP22_TX_STATE_A0;
 	}
 
-	/* Verify the signature */
-	KPubDpcPtr = XHdcp22Tx_GetKPubDpc(InstancePtr);
-	XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG,
-	                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE);
-	Result = XHdcp22Tx_VerifyCertificate(&MsgPtr->Message.AKESendCert.CertRx,
-	                   KPubDpcPtr, /* N */
-	                   XHDCP22_TX_KPUB_DCP_LLC_N_SIZE,
-	                   &KPubDpcPtr[XHDCP22_TX_KPUB_DCP_LLC_N_SIZE], /* e */
-	                   XHDCP22_TX_KPUB_DCP_LLC_E_SIZE);
-
-	if (Result != XST_SUCCESS) {
+	/* Verify the signature, unless this certificate has been verified
+	 * before (re-authentication of the same receiver) */
+	DcpKeyPtr = XHdcp22Tx_GetDcpKey(InstancePtr);
+	XHdcp22Tx_ComputeCertHash(&MsgPtr->Message.AKESendCert.CertRx, CertHash);
+	if (XHdcp22Tx_IsCertVerified(InstancePtr,
+	        MsgPtr->Message.AKESendCert.CertRx.ReceiverId, CertHash)) {
 		XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG,
-	                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_FAIL);
-		return XHDCP22_TX_STATE_A0;
+	                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_STORED);
 	}
 	else {
 		XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG,
-	                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_PASS);
+	                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE);
+		Result = XHdcp22Tx_VerifyCertificate(&MsgPtr->Message.AKESendCert.CertRx,
+		                                     DcpKeyPtr);
+
+		if (Result != XST_SUCCESS) {
+			XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG,
+		                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_FAIL);
+			return XHDCP22_TX_STATE_A0;
+		}
+		else {
+			XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG,
+		                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_PASS);
+		}
 	}
+	XHdcp22Tx_UpdateCertInfo(InstancePtr,
+	        MsgPtr->Message.AKESendCert.CertRx.ReceiverId, CertHash);
 
 	/* SRM and revocation check are only performed by the top-level HDCP transmitter */
 	if (InstancePtr->Config.Mode == XHDCP22_TX_TRANSMITTER) {
@@ -3124,6 +3136,39 @@ static const u8* XHdcp22Tx_GetKPubDpc(XHdcp22_Tx *InstancePtr)
 	return KPubDpcPtr;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function returns the DCP LLC key context, computing it first if the
+* key returned by XHdcp22Tx_GetKPubDpc has changed.
+*
+* @param  InstancePtr is a pointer to the XHdcp22Tx core instance.
+*
+* @return A pointer to the DCP LLC key context.
+*
+* @note   Changing the key clears the verified certificates.
+*
+******************************************************************************/
+static const XHdcp22_Tx_DcpKey *XHdcp22Tx_GetDcpKey(XHdcp22_Tx *InstancePtr)
+{
+	const u8* KPubDpcPtr = NULL;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	KPubDpcPtr = XHdcp22Tx_GetKPubDpc(InstancePtr);
+
+	if (InstancePtr->DcpKey.KeyPtr != KPubDpcPtr) {
+		XHdcp22Tx_InitDcpKey(&InstancePtr->DcpKey,
+		                     KPubDpcPtr, /* N */
+		                     XHDCP22_TX_KPUB_DCP_LLC_N_SIZE,
+		                     &KPubDpcPtr[XHDCP22_TX_KPUB_DCP_LLC_N_SIZE], /* e */
+		                     XHDCP22_TX_KPUB_DCP_LLC_E_SIZE);
+		XHdcp22Tx_ClearCertInfo(InstancePtr);
+	}
+
+	return &InstancePtr->DcpKey;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -3855,6 +3900,103 @@ int XHdcp22Tx_ClearPairingInfo(XHdcp22_Tx *InstancePtr)
 
 	return XST_SUCCESS;
 }
+
+/*****************************************************************************/
+/**
+*
+* This function clears the stored verified receiver certificates, so that
+* the next authentication of every receiver verifies the certificate
+* signature again.
+*
+* @param   InstancePtr is a pointer to the XHdcp22Tx core instance.
+*
+* @return  XST_SUCCESS
+*
+* @note    None.
+*
+******************************************************************************/
+int XHdcp22Tx_ClearCertInfo(XHdcp22_Tx *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	memset(InstancePtr->Info.CertInfo, 0x00,
+	       sizeof(InstancePtr->Info.CertInfo));
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks if a receiver certificate has been verified before.
+*
+* @param  InstancePtr is a pointer to the XHdcp22Tx core instance.
+* @param  ReceiverId is a pointer to the 5-byte receiver Id.
+* @param  CertHash is the hash of the certificate computed by
+*         XHdcp22Tx_ComputeCertHash.
+*
+* @return TRUE if the same certificate has been verified, FALSE otherwise.
+*
+* @note   None.
+*
+******************************************************************************/
+static u8 XHdcp22Tx_IsCertVerified(XHdcp22_Tx *InstancePtr,
+                                   const u8 *ReceiverId, const u8 *CertHash)
+{
+	int i = 0;
+	XHdcp22_Tx_CertInfo *CertInfoPtr = NULL;
+
+	for (i=0; i<XHDCP22_TX_MAX_STORED_CERTINFO; i++) {
+		CertInfoPtr = &InstancePtr->Info.CertInfo[i];
+		if ((CertInfoPtr->Ready == TRUE) &&
+		    (memcmp(ReceiverId, CertInfoPtr->ReceiverId,
+		            XHDCP22_TX_CERT_RCVID_SIZE) == 0) &&
+		    (memcmp(CertHash, CertInfoPtr->CertHash,
+		            sizeof(CertInfoPtr->CertHash)) == 0)) {
+			return (TRUE);
+		}
+	}
+	return (FALSE);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function stores a verified receiver certificate as the most recently
+* used entry. It replaces an earlier certificate of the same receiver, or
+* else the least recently used entry.
+*
+* @param  InstancePtr is a pointer to the XHdcp22Tx core instance.
+* @param  ReceiverId is a pointer to the 5-byte receiver Id.
+* @param  CertHash is the hash of the certificate computed by
+*         XHdcp22Tx_ComputeCertHash.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Tx_UpdateCertInfo(XHdcp22_Tx *InstancePtr,
+                                     const u8 *ReceiverId, const u8 *CertHash)
+{
+	int i = 0;
+	XHdcp22_Tx_CertInfo *CertInfoPtr = InstancePtr->Info.CertInfo;
+
+	/* Find the slot to reuse, the last one is the least recently used */
+	for (i=0; i<XHDCP22_TX_MAX_STORED_CERTINFO-1; i++) {
+		if ((CertInfoPtr[i].Ready == FALSE) ||
+		    (memcmp(ReceiverId, CertInfoPtr[i].ReceiverId,
+		            XHDCP22_TX_CERT_RCVID_SIZE) == 0)) {
+			break;
+		}
+	}
+
+	/* Move the more recent entries down and store at the top */
+	memmove(&CertInfoPtr[1], &CertInfoPtr[0], i * sizeof(XHdcp22_Tx_CertInfo));
+	memcpy(CertInfoPtr[0].ReceiverId, ReceiverId, XHDCP22_TX_CERT_RCVID_SIZE);
+	memcpy(CertInfoPtr[0].CertHash, CertHash, sizeof(CertInfoPtr[0].CertHash));
+	CertInfoPtr[0].Ready = (TRUE);
+}
 /*****************************************************************************/
 /**
 *
@@ -4384,6 +4526,7 @@ void XHdcp22Tx_LogDisplay(XHdcp22_Tx *InstancePtr)
 				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, VERIFY_SIGNATURE)
 				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, VERIFY_SIGNATURE_PASS)
 				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, VERIFY_SIGNATURE_FAIL)
+				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, VERIFY_SIGNATURE_STORED)
 				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, DEVICE_IS_REVOKED)
 				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, ENCRYPT_KM)
 				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, ENCRYPT_KM_DONE)
@@ -130,6 +130,11 @@ extern "C" {
 */
 #define XHDCP22_TX_MAX_STORED_PAIRINGINFO  2
 
+/**
+* The list of maximum verified receiver certificates to store.
+*/
+#define XHDCP22_TX_MAX_STORED_CERTINFO  8
+
 /**
 * The size of the log buffer.
 */
@@ -316,6 +321,29 @@ typedef struct {
 	u8 Ekh_Km[16];       /**< Ekh(Km). */
      u8 Ready;            /**< Indicates a valid entry */
 } XHdcp22_Tx_PairingInfo;
+
+/**
+* This typedef contains a receiver certificate whose DCP LLC signature has
+* been verified, so that re-authentication of the same receiver can skip the
+* RSA signature verification.
+*/
+typedef struct {
+	u8 ReceiverId[5];    /**< Unique receiver Id. */
+	u8 CertHash[32];     /**< SHA256 hash of the entire certificate. */
+	u8 Ready;            /**< Indicates a valid entry */
+} XHdcp22_Tx_CertInfo;
+
+/**
+* This typedef contains the DCP LLC public key in Montgomery form, computed
+* once and used for every certificate and SRM signature verification.
+*/
+typedef struct {
+	const u8 *KeyPtr;    /**< Key the context was computed from. */
+	u32 N[96];           /**< Modulus n (3072 bits). */
+	u32 E[96];           /**< Public exponent e. */
+	u32 RR[96];          /**< R^2 mod n, with R = 2^3072. */
+	u32 NInv;            /**< -n^-1 mod 2^32. */
+} XHdcp22_Tx_DcpKey;
 /**
 * This typedef contains information about the HDCP22 transmitter.
 */
@@ -334,6 +362,8 @@ typedef struct
 	u8 MsgAvailable;                    /**< Message is available for reading. */
 
 	XHdcp22_Tx_PairingInfo PairingInfo[XHDCP22_TX_MAX_STORED_PAIRINGINFO];
+	/** Verified receiver certificates, most recently used first. */
+	XHdcp22_Tx_CertInfo CertInfo[XHDCP22_TX_MAX_STORED_CERTINFO];
 	/** The result after a call to #XHdcp22Tx_Poll. */
 	XHdcp22_Tx_AuthenticationType AuthenticationStatus;
 
@@ -561,6 +591,9 @@ typedef struct
 	/** Revocation List. */
 	XHdcp22_Tx_RevocationList RevocationList;
 
+	/** DCP LLC public key context. */
+	XHdcp22_Tx_DcpKey DcpKey;
+
 	/** Topology info. */
 	XHdcp22_Tx_Topology Topology;
 
@@ -584,6 +617,7 @@ int XHdcp22Tx_CfgInitialize(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_Config *CfgPtr,
                             UINTPTR EffectiveAddr);
 int XHdcp22Tx_Reset(XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_ClearPairingInfo(XHdcp22_Tx *InstancePtr);
+int XHdcp22Tx_ClearCertInfo(XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_Authenticate (XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_Poll(XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_Enable (XHdcp22_Tx *InstancePtr);
@@ -65,6 +65,9 @@
 /** Size RSA encryption parameters to support 384 byte maximum modulus size */
 #define BD_MAX_MOD_SIZE  (384/sizeof(u32))
 
+/** Size of the DCP LLC key in digits */
+#define XHDCP22_TX_DCP_KEY_DIGITS  (XHDCP22_TX_KPUB_DCP_LLC_N_SIZE/sizeof(u32))
+
 /**************************** Type Definitions *******************************/
 
 /************************** Function Prototypes ******************************/
@@ -83,8 +86,7 @@ static int XHdcp22Tx_RsaEncryptMsg(const u8 *KeyPubNPtr, int KeyPubNSize,
                                    u8 *EncryptedMsgPtr);
 static int XHdcp22Tx_RsaSignatureVerify(const u8 *MessagePtr, int MessageSize,
                                         const u8 *SignaturePtr,
-                                        const u8 *KpubDcpNPtr, int KpubDcpNSize,
-                                        const u8 *KpubDcpEPtr, int KpubDcpESize);
+                                        const XHdcp22_Tx_DcpKey *DcpKeyPtr);
 
 /************************** Variable Definitions *****************************/
 
@@ -345,10 +347,7 @@ static int XHdcp22Tx_RsaOaepEncrypt(const u8 *KeyPubNPtr, int KeyPubNSize,
 * @param  MessagePtr is a pointer to the start of the message to be hashed.
 * @param  MessageSize is the size of the message to be hashed.
 * @param  SignaturePtr is a pointer to the start of the DCP generated signature.
-* @param  KpubDcpNPtr is a pointer to the N-value of the certificate signature.
-* @param  KpubDcpNSize is the size of the N-value of the certificates signature.
-* @param  KpubDcpEPtr iis a pointer to the E-value of the certificate signature.
-* @param  KpubDcpESize is the size of the E-value of the certificates signature.
+* @param  DcpKeyPtr is a pointer to the DCP LLC key context.
 *
 * @return
 *         - XST_SUCCESS if the certificate is valid.
@@ -358,19 +357,17 @@ static int XHdcp22Tx_RsaOaepEncrypt(const u8 *KeyPubNPtr, int KeyPubNSize,
 *****************************************************************************/
 static int XHdcp22Tx_RsaSignatureVerify(const u8 *MessagePtr, int MessageSize,
                                         const u8 *SignaturePtr,
-                                        const u8 *KpubDcpNPtr, int KpubDcpNSize,
-                                        const u8 *KpubDcpEPtr, int KpubDcpESize)
+                                        const XHdcp22_Tx_DcpKey *DcpKeyPtr)
 {
 	/* Verify arguments */
 	Xil_AssertNonvoid(MessagePtr   != NULL);
 	Xil_AssertNonvoid(SignaturePtr != NULL);
-	Xil_AssertNonvoid(KpubDcpNPtr  != NULL);
-	Xil_AssertNonvoid(KpubDcpEPtr  != NULL);
-	Xil_AssertNonvoid(KpubDcpNSize > 0);
-	Xil_AssertNonvoid(KpubDcpESize > 0);
+	Xil_AssertNonvoid(DcpKeyPtr    != NULL);
+	Xil_AssertNonvoid(DcpKeyPtr->KeyPtr != NULL);
 
 	int i;
 	int Result = XST_SUCCESS;
+	u32 s[XHDCP22_TX_DCP_KEY_DIGITS], m[XHDCP22_TX_DCP_KEY_DIGITS];
 	u8 THash[XHDCP22_TX_SHA256_HASH_SIZE];
 	u8 TIdentifer[] = {	0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86,
 					0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01, 0x05,
@@ -381,15 +378,17 @@ static int XHdcp22Tx_RsaSignatureVerify(const u8 *MessagePtr, int MessageSize,
 	/* Create hash of first part of the certificate (without the signature). */
 	XHdcp22Cmn_Sha256Hash(MessagePtr, MessageSize, THash);
 
-	/* Perform RSA decryption and recover EM */
-	Result = XHdcp22Tx_RsaEncryptMsg(KpubDcpNPtr, KpubDcpNSize,
-                                   KpubDcpEPtr, KpubDcpESize,
-                                   SignaturePtr,
-                                   XHDCP22_TX_CERT_SIGNATURE_SIZE,
-                                   Em);
-	if (Result != XST_SUCCESS) {
+	/* Perform RSA decryption and recover EM. The signature representative
+	 * must be smaller than the modulus (PKCS#1 v2.1, Section 5.2.2). */
+	mpConvFromOctets(s, XHDCP22_TX_DCP_KEY_DIGITS, SignaturePtr,
+	                 XHDCP22_TX_CERT_SIGNATURE_SIZE);
+	if (mpCompare(s, DcpKeyPtr->N, XHDCP22_TX_DCP_KEY_DIGITS) >= 0) {
 		return XST_FAILURE;
 	}
+	mpMontExp(m, s, DcpKeyPtr->E, DcpKeyPtr->N, DcpKeyPtr->RR,
+	          DcpKeyPtr->NInv, XHDCP22_TX_DCP_KEY_DIGITS);
+	mpConvToOctets(m, XHDCP22_TX_DCP_KEY_DIGITS, Em,
+	               XHDCP22_TX_CERT_SIGNATURE_SIZE);
 
 	/*
 	 * Compare EM to EM'
@@ -454,6 +453,44 @@ void XHdcp22Tx_GenerateRandom(XHdcp22_Tx *InstancePtr, int NumOctets,
 	XHdcp22Rng_GetRandom(&InstancePtr->Rng, RandomNumberPtr, NumOctets, NumOctets);
 }
 
+/*****************************************************************************/
+/**
+*
+* This function computes the Montgomery form of the DCP LLC public key used
+* by XHdcp22Tx_VerifyCertificate and XHdcp22Tx_VerifySRM.
+*
+* @param  DcpKeyPtr is a pointer to the key context to initialize.
+* @param  KpubDcpNPtr is a pointer to the N-value of the DCP LLC key.
+* @param  KpubDcpNSize is the size of the N-value of the DCP LLC key.
+* @param  KpubDcpEPtr iis a pointer to the E-value of the DCP LLC key.
+* @param  KpubDcpESize is the size of the E-value of the DCP LLC key.
+*
+* @return None.
+*
+* @note   The context refers to the key by KpubDcpNPtr so that a change of
+*         key can be detected.
+*
+******************************************************************************/
+void XHdcp22Tx_InitDcpKey(XHdcp22_Tx_DcpKey *DcpKeyPtr,
+                          const u8* KpubDcpNPtr, int KpubDcpNSize,
+                          const u8* KpubDcpEPtr, int KpubDcpESize)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(DcpKeyPtr != NULL);
+	Xil_AssertVoid(KpubDcpNPtr != NULL);
+	Xil_AssertVoid(KpubDcpEPtr != NULL);
+	Xil_AssertVoid(KpubDcpNSize == XHDCP22_TX_KPUB_DCP_LLC_N_SIZE);
+	Xil_AssertVoid(KpubDcpESize > 0);
+
+	mpConvFromOctets(DcpKeyPtr->N, XHDCP22_TX_DCP_KEY_DIGITS,
+	                 KpubDcpNPtr, KpubDcpNSize);
+	mpConvFromOctets(DcpKeyPtr->E, XHDCP22_TX_DCP_KEY_DIGITS,
+	                 KpubDcpEPtr, KpubDcpESize);
+	mpMontRR(DcpKeyPtr->RR, DcpKeyPtr->N, XHDCP22_TX_DCP_KEY_DIGITS);
+	DcpKeyPtr->NInv = mpMontInv(DcpKeyPtr->N[0]);
+	DcpKeyPtr->KeyPtr = KpubDcpNPtr;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -461,10 +498,7 @@ void XHdcp22Tx_GenerateRandom(XHdcp22_Tx *InstancePtr, int NumOctets,
 *
 * @param  CertificatePtr is a pointer to the certificate from the HDCP2.2
 *         receiver.
-* @param  KpubDcpNPtr is a pointer to the N-value of the certificate signature.
-* @param  KpubDcpNSize is the size of the N-value of the certificates signature.
-* @param  KpubDcpEPtr iis a pointer to the E-value of the certificate signature.
-* @param  KpubDcpESize is the size of the E-value of the certificates signature.
+* @param  DcpKeyPtr is a pointer to the DCP LLC key context.
 *
 * @return
 *         - XST_SUCCESS if the certificate is valid.
@@ -473,15 +507,11 @@ void XHdcp22Tx_GenerateRandom(XHdcp22_Tx *InstancePtr, int NumOctets,
 *
 ******************************************************************************/
 int XHdcp22Tx_VerifyCertificate(const XHdcp22_Tx_CertRx* CertificatePtr,
-                                const u8* KpubDcpNPtr, int KpubDcpNSize,
-                                const u8* KpubDcpEPtr, int KpubDcpESize)
+                                const XHdcp22_Tx_DcpKey *DcpKeyPtr)
 {
 	/* Verify arguments */
 	Xil_AssertNonvoid(CertificatePtr != NULL);
-	Xil_AssertNonvoid(KpubDcpNPtr != NULL);
-	Xil_AssertNonvoid(KpubDcpEPtr != NULL);
-	Xil_AssertNonvoid(KpubDcpNSize > 0);
-	Xil_AssertNonvoid(KpubDcpESize > 0);
+	Xil_AssertNonvoid(DcpKeyPtr != NULL);
 
 	int Result = XST_SUCCESS;
 
@@ -489,12 +519,38 @@ int XHdcp22Tx_VerifyCertificate(const XHdcp22_Tx_CertRx* CertificatePtr,
 				(u8 *)CertificatePtr,
                     (sizeof(XHdcp22_Tx_CertRx) - sizeof(CertificatePtr->Signature)),
 				CertificatePtr->Signature,
-				KpubDcpNPtr, KpubDcpNSize,
-				KpubDcpEPtr, KpubDcpESize);
+				DcpKeyPtr);
 
 	return Result;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function computes the hash that identifies a verified receiver
+* certificate.
+*
+* @param  CertificatePtr is a pointer to the certificate from the HDCP2.2
+*         receiver.
+* @param  CertHash is the SHA256 hash of the entire certificate, including
+*         the signature.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+void XHdcp22Tx_ComputeCertHash(const XHdcp22_Tx_CertRx *CertificatePtr,
+                               u8 *CertHash)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(CertificatePtr != NULL);
+	Xil_AssertVoid(CertHash != NULL);
+
+	XHdcp22Cmn_Sha256Hash((const u8 *)CertificatePtr,
+	                      sizeof(XHdcp22_Tx_CertRx), CertHash);
+}
+
 /*****************************************************************************/
 /**
 *
@@ -502,10 +558,7 @@ int XHdcp22Tx_VerifyCertificate(const XHdcp22_Tx_CertRx* CertificatePtr,
 *
 * @param  SrmPtr is a pointer to the SRM.
 * @param  SrmSize is the size of the SRM in bytes.
-* @param  KpubDcpNPtr is a pointer to the N-value of the DCP LLC key.
-* @param  KpubDcpNSize is the size of the N-value of the DCP LLC key.
-* @param  KpubDcpEPtr iis a pointer to the E-value of the DCP LLC key.
-* @param  KpubDcpESize is the size of the E-value of the DCP LLC key.
+* @param  DcpKeyPtr is a pointer to the DCP LLC key context.
 *
 * @return
 *         - XST_SUCCESS if the SRM block is valid.
@@ -514,16 +567,12 @@ int XHdcp22Tx_VerifyCertificate(const XHdcp22_Tx_CertRx* CertificatePtr,
 *
 ******************************************************************************/
 int XHdcp22Tx_VerifySRM(const u8* SrmPtr, int SrmSize,
-	const u8* KpubDcpNPtr, int KpubDcpNSize,
-	const u8* KpubDcpEPtr, int KpubDcpESize)
+	const XHdcp22_Tx_DcpKey *DcpKeyPtr)
 {
 	/* Verify arguments */
 	Xil_AssertNonvoid(SrmPtr != NULL);
-	Xil_AssertNonvoid(KpubDcpNPtr != NULL);
-	Xil_AssertNonvoid(KpubDcpEPtr != NULL);
+	Xil_AssertNonvoid(DcpKeyPtr != NULL);
 	Xil_AssertNonvoid(SrmSize > 0);
-	Xil_AssertNonvoid(KpubDcpNSize > 0);
-	Xil_AssertNonvoid(KpubDcpESize > 0);
 
 	int Result = XST_SUCCESS;
 
@@ -531,8 +580,7 @@ int XHdcp22Tx_VerifySRM(const u8* SrmPtr, int SrmSize,
 				(u8 *)SrmPtr,
                     SrmSize - XHDCP22_TX_SRM_SIGNATURE_SIZE,
 				SrmPtr + (SrmSize - XHDCP22_TX_SRM_SIGNATURE_SIZE),
-				KpubDcpNPtr, KpubDcpNSize,
-				KpubDcpEPtr, KpubDcpESize);
+				DcpKeyPtr);
 
 	return Result;
 }
@@ -566,7 +614,7 @@ void XHdcp22Tx_ComputeHPrime(const u8* Rrx, const u8 *RxCaps,
 	Xil_AssertVoid(Km != NULL);
 	Xil_AssertVoid(HPrime != NULL);
 
-	u8 Aes_Iv[XHDCP22_TX_AES128_SIZE];
+	u8 Aes_Iv[2 * XHDCP22_TX_AES128_SIZE]; /* m for dkey0 || m for dkey1. */
 	u8 Aes_Key[XHDCP22_TX_AES128_SIZE];
 	u8 Kd[2 * XHDCP22_TX_AES128_SIZE]; /* Dkey0 || Dkey 1. */
 
@@ -582,12 +630,13 @@ void XHdcp22Tx_ComputeHPrime(const u8* Rrx, const u8 *RxCaps,
 	memcpy(Aes_Iv, Rtx, XHDCP22_TX_RTX_SIZE);
 	/* Normally we should do Rrx XOR with Ctr0, but Ctr0 is 0. */
 	memcpy(&Aes_Iv[XHDCP22_TX_RTX_SIZE], Rrx, XHDCP22_TX_RRX_SIZE);
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, Kd);
-
 
 	/* Determine dkey1, counter is 1: Rrx | 0x01. */
-	Aes_Iv[15] ^= 0x01; /* big endian! */
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, &Kd[XHDCP22_TX_KM_SIZE]);
+	memcpy(&Aes_Iv[XHDCP22_TX_AES128_SIZE], Aes_Iv, XHDCP22_TX_AES128_SIZE);
+	Aes_Iv[XHDCP22_TX_AES128_SIZE + 15] ^= 0x01; /* big endian! */
+
+	/* Kd = dkey0 || dkey1, both blocks with one key schedule. */
+	XHdcp22Cmn_Aes128EncryptBlocks(Aes_Iv, 2, Aes_Key, Kd);
 
 
 	/* Create hash with HMAC-SHA256. */
@@ -694,7 +743,7 @@ void XHdcp22Tx_ComputeLPrime(const u8* Rn, const u8 *Km,
 	Xil_AssertVoid(Rtx != NULL);
 	Xil_AssertVoid(LPrime != NULL);
 
-	u8 Aes_Iv[XHDCP22_TX_AES128_SIZE];
+	u8 Aes_Iv[2 * XHDCP22_TX_AES128_SIZE]; /* m for dkey0 || m for dkey1. */
 	u8 Aes_Key[XHDCP22_TX_AES128_SIZE];
 	u8 Kd[2 * XHDCP22_TX_AES128_SIZE]; /* Dkey0 || Dkey 1. */
 	u8 HashKey[XHDCP22_TX_SHA256_HASH_SIZE];
@@ -711,12 +760,13 @@ void XHdcp22Tx_ComputeLPrime(const u8* Rn, const u8 *Km,
 	memcpy(Aes_Iv, Rtx, XHDCP22_TX_RTX_SIZE);
 	/* Rrx XOR Ctr0, where Ctr0 is 0. */
 	memcpy(&Aes_Iv[XHDCP22_TX_RTX_SIZE], Rrx, XHDCP22_TX_RRX_SIZE);
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, Kd);
-
 
 	/* Compute Dkey0 , counter is 1: Rrx | 0x01. */
-	Aes_Iv[15] ^= 0x01; /* big endian! */
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, &Kd[XHDCP22_TX_KM_SIZE]);
+	memcpy(&Aes_Iv[XHDCP22_TX_AES128_SIZE], Aes_Iv, XHDCP22_TX_AES128_SIZE);
+	Aes_Iv[XHDCP22_TX_AES128_SIZE + 15] ^= 0x01; /* big endian! */
+
+	/* Kd = dkey0 || dkey1, both blocks with one key schedule. */
+	XHdcp22Cmn_Aes128EncryptBlocks(Aes_Iv, 2, Aes_Key, Kd);
 
 
 	/* Create hash with HMAC-SHA256. */
@@ -755,7 +805,7 @@ void XHdcp22Tx_ComputeV(const u8* Rn, const u8* Rrx, const u8* RxInfo,
 	Xil_AssertVoid(Km != NULL);
 	Xil_AssertVoid(V != NULL);
 
-	u8 Aes_Iv[XHDCP22_TX_AES128_SIZE];
+	u8 Aes_Iv[2 * XHDCP22_TX_AES128_SIZE]; /* m for dkey0 || m for dkey1. */
 	u8 Aes_Key[XHDCP22_TX_AES128_SIZE];
 	u8 Kd[2 * XHDCP22_TX_AES128_SIZE]; /* Dkey0 || Dkey 1. */
 
@@ -775,11 +825,13 @@ void XHdcp22Tx_ComputeV(const u8* Rn, const u8* Rrx, const u8* RxInfo,
 	memcpy(Aes_Iv, Rtx, XHDCP22_TX_RTX_SIZE);
 	/* Normally we should do Rrx XOR with Ctr0, but Ctr0 is 0. */
 	memcpy(&Aes_Iv[XHDCP22_TX_RTX_SIZE], Rrx, XHDCP22_TX_RRX_SIZE);
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, Kd);
 
 	/* Determine dkey1, counter is 1: Rrx | 0x01. */
-	Aes_Iv[15] ^= 0x01; /* big endian! */
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, &Kd[XHDCP22_TX_KM_SIZE]);
+	memcpy(&Aes_Iv[XHDCP22_TX_AES128_SIZE], Aes_Iv, XHDCP22_TX_AES128_SIZE);
+	Aes_Iv[XHDCP22_TX_AES128_SIZE + 15] ^= 0x01; /* big endian! */
+
+	/* Kd = dkey0 || dkey1, both blocks with one key schedule. */
+	XHdcp22Cmn_Aes128EncryptBlocks(Aes_Iv, 2, Aes_Key, Kd);
 
 	/* Create hash with HMAC-SHA256. */
 	/* Input: ReceiverID list || RxInfo || seq_num_V. */
@@ -820,7 +872,7 @@ void XHdcp22Tx_ComputeM(const u8* Rn, const u8* Rrx, const u8* Rtx,
 	Xil_AssertVoid(Km != NULL);
 	Xil_AssertVoid(M != NULL);
 
-	u8 Aes_Iv[XHDCP22_TX_AES128_SIZE];
+	u8 Aes_Iv[2 * XHDCP22_TX_AES128_SIZE]; /* m for dkey0 || m for dkey1. */
 	u8 Aes_Key[XHDCP22_TX_AES128_SIZE];
 	u8 Kd[2 * XHDCP22_TX_AES128_SIZE]; /* Dkey0 || Dkey 1. */
 
@@ -848,11 +900,13 @@ void XHdcp22Tx_ComputeM(const u8* Rn, const u8* Rrx, const u8* Rtx,
 	memcpy(Aes_Iv, Rtx, XHDCP22_TX_RTX_SIZE);
 	/* Normally we should do Rrx XOR with Ctr0, but Ctr0 is 0. */
 	memcpy(&Aes_Iv[XHDCP22_TX_RTX_SIZE], Rrx, XHDCP22_TX_RRX_SIZE);
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, Kd);
 
 	/* Determine dkey1, counter is 1: Rrx | 0x01. */
-	Aes_Iv[15] ^= 0x01; /* big endian! */
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, &Kd[XHDCP22_TX_KM_SIZE]);
+	memcpy(&Aes_Iv[XHDCP22_TX_AES128_SIZE], Aes_Iv, XHDCP22_TX_AES128_SIZE);
+	Aes_Iv[XHDCP22_TX_AES128_SIZE + 15] ^= 0x01; /* big endian! */
+
+	/* Kd = dkey0 || dkey1, both blocks with one key schedule. */
+	XHdcp22Cmn_Aes128EncryptBlocks(Aes_Iv, 2, Aes_Key, Kd);
 
 	/* Create hash with SHA256 */
 	XHdcp22Cmn_Sha256Hash(Kd, sizeof(Kd), SHA256_Kd);
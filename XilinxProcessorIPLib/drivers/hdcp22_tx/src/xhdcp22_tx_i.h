@@ -249,6 +249,7 @@ typedef enum
 	XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE,
 	XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_PASS,
 	XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_FAIL,
+	XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_STORED,
 	XHDCP22_TX_LOG_DBG_DEVICE_IS_REVOKED,
 	XHDCP22_TX_LOG_DBG_ENCRYPT_KM,
 	XHDCP22_TX_LOG_DBG_ENCRYPT_KM_DONE,
@@ -487,12 +488,15 @@ typedef struct
 /* Crypto functions */
 void XHdcp22Tx_MemXor(u8 *Output, const u8 *InputA, const u8 *InputB,
                       unsigned int Size);
+void XHdcp22Tx_InitDcpKey(XHdcp22_Tx_DcpKey *DcpKeyPtr,
+                          const u8* KpubDcpNPtr, int KpubDcpNSize,
+                          const u8* KpubDcpEPtr, int KpubDcpESize);
 int XHdcp22Tx_VerifyCertificate(const XHdcp22_Tx_CertRx *CertificatePtr,
-                                const u8* KpubDcpNPtr, int KpubDcpNSize,
-                                const u8* KpubDcpEPtr, int KpubDcpESize);
+                                const XHdcp22_Tx_DcpKey *DcpKeyPtr);
 int XHdcp22Tx_VerifySRM(const u8* SrmPtr, int SrmSize,
-                        const u8* KpubDcpNPtr, int KpubDcpNSize,
-                        const u8* KpubDcpEPtr, int KpubDcpESize);
+                        const XHdcp22_Tx_DcpKey *DcpKeyPtr);
+void XHdcp22Tx_ComputeCertHash(const XHdcp22_Tx_CertRx *CertificatePtr,
+                               u8 *CertHash);
 void XHdcp22Tx_ComputeHPrime(const u8 *Rrx, const u8 *RxCaps,
                              const u8* Rtx,  const u8 *TxCaps,
                              const u8 *Km, u8 *HPrime);
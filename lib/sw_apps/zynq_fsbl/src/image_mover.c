@@ -102,6 +102,14 @@
 #define MAXIMUM_IMAGE_WORD_LEN 0x40000000
 #define MD5_CHECKSUM_SIZE   16
 
+/*
+ * Partitions copied by the CPU from non-linear boot devices are read and
+ * hashed in chunks of this size, must be a multiple of 64 bytes
+ */
+#ifndef PARTITION_CHECKSUM_CHUNK_SIZE
+#define PARTITION_CHECKSUM_CHUNK_SIZE	0x10000
+#endif
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -110,6 +118,7 @@
 u32 ValidateParition(u32 StartAddr, u32 Length, u32 ChecksumOffset);
 u32 GetPartitionChecksum(u32 ChecksumOffset, u8 *Checksum);
 u32 CalcPartitionChecksum(u32 SourceAddr, u32 DataLength, u8 *Checksum);
+u32 MoveImageChecksum(u32 SourceAddr, u32 DestAddr, u32 LengthBytes);
 
 /************************** Variable Definitions *****************************/
 /*
@@ -126,6 +135,15 @@ u8 ApplicationFlag;
 u32 ExecutionAddress;
 ImageMoverType MoveImage;
 
+/*
+ * Checksum of the partition hashed while it was moved, valid when
+ * StreamChecksumFlag is set
+ */
+static MD5Context StreamChecksumContext;
+static u32 StreamChecksumAddr;
+static u32 StreamChecksumLength;
+static u8 StreamChecksumFlag;
+
 /*
  * Header array
  */
@@ -1063,6 +1081,8 @@ u32 PartitionMove(u32 ImageBaseAddress, PartHeader *Header)
     u32 ImageWordLen;
     u32 DataWordLen;
 
+	StreamChecksumFlag = 0;
+
 	SourceAddr = ImageBaseAddress;
 	SourceAddr += Header->PartitionStart<<WORD_LENGTH_SHIFT;
 	LoadAddr = Header->LoadAddr;
@@ -1114,9 +1134,18 @@ u32 PartitionMove(u32 ImageBaseAddress, PartHeader *Header)
 			LoadAddr = DDR_TEMP_START_ADDR;
 		}
 
-		Status = MoveImage(SourceAddr,
+		if (PartitionChecksumFlag) {
+			/*
+			 * Hash each chunk as soon as it is read from flash
+			 */
+			Status = MoveImageChecksum(SourceAddr,
+						LoadAddr,
+						(ImageWordLen << WORD_LENGTH_SHIFT));
+		} else {
+			Status = MoveImage(SourceAddr,
 						LoadAddr,
 						(ImageWordLen << WORD_LENGTH_SHIFT));
+		}
 		if(Status != XST_SUCCESS) {
 			fsbl_printf(DEBUG_GENERAL, "Move Image Failed\r\n");
 			return XST_FAILURE;
@@ -1338,6 +1367,18 @@ u32 GetPartitionChecksum(u32 ChecksumOffset, u8 *Checksum)
 *******************************************************************************/
 u32 CalcPartitionChecksum(u32 SourceAddr, u32 DataLength, u8 *Checksum)
 {
+	/*
+	 * Use the checksum calculated while the partition was moved
+	 */
+	if ((StreamChecksumFlag) &&
+			(StreamChecksumAddr == SourceAddr) &&
+			(StreamChecksumLength == DataLength)) {
+		MD5Final(&StreamChecksumContext, Checksum, 0);
+		StreamChecksumFlag = 0;
+
+		return XST_SUCCESS;
+	}
+
 	/*
 	 * Calculate checksum using MD5 algorithm
 	 */
@@ -1346,3 +1387,61 @@ u32 CalcPartitionChecksum(u32 SourceAddr, u32 DataLength, u8 *Checksum)
     return XST_SUCCESS;
 }
 
+
+/******************************************************************************/
+/**
+*
+* This function moves the partition from a non-linear boot device in chunks
+* and updates the partition checksum with each chunk right after it is read,
+* so that no second pass over the partition is needed after the move. The
+* checksum is completed by CalcPartitionChecksum
+*
+* @param 	SourceAddr Source address on flash
+* @param 	DestAddr Destination address in memory
+* @param 	LengthBytes Length of the partition in bytes
+*
+* @return
+*		- XST_SUCCESS if move successful
+*		- XST_FAILURE if move failed
+*
+* @note		None
+*
+*******************************************************************************/
+u32 MoveImageChecksum(u32 SourceAddr, u32 DestAddr, u32 LengthBytes)
+{
+	u32 Status;
+	u32 Offset;
+	u32 ChunkSize;
+
+	StreamChecksumFlag = 0;
+	MD5Init(&StreamChecksumContext);
+
+	for (Offset = 0; Offset < LengthBytes; Offset += ChunkSize) {
+		ChunkSize = LengthBytes - Offset;
+		if (ChunkSize > PARTITION_CHECKSUM_CHUNK_SIZE) {
+			ChunkSize = PARTITION_CHECKSUM_CHUNK_SIZE;
+		}
+
+		Status = MoveImage(SourceAddr + Offset, DestAddr + Offset, ChunkSize);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+#ifdef	XPAR_XWDTPS_0_BASEADDR
+		/*
+		 * Prevent WDT reset
+		 */
+		XWdtPs_RestartWdt(&Watchdog);
+#endif
+
+		MD5Update(&StreamChecksumContext, (u8*)(DestAddr + Offset),
+				ChunkSize, 0);
+	}
+
+	StreamChecksumAddr = DestAddr;
+	StreamChecksumLength = LengthBytes;
+	StreamChecksumFlag = 1;
+
+	return XST_SUCCESS;
+}
+
@@ -68,7 +68,6 @@
 * ----- ---- -------- -------------------------------------------------------
 * 5.00a sgd	05/17/13 Initial release
 *
-*
 * </pre>
 *
 * @note
@@ -97,6 +96,24 @@
 inline void * MD5Memset( void *dest, int	ch, u32	count )
 {
 	register char *dst8 = (char*)dest;
+	register u32 *dst32;
+	register u32 fill;
+
+	if( ( ( (UINTPTR)dst8 ) & 3U ) == 0U ) {
+		/*
+		 * Fill whole words first, the remainder is done byte-wise
+		 */
+		fill = (u8)ch;
+		fill |= fill << 8;
+		fill |= fill << 16;
+		dst32 = (u32*)dst8;
+
+		while( count >= sizeof( u32 ) ) {
+			*dst32++ = fill;
+			count -= sizeof( u32 );
+		}
+		dst8 = (char*)dst32;
+	}
 
 	while( count-- )
 		*dst8++ = ch;
@@ -125,13 +142,41 @@ inline void * MD5Memcpy( void *dest, const void *src,
 {
 	register char * dst8 = (char*)dest;
 	register char * src8 = (char*)src;
-	
+	register u32 * dst32;
+	register const u32 * src32;
+	register u32 word;
+	u32 aligned = ( ( ( (UINTPTR)dst8 | (UINTPTR)src8 ) & 3U ) == 0U );
+
 	if( doByteSwap == FALSE ) {
+		if( aligned ) {
+			dst32 = (u32*)dst8;
+			src32 = (const u32*)src8;
+
+			while( count >= sizeof( u32 ) ) {
+				*dst32++ = *src32++;
+				count -= sizeof( u32 );
+			}
+			dst8 = (char*)dst32;
+			src8 = (char*)src32;
+		}
+
 		while( count-- )
 			*dst8++ = *src8++;
 	} else {
 		count /= sizeof( u32 );
-		
+
+		if( aligned ) {
+			dst32 = (u32*)dst8;
+			src32 = (const u32*)src8;
+
+			while( count-- ) {
+				word = *src32++;
+				*dst32++ = ( word >> 24 ) | ( ( word >> 8 ) & 0xFF00U ) |
+					( ( word << 8 ) & 0xFF0000U ) | ( word << 24 );
+			}
+			return dest;
+		}
+
 		while( count-- ) {
 			dst8[ 0 ] = src8[ 3 ];
 			dst8[ 1 ] = src8[ 2 ];
@@ -354,9 +399,19 @@ inline void MD5Update( MD5Context *context, u8 *buffer,
 	}
 		
 	/*
-	 * Process data in 64-byte, 512 bit, chunks
+	 * Process data in 64-byte, 512 bit, chunks. Word aligned input that
+	 * needs no swapping is transformed in place, without the copy
 	 */
 
+	if( ( doByteSwap == FALSE ) && ( ( ( (UINTPTR)buffer ) & 3U ) == 0U ) ) {
+		while( len >= MD5_SIGNATURE_BYTE_SIZE ) {
+			MD5Transform( context->buffer, (u32 *)buffer );
+
+			buffer += MD5_SIGNATURE_BYTE_SIZE;
+			len    -= MD5_SIGNATURE_BYTE_SIZE;
+		}
+	}
+
 	while( len >= MD5_SIGNATURE_BYTE_SIZE ) {
 		MD5Memcpy( context->intermediate, buffer, MD5_SIGNATURE_BYTE_SIZE,
 				 doByteSwap );
@@ -73,10 +73,19 @@
 u32 XFsbl_SpkVer(u64 AcOffset, u32 HashLen);
 u32 XFsbl_PpkVer(u64 AcOffset, u32 HashLen);
 void XFsbl_ReadPpkHash(u32 *PpkHash, u8 PpkSelect);
+static u32 XFsbl_PpkSignVer(u8 *AcPtr, u8 *SpkHash, u32 HashLen);
 /*****************************************************************************/
 
 static XSecure_Rsa SecureRsa;
 
+/* Hash of auth header and SPK last verified with the PPK */
+static u8 VerifiedSpkHash[XFSBL_HASH_TYPE_SHA3] __attribute__ ((aligned (4)));
+static u8 IsSpkHashValid = FALSE;
+
+/* Verified SPK, the key of SecureRsa when IsSpkLoaded */
+static u8 SpkKey[XFSBL_SPK_SIZE] __attribute__ ((aligned (32)));
+static u8 IsSpkLoaded = FALSE;
+
 #if defined(XFSBL_BS)
 extern u8 ReadBuffer[READ_BUFFER_SIZE];
 #endif
@@ -102,17 +111,11 @@ u8 EfusePpkKey[XFSBL_PPK_SIZE]__attribute__ ((aligned (32))) = {0U};
 u32 XFsbl_SpkVer(u64 AcOffset, u32 HashLen)
 {
 	u8 SpkHash[XFSBL_HASH_TYPE_SHA3] __attribute__ ((aligned (4)))={0};
-	u8* PpkModular;
-	u8* PpkModularEx;
-	u8* PpkExpPtr;
-	u32 PpkExp;
 	u8 * AcPtr = (u8*) (PTRSIZE) AcOffset;
 	u8 SpkIdFuseSel = ((*(u32 *)(AcPtr) & XFSBL_AH_ATTR_SPK_ID_FUSE_SEL_MASK)) >>
 		                                        XFSBL_AH_ATTR_SPK_ID_FUSE_SEL_SHIFT;
 	u32 Status;
 	void * ShaCtx = (void * )NULL;
-	u8 XFsbl_RsaSha3Array[512] = {0};
-	u8 *PpkKey = EfusePpkKey;
 	u32 EfuseRsa = XFsbl_In32(EFUSE_SEC_CTRL);
 	u32 EfuseSpkId;
 	u32 *SpkId = (u32 *)(AcPtr + XFSBL_SPKID_AC_ALIGN);
@@ -153,6 +156,100 @@ u32 XFsbl_SpkVer(u64 AcOffset, u32 HashLen)
 
 	XFsbl_ShaFinish(ShaCtx, (u8 *)SpkHash, HashLen);
 
+	/* An SPK verified before with the same PPK needs no RSA operation */
+	if ((IsSpkHashValid == TRUE) && (XFsbl_CompareHashs(SpkHash,
+			VerifiedSpkHash, HashLen) == XFSBL_SUCCESS)) {
+		XFsbl_Printf(DEBUG_DETAILED,
+			"XFsbl_SpkVer: SPK verified before\r\n");
+	}
+	else {
+		Status = XFsbl_PpkSignVer(AcPtr, SpkHash, HashLen);
+		if (Status != XFSBL_SUCCESS) {
+			goto END;
+		}
+	}
+
+	/* SPK revocation check */
+	if ((EfuseRsa & EFUSE_SEC_CTRL_RSA_EN_MASK) != 0x00) {
+		EfuseSpkId = Xil_In32(EFUSE_SPKID);
+
+		/* If SPKID Efuse is selected , Verifies SPKID with Efuse SPKID*/
+		if (SpkIdFuseSel == XFSBL_SPKID_EFUSE) {
+			if (EfuseSpkId != *SpkId) {
+				Status = XFSBL_ERROR_SPKID_VERIFICATION;
+				XFsbl_Printf(DEBUG_INFO,
+						"Image's SPK ID : %x\n\r", *SpkId);
+				XFsbl_Printf(DEBUG_INFO,
+						"eFUSE SPK ID: %x\n\r", EfuseSpkId);
+				XFsbl_Printf(DEBUG_GENERAL,
+						"XFsbl_SpkVer: "
+						"XFSBL_ERROR_SPKID_VERIFICATION\r\n");
+				goto END;
+			}
+		}
+		/*
+		 * If User EFUSE is selected, checks the corresponding User-Efuse bit
+		 * programmed or not. If Programmed (indicates that key is revocated)
+		 * throws an error
+		 */
+		else if (SpkIdFuseSel == XFSBL_USER_EFUSE) {
+			if ((*SpkId >= XFSBL_USER_EFUSE_MIN_VALUE) &&
+				(*SpkId <= XFSBL_USER_EFUSE_MAX_VALUE)) {
+				UserFuseAddr = XFSBL_USER_EFUSE_ADDR +
+								(((*SpkId - 1) / XFSBL_WORD_SHIFT) *
+											XFSBL_WORD_LEN_IN_BYTES);
+				UserFuseVal = Xil_In32(UserFuseAddr);
+				if ((UserFuseVal & (0x1U << ((*SpkId - 1) %
+									XFSBL_WORD_SHIFT))) != 0x0U) {
+					Status = XFSBL_ERROR_USER_EFUSE_ISREVOKED;
+					XFsbl_Printf(DEBUG_GENERAL,
+							"XFsbl_SpkVer: "
+							"XFSBL_ERROR_USER_EFUSE_ISREVOKED\r\n");
+					goto END;
+				}
+			}
+			else {
+				Status = XFSBL_ERROR_OUT_OF_RANGE_USER_EFUSE;
+				XFsbl_Printf(DEBUG_GENERAL,
+								"XFsbl_SpkVer: "
+								"XFSBL_ERROR_OUT_OF_RANGE_USER_EFUSE\r\n");
+				goto END;
+			}
+		}
+	}
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Verifies the SPK signature of an authentication certificate with the PPK
+ * saved at boot header authentication, and keeps the SPK hash as verified.
+ *
+ * @param	AcPtr is the address of the authentication certificate
+ * @param	SpkHash is the hash of auth header and SPK
+ * @param	HashLen is the length of the hash
+ *
+ * @return	XFSBL_SUCCESS on success, else an error code
+ *
+ * @note	SecureRsa holds the PPK afterwards, so the SPK has to be set
+ *		again by XFsbl_VerifyWithSpk().
+ *
+ ******************************************************************************/
+static u32 XFsbl_PpkSignVer(u8 *AcPtr, u8 *SpkHash, u32 HashLen)
+{
+	u8* PpkModular;
+	u8* PpkModularEx;
+	u8* PpkExpPtr;
+	u32 PpkExp;
+	u32 Status;
+	u8 XFsbl_RsaSha3Array[512] = {0};
+	u8 *PpkKey = EfusePpkKey;
+
+	IsSpkHashValid = FALSE;
+	IsSpkLoaded = FALSE;
+
 	/* Set PPK pointer */
 	PpkModular = (u8 *)PpkKey;
 	PpkKey += XFSBL_PPK_MOD_SIZE;
@@ -163,8 +260,8 @@ u32 XFsbl_SpkVer(u64 AcOffset, u32 HashLen)
 
 	if((PpkModular != NULL) && (PpkModularEx != NULL)) {
 	XFsbl_Printf(DEBUG_DETAILED,
-		"XFsbl_SpkVer: Ppk Mod %0x, Ppk Mod Ex %0x, Ppk Exp %0x\r\n",
-		PpkModular, PpkModularEx, PpkExp);
+		"XFsbl_SpkVer: Ppk Mod %0lx, Ppk Mod Ex %0lx, Ppk Exp %0x\r\n",
+		(PTRSIZE)PpkModular, (PTRSIZE)PpkModularEx, PpkExp);
 		XFsbl_PrintArray(DEBUG_DETAILED, PpkModular, XFSBL_PPK_MOD_SIZE, "Ppk Modular");
 		XFsbl_PrintArray(DEBUG_DETAILED, PpkModularEx, XFSBL_PPK_MOD_EXT_SIZE, "Ppk ModularEx");
 		XFsbl_Printf(DEBUG_DETAILED, "Ppk Exp = %x\n\r", PpkExp);
@@ -210,55 +307,74 @@ u32 XFsbl_SpkVer(u64 AcOffset, u32 HashLen)
 		goto END;
 	}
 
-	/* SPK revocation check */
-	if ((EfuseRsa & EFUSE_SEC_CTRL_RSA_EN_MASK) != 0x00) {
-		EfuseSpkId = Xil_In32(EFUSE_SPKID);
+	/* SPK is verified, keep its hash for the next partitions */
+	XFsbl_MemCpy(VerifiedSpkHash, SpkHash, HashLen);
+	IsSpkHashValid = TRUE;
 
-		/* If SPKID Efuse is selected , Verifies SPKID with Efuse SPKID*/
-		if (SpkIdFuseSel == XFSBL_SPKID_EFUSE) {
-			if (EfuseSpkId != *SpkId) {
-				Status = XFSBL_ERROR_SPKID_VERIFICATION;
-				XFsbl_Printf(DEBUG_INFO,
-						"Image's SPK ID : %x\n\r", SpkId);
-				XFsbl_Printf(DEBUG_INFO,
-						"eFUSE SPK ID: %x\n\r", EfuseSpkId);
-				XFsbl_Printf(DEBUG_GENERAL,
-						"XFsbl_SpkVer: "
-						"XFSBL_ERROR_SPKID_VERIFICATION\r\n");
-				goto END;
-			}
-		}
-		/*
-		 * If User EFUSE is selected, checks the corresponding User-Efuse bit
-		 * programmed or not. If Programmed (indicates that key is revocated)
-		 * throws an error
-		 */
-		else if (SpkIdFuseSel == XFSBL_USER_EFUSE) {
-			if ((*SpkId >= XFSBL_USER_EFUSE_MIN_VALUE) &&
-				(*SpkId <= XFSBL_USER_EFUSE_MAX_VALUE)) {
-				UserFuseAddr = XFSBL_USER_EFUSE_ADDR +
-								(((*SpkId - 1) / XFSBL_WORD_SHIFT) *
-											XFSBL_WORD_LEN_IN_BYTES);
-				UserFuseVal = Xil_In32(UserFuseAddr);
-				if ((UserFuseVal & (0x1U << ((*SpkId - 1) %
-									XFSBL_WORD_SHIFT))) != 0x0U) {
-					Status = XFSBL_ERROR_USER_EFUSE_ISREVOKED;
-					XFsbl_Printf(DEBUG_GENERAL,
-							"XFsbl_SpkVer: "
-							"XFSBL_ERROR_USER_EFUSE_ISREVOKED\r\n");
-					goto END;
-				}
-			}
-			else {
-				Status = XFSBL_ERROR_OUT_OF_RANGE_USER_EFUSE;
-				XFsbl_Printf(DEBUG_GENERAL,
-								"XFsbl_SpkVer: "
-								"XFSBL_ERROR_OUT_OF_RANGE_USER_EFUSE\r\n");
-				goto END;
-			}
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Verifies a signature with the SPK of an authentication certificate. The
+ * SPK is copied and set as the key of SecureRsa once and is kept while
+ * XFsbl_SpkVer() finds the same SPK. The RSA core itself is loaded with the
+ * key again for every signature.
+ *
+ * @param	AcOffset is the address of the authentication certificate
+ * @param	Signature is the signature to be verified
+ * @param	Hash is the hash of the signed data
+ * @param	HashLen is the length of the hash
+ * @param	RsaResult is a buffer of 512 bytes for the decrypted signature
+ *
+ * @return
+ *		XFSBL_SUCCESS if the signature matches the hash
+ *		XFSBL_ERROR_RSA_INITIALIZE if the SPK could not be set
+ *		XSECURE_RSA_SIGN_VERIFY_ERROR if the signature does not match
+ *		other values on RSA failure
+ *
+ * @note	The SPK of the certificate must have been verified by
+ *		XFsbl_SpkVer() just before.
+ *
+ ******************************************************************************/
+u32 XFsbl_VerifyWithSpk(u64 AcOffset, u8 *Signature, u8 *Hash, u32 HashLen,
+				u8 *RsaResult)
+{
+	u8 * AcPtr = (u8*)(PTRSIZE) AcOffset;
+	u8 * SpkModular = SpkKey;
+	u8 * SpkModularEx = SpkKey + XFSBL_SPK_MOD_SIZE;
+	u8 * SpkExpPtr = SpkModularEx + XFSBL_SPK_MOD_EXT_SIZE;
+	u32 Status;
+	s32 SStatus;
+
+	if (IsSpkLoaded == FALSE) {
+		XFsbl_MemCpy(SpkKey, AcPtr + XFSBL_AUTH_CERT_SPK_OFFSET,
+					XFSBL_SPK_SIZE);
+		XFsbl_Printf(DEBUG_DETAILED,
+			"XFsbl_VerifyWithSpk: Spk Mod %0lx, Spk Mod Ex %0lx,"
+			" Spk Exp %0x\r\n", (PTRSIZE)SpkModular,
+			(PTRSIZE)SpkModularEx,
+			*((u32 *)SpkExpPtr));
+		XFsbl_PrintArray(DEBUG_DETAILED, SpkModular,
+			XFSBL_SPK_MOD_SIZE, "Spk Modular");
+		XFsbl_PrintArray(DEBUG_DETAILED, SpkModularEx,
+			XFSBL_SPK_MOD_EXT_SIZE, "Spk ModularEx");
+
+		SStatus = XSecure_RsaInitialize(&SecureRsa, SpkModular,
+					SpkModularEx, SpkExpPtr);
+		if (SStatus != XFSBL_SUCCESS) {
+			Status = XFSBL_ERROR_RSA_INITIALIZE;
+			XFsbl_Printf(DEBUG_GENERAL,
+				"XFSBL_ERROR_RSA_INITIALIZE\r\n");
+			goto END;
 		}
+		IsSpkLoaded = TRUE;
 	}
 
+	Status = (u32)XSecure_RsaVerify(&SecureRsa, Signature, Hash, HashLen,
+					RsaResult);
+
 END:
 	return Status;
 }
@@ -282,16 +398,12 @@ static u32 XFsbl_PartitionSignVer(const XFsblPs *FsblInstancePtr, u64 PartitionO
 {
 
 	u8 PartitionHash[XFSBL_HASH_TYPE_SHA3] __attribute__ ((aligned (4))) = {0};
-	u8 * SpkModular;
-	u8* SpkModularEx;
-	u32 SpkExp;
 	u8 * AcPtr = (u8*)(PTRSIZE) AcOffset;
 	u32 Status;
 	u32 HashDataLen;
 	void * ShaCtx = (void * )NULL;
 	u8 XFsbl_RsaSha3Array[512] = {0};
 	u32 HashLen = XFSBL_HASH_TYPE_SHA3;
-	s32 SStatus;
 
 	XFsbl_Printf(DEBUG_INFO, "Doing Partition Sign verification\r\n");
 
@@ -334,6 +446,9 @@ static u32 XFsbl_PartitionSignVer(const XFsblPs *FsblInstancePtr, u64 PartitionO
 							HashDataLen, HashLen);
 	}
 #else
+	(void)FsblInstancePtr;
+	(void)PartitionNum;
+
 	/* SHA calculation in DDRful systems */
 	XFsbl_ShaUpdate(ShaCtx, (u8 *)(PTRSIZE)PartitionOffset, HashDataLen, HashLen);
 
@@ -345,51 +460,19 @@ static u32 XFsbl_PartitionSignVer(const XFsblPs *FsblInstancePtr, u64 PartitionO
 
 	XFsbl_ShaFinish(ShaCtx, (u8 *)PartitionHash, HashLen);
 
-	/* Set SPK pointer */
-	AcPtr += (XFSBL_RSA_AC_ALIGN + XFSBL_PPK_SIZE);
-	SpkModular = AcPtr;
-	AcPtr += XFSBL_SPK_MOD_SIZE;
-	SpkModularEx = AcPtr;
-	AcPtr += XFSBL_SPK_MOD_EXT_SIZE;
-	SpkExp = *((u32 *)AcPtr);
-	AcPtr += XFSBL_RSA_AC_ALIGN;
-
-	/* Increment by  SPK Signature pointer */
-	AcPtr += XFSBL_SPK_SIG_SIZE;
-	/* Increment by  BHDR Signature pointer */
-	AcPtr += XFSBL_BHDR_SIG_SIZE;
-	if((SpkModular != NULL) && (SpkModularEx != NULL)) {
-	XFsbl_Printf(DEBUG_DETAILED,
-		"XFsbl_PartVer: Spk Mod %0x, Spk Mod Ex %0x, Spk Exp %0x\r\n",
-		SpkModular, SpkModularEx, SpkExp);
-		XFsbl_PrintArray(DEBUG_DETAILED, SpkModular, XFSBL_SPK_MOD_SIZE, "Spk Modular");
-		XFsbl_PrintArray(DEBUG_DETAILED, SpkModularEx, XFSBL_SPK_MOD_EXT_SIZE, "Spk ModularEx");
-		XFsbl_Printf(DEBUG_DETAILED, "Spk Exp %x\n\r", SpkExp);
-	}
+	/* Set Partition Signature pointer, after SPK and BHDR signatures */
+	AcPtr += XFSBL_AUTH_CERT_SPK_SIG_OFFSET + XFSBL_SPK_SIG_SIZE +
+			XFSBL_BHDR_SIG_SIZE;
 	XFsbl_Printf(DEBUG_INFO,
 			"Partition Verification done \r\n");
 
-	SStatus = XSecure_RsaInitialize(&SecureRsa, SpkModular,
-				SpkModularEx, (u8 *)&SpkExp);
-	if (SStatus != XFSBL_SUCCESS) {
-		Status = XFSBL_ERROR_RSA_INITIALIZE;
-		XFsbl_Printf(DEBUG_GENERAL, "XFSBL_ERROR_RSA_INITIALIZE\r\n");
+	/* Decrypt and authenticate Partition Signature */
+	Status = XFsbl_VerifyWithSpk(AcOffset, AcPtr, PartitionHash, HashLen,
+				XFsbl_RsaSha3Array);
+	if (Status == XFSBL_ERROR_RSA_INITIALIZE) {
 		goto END;
 	}
-	/* Decrypt Partition Signature. */
-	if(XFSBL_SUCCESS !=
-		XSecure_RsaPublicEncrypt(&SecureRsa, AcPtr, XSECURE_RSA_4096_KEY_SIZE,
-				XFsbl_RsaSha3Array))
-	{
-		XFsbl_Printf(DEBUG_GENERAL,
-			"XFsbl_SpkVer: XFSBL_ERROR_PART_RSA_DECRYPT\r\n");
-		Status = XFSBL_ERROR_PART_RSA_DECRYPT;
-		goto END;
-	}
-
-	/* Authenticate Partition Signature */
-	if(XFSBL_SUCCESS != XSecure_RsaSignVerification(XFsbl_RsaSha3Array,
-				PartitionHash, HashLen))
+	if (Status == XSECURE_RSA_SIGN_VERIFY_ERROR)
 	{
 		XFsbl_PrintArray(DEBUG_INFO, PartitionHash,
 				HashLen, "Calculated Partition Hash");
@@ -400,7 +483,13 @@ static u32 XFsbl_PartitionSignVer(const XFsblPs *FsblInstancePtr, u64 PartitionO
 		Status = XFSBL_ERROR_PART_SIGNATURE;
 		goto END;
 	}
-	Status = XFSBL_SUCCESS;
+	if (Status != XFSBL_SUCCESS)
+	{
+		XFsbl_Printf(DEBUG_GENERAL,
+			"XFsbl_PartVer: XFSBL_ERROR_PART_RSA_DECRYPT\r\n");
+		Status = XFSBL_ERROR_PART_RSA_DECRYPT;
+		goto END;
+	}
 END:
 	return Status;
 }
@@ -421,8 +510,8 @@ u32 XFsbl_Authentication(const XFsblPs * FsblInstancePtr, u64 PartitionOffset,
         u32 HashLen = XFSBL_HASH_TYPE_SHA3;
 
 	XFsbl_Printf(DEBUG_INFO,
-		"Auth: Partition Offset %0x, PartitionLen %0x,"
-		" AcOffset %0x, HashLen %0x\r\n",
+		"Auth: Partition Offset %0lx, PartitionLen %0x,"
+		" AcOffset %0lx, HashLen %0x\r\n",
 		(PTRSIZE )PartitionOffset, PartitionLen,
 		(PTRSIZE )AcOffset, HashLen);
         /* Do SPK Signature verification using PPK */
@@ -468,28 +557,34 @@ u32 XFsbl_ShaUpdate_DdrLess(const XFsblPs *FsblInstancePtr, void *Ctx,
 	u32 Status = XFSBL_SUCCESS;
 	/**
 	 * bitstream partion in DDR less system, Chunk by chunk copy
-	 * into OCM and update SHA module
+	 * into OCM and update SHA module. The two halves of the read
+	 * buffer are used alternately, so that the next chunk is copied
+	 * from the device while the CSU DMA feeds the previous one to SHA
 	 */
-	u32 NumChunks = 0U;
-	u32 RemainingBytes = 0U;
-	u32 Index = 0U;
+	u32 ChunkSize = READ_BUFFER_SIZE / 2U;
+	u32 BufferIndex = 0U;
+	u32 Offset;
+	u32 Len;
+	u8 *Buffer;
 	u32 StartAddrByte = PartitionOffset;
 
-	NumChunks = PartitionLen / READ_BUFFER_SIZE;
-	RemainingBytes = (PartitionLen % READ_BUFFER_SIZE);
-
 			/* Start the SHA engine */
 		(void)XFsbl_ShaStart(Ctx, HashLen);
 
 		XFsbl_Printf(DEBUG_INFO,
 			"XFsbl_PartitionVer: NumChunks :%0d, RemainingBytes : %0d \r\n",
-			NumChunks, RemainingBytes);
+			PartitionLen / ChunkSize, PartitionLen % ChunkSize);
 
-		for(Index = 0; Index < NumChunks; Index++)
+		for (Offset = 0U; Offset < PartitionLen; Offset += Len)
 		{
+			Len = PartitionLen - Offset;
+			if (Len > ChunkSize) {
+				Len = ChunkSize;
+			}
+			Buffer = &ReadBuffer[BufferIndex * ChunkSize];
+
 			if(XFSBL_SUCCESS !=FsblInstancePtr->DeviceOps.DeviceCopy(
-					StartAddrByte, (PTRSIZE)ReadBuffer,
-					READ_BUFFER_SIZE))
+					StartAddrByte + Offset, (PTRSIZE)Buffer, Len))
 			{
 				XFsbl_Printf(DEBUG_GENERAL,
 					"XFsblPartitionVer: Device "
@@ -498,30 +593,24 @@ u32 XFsbl_ShaUpdate_DdrLess(const XFsblPs *FsblInstancePtr, void *Ctx,
 				goto END;
 			}
 
-			XFsbl_ShaUpdate(Ctx, (u8 *)ReadBuffer,
-						READ_BUFFER_SIZE, HashLen);
-
-			StartAddrByte += READ_BUFFER_SIZE;
-		}
+			/* Previous chunk has to be hashed before the next update */
+			Status = XFsbl_ShaUpdateWait(Ctx, HashLen);
+			if (XFSBL_SUCCESS != Status) {
+				goto END;
+			}
 
-		/* Send the residual bytes if Size is not buffer size multiple */
-		if(RemainingBytes != 0)
-		{
-			if(XFSBL_SUCCESS!=FsblInstancePtr->DeviceOps.DeviceCopy(
-						StartAddrByte, (PTRSIZE)ReadBuffer,
-						RemainingBytes))
-			{
-				XFsbl_Printf(DEBUG_GENERAL,
-					"XFsblPartitionVer: Device "
-					"to OCM copy of partition failed (last chunk)\r\n");
-				Status = XFSBL_FAILURE;
+			Status = XFsbl_ShaUpdateStart(Ctx, Buffer, Len, HashLen);
+			if (XFSBL_SUCCESS != Status) {
 				goto END;
 			}
 
-			XFsbl_ShaUpdate(Ctx, (u8 *)ReadBuffer,
-						RemainingBytes, HashLen);
+			BufferIndex ^= 1U;
 		}
 END:
+		/* Last chunk, or the one in progress on an error */
+		if (XFSBL_SUCCESS != XFsbl_ShaUpdateWait(Ctx, HashLen)) {
+			Status = XFSBL_FAILURE;
+		}
 		return Status;
 
 }
@@ -697,9 +786,6 @@ u32 XFsbl_BhAuthentication(const XFsblPs * FsblInstancePtr, u8 *Data,
 	void * ShaCtx = (void * )NULL;
 	u32 SizeofBH;
 	u8 BhHash[XFSBL_HASH_TYPE_SHA3] __attribute__ ((aligned (4)))={0};
-	u8 * SpkModular;
-	u8* SpkModularEx;
-	u32 SpkExp;
 	u8 XFsbl_RsaSha3Array[512] = {0};
 	u8 * AcPtr = (u8*) (PTRSIZE) AcOffset;
 
@@ -732,6 +818,9 @@ u32 XFsbl_BhAuthentication(const XFsblPs * FsblInstancePtr, u8 *Data,
 	/* Copy PPK to global variable for future use */
 	XFsbl_MemCpy(EfusePpkKey, AcPtr + XFSBL_AUTH_CERT_PPK_OFFSET,
 						XFSBL_PPK_SIZE);
+	/* SPKs verified with a previous PPK are not valid anymore */
+	IsSpkHashValid = FALSE;
+	IsSpkLoaded = FALSE;
 
 	/* SPK verify */
 	Status = XFsbl_SpkVer(AcOffset, HashLen);
@@ -755,53 +844,16 @@ u32 XFsbl_BhAuthentication(const XFsblPs * FsblInstancePtr, u8 *Data,
 	XFsbl_ShaUpdate(ShaCtx, Data, SizeofBH, HashLen);
 	XFsbl_ShaFinish(ShaCtx, BhHash, HashLen);
 
-	/* Set SPK pointer */
-	AcPtr += (XFSBL_RSA_AC_ALIGN + XFSBL_PPK_SIZE);
-	SpkModular = AcPtr;
-	AcPtr += XFSBL_SPK_MOD_SIZE;
-	SpkModularEx = AcPtr;
-	AcPtr += XFSBL_SPK_MOD_EXT_SIZE;
-	SpkExp = *((u32 *)AcPtr);
-	AcPtr += XFSBL_RSA_AC_ALIGN;
-
-	/* Increment by  SPK Signature pointer */
-	AcPtr += XFSBL_SPK_SIG_SIZE;
+	/* Set BHDR Signature pointer, after SPK signature */
+	AcPtr += XFSBL_AUTH_CERT_SPK_SIG_OFFSET + XFSBL_SPK_SIG_SIZE;
 
-	if((SpkModular != NULL) && (SpkModularEx != NULL)) {
-		XFsbl_Printf(DEBUG_DETAILED,
-			"XFsbl_BhAuthentication: "
-			"Spk Mod %0x, Spk Mod Ex %0x, Spk Exp %0x\r\n",
-		SpkModular, SpkModularEx, SpkExp);
-		XFsbl_PrintArray(DEBUG_DETAILED, SpkModular,
-			XFSBL_SPK_MOD_SIZE, "Spk Modular");
-		XFsbl_PrintArray(DEBUG_DETAILED, SpkModularEx,
-			XFSBL_SPK_MOD_EXT_SIZE, "Spk ModularEx");
-		XFsbl_Printf(DEBUG_DETAILED, "Spk Exp = %x\n\r", SpkExp);
-	}
-
-	/* Set SPK Signature pointer */
-	Status = XSecure_RsaInitialize(&SecureRsa, SpkModular,
-					SpkModularEx, (u8 *)&SpkExp);
-
-	if (Status != XFSBL_SUCCESS) {
-		Status = XFSBL_ERROR_RSA_INITIALIZE;
-		XFsbl_Printf(DEBUG_GENERAL, "XFSBL_ERROR_RSA_INITIALIZE\r\n");
+	/* Decrypt and authenticate BHDR Signature */
+	Status = XFsbl_VerifyWithSpk(AcOffset, AcPtr, BhHash, HashLen,
+				XFsbl_RsaSha3Array);
+	if (Status == XFSBL_ERROR_RSA_INITIALIZE) {
 		goto END;
 	}
-	/* Decrypt SPK Signature */
-	if(XFSBL_SUCCESS !=
-		XSecure_RsaPublicEncrypt(&SecureRsa, AcPtr, XSECURE_RSA_4096_KEY_SIZE,
-				XFsbl_RsaSha3Array))
-	{
-		XFsbl_Printf(DEBUG_GENERAL,"XFsbl_BhAuthentication:"
-				" XFSBL_ERROR_BH_RSA_DECRYPT\r\n");
-			Status = XFSBL_ERROR_BH_RSA_DECRYPT;
-		goto END;
-	}
-
-	/* Authenticate SPK Signature */
-	if(XFSBL_SUCCESS != XSecure_RsaSignVerification(XFsbl_RsaSha3Array,
-			BhHash, HashLen))
+	if (Status == XSECURE_RSA_SIGN_VERIFY_ERROR)
 	{
 		XFsbl_PrintArray(DEBUG_INFO, BhHash,
 				HashLen, "Calculated Boot header Hash");
@@ -811,6 +863,11 @@ u32 XFsbl_BhAuthentication(const XFsblPs * FsblInstancePtr, u8 *Data,
 			"XFsbl_BhAuthentication: XFSBL_ERROR_BH_SIGNATURE\r\n");
 		Status = XFSBL_ERROR_BH_SIGNATURE;
 	}
+	else if (Status != XFSBL_SUCCESS) {
+		XFsbl_Printf(DEBUG_GENERAL,"XFsbl_BhAuthentication:"
+				" XFSBL_ERROR_BH_RSA_DECRYPT\r\n");
+		Status = XFSBL_ERROR_BH_RSA_DECRYPT;
+	}
 
 END:
 	return Status;
@@ -127,11 +127,15 @@ u32 XFsbl_Authentication(const XFsblPs * FsblInstancePtr, u64 PartitionOffset,
 void XFsbl_ShaDigest(const u8 *In, const u32 Size, u8 *Out, u32 HashLen);
 void XFsbl_ShaStart(void * Ctx, u32 HashLen);
 void XFsbl_ShaUpdate(void * Ctx, u8 * Data, u32 Size, u32 HashLen);
+u32 XFsbl_ShaUpdateStart(void * Ctx, u8 * Data, u32 Size, u32 HashLen);
+u32 XFsbl_ShaUpdateWait(void * Ctx, u32 HashLen);
 void XFsbl_ShaFinish(void * Ctx, u8 * Hash, u32 HashLen);
 u32 XFsbl_CompareHashs(u8 *Hash1, u8 *Hash2, u32 HashLen);
 u32 XFsbl_Sha3PadSelect(u8 PadType);
 u32 XFsbl_BhAuthentication(const XFsblPs * FsblInstancePtr, u8 *Data,
 					u64 AcOffset, u8 IsEfuseRsa);
+u32 XFsbl_VerifyWithSpk(u64 AcOffset, u8 *Signature, u8 *Hash, u32 HashLen,
+				u8 *RsaResult);
 #endif
 
 
@@ -111,6 +111,11 @@ static u32 XFsbl_CalcualteSHA(const XFsblPs* FsblInstancePtr,
 		PTRSIZE LoadAddress, u32 PartitionNum, u32 ShaType);
 #endif
 
+#if defined(XFSBL_SECURE) && defined(XFSBL_PERF) && !defined(XFSBL_PS_DDR)
+static u64 XFsbl_GetChunkTime(void);
+static u32 XFsbl_ChunkTimeUs(u64 Ticks);
+#endif
+
 #ifdef ARMR5
 static void XFsbl_SetR5ExcepVectorHiVec(void);
 static void XFsbl_SetR5ExcepVectorLoVec(void);
@@ -1517,12 +1522,21 @@ static u32 XFsbl_PartitionValidation(XFsblPs * FsblInstancePtr,
 			XFsbl_Printf(DEBUG_GENERAL,
 				"Bitstream will be decrypted and transferred"
 				" in chunks\r\n");
-			/* Enable chunking in Decryption */
+			/*
+			 * Enable chunking in Decryption, the next chunk is
+			 * copied to one half of the read buffer while the
+			 * other half is decrypted
+			 */
 			XSecure_AesSetChunking(&SecureAes,
 					XSECURE_CSU_AES_CHUNKING_ENABLED);
 			XSecure_AesSetChunkConfig(&SecureAes, ReadBuffer,
-					READ_BUFFER_SIZE,
+					READ_BUFFER_SIZE / 2U,
 					FsblInstancePtr->DeviceOps.DeviceCopy);
+			XSecure_AesSetChunkPingPong(&SecureAes,
+					&ReadBuffer[READ_BUFFER_SIZE / 2U]);
+#ifdef XFSBL_PERF
+			XSecure_AesSetChunkTimer(&SecureAes, XFsbl_GetChunkTime);
+#endif
 
 			/**
 			 * In case of DDR less system, pass the partition source
@@ -1532,6 +1546,15 @@ static u32 XFsbl_PartitionValidation(XFsblPs * FsblInstancePtr,
 					(u8 *) XFSBL_DESTINATION_PCAP_ADDR,
 					(u8 *)(PTRSIZE) SrcAddress,
 					UnencryptedLength);
+#ifdef XFSBL_PERF
+			XFsbl_Printf(DEBUG_PRINT_ALWAYS, "P%d %d chunks, copy %d us"
+				" (max %d us), decrypt wait %d us (max %d us)\r\n",
+				PartitionNum, SecureAes.ChunkStats.ChunkCount,
+				XFsbl_ChunkTimeUs(SecureAes.ChunkStats.ReadTime),
+				XFsbl_ChunkTimeUs(SecureAes.ChunkStats.MaxReadTime),
+				XFsbl_ChunkTimeUs(SecureAes.ChunkStats.WaitTime),
+				XFsbl_ChunkTimeUs(SecureAes.ChunkStats.MaxWaitTime));
+#endif
 #endif
 
 #ifdef XFSBL_PERF
@@ -1996,3 +2019,38 @@ static void XFsbl_SetR5ExcepVectorLoVec(void)
 }
 
 #endif
+
+#if defined(XFSBL_SECURE) && defined(XFSBL_PERF) && !defined(XFSBL_PS_DDR)
+/*****************************************************************************/
+/**
+ * This function is the time source for the chunk timing of the bitstream
+ * decryption.
+ *
+ * @param	None
+ *
+ * @return	Current time in counts of the global timer
+ *
+ *****************************************************************************/
+static u64 XFsbl_GetChunkTime(void)
+{
+	XTime tCur = 0;
+
+	XTime_GetTime(&tCur);
+
+	return (u64)tCur;
+}
+
+/*****************************************************************************/
+/**
+ * This function converts global timer counts to microseconds.
+ *
+ * @param	Ticks Number of counts
+ *
+ * @return	Time in microseconds
+ *
+ *****************************************************************************/
+static u32 XFsbl_ChunkTimeUs(u64 Ticks)
+{
+	return (u32)((Ticks * 1000000U) / COUNTS_PER_SECOND);
+}
+#endif
@@ -457,17 +457,12 @@ static u32 XFsbl_PlSignVer(XFsblPs_PlPartition *PartitionParams,
 {
 
 	u8 PartitionHash[XFSBL_HASH_TYPE_SHA3]={0U};
-	u8 * SpkModular;
-	u8* SpkModularEx;
-	u32 SpkExp;
 	u8 * AcPtr = (u8*)AcOffset;
 	u32 Status;
 	u32 HashDataLen = BlockSize;
 	u8 XFsbl_RsaSha3Array[512] = {0U};
-	s32 SStatus;
 	u8 *ChunksHash = PartitionParams->PlAuth.HashsOfChunks;
 	XSecure_Sha3 SecureSha3={0U};
-	XSecure_Rsa SecureRsa={0U};
 	u32 Index;
 	u32 Len = PartitionParams->ChunkSize;
 	u64 Offset;
@@ -527,47 +522,19 @@ static u32 XFsbl_PlSignVer(XFsblPs_PlPartition *PartitionParams,
 		(XFSBL_AUTH_CERT_MIN_SIZE - XFSBL_FSBL_SIG_SIZE));
 	XSecure_Sha3Finish(&SecureSha3, (u8 *)PartitionHash);
 
-	/* Set SPK pointer */
-	AcPtr += (XFSBL_RSA_AC_ALIGN + XFSBL_PPK_SIZE);
-	SpkModular = AcPtr;
-	AcPtr += XFSBL_SPK_MOD_SIZE;
-	SpkModularEx = AcPtr;
-	AcPtr += XFSBL_SPK_MOD_EXT_SIZE;
-	SpkExp = *((u32 *)AcPtr);
-	AcPtr += XFSBL_RSA_AC_ALIGN;
-
-	/* Increment by  SPK Signature pointer */
-	AcPtr += XFSBL_SPK_SIG_SIZE;
-	/* Increment by  BHDR Signature pointer */
-	AcPtr += XFSBL_BHDR_SIG_SIZE;
-	if((SpkModular != NULL) && (SpkModularEx != NULL)) {
-		XFsbl_Printf(DEBUG_DETAILED,
-		"XFsbl_PartVer: Spk Mod %0x, Spk Mod Ex %0x, Spk Exp %0x\r\n",
-		SpkModular, SpkModularEx, SpkExp);
-	}
+	/* Set Partition Signature pointer, after SPK and BHDR signatures */
+	AcPtr += XFSBL_AUTH_CERT_SPK_SIG_OFFSET + XFSBL_SPK_SIG_SIZE +
+			XFSBL_BHDR_SIG_SIZE;
 
-	SStatus = XSecure_RsaInitialize(&SecureRsa, SpkModular,
-				SpkModularEx, (u8 *)&SpkExp);
-	if (SStatus != XFSBL_SUCCESS) {
-		Status = XFSBL_ERROR_RSA_INITIALIZE;
+	/* Decrypt and authenticate Partition Signature */
+	Status = XFsbl_VerifyWithSpk((UINTPTR)AcOffset, AcPtr, PartitionHash,
+			PartitionParams->PlAuth.AuthType, XFsbl_RsaSha3Array);
+	if (Status == XFSBL_ERROR_RSA_INITIALIZE) {
 		XFsbl_Printf(DEBUG_INFO,
 		"XFSBL_ERROR_RSA_INITIALIZE at PL verification\r\n");
 		goto END;
 	}
-	/* Decrypt Partition Signature. */
-	if(XFSBL_SUCCESS !=
-		XSecure_RsaPublicEncrypt(&SecureRsa, AcPtr,
-				XSECURE_RSA_4096_KEY_SIZE, XFsbl_RsaSha3Array)) {
-		XFsbl_Printf(DEBUG_INFO, "XFsbl_SpkVer: "
-			"XFSBL_ERROR_PART_RSA_DECRYPT at PL verification\r\n");
-		Status = XFSBL_ERROR_PART_RSA_DECRYPT;
-		goto END;
-	}
-
-
-	/* Authenticate Partition Signature */
-	if(XFSBL_SUCCESS != XSecure_RsaSignVerification(XFsbl_RsaSha3Array,
-			PartitionHash, PartitionParams->PlAuth.AuthType))
+	if (Status == XSECURE_RSA_SIGN_VERIFY_ERROR)
 	{
 		XFsbl_PrintArray(DEBUG_INFO, PartitionHash,
 			PartitionParams->PlAuth.AuthType,
@@ -577,8 +544,12 @@ static u32 XFsbl_PlSignVer(XFsblPs_PlPartition *PartitionParams,
 		Status = XFSBL_FAILURE;
 		goto END;
 	}
-
-	Status = XFSBL_SUCCESS;
+	if (Status != XFSBL_SUCCESS) {
+		XFsbl_Printf(DEBUG_INFO, "XFsbl_PlSignVer: "
+			"XFSBL_ERROR_PART_RSA_DECRYPT at PL verification\r\n");
+		Status = XFSBL_ERROR_PART_RSA_DECRYPT;
+		goto END;
+	}
 
 END:
 	return Status;
@@ -64,6 +64,7 @@
 
 /************************** Variable Definitions *****************************/
 static XSecure_Sha3 SecureSha3;
+static XSecure_Sha3Segment SecureSha3Segment;
 
 /*****************************************************************************
  *
@@ -110,6 +111,8 @@ u32 XFsbl_Sha3PadSelect(u8 PadType)
  ******************************************************************************/
 void XFsbl_ShaStart(void * Ctx, u32 HashLen)
 {
+	(void)Ctx;
+
 	if(XFSBL_HASH_TYPE_SHA3 == HashLen)
 	{
 		(void)XSecure_Sha3Initialize(&SecureSha3, &CsuDma);
@@ -128,12 +131,76 @@ void XFsbl_ShaStart(void * Ctx, u32 HashLen)
  ******************************************************************************/
 void XFsbl_ShaUpdate(void * Ctx, u8 * Data, u32 Size, u32 HashLen)
 {
+	(void)Ctx;
+
 	if(XFSBL_HASH_TYPE_SHA3 == HashLen)
 	{
 		XSecure_Sha3Update(&SecureSha3, Data, Size);
 	}
 }
 
+/*****************************************************************************
+ *
+ * This function starts the SHA3 update of a buffer and returns without
+ * waiting for it to be hashed. The buffer must not be modified until
+ * XFsbl_ShaUpdateWait() returns.
+ *
+ * @param	Ctx	SHA context, not used for SHA3
+ * @param	Data	Pointer to the data to be hashed
+ * @param	Size	Size of the data in bytes
+ * @param	HashLen	Hash type
+ *
+ * @return	XFSBL_SUCCESS if the update is started
+ *		XFSBL_FAILURE otherwise
+ *
+ ******************************************************************************/
+u32 XFsbl_ShaUpdateStart(void * Ctx, u8 * Data, u32 Size, u32 HashLen)
+{
+	u32 Status = XFSBL_SUCCESS;
+
+	(void)Ctx;
+
+	if(XFSBL_HASH_TYPE_SHA3 == HashLen)
+	{
+		SecureSha3Segment.Addr = (UINTPTR)Data;
+		SecureSha3Segment.Size = Size;
+		if (XST_SUCCESS != XSecure_Sha3SgStart(&SecureSha3,
+					&SecureSha3Segment, 1U)) {
+			Status = XFSBL_FAILURE;
+		}
+	}
+
+	return Status;
+}
+
+/*****************************************************************************
+ *
+ * This function waits till the update started by XFsbl_ShaUpdateStart()
+ * is done. It returns immediately if no update is in progress.
+ *
+ * @param	Ctx	SHA context, not used for SHA3
+ * @param	HashLen	Hash type
+ *
+ * @return	XFSBL_SUCCESS if the update is done
+ *		XFSBL_FAILURE otherwise
+ *
+ ******************************************************************************/
+u32 XFsbl_ShaUpdateWait(void * Ctx, u32 HashLen)
+{
+	u32 Status = XFSBL_SUCCESS;
+
+	(void)Ctx;
+
+	if(XFSBL_HASH_TYPE_SHA3 == HashLen)
+	{
+		if (XST_SUCCESS != XSecure_Sha3SgWait(&SecureSha3)) {
+			Status = XFSBL_FAILURE;
+		}
+	}
+
+	return Status;
+}
+
 /*****************************************************************************
  *
  * @param	None
@@ -143,6 +210,8 @@ void XFsbl_ShaUpdate(void * Ctx, u8 * Data, u32 Size, u32 HashLen)
  ******************************************************************************/
 void XFsbl_ShaFinish(void * Ctx, u8 * Hash, u32 HashLen)
 {
+	(void)Ctx;
+
 
 	if(XFSBL_HASH_TYPE_SHA3 == HashLen)
 	{
@@ -117,6 +117,11 @@ proc xgen_opts_file {libhandle} {
 	set set_fs_rpath [common::get_property CONFIG.set_fs_rpath $libhandle]
 	set word_access [common::get_property CONFIG.word_access $libhandle]
 	set use_chmod [common::get_property CONFIG.use_chmod $libhandle]
+	set enable_cache [common::get_property CONFIG.enable_cache $libhandle]
+	set enable_fastseek_auto [common::get_property CONFIG.enable_fastseek_auto $libhandle]
+	set enable_freemap [common::get_property CONFIG.enable_freemap $libhandle]
+	set enable_dircache [common::get_property CONFIG.enable_dircache $libhandle]
+	set enable_direct [common::get_property CONFIG.enable_direct $libhandle]
 
 	# do processor specific checks
 	set proc  [hsi::get_sw_processor];
@@ -202,6 +207,62 @@ proc xgen_opts_file {libhandle} {
 			set set_fs_rpath 0
 		}
 		puts $file_handle "\#define FILE_SYSTEM_SET_FS_RPATH $set_fs_rpath"
+		if {$enable_cache == true} {
+			set cache_ways [common::get_property CONFIG.cache_ways $libhandle]
+			if {$cache_ways < 1} {
+				puts "WARNING : Invalid cache_ways option, setting \
+						back to 1\n"
+				set cache_ways 1
+			}
+			puts $file_handle "\#define FILE_SYSTEM_USE_CACHE"
+			foreach pool {fat dir data} {
+				set sectors [common::get_property CONFIG.cache_${pool}_sectors $libhandle]
+				if {$sectors < 1 || ($sectors >= $cache_ways && $sectors % $cache_ways != 0)} {
+					error "ERROR: cache_${pool}_sectors must be a non-zero multiple of cache_ways \n"
+				}
+				puts $file_handle "\#define FILE_SYSTEM_CACHE_[string toupper $pool]_SECTORS $sectors"
+			}
+			puts $file_handle "\#define FILE_SYSTEM_CACHE_WAYS $cache_ways"
+		}
+		if {$enable_fastseek_auto == true} {
+			set fastseek_maps [common::get_property CONFIG.fastseek_maps $libhandle]
+			set fastseek_extents [common::get_property CONFIG.fastseek_extents $libhandle]
+			if {$fastseek_maps < 1 || $fastseek_extents < 1} {
+				error "ERROR: fastseek_maps and fastseek_extents must be non-zero \n"
+			}
+			puts $file_handle "\#define FILE_SYSTEM_FASTSEEK_AUTO"
+			puts $file_handle "\#define FILE_SYSTEM_FASTSEEK_MAPS $fastseek_maps"
+			puts $file_handle "\#define FILE_SYSTEM_FASTSEEK_EXTENTS $fastseek_extents"
+		}
+		if {$enable_dircache == true} {
+			set dircache_entries [common::get_property CONFIG.dircache_entries $libhandle]
+			if {$dircache_entries < 4 || $dircache_entries % 4 != 0} {
+				error "ERROR: dircache_entries must be a non-zero multiple of 4 \n"
+			}
+			puts $file_handle "\#define FILE_SYSTEM_USE_DIRCACHE"
+			puts $file_handle "\#define FILE_SYSTEM_DIRCACHE_ENTRIES $dircache_entries"
+		}
+		if {$enable_freemap == true} {
+			if {$read_only == true} {
+				puts "WARNING : Free cluster map is not used \
+						with read_only set to true\n"
+			} else {
+				set freemap_groups [common::get_property CONFIG.freemap_groups $libhandle]
+				if {$freemap_groups < 1} {
+					error "ERROR: freemap_groups must be non-zero \n"
+				}
+				puts $file_handle "\#define FILE_SYSTEM_USE_FREEMAP"
+				puts $file_handle "\#define FILE_SYSTEM_FREEMAP_GROUPS $freemap_groups"
+			}
+		}
+		if {$enable_direct == true} {
+			set direct_align [common::get_property CONFIG.direct_align $libhandle]
+			if {$direct_align < 1 || ($direct_align & ($direct_align - 1)) != 0} {
+				error "ERROR: direct_align must be a power of 2 \n"
+			}
+			puts $file_handle "\#define FILE_SYSTEM_USE_DIRECT"
+			puts $file_handle "\#define FILE_SYSTEM_DIRECT_ALIGN $direct_align"
+		}
 
 		# MB does not allow word access from RAM
 		if {$proc_type != "microblaze" && $word_access == true} {
@@ -0,0 +1,674 @@
+/******************************************************************************
+*
+* Copyright (C) 2018 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file ffbench.c
+*		FatFs benchmark for the Linux host build of XilFFs.
+*
+*		For every combination of filesystem type, cluster size and
+*		fragmentation level the image is recreated, formatted and put
+*		through a fixed sequence of phases: f_mkfs, mount, sequential
+*		f_write and f_read from a sector aligned buffer and again from
+*		a misaligned one, random reads, small appends with f_sync (as
+*		a logging application does), creating, opening, listing and
+*		deleting small files and f_getfree. Every phase reports its
+*		wall clock time, throughput, per call latency and the disk
+*		commands it caused. The workload does not depend on the host,
+*		so the command counts can be compared between runs and builds.
+*
+*		Fragmentation level N means that the file of the sequential
+*		phases is laid out in fragments of N clusters, separated by one
+*		cluster of another file. 0 lays it out contiguously.
+*
+*		All data read back is verified. At the end all files are
+*		deleted and the free cluster count must be back at its value
+*		after f_mkfs, otherwise clusters were lost.
+*
+* <pre>
+* usage: ffbench [options]
+*   -i <image>    image file (default ffbench.img)
+*   -m            access the image through mmap instead of pread/pwrite
+*   -S            make f_sync also flush the image to the host disk
+*   -s <MB>       image size (default 4096, sparse)
+*   -t <types>    fat32, exfat or both (default fat32,exfat)
+*   -c <KB,...>   cluster sizes (default 4,16,32)
+*   -F <N,...>    fragmentation levels (default 0,8,1)
+*   -z <MB>       size of the sequential file (default 32)
+*   -w <KB>       f_write/f_read size of the sequential phases (default 32)
+*   -n <count>    number of small files (default 1000)
+*   -r <count>    number of random reads and appends (default 2000)
+*   -l <bytes>    size of a random read or append (default 128)
+*   -C            CSV output
+*   -h            this help
+* </pre>
+*
+******************************************************************************/
+#define _FILE_OFFSET_BITS 64
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ff.h"
+#include "hostdisk.h"
+
+#define BENCH_DRIVE		0U
+#define BENCH_MAX_LIST	16U
+#define BENCH_WORK_SIZE	(32U * 1024U)
+#define BENCH_ALIGN		4096U	/* Sector aligned, a multiple of FF_DIRECT_ALIGN */
+#define BENCH_MISALIGN	4U		/* Offset of the misaligned buffer */
+
+typedef struct {
+	const char*	name;
+	BYTE		opt;		/* f_mkfs option */
+} BENCH_FSTYPE;
+
+typedef struct {
+	const char*	image;
+	BYTE		mode;
+	u64			size;
+	UINT		types;				/* Bit mask of FsType[] */
+	UINT		cluster[BENCH_MAX_LIST];	/* Cluster sizes in bytes */
+	UINT		ncluster;
+	UINT		frag[BENCH_MAX_LIST];		/* Fragment lengths in clusters */
+	UINT		nfrag;
+	FSIZE_t		file_size;
+	UINT		chunk;
+	UINT		files;
+	UINT		records;
+	UINT		record_size;
+	int			csv;
+} BENCH_CONFIG;
+
+typedef struct {
+	const char*	name;
+	u64			ops;
+	u64			bytes;
+	double		start;
+	double		time;		/* Wall clock time of the phase */
+	double		lat;		/* Sum of the per call latencies */
+	double		max;
+	double		op_start;
+} BENCH_PHASE;
+
+static const BENCH_FSTYPE FsType[] = {
+	{ "fat32", FM_FAT32 | FM_SFD },
+	{ "exfat", FM_EXFAT | FM_SFD }
+};
+
+static FATFS Fs;
+static BYTE Work[BENCH_WORK_SIZE];
+static BYTE* Buf;
+static BYTE* Ref;
+static u32 Seed;
+
+static double now (void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Small LCG, so that every run uses the same sequence on every host */
+static u32 bench_rand (void)
+{
+	Seed = Seed * 1103515245U + 12345U;
+	return Seed >> 8;
+}
+
+/* Content of the sequential file at a given offset */
+static void fill_pattern (BYTE* buf, FSIZE_t off, UINT len)
+{
+	UINT i;
+
+	for (i = 0; i < len; i++) {
+		buf[i] = (BYTE)((off + i) * 7U + ((off + i) >> 9));
+	}
+}
+
+static void phase_begin (BENCH_PHASE* p, const char* name)
+{
+	memset(p, 0, sizeof(*p));
+	p->name = name;
+	hostdisk_stat(BENCH_DRIVE, NULL, 1U);
+#if FF_USE_DIRECT
+	ff_io_stat(NULL, 1U);
+#endif
+#if FF_USE_CACHE
+	{
+		BYTE i;
+		for (i = 0; i < FF_CACHE_POOLS; i++) {
+			ff_cache_stat(i, NULL, 1U);
+		}
+	}
+#endif
+	p->start = now();
+}
+
+static void op_begin (BENCH_PHASE* p)
+{
+	p->op_start = now();
+}
+
+static void op_end (BENCH_PHASE* p, UINT bytes)
+{
+	double lat = now() - p->op_start;
+
+	p->lat += lat;
+	if (lat > p->max) {
+		p->max = lat;
+	}
+	p->ops++;
+	p->bytes += bytes;
+}
+
+static void print_header (const BENCH_CONFIG* cfg)
+{
+	const char* hit = FF_USE_CACHE ? "hit%" : "";
+	const char* direct = FF_USE_DIRECT ? "direct" : "";
+	const char* bounce = FF_USE_DIRECT ? "bounce" : "";
+	const char* xfers = FF_USE_DIRECT ? "xfers" : "";
+
+	if (cfg->csv) {
+		printf("fs,cluster,frag,phase,ops,bytes,time_ms,mb_s,ops_s,avg_us,max_us,"
+				"rd_cmds,rd_sect,wr_cmds,wr_sect,syncs%s%s%s%s%s%s%s%s\n",
+				FF_USE_CACHE ? "," : "", hit, FF_USE_DIRECT ? "," : "", direct,
+				FF_USE_DIRECT ? "," : "", bounce, FF_USE_DIRECT ? "," : "", xfers);
+	} else {
+		printf("%-5s %7s %4s %-8s %7s %9s %9s %8s %9s %8s %9s %8s %9s %8s %9s %6s %5s %10s %10s %7s\n",
+				"fs", "cluster", "frag", "phase", "ops", "bytes", "time_ms",
+				"MB/s", "ops/s", "avg_us", "max_us", "rd_cmds", "rd_sect",
+				"wr_cmds", "wr_sect", "syncs", hit, direct, bounce, xfers);
+	}
+}
+
+static void phase_end (const BENCH_CONFIG* cfg, BENCH_PHASE* p,
+		const char* fs, UINT cluster, UINT frag)
+{
+	HOSTDISK_STAT io;
+	double mbs, opss, avg;
+	char hit[16] = "";
+	char direct[24] = "", bounce[24] = "", xfers[24] = "";
+
+	p->time = now() - p->start;
+	hostdisk_stat(BENCH_DRIVE, &io, 0U);
+#if FF_USE_CACHE
+	{
+		FF_CACHE_STAT cs;
+		DWORD h = 0, m = 0;
+		BYTE i;
+
+		for (i = 0; i < FF_CACHE_POOLS; i++) {
+			ff_cache_stat(i, &cs, 0U);
+			h += cs.hit;
+			m += cs.miss;
+		}
+		snprintf(hit, sizeof(hit), "%.1f", (h + m) ? 100.0 * h / (h + m) : 0.0);
+	}
+#endif
+#if FF_USE_DIRECT
+	{
+		FF_IO_STAT ds;
+
+		ff_io_stat(&ds, 0U);
+		snprintf(direct, sizeof(direct), "%llu", (unsigned long long)ds.direct);
+		snprintf(bounce, sizeof(bounce), "%llu", (unsigned long long)ds.bounce);
+		snprintf(xfers, sizeof(xfers), "%lu", (unsigned long)ds.xfers);
+	}
+#endif
+	mbs = (p->time > 0.0) ? (double)p->bytes / p->time / (1024.0 * 1024.0) : 0.0;
+	opss = (p->time > 0.0) ? (double)p->ops / p->time : 0.0;
+	avg = p->ops ? p->lat / (double)p->ops : 0.0;
+
+	if (cfg->csv) {
+		printf("%s,%u,%u,%s,%llu,%llu,%.3f,%.2f,%.0f,%.2f,%.2f,%llu,%llu,%llu,%llu,%llu%s%s%s%s%s%s%s%s\n",
+				fs, cluster, frag, p->name,
+				(unsigned long long)p->ops, (unsigned long long)p->bytes,
+				p->time * 1e3, mbs, opss, avg * 1e6, p->max * 1e6,
+				(unsigned long long)io.read_cmds, (unsigned long long)io.read_sectors,
+				(unsigned long long)io.write_cmds, (unsigned long long)io.write_sectors,
+				(unsigned long long)io.syncs, FF_USE_CACHE ? "," : "", hit,
+				FF_USE_DIRECT ? "," : "", direct, FF_USE_DIRECT ? "," : "", bounce,
+				FF_USE_DIRECT ? "," : "", xfers);
+	} else {
+		printf("%-5s %7u %4u %-8s %7llu %9llu %9.3f %8.2f %9.0f %8.2f %9.2f %8llu %9llu %8llu %9llu %6llu %5s %10s %10s %7s\n",
+				fs, cluster, frag, p->name,
+				(unsigned long long)p->ops, (unsigned long long)p->bytes,
+				p->time * 1e3, mbs, opss, avg * 1e6, p->max * 1e6,
+				(unsigned long long)io.read_cmds, (unsigned long long)io.read_sectors,
+				(unsigned long long)io.write_cmds, (unsigned long long)io.write_sectors,
+				(unsigned long long)io.syncs, hit, direct, bounce, xfers);
+	}
+}
+
+#define CHECK(expr)	do { \
+		FRESULT res_ = (expr); \
+		if (res_ != FR_OK) { \
+			fprintf(stderr, "ffbench: %s failed (%d), line %d\n", #expr, (int)res_, __LINE__); \
+			return -1; \
+		} \
+	} while (0)
+
+/* Interleave the sequential file with a filler file, then truncate it */
+static int fragment (const BENCH_CONFIG* cfg, UINT cluster, UINT frag)
+{
+	FIL a, b;
+	UINT bw;
+	FSIZE_t size = 0;
+
+	CHECK(f_open(&a, "/seq.bin", FA_CREATE_ALWAYS | FA_WRITE));
+	CHECK(f_open(&b, "/filler.bin", FA_CREATE_ALWAYS | FA_WRITE));
+	memset(Buf, 0xA5, cluster);
+	while (size < cfg->file_size) {
+		UINT i;
+		for (i = 0; i < frag; i++) {
+			CHECK(f_write(&a, Buf, cluster, &bw));
+			if (bw != cluster) {
+				return -1;
+			}
+		}
+		CHECK(f_write(&b, Buf, cluster, &bw));
+		if (bw != cluster) {
+			return -1;
+		}
+		size += (FSIZE_t)frag * cluster;
+	}
+	CHECK(f_close(&b));
+	CHECK(f_close(&a));
+
+	return 0;
+}
+
+/* Sequential write of the file from buf, reusing the holes left by fragment() */
+static int seq_write (const BENCH_CONFIG* cfg, BENCH_PHASE* p, BYTE* buf)
+{
+	FIL f;
+	FSIZE_t off;
+	UINT bw, len;
+
+	CHECK(f_open(&f, "/seq.bin", FA_CREATE_ALWAYS | FA_WRITE));
+	for (off = 0; off < cfg->file_size; off += len) {
+		len = (UINT)((cfg->file_size - off < cfg->chunk) ? cfg->file_size - off : cfg->chunk);
+		fill_pattern(buf, off, len);
+		op_begin(p);
+		CHECK(f_write(&f, buf, len, &bw));
+		op_end(p, bw);
+		if (bw != len) {
+			fprintf(stderr, "ffbench: volume full\n");
+			return -1;
+		}
+	}
+	CHECK(f_close(&f));
+
+	return 0;
+}
+
+/* Sequential read of the file into buf, data verified */
+static int seq_read (const BENCH_CONFIG* cfg, BENCH_PHASE* p, BYTE* buf)
+{
+	FIL f;
+	FSIZE_t off;
+	UINT bw, len;
+
+	CHECK(f_open(&f, "/seq.bin", FA_READ));
+	for (off = 0; off < cfg->file_size; off += len) {
+		len = (UINT)((cfg->file_size - off < cfg->chunk) ? cfg->file_size - off : cfg->chunk);
+		op_begin(p);
+		CHECK(f_read(&f, buf, len, &bw));
+		op_end(p, bw);
+		fill_pattern(Ref, off, len);
+		if (bw != len || memcmp(buf, Ref, len) != 0) {
+			fprintf(stderr, "ffbench: data mismatch at %llu\n", (unsigned long long)off);
+			return -1;
+		}
+	}
+	CHECK(f_close(&f));
+
+	return 0;
+}
+
+static int run (const BENCH_CONFIG* cfg, const BENCH_FSTYPE* type, UINT cluster, UINT frag)
+{
+	BENCH_PHASE p;
+	FIL f;
+	DIR d;
+	FILINFO fi;
+	FATFS* fs;
+	DWORD nclst, nfree;
+	FSIZE_t off;
+	UINT i, n, bw;
+	UINT* order;
+	char name[32];
+	FRESULT res;
+
+	if (hostdisk_open(BENCH_DRIVE, cfg->image, cfg->size, cfg->mode | HOSTDISK_CREATE) != 0) {
+		perror(cfg->image);
+		return -1;
+	}
+
+	phase_begin(&p, "mkfs");
+	op_begin(&p);
+	res = f_mkfs("", type->opt, cluster, Work, sizeof(Work));
+	op_end(&p, 0U);
+	if (res == FR_MKFS_ABORTED) {
+		if (!cfg->csv) {
+			printf("%-5s %7u %4u cluster size not possible for this volume size\n",
+					type->name, cluster, frag);
+		}
+		hostdisk_close(BENCH_DRIVE);
+		return 0;
+	}
+	CHECK(res);
+	phase_end(cfg, &p, type->name, cluster, frag);
+
+	CHECK(f_mount(&Fs, "", 1));
+	CHECK(f_getfree("", &nfree, &fs));
+	if (frag != 0U && fragment(cfg, cluster, frag) != 0) {
+		return -1;
+	}
+
+	phase_begin(&p, "mount");
+	CHECK(f_mount(NULL, "", 0));
+	op_begin(&p);
+	CHECK(f_mount(&Fs, "", 1));
+	op_end(&p, 0U);
+	phase_end(cfg, &p, type->name, cluster, frag);
+
+	/* Aligned buffer (direct transfers over contiguous clusters with
+	   FF_USE_DIRECT), then a misaligned one (one transfer per cluster) */
+	phase_begin(&p, "write");
+	if (seq_write(cfg, &p, Buf) != 0) {
+		return -1;
+	}
+	phase_end(cfg, &p, type->name, cluster, frag);
+
+	phase_begin(&p, "read");
+	if (seq_read(cfg, &p, Buf) != 0) {
+		return -1;
+	}
+	phase_end(cfg, &p, type->name, cluster, frag);
+
+	phase_begin(&p, "uwrite");
+	if (seq_write(cfg, &p, Buf + BENCH_MISALIGN) != 0) {
+		return -1;
+	}
+	phase_end(cfg, &p, type->name, cluster, frag);
+
+	phase_begin(&p, "uread");
+	if (seq_read(cfg, &p, Buf + BENCH_MISALIGN) != 0) {
+		return -1;
+	}
+	phase_end(cfg, &p, type->name, cluster, frag);
+
+	phase_begin(&p, "seek");
+	Seed = 1U;
+	CHECK(f_open(&f, "/seq.bin", FA_READ));
+	for (i = 0; i < cfg->records; i++) {
+		off = (FSIZE_t)(((u64)bench_rand() << 16 ^ bench_rand()) %
+				(cfg->file_size - cfg->record_size + 1U));
+		op_begin(&p);
+		CHECK(f_lseek(&f, off));
+		CHECK(f_read(&f, Buf, cfg->record_size, &bw));
+		op_end(&p, bw);
+		fill_pattern(Ref, off, cfg->record_size);
+		if (bw != cfg->record_size || memcmp(Buf, Ref, bw) != 0) {
+			fprintf(stderr, "ffbench: data mismatch at %llu\n", (unsigned long long)off);
+			return -1;
+		}
+	}
+	CHECK(f_close(&f));
+	phase_end(cfg, &p, type->name, cluster, frag);
+
+	phase_begin(&p, "append");
+	CHECK(f_open(&f, "/log.txt", FA_OPEN_APPEND | FA_WRITE));
+	memset(Buf, 'L', cfg->record_size);
+	for (i = 0; i < cfg->records; i++) {
+		op_begin(&p);
+		CHECK(f_write(&f, Buf, cfg->record_size, &bw));
+		CHECK(f_sync(&f));
+		op_end(&p, bw);
+	}
+	CHECK(f_close(&f));
+	phase_end(cfg, &p, type->name, cluster, frag);
+
+	CHECK(f_mkdir("/files"));
+	phase_begin(&p, "create");
+	for (i = 0; i < cfg->files; i++) {
+		snprintf(name, sizeof(name), "/files/record_%05u.log", i);
+		op_begin(&p);
+		CHECK(f_open(&f, name, FA_CREATE_NEW | FA_WRITE));
+		CHECK(f_write(&f, Buf, cfg->record_size, &bw));
+		CHECK(f_close(&f));
+		op_end(&p, bw);
+	}
+	phase_end(cfg, &p, type->name, cluster, frag);
+
+	order = malloc(cfg->files * sizeof(UINT));
+	if (order == NULL) {
+		return -1;
+	}
+	for (i = 0; i < cfg->files; i++) {
+		order[i] = i;
+	}
+	for (i = cfg->files; i > 1U; i--) {
+		n = bench_rand() % i;
+		bw = order[i - 1U];
+		order[i - 1U] = order[n];
+		order[n] = bw;
+	}
+
+	phase_begin(&p, "open");
+	for (i = 0; i < cfg->files; i++) {
+		snprintf(name, sizeof(name), "/files/record_%05u.log", order[i]);
+		op_begin(&p);
+		CHECK(f_open(&f, name, FA_READ));
+		CHECK(f_close(&f));
+		op_end(&p, 0U);
+	}
+	phase_end(cfg, &p, type->name, cluster, frag);
+
+	phase_begin(&p, "readdir");
+	CHECK(f_opendir(&d, "/files"));
+	for (;;) {
+		op_begin(&p);
+		CHECK(f_readdir(&d, &fi));
+		if (fi.fname[0] == '\0') {
+			break;
+		}
+		op_end(&p, 0U);
+	}
+	CHECK(f_closedir(&d));
+	phase_end(cfg, &p, type->name, cluster, frag);
+	if (p.ops != cfg->files) {
+		fprintf(stderr, "ffbench: %llu directory entries, expected %u\n",
+				(unsigned long long)p.ops, cfg->files);
+		return -1;
+	}
+
+	phase_begin(&p, "unlink");
+	for (i = 0; i < cfg->files; i++) {
+		snprintf(name, sizeof(name), "/files/record_%05u.log", order[i]);
+		op_begin(&p);
+		CHECK(f_unlink(name));
+		op_end(&p, 0U);
+	}
+	phase_end(cfg, &p, type->name, cluster, frag);
+	free(order);
+
+	/* Remount, so that f_getfree() cannot use a free count in memory */
+	CHECK(f_mount(NULL, "", 0));
+	CHECK(f_mount(&Fs, "", 1));
+	phase_begin(&p, "getfree");
+	op_begin(&p);
+	CHECK(f_getfree("", &nclst, &fs));
+	op_end(&p, 0U);
+	phase_end(cfg, &p, type->name, cluster, frag);
+
+	/* With every file deleted, all clusters must be free again */
+	CHECK(f_unlink("/files"));
+	CHECK(f_unlink("/log.txt"));
+	CHECK(f_unlink("/seq.bin"));
+	if (frag != 0U) {
+		CHECK(f_unlink("/filler.bin"));
+	}
+	CHECK(f_mount(NULL, "", 0));
+	CHECK(f_mount(&Fs, "", 1));
+	CHECK(f_getfree("", &nclst, &fs));
+	if (nclst != nfree) {
+		fprintf(stderr, "ffbench: %lu clusters lost\n", (unsigned long)(nfree - nclst));
+		return -1;
+	}
+
+	CHECK(f_mount(NULL, "", 0));
+	hostdisk_close(BENCH_DRIVE);
+
+	return 0;
+}
+
+static UINT parse_list (const char* arg, UINT* list, UINT scale)
+{
+	UINT n = 0;
+	char* end;
+
+	while (*arg != '\0' && n < BENCH_MAX_LIST) {
+		list[n++] = (UINT)strtoul(arg, &end, 0) * scale;
+		if (end == arg) {
+			return 0;
+		}
+		arg = (*end == ',') ? end + 1 : end;
+	}
+	return n;
+}
+
+static void usage (int status)
+{
+	fprintf((status == 0) ? stdout : stderr,
+		"usage: ffbench [options]\n"
+		"  -i <image>    image file (default ffbench.img)\n"
+		"  -m            access the image through mmap instead of pread/pwrite\n"
+		"  -S            make f_sync also flush the image to the host disk\n"
+		"  -s <MB>       image size (default 4096, sparse)\n"
+		"  -t <types>    fat32, exfat or both (default fat32,exfat)\n"
+		"  -c <KB,...>   cluster sizes (default 4,16,32)\n"
+		"  -F <N,...>    fragmentation levels (default 0,8,1)\n"
+		"  -z <MB>       size of the sequential file (default 32)\n"
+		"  -w <KB>       f_write/f_read size of the sequential phases (default 32)\n"
+		"  -n <count>    number of small files (default 1000)\n"
+		"  -r <count>    number of random reads and appends (default 2000)\n"
+		"  -l <bytes>    size of a random read or append (default 128)\n"
+		"  -C            CSV output\n"
+		"  -h            this help\n");
+	exit(status);
+}
+
+int main (int argc, char** argv)
+{
+	BENCH_CONFIG cfg;
+	UINT t, c, f;
+	int opt;
+
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.image = "ffbench.img";
+	cfg.mode = HOSTDISK_FILE;
+	cfg.size = 4096ULL << 20;
+	cfg.types = 3U;
+	cfg.ncluster = parse_list("4,16,32", cfg.cluster, 1024U);
+	cfg.nfrag = parse_list("0,8,1", cfg.frag, 1U);
+	cfg.file_size = (FSIZE_t)32U << 20;
+	cfg.chunk = 32U * 1024U;
+	cfg.files = 1000U;
+	cfg.records = 2000U;
+	cfg.record_size = 128U;
+
+	while ((opt = getopt(argc, argv, "i:mSs:t:c:F:z:w:n:r:l:Ch")) != -1) {
+		switch (opt) {
+		case 'i': cfg.image = optarg; break;
+		case 'm': cfg.mode |= HOSTDISK_MMAP; break;
+		case 'S': cfg.mode |= HOSTDISK_SYNC; break;
+		case 's': cfg.size = strtoull(optarg, NULL, 0) << 20; break;
+		case 't':
+			cfg.types = (strstr(optarg, "fat32") ? 1U : 0U) |
+					(strstr(optarg, "exfat") ? 2U : 0U);
+			break;
+		case 'c': cfg.ncluster = parse_list(optarg, cfg.cluster, 1024U); break;
+		case 'F': cfg.nfrag = parse_list(optarg, cfg.frag, 1U); break;
+		case 'z': cfg.file_size = (FSIZE_t)strtoull(optarg, NULL, 0) << 20; break;
+		case 'w': cfg.chunk = (UINT)strtoul(optarg, NULL, 0) * 1024U; break;
+		case 'n': cfg.files = (UINT)strtoul(optarg, NULL, 0); break;
+		case 'r': cfg.records = (UINT)strtoul(optarg, NULL, 0); break;
+		case 'l': cfg.record_size = (UINT)strtoul(optarg, NULL, 0); break;
+		case 'C': cfg.csv = 1; break;
+		case 'h': usage(0); break;
+		default: usage(2);
+		}
+	}
+	if (optind != argc || cfg.types == 0U || cfg.ncluster == 0U || cfg.nfrag == 0U ||
+			cfg.chunk == 0U || cfg.record_size == 0U ||
+			cfg.file_size < cfg.record_size || cfg.size == 0U) {
+		usage(2);
+	}
+#if !FF_FS_EXFAT
+	cfg.types &= 1U;
+#endif
+
+	c = cfg.chunk;
+	for (f = 0; f < cfg.ncluster; f++) {
+		if (cfg.cluster[f] > c) {
+			c = cfg.cluster[f];
+		}
+	}
+	if (cfg.record_size > c) {
+		c = cfg.record_size;
+	}
+	c += BENCH_MISALIGN;
+	Buf = aligned_alloc(BENCH_ALIGN, (c + BENCH_ALIGN - 1U) / BENCH_ALIGN * BENCH_ALIGN);
+	Ref = malloc(c);
+	if (Buf == NULL || Ref == NULL) {
+		return 1;
+	}
+
+	print_header(&cfg);
+	for (t = 0; t < sizeof(FsType) / sizeof(FsType[0]); t++) {
+		if ((cfg.types & (1U << t)) == 0U) {
+			continue;
+		}
+		for (c = 0; c < cfg.ncluster; c++) {
+			for (f = 0; f < cfg.nfrag; f++) {
+				if (run(&cfg, &FsType[t], cfg.cluster[c], cfg.frag[f]) != 0) {
+					hostdisk_close(BENCH_DRIVE);
+					return 1;
+				}
+			}
+		}
+	}
+	unlink(cfg.image);
+
+	return 0;
+}
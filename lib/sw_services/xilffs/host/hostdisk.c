@@ -0,0 +1,379 @@
+/******************************************************************************
+*
+* Copyright (C) 2018 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file hostdisk.c
+*		Image file backed disk I/O layer for the Linux host build of
+*		XilFFs. It replaces diskio.c, so that the FatFs module, the
+*		sector cache and applications can be run and measured without
+*		a board.
+*
+*		The image is accessed with pread()/pwrite() (HOSTDISK_FILE) or
+*		through a shared mapping (HOSTDISK_MMAP). The mapped mode takes
+*		the host system calls out of the measurement, the file mode is
+*		closer to a block device with a per command cost. Every drive
+*		counts the commands and sectors it transfers, which gives
+*		numbers that do not depend on the speed of the host.
+*
+* @note		The erase block size reported to f_mkfs() is the one of the
+*		SD interface of diskio.c, so that volumes are laid out as on a
+*		card.
+*
+******************************************************************************/
+#define _FILE_OFFSET_BITS 64
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "hostdisk.h"
+#include "ff.h"
+
+#define HOSTDISK_BLOCK_SIZE	128U	/* Erase block size in sectors, as for SD */
+
+typedef struct {
+	int		fd;
+	BYTE	mode;
+	BYTE*	map;
+	u64		size;
+	DSTATUS	stat;
+	HOSTDISK_STAT	cnt;
+} HOSTDISK;
+
+static HOSTDISK Disk[HOSTDISK_DRIVES] = {
+	{ -1, 0U, NULL, 0U, STA_NOINIT | STA_NODISK, { 0U } },
+	{ -1, 0U, NULL, 0U, STA_NOINIT | STA_NODISK, { 0U } }
+};
+
+/*****************************************************************************/
+/**
+*
+* Attaches an image file to a drive.
+*
+* @param	pdrv - Drive number
+* @param	path - Image file
+* @param	size - Size of the image in bytes with HOSTDISK_CREATE, else 0
+*		to use the size of the existing file
+* @param	mode - HOSTDISK_FILE or HOSTDISK_MMAP, optionally ORed with
+*		HOSTDISK_SYNC and HOSTDISK_CREATE
+*
+* @return	0 on success, -1 on error (errno is set)
+*
+* @note		With HOSTDISK_CREATE the image is truncated first, so that
+*		every run starts from an all zero (sparse) image.
+*
+******************************************************************************/
+int hostdisk_open (
+	BYTE pdrv,
+	const char* path,
+	u64 size,
+	BYTE mode
+)
+{
+	HOSTDISK* d;
+	struct stat st;
+	void* map;
+
+	if (pdrv >= HOSTDISK_DRIVES) {
+		return -1;
+	}
+	hostdisk_close(pdrv);
+	d = &Disk[pdrv];
+
+	d->fd = open(path, (mode & HOSTDISK_CREATE) ? (O_RDWR | O_CREAT) : O_RDWR, 0644);
+	if (d->fd < 0) {
+		return -1;
+	}
+	if ((mode & HOSTDISK_CREATE) != 0U) {
+		if (ftruncate(d->fd, 0) != 0 || ftruncate(d->fd, (off_t)size) != 0) {
+			goto err;
+		}
+	} else {
+		if (fstat(d->fd, &st) != 0) {
+			goto err;
+		}
+		size = (u64)st.st_size;
+	}
+	d->size = size - size % HOSTDISK_SECTOR_SIZE;
+	if (d->size == 0U) {
+		goto err;
+	}
+
+	if ((mode & HOSTDISK_MMAP) != 0U) {
+		map = mmap(NULL, (size_t)d->size, PROT_READ | PROT_WRITE, MAP_SHARED, d->fd, 0);
+		if (map == MAP_FAILED) {
+			goto err;
+		}
+		d->map = map;
+	}
+	d->mode = mode;
+	d->stat = STA_NOINIT;
+	memset(&d->cnt, 0, sizeof(d->cnt));
+
+	return 0;
+
+err:
+	close(d->fd);
+	d->fd = -1;
+	return -1;
+}
+
+/*****************************************************************************/
+/**
+*
+* Detaches the image from a drive, writing the mapping back first.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+void hostdisk_close (
+	BYTE pdrv
+)
+{
+	HOSTDISK* d;
+
+	if (pdrv >= HOSTDISK_DRIVES || Disk[pdrv].fd < 0) {
+		return;
+	}
+	d = &Disk[pdrv];
+	if (d->map != NULL) {
+		munmap(d->map, (size_t)d->size);
+		d->map = NULL;
+	}
+	close(d->fd);
+	d->fd = -1;
+	d->stat = STA_NOINIT | STA_NODISK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Gets the transfer counters of a drive.
+*
+* @param	pdrv - Drive number
+* @param	stat - Returns the counters (can be NULL)
+* @param	reset - 1: Clear the counters
+*
+* @return	None
+*
+******************************************************************************/
+void hostdisk_stat (
+	BYTE pdrv,
+	HOSTDISK_STAT* stat,
+	BYTE reset
+)
+{
+	if (pdrv >= HOSTDISK_DRIVES) {
+		return;
+	}
+	if (stat != NULL) {
+		*stat = Disk[pdrv].cnt;
+	}
+	if (reset != 0U) {
+		memset(&Disk[pdrv].cnt, 0, sizeof(Disk[pdrv].cnt));
+	}
+}
+
+/*-----------------------------------------------------------------------*/
+/* Get Disk Status							*/
+/*-----------------------------------------------------------------------*/
+
+DSTATUS disk_status (
+		BYTE pdrv	/* Drive number */
+)
+{
+	if (pdrv >= HOSTDISK_DRIVES) {
+		return STA_NOINIT | STA_NODISK;
+	}
+	return Disk[pdrv].stat;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Initialize Disk Drive						*/
+/*-----------------------------------------------------------------------*/
+
+DSTATUS disk_initialize (
+		BYTE pdrv	/* Drive number */
+)
+{
+	if (pdrv >= HOSTDISK_DRIVES) {
+		return STA_NOINIT | STA_NODISK;
+	}
+	if (Disk[pdrv].fd >= 0) {
+		Disk[pdrv].stat &= (DSTATUS)~STA_NOINIT;
+	}
+	return Disk[pdrv].stat;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Read Sector(s)							*/
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_read (
+		BYTE pdrv,	/* Drive number */
+		BYTE *buff,	/* Pointer to the data buffer to store read data */
+		DWORD sector,	/* Start sector number (LBA) */
+		UINT count	/* Sector count */
+)
+{
+	HOSTDISK* d;
+	u64 off = (u64)sector * HOSTDISK_SECTOR_SIZE;
+	size_t len = (size_t)count * HOSTDISK_SECTOR_SIZE;
+
+	if (pdrv >= HOSTDISK_DRIVES || count == 0U) {
+		return RES_PARERR;
+	}
+	d = &Disk[pdrv];
+	if ((d->stat & STA_NOINIT) != 0U) {
+		return RES_NOTRDY;
+	}
+	if (off + len > d->size) {
+		return RES_PARERR;
+	}
+	if (d->map != NULL) {
+		memcpy(buff, d->map + off, len);
+	} else if (pread(d->fd, buff, len, (off_t)off) != (ssize_t)len) {
+		return RES_ERROR;
+	}
+	d->cnt.read_cmds++;
+	d->cnt.read_sectors += count;
+
+	return RES_OK;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Write Sector(s)							*/
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_write (
+		BYTE pdrv,	/* Drive number */
+		const BYTE *buff,	/* Pointer to the data to be written */
+		DWORD sector,	/* Start sector number (LBA) */
+		UINT count	/* Sector count */
+)
+{
+	HOSTDISK* d;
+	u64 off = (u64)sector * HOSTDISK_SECTOR_SIZE;
+	size_t len = (size_t)count * HOSTDISK_SECTOR_SIZE;
+
+	if (pdrv >= HOSTDISK_DRIVES || count == 0U) {
+		return RES_PARERR;
+	}
+	d = &Disk[pdrv];
+	if ((d->stat & STA_NOINIT) != 0U) {
+		return RES_NOTRDY;
+	}
+	if (off + len > d->size) {
+		return RES_PARERR;
+	}
+	if (d->map != NULL) {
+		memcpy(d->map + off, buff, len);
+	} else if (pwrite(d->fd, buff, len, (off_t)off) != (ssize_t)len) {
+		return RES_ERROR;
+	}
+	d->cnt.write_cmds++;
+	d->cnt.write_sectors += count;
+
+	return RES_OK;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Miscellaneous Functions						*/
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_ioctl (
+	BYTE pdrv,				/* Drive number */
+	BYTE cmd,				/* Control code */
+	void *buff				/* Buffer to send/receive control data */
+)
+{
+	HOSTDISK* d;
+	DRESULT res = RES_OK;
+
+	if (pdrv >= HOSTDISK_DRIVES) {
+		return RES_PARERR;
+	}
+	d = &Disk[pdrv];
+	if ((d->stat & STA_NOINIT) != 0U) {
+		return RES_NOTRDY;
+	}
+
+	switch (cmd) {
+	case (BYTE)CTRL_SYNC:
+		d->cnt.syncs++;
+		if ((d->mode & HOSTDISK_SYNC) != 0U) {
+			if (d->map != NULL) {
+				if (msync(d->map, (size_t)d->size, MS_SYNC) != 0) {
+					res = RES_ERROR;
+				}
+			} else if (fdatasync(d->fd) != 0) {
+				res = RES_ERROR;
+			}
+		}
+		break;
+	case (BYTE)GET_SECTOR_COUNT:
+		*(DWORD *)buff = (DWORD)(d->size / HOSTDISK_SECTOR_SIZE);
+		break;
+	case (BYTE)GET_SECTOR_SIZE:
+		*(WORD *)buff = (WORD)HOSTDISK_SECTOR_SIZE;
+		break;
+	case (BYTE)GET_BLOCK_SIZE:
+		*(DWORD *)buff = (DWORD)HOSTDISK_BLOCK_SIZE;
+		break;
+	default:
+		res = RES_PARERR;
+		break;
+	}
+
+	return res;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is User Provided Timer Function for FatFs module
+*
+* @return	DWORD
+*
+* @note		The time stamp is fixed as in diskio.c, so that images
+*		created by the same sequence of calls are identical.
+*
+****************************************************************************/
+DWORD get_fattime (void)
+{
+	return	((DWORD)(2010U - 1980U) << 25U)	/* Fixed to Jan. 1, 2010 */
+		| ((DWORD)1 << 21)
+		| ((DWORD)1 << 16)
+		| ((DWORD)0 << 11)
+		| ((DWORD)0 << 5)
+		| ((DWORD)0 >> 1);
+}
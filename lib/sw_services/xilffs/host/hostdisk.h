@@ -0,0 +1,73 @@
+/******************************************************************************
+*
+* Copyright (C) 2018 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file hostdisk.h
+*		Image file backed block device for the Linux host build of
+*		XilFFs. hostdisk.c implements the disk_xxx functions of diskio.h
+*		on top of a regular file, accessed either with pread/pwrite or
+*		through a shared mapping of the whole image.
+*
+******************************************************************************/
+#ifndef HOSTDISK_H
+#define HOSTDISK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "diskio.h"
+
+#define HOSTDISK_DRIVES		2U		/* Number of physical drives */
+#define HOSTDISK_SECTOR_SIZE	512U
+
+/* Access modes of hostdisk_open() */
+#define HOSTDISK_FILE		0x00U	/* pread()/pwrite() on the image */
+#define HOSTDISK_MMAP		0x01U	/* memcpy() on a shared mapping of the image */
+#define HOSTDISK_SYNC		0x02U	/* CTRL_SYNC flushes to the host disk too */
+#define HOSTDISK_CREATE		0x04U	/* Create (or zero) the image with the given size */
+
+/* Transfer counters of a drive, see hostdisk_stat() */
+typedef struct {
+	u64	read_cmds;		/* disk_read() calls */
+	u64	read_sectors;	/* Sectors read */
+	u64	write_cmds;		/* disk_write() calls */
+	u64	write_sectors;	/* Sectors written */
+	u64	syncs;			/* CTRL_SYNC requests */
+} HOSTDISK_STAT;
+
+int hostdisk_open (BYTE pdrv, const char* path, u64 size, BYTE mode);
+void hostdisk_close (BYTE pdrv);
+void hostdisk_stat (BYTE pdrv, HOSTDISK_STAT* stat, BYTE reset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -111,6 +111,11 @@ static u32 CardDetect;
 static u32 WriteProtect;
 static u32 SlotType[2];
 static u8 HostCntrlrVer[2];
+
+/* Largest transfer (in blocks) that the ADMA2 descriptor table can describe */
+#define SD_MAX_BLKCNT	((u32)(sizeof(SdInstance[0].Adma2_DescrTbl) / \
+			sizeof(SdInstance[0].Adma2_DescrTbl[0])) * \
+			(XSDPS_DESC_MAX_LENGTH / XSDPS_BLK_SIZE_512_MASK))
 #endif
 
 /*-----------------------------------------------------------------------*/
@@ -337,6 +342,9 @@ DRESULT disk_read (
 #ifdef FILE_SYSTEM_INTERFACE_SD
 	s32 Status;
 	DWORD LocSector = sector;
+	UINT LocCount = count;
+	UINT BlkCnt;
+	BYTE *LocBuff = buff;
 #endif
 
 	s = disk_status(pdrv);
@@ -354,9 +362,17 @@ DRESULT disk_read (
 		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
 	}
 
-	Status  = XSdPs_ReadPolled(&SdInstance[pdrv], (u32)LocSector, count, buff);
-	if (Status != XST_SUCCESS) {
-		return RES_ERROR;
+	/* Transfer in pieces the descriptor table can hold */
+	while (LocCount > 0U) {
+		BlkCnt = (LocCount > SD_MAX_BLKCNT) ? SD_MAX_BLKCNT : LocCount;
+		Status  = XSdPs_ReadPolled(&SdInstance[pdrv], (u32)LocSector, BlkCnt, LocBuff);
+		if (Status != XST_SUCCESS) {
+			return RES_ERROR;
+		}
+		LocSector += ((SdInstance[pdrv].HCS) == 0U) ?
+				(BlkCnt * (DWORD)XSDPS_BLK_SIZE_512_MASK) : BlkCnt;
+		LocBuff += BlkCnt * XSDPS_BLK_SIZE_512_MASK;
+		LocCount -= BlkCnt;
 	}
 #endif
 
@@ -480,6 +496,9 @@ DRESULT disk_write (
 #ifdef FILE_SYSTEM_INTERFACE_SD
 	s32 Status;
 	DWORD LocSector = sector;
+	UINT LocCount = count;
+	UINT BlkCnt;
+	const BYTE *LocBuff = buff;
 #endif
 
 	s = disk_status(pdrv);
@@ -496,9 +515,17 @@ DRESULT disk_write (
 		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
 	}
 
-	Status  = XSdPs_WritePolled(&SdInstance[pdrv], (u32)LocSector, count, buff);
-	if (Status != XST_SUCCESS) {
-		return RES_ERROR;
+	/* Transfer in pieces the descriptor table can hold */
+	while (LocCount > 0U) {
+		BlkCnt = (LocCount > SD_MAX_BLKCNT) ? SD_MAX_BLKCNT : LocCount;
+		Status  = XSdPs_WritePolled(&SdInstance[pdrv], (u32)LocSector, BlkCnt, LocBuff);
+		if (Status != XST_SUCCESS) {
+			return RES_ERROR;
+		}
+		LocSector += ((SdInstance[pdrv].HCS) == 0U) ?
+				(BlkCnt * (DWORD)XSDPS_BLK_SIZE_512_MASK) : BlkCnt;
+		LocBuff += BlkCnt * XSDPS_BLK_SIZE_512_MASK;
+		LocCount -= BlkCnt;
 	}
 
 #endif
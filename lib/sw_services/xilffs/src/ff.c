@@ -28,7 +28,8 @@
 *
 ******************************************************************************/
 #include "xparameters.h"
-#if (defined FILE_SYSTEM_INTERFACE_SD) || (defined FILE_SYSTEM_INTERFACE_RAM)
+#if (defined FILE_SYSTEM_INTERFACE_SD) || (defined FILE_SYSTEM_INTERFACE_RAM) || \
+	(defined FILE_SYSTEM_INTERFACE_HOST)
 #include "ff.h"			/* Declarations of FatFs API */
 #include "diskio.h"		/* Declarations of device I/O functions */
 #include "xil_printf.h"
@@ -87,6 +88,23 @@
 #define MAX_EXFAT	0x7FFFFFFD		/* Max exFAT clusters (differs from specs, implementation limit) */
 
 
+/* Sector cache: route the disk I/O of this module through ffcache.c. Window
+/  transfers are sorted into the FAT and directory pools, all other transfers
+/  (file data, f_mkfs and f_fdisk) use the data pool. */
+#if FF_USE_CACHE
+#define win_pool(fs, sect)	(((fs)->fs_type != 0 && (sect) - (fs)->fatbase < (fs)->fsize * (fs)->n_fats) ? FF_CACHE_FAT : FF_CACHE_DIR)
+#define win_read(fs, sect)	ff_cache_read((fs)->pdrv, win_pool(fs, sect), (fs)->win, (sect), 1)
+#define win_write(fs, sect)	ff_cache_write((fs)->pdrv, win_pool(fs, sect), (fs)->win, (sect), 1)
+#define disk_initialize(pdrv)	ff_cache_initialize(pdrv)
+#define disk_read(pdrv, buff, sect, cnt)	ff_cache_read((pdrv), FF_CACHE_DATA, (buff), (sect), (cnt))
+#define disk_write(pdrv, buff, sect, cnt)	ff_cache_write((pdrv), FF_CACHE_DATA, (buff), (sect), (cnt))
+#define disk_ioctl(pdrv, cmd, buff)	ff_cache_ioctl((pdrv), (cmd), (buff))
+#else
+#define win_read(fs, sect)	disk_read((fs)->pdrv, (fs)->win, (sect), 1)
+#define win_write(fs, sect)	disk_write((fs)->pdrv, (fs)->win, (sect), 1)
+#endif
+
+
 /* FatFs refers the FAT structure as simple byte array instead of structure member
 / because the C structure is not binary compatible between different platforms */
 
@@ -1055,10 +1073,10 @@ static FRESULT sync_window (	/* Returns FR_OK or FR_DISK_ERR */
 
 
 	if (fs->wflag) {	/* Is the disk access window dirty */
-		if (disk_write(fs->pdrv, fs->win, fs->winsect, 1) == RES_OK) {	/* Write back the window */
+		if (win_write(fs, fs->winsect) == RES_OK) {	/* Write back the window */
 			fs->wflag = 0;	/* Clear window dirty flag */
 			if (fs->winsect - fs->fatbase < fs->fsize) {	/* Is it in the 1st FAT? */
-				if (fs->n_fats == 2) disk_write(fs->pdrv, fs->win, fs->winsect + fs->fsize, 1);	/* Reflect it to 2nd FAT if needed */
+				if (fs->n_fats == 2) win_write(fs, fs->winsect + fs->fsize);	/* Reflect it to 2nd FAT if needed */
 			}
 		} else {
 			res = FR_DISK_ERR;
@@ -1082,7 +1100,7 @@ static FRESULT move_window (	/* Returns FR_OK or FR_DISK_ERR */
 		res = sync_window(fs);		/* Write-back changes */
 #endif
 		if (res == FR_OK) {			/* Fill sector window with new data */
-			if (disk_read(fs->pdrv, fs->win, sector, 1) != RES_OK) {
+			if (win_read(fs, sector) != RES_OK) {
 				sector = 0xFFFFFFFF;	/* Invalidate window if read data is not valid */
 				res = FR_DISK_ERR;
 			}
@@ -1119,7 +1137,7 @@ static FRESULT sync_fs (	/* Returns FR_OK or FR_DISK_ERR */
 			st_dword(fs->win + FSI_Nxt_Free, fs->last_clst);
 			/* Write it into the FSInfo sector */
 			fs->winsect = fs->volbase + 1;
-			disk_write(fs->pdrv, fs->win, fs->winsect, 1);
+			win_write(fs, fs->winsect);
 			fs->fsi_flag = 0;
 		}
 		/* Make sure that no pending write process in the lower layer */
@@ -1227,6 +1245,159 @@ static DWORD get_fat (		/* 0xFFFFFFFF:Disk error, 1:Internal error, 2..0x7FFFFFF
 
 
 
+#if FF_USE_FREEMAP
+/*-----------------------------------------------------------------------*/
+/* FAT handling - Free cluster map                                       */
+/*-----------------------------------------------------------------------*/
+/* The free cluster map holds the number of free clusters in each group of
+/  fs->fmap_gcl clusters. A group is made of whole FAT sectors (allocation bitmap
+/  sectors at exFAT), so that a group with free clusters is scanned with a few
+/  window loads and groups without free clusters are skipped. The map is built
+/  on first use after mount by reading the FAT in bursts and is kept up to date
+/  by put_fat() and change_bitmap(). FAT12 volumes do not use it. */
+
+#if FF_FS_REENTRANT
+#define FMAP_BUFS	FF_VOLUMES	/* Volumes are locked one by one, each scans into its own buffer */
+#else
+#define FMAP_BUFS	1
+#endif
+static DWORD FreeMap[FF_VOLUMES][FF_FREEMAP_GROUPS];	/* Free cluster map of each volume */
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+static BYTE FreeMapBuf[FMAP_BUFS][FF_FREEMAP_BURST * FF_MAX_SS];
+#elif defined (__aarch64__)
+static BYTE FreeMapBuf[FMAP_BUFS][FF_FREEMAP_BURST * FF_MAX_SS] __attribute__ ((aligned(64)));	/* Scan buffer */
+#else
+static BYTE FreeMapBuf[FMAP_BUFS][FF_FREEMAP_BURST * FF_MAX_SS] __attribute__ ((aligned(32)));	/* Scan buffer */
+#endif
+
+#define FMAP_TOP(fs)	(((fs)->fs_type == FS_EXFAT) ? 2 : 0)	/* Cluster of the first entry of group 0 */
+
+
+static void freemap_adjust (
+	FATFS* fs,		/* Filesystem object */
+	DWORD clst,		/* Cluster which has been allocated or freed */
+	int d			/* -1:Allocated, 1:Freed */
+)
+{
+	if (fs->fmap) fs->fmap[(clst - FMAP_TOP(fs)) / fs->fmap_gcl] += (DWORD)d;
+}
+
+
+static FRESULT freemap_build (	/* FR_OK (also when the volume cannot use the map) or FR_DISK_ERR */
+	FATFS* fs		/* Filesystem object */
+)
+{
+	DWORD epsec, nent, ent, sect, nsect, gcl, nfree, *map;
+	UINT vol, i, n, b;
+	BYTE bm, *buf;
+
+
+	if (fs->fmap || fs->fs_type == FS_FAT12) return FR_OK;
+	for (vol = 0; vol < FF_VOLUMES && FatFs[vol] != fs; vol++) ;
+	if (vol == FF_VOLUMES) return FR_OK;
+	if (sync_window(fs) != FR_OK) return FR_DISK_ERR;	/* Scan reads the medium */
+
+	if (fs->fs_type == FS_EXFAT) {	/* exFAT: Allocation bitmap (assuming it is located top of the cluster heap) */
+		epsec = SS(fs) * 8; nent = fs->n_fatent - 2; sect = fs->database;
+	} else {						/* FAT16/32: FAT entries */
+		epsec = SS(fs) / ((fs->fs_type == FS_FAT16) ? 2 : 4); nent = fs->n_fatent; sect = fs->fatbase;
+	}
+	nsect = (nent + epsec - 1) / epsec;
+	gcl = (nsect + FF_FREEMAP_GROUPS - 1) / FF_FREEMAP_GROUPS * epsec;	/* Whole sectors per group */
+	map = FreeMap[vol];
+	buf = FreeMapBuf[vol % FMAP_BUFS];
+	mem_set(map, 0, sizeof FreeMap[0]);
+
+	nfree = 0; ent = 0;
+	while (nsect) {		/* Count free entries of each group */
+		n = (nsect < FF_FREEMAP_BURST) ? (UINT)nsect : FF_FREEMAP_BURST;
+		if (disk_read(fs->pdrv, buf, sect, n) != RES_OK) return FR_DISK_ERR;
+		sect += n; nsect -= n;
+		n *= SS(fs);
+		for (i = 0; i < n && ent < nent; ) {
+			switch (fs->fs_type) {
+			case FS_EXFAT :
+				for (bm = buf[i++], b = 8; b && ent < nent; b--, ent++) {
+					if (!(bm & 1)) { map[ent / gcl]++; nfree++; }
+					bm >>= 1;
+				}
+				break;
+			case FS_FAT16 :
+				if (ld_word(buf + i) == 0) { map[ent / gcl]++; nfree++; }
+				i += 2; ent++;
+				break;
+			default :
+				if ((ld_dword(buf + i) & 0x0FFFFFFF) == 0) { map[ent / gcl]++; nfree++; }
+				i += 4; ent++;
+			}
+		}
+	}
+	fs->fmap = map;
+	fs->fmap_gcl = gcl;
+	fs->free_clst = nfree;	/* The free cluster count is exact now */
+	fs->fsi_flag |= 1;
+	return FR_OK;
+}
+
+
+static DWORD freemap_find (	/* 0:Not found, 0xFFFFFFFF:Disk error, 1:Internal error, >=2:First cluster of the block */
+	FATFS* fs,		/* Filesystem object with a valid map */
+	DWORD clst,		/* Cluster to scan from */
+	DWORD ncl		/* Number of contiguous free clusters to find (1..) */
+)
+{
+	DWORD top = FMAP_TOP(fs), gcl = fs->fmap_gcl;
+	DWORD cl, scl, ctr, g, gs, ge, val;
+	FFOBJID obj;
+	int wrap = 0;
+
+
+	obj.fs = fs;
+	if (clst < 2 || clst >= fs->n_fatent) clst = 2;
+	cl = scl = clst; ctr = 0;
+	for (;;) {
+		if (cl >= fs->n_fatent) {	/* Wrap-around (a block does not span the end of the volume) */
+			if (wrap) return 0;
+			wrap = 1; cl = scl = 2; ctr = 0;
+		}
+		if (wrap && cl >= clst) return 0;	/* All clusters scanned? */
+		g = (cl - top) / gcl;
+		gs = top + g * gcl;					/* First cluster of the group */
+		ge = gs + gcl;						/* End of the group */
+		if (ge > fs->n_fatent) ge = fs->n_fatent;
+		if (fs->fmap[g] == 0) {				/* No free cluster in the group */
+			cl = scl = ge; ctr = 0;
+			continue;
+		}
+		if (cl == gs && fs->fmap[g] == ge - gs) {	/* Whole group is free */
+			ctr += ge - gs; cl = ge;
+			if (ctr >= ncl) return scl;
+			continue;
+		}
+		do {								/* Scan the group */
+			if (fs->fs_type == FS_EXFAT) {
+				if (move_window(fs, fs->database + (cl - 2) / 8 / SS(fs)) != FR_OK) return 0xFFFFFFFF;
+				val = fs->win[(cl - 2) / 8 % SS(fs)] & (1 << ((cl - 2) % 8));
+			} else {
+				val = get_fat(&obj, cl);
+				if (val == 1 || val == 0xFFFFFFFF) return val;
+			}
+			cl++;
+			if (val == 0) {					/* Free cluster */
+				if (++ctr == ncl) return scl;
+			} else {
+				scl = cl; ctr = 0;
+			}
+		} while (cl < ge && !(wrap && cl >= clst));
+	}
+}
+
+#endif	/* FF_USE_FREEMAP */
+
+
+
+
 #if !FF_FS_READONLY
 /*-----------------------------------------------------------------------*/
 /* FAT access - Change value of a FAT entry                              */
@@ -1262,6 +1433,9 @@ static FRESULT put_fat (	/* FR_OK(0):succeeded, !=0:error */
 		case FS_FAT16 :
 			res = move_window(fs, fs->fatbase + (clst / (SS(fs) / 2)));
 			if (res != FR_OK) break;
+#if FF_USE_FREEMAP
+			if (!ld_word(fs->win + clst * 2 % SS(fs)) != !(WORD)val) freemap_adjust(fs, clst, val ? -1 : 1);
+#endif
 			st_word(fs->win + clst * 2 % SS(fs), (WORD)val);	/* Simple WORD array */
 			fs->wflag = 1;
 			break;
@@ -1273,6 +1447,11 @@ static FRESULT put_fat (	/* FR_OK(0):succeeded, !=0:error */
 			res = move_window(fs, fs->fatbase + (clst / (SS(fs) / 4)));
 			if (res != FR_OK) break;
 			if (!FF_FS_EXFAT || fs->fs_type != FS_EXFAT) {
+#if FF_USE_FREEMAP
+				if (!(ld_dword(fs->win + clst * 4 % SS(fs)) & 0x0FFFFFFF) != !(val & 0x0FFFFFFF)) {
+					freemap_adjust(fs, clst, (val & 0x0FFFFFFF) ? -1 : 1);
+				}
+#endif
 				val = (val & 0x0FFFFFFF) | (ld_dword(fs->win + clst * 4 % SS(fs)) & 0xF0000000);
 			}
 			st_dword(fs->win + clst * 4 % SS(fs), val);
@@ -1308,6 +1487,13 @@ static DWORD find_bitmap (	/* 0:Not found, 2..:Cluster block found, 0xFFFFFFFF:D
 	DWORD val, scl, ctr;
 
 
+#if FF_USE_FREEMAP
+	if (freemap_build(fs) != FR_OK) return 0xFFFFFFFF;
+	if (fs->fmap) {		/* Skip full cluster groups with the free cluster map */
+		val = freemap_find(fs, clst, ncl);
+		return (val == 1) ? 0xFFFFFFFF : val;
+	}
+#endif
 	clst -= 2;	/* The first bit in the bitmap corresponds to cluster #2 */
 	if (clst >= fs->n_fatent - 2) clst = 0;
 	scl = val = clst; ctr = 0;
@@ -1347,6 +1533,9 @@ static FRESULT change_bitmap (
 	BYTE bm;
 	UINT i;
 	DWORD sect;
+#if FF_USE_FREEMAP
+	DWORD cl = clst;
+#endif
 
 
 	clst -= 2;	/* The first bit corresponds to cluster #2 */
@@ -1360,6 +1549,9 @@ static FRESULT change_bitmap (
 				if (bv == (int)((fs->win[i] & bm) != 0)) return FR_INT_ERR;	/* Is the bit expected value? */
 				fs->win[i] ^= bm;	/* Flip the bit */
 				fs->wflag = 1;
+#if FF_USE_FREEMAP
+				freemap_adjust(fs, cl++, bv ? -1 : 1);
+#endif
 				if (--ncl == 0) return FR_OK;	/* All bits processed? */
 			} while (bm <<= 1);		/* Next bit */
 			bm = 1;
@@ -1580,17 +1772,26 @@ static DWORD create_chain (	/* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:D
 			}
 		}
 		if (ncl == 0) {	/* The new cluster cannot be contiguous and find another fragment */
-			ncl = scl;	/* Start cluster */
-			for (;;) {
-				ncl++;							/* Next cluster */
-				if (ncl >= fs->n_fatent) {		/* Check wrap-around */
-					ncl = 2;
-					if (ncl > scl) return 0;	/* No free cluster found? */
+#if FF_USE_FREEMAP
+			if (freemap_build(fs) != FR_OK) return 0xFFFFFFFF;
+			if (fs->fmap) {	/* Skip full cluster groups with the free cluster map */
+				ncl = freemap_find(fs, scl + 1, 1);
+				if (ncl < 2 || ncl == 0xFFFFFFFF) return ncl;
+			} else
+#endif
+			{
+				ncl = scl;	/* Start cluster */
+				for (;;) {
+					ncl++;							/* Next cluster */
+					if (ncl >= fs->n_fatent) {		/* Check wrap-around */
+						ncl = 2;
+						if (ncl > scl) return 0;	/* No free cluster found? */
+					}
+					cs = get_fat(obj, ncl);			/* Get the cluster status */
+					if (cs == 0) break;				/* Found a free cluster? */
+					if (cs == 1 || cs == 0xFFFFFFFF) return cs;	/* Test for error */
+					if (ncl == scl) return 0;		/* No free cluster found? */
 				}
-				cs = get_fat(obj, ncl);			/* Get the cluster status */
-				if (cs == 0) break;				/* Found a free cluster? */
-				if (cs == 1 || cs == 0xFFFFFFFF) return cs;	/* Test for error */
-				if (ncl == scl) return 0;		/* No free cluster found? */
 			}
 		}
 		res = put_fat(fs, ncl, 0xFFFFFFFF);		/* Mark the new cluster 'EOC' */
@@ -1644,6 +1845,209 @@ static DWORD clmt_clust (	/* <2:Error, >=2:Cluster number */
 
 
 
+#if FF_FASTSEEK_AUTO
+/*-----------------------------------------------------------------------*/
+/* FAT handling - Automatic cluster map of large files                   */
+/*-----------------------------------------------------------------------*/
+
+struct ff_xmap {
+	FIL*	fp;			/* Owner file object (null: free) */
+	FATFS*	fs;			/* Filesystem object of the owner */
+	WORD	id;			/* Volume mount ID of the owner */
+	UINT	n;			/* Number of extents */
+	DWORD	ncl;		/* Number of clusters covered by the extents */
+	DWORD	ofs[FF_FASTSEEK_EXTENTS];	/* Cluster order of the first cluster of each extent */
+	DWORD	top[FF_FASTSEEK_EXTENTS];	/* First cluster of each extent */
+};
+
+static struct ff_xmap XMap[FF_FASTSEEK_MAPS];	/* Pool of cluster maps */
+
+
+static void xmap_release (
+	FIL* fp,		/* File object to release the map of */
+	FATFS* fs		/* Release all maps of this volume instead (fp = 0) */
+)
+{
+	UINT i;
+
+
+	for (i = 0; i < FF_FASTSEEK_MAPS; i++) {
+		if ((fp && XMap[i].fp == fp) || (!fp && XMap[i].fs == fs)) {
+			XMap[i].fp = 0; XMap[i].fs = 0;
+		}
+	}
+	if (fp) fp->xmap = 0;
+}
+
+
+static DWORD xmap_clust (	/* 0:No map, 1:Internal error, 0xFFFFFFFF:Disk error, >=2:Cluster number */
+	FIL* fp,		/* Pointer to the file object */
+	DWORD* ncl		/* Cluster order to look up, returns the order of the returned cluster */
+)
+{
+	FATFS *fs = fp->obj.fs;
+	struct ff_xmap *xm = fp->xmap;
+	DWORD bcs, lim, cl, pcl, i;
+	UINT n, lo, hi;
+
+
+	bcs = (DWORD)fs->csize * SS(fs);
+	lim = (DWORD)((fp->obj.objsize + bcs - 1) / bcs);	/* Clusters within the file size */
+	if (lim < FF_FASTSEEK_MIN_CLST || fp->obj.sclust == 0) return 0;
+	if (*ncl >= lim) *ncl = lim - 1;
+#if FF_FS_EXFAT
+	if (fp->obj.stat == 2) return fp->obj.sclust + *ncl;	/* Contiguous file needs no map */
+#endif
+
+	if (!xm || xm->fp != fp || xm->fs != fs || xm->id != fs->id) {	/* Create the map on first use */
+		fp->xmap = xm = 0;
+		for (n = 0; n < FF_FASTSEEK_MAPS; n++) {	/* Take a free map, or one of a dismounted volume */
+			if (!XMap[n].fp || XMap[n].fs->id != XMap[n].id) {
+				xm = &XMap[n]; break;
+			}
+		}
+		if (!xm) return 0;		/* Pool is exhausted */
+		xm->fp = fp; xm->fs = fs; xm->id = fs->id;
+		xm->n = 0; xm->ncl = 0;
+		fp->xmap = xm;
+	}
+
+	if (xm->ncl < lim && xm->n < FF_FASTSEEK_EXTENTS) {	/* Record the chain up to the file size */
+		n = xm->n; i = xm->ncl; pcl = 0;
+		if (n == 0) {
+			cl = fp->obj.sclust;
+		} else {				/* The file has grown since, continue after the last cluster */
+			pcl = xm->top[n - 1] + (i - 1 - xm->ofs[n - 1]);
+			cl = get_fat(&fp->obj, pcl);
+			if (cl == 0xFFFFFFFF) return cl;
+			if (cl < 2 || cl >= fs->n_fatent) return 1;
+		}
+		while (i < lim) {
+			if (n == 0 || cl != pcl + 1) {	/* Start of a new extent? */
+				if (n == FF_FASTSEEK_EXTENTS) break;
+				xm->ofs[n] = i; xm->top[n] = cl; n++;
+			}
+			pcl = cl;
+			if (++i >= lim) break;
+			cl = get_fat(&fp->obj, cl);
+			if (cl == 0xFFFFFFFF) return cl;
+			if (cl < 2 || cl >= fs->n_fatent) return 1;
+		}
+		xm->n = n; xm->ncl = i;
+	}
+
+	if (*ncl >= xm->ncl) *ncl = xm->ncl - 1;	/* Stop at the last recorded cluster */
+	lo = 0; hi = xm->n - 1;
+	while (lo < hi) {		/* Find the last extent starting at or before the cluster */
+		n = (lo + hi + 1) / 2;
+		if (xm->ofs[n] <= *ncl) {
+			lo = n;
+		} else {
+			hi = n - 1;
+		}
+	}
+	return xm->top[lo] + (*ncl - xm->ofs[lo]);
+}
+
+#endif	/* FF_FASTSEEK_AUTO */
+
+
+
+
+#if FF_USE_DIRECT
+/*-----------------------------------------------------------------------*/
+/* File access - Contiguous run for direct transfer                      */
+/*-----------------------------------------------------------------------*/
+/* A direct transfer that reaches the end of the current cluster is carried
+/  on into the following clusters as long as they are contiguous, so a large
+/  f_read()/f_write() to a cache-line aligned buffer becomes one multi-block
+/  disk command per fragment instead of one per cluster. */
+
+#define IS_DIRECT(p)	(((UINTPTR)(p) % FF_DIRECT_ALIGN) == 0)
+
+static FF_IO_STAT IoStat;	/* Direct/bounce transfer counters */
+
+
+#if !FF_FS_READONLY
+static DWORD direct_free (	/* 0:In use or out of the volume, 1:Free, 0xFFFFFFFF:Disk error */
+	FFOBJID* obj,	/* Object whose chain is to be stretched */
+	DWORD clst		/* Cluster to test */
+)
+{
+	FATFS *fs = obj->fs;
+	DWORD val;
+
+
+	if (clst < 2 || clst >= fs->n_fatent) return 0;
+#if FF_FS_EXFAT
+	if (fs->fs_type == FS_EXFAT) {	/* Allocation bitmap */
+		if (move_window(fs, fs->database + (clst - 2) / 8 / SS(fs)) != FR_OK) return 0xFFFFFFFF;
+		return (fs->win[(clst - 2) / 8 % SS(fs)] & (1 << ((clst - 2) % 8))) ? 0 : 1;
+	}
+#endif
+	val = get_fat(obj, clst);
+	if (val == 0xFFFFFFFF) return val;
+	return (val == 0) ? 1 : 0;
+}
+#endif
+
+
+static UINT direct_run (	/* Returns number of sectors added to the run */
+	FIL* fp,		/* Pointer to the file object (fp->clust is the last cluster of the run) */
+	UINT nsect,		/* Number of whole sectors left to transfer past the current cluster */
+	int stretch		/* 0:Follow the chain, 1:Stretch the chain if needed */
+)
+{
+	FATFS *fs = fp->obj.fs;
+	DWORD clst, bcs = (DWORD)fs->csize * SS(fs);
+#if !FF_FS_READONLY
+	FSIZE_t pos;
+#endif
+	UINT n = 0;
+
+
+	while (nsect - n >= fs->csize) {
+#if FF_USE_FASTSEEK
+		if (fp->cltbl) {
+			clst = clmt_clust(fp, (fp->fptr / bcs + 1) * bcs + (FSIZE_t)n * SS(fs));
+		} else
+#endif
+		{
+#if !FF_FS_READONLY
+			if (stretch) {
+				pos = (fp->fptr / bcs + 1) * bcs + (FSIZE_t)n * SS(fs);	/* End of the current cluster */
+				if (fp->obj.objsize < pos) fp->obj.objsize = pos;	/* Cover it, as the exFAT chain is generated from the size */
+			}
+#endif
+			clst = get_fat(&fp->obj, fp->clust);
+#if !FF_FS_READONLY
+			if (stretch && clst >= fs->n_fatent && clst != 0xFFFFFFFF) {	/* End of the chain? */
+				if (direct_free(&fp->obj, fp->clust + 1) != 1) break;	/* Stretch only with the next cluster, f_write() allocates any other */
+				clst = create_chain(&fp->obj, fp->clust);
+			}
+#endif
+		}
+		if (clst != fp->clust + 1) break;	/* End of the run (errors are caught by the caller on the next cluster) */
+		fp->clust = clst;
+		n += fs->csize;
+	}
+	return n;
+}
+
+
+void ff_io_stat (
+	FF_IO_STAT* stat,	/* Returns the counters (can be null) */
+	BYTE reset			/* 1: Clear the counters */
+)
+{
+	if (stat) *stat = IoStat;
+	if (reset) mem_set(&IoStat, 0, sizeof IoStat);
+}
+
+#endif	/* FF_USE_DIRECT */
+
+
+
 
 /*-----------------------------------------------------------------------*/
 /* Directory handling - Fill a cluster with zeros                        */
@@ -2414,12 +2818,123 @@ static FRESULT dir_read (
 
 
 
+#if FF_USE_DIRCACHE
+/*-----------------------------------------------------------------------*/
+/* Directory handling - Name lookup cache                                */
+/*-----------------------------------------------------------------------*/
+/* Each volume has a table of FF_DIRCACHE_ENTRIES entries, DC_WAYS per set,
+/  that maps the hash of a name in a directory to the offset of its entry block.
+/  The table is a hint. A position taken from it is accepted only when the
+/  entry found there matches the name, so stale entries just cost one read.
+/  The hash is an FNV-1a hash of the up-case converted LFN (of the SFN at non-LFN
+/  configuration). The 16-bit xname_sum() of exFAT is not used as the key since
+/  names that differ only in a few characters often share it. */
+
+#define DC_WAYS	4
+
+#if FF_DIRCACHE_ENTRIES < DC_WAYS || FF_DIRCACHE_ENTRIES % DC_WAYS
+#error FF_DIRCACHE_ENTRIES must be a multiple of 4
+#endif
+
+struct ff_dcent {
+	DWORD	dcl;		/* Start cluster of the directory (0:root) */
+	DWORD	hash;		/* Hash of the name */
+	DWORD	ofs;		/* Offset of the entry block (0xFFFFFFFF:unused) */
+	DWORD	end;		/* Offset of the SFN entry (file entry at exFAT) */
+};
+
+static struct ff_dcent DirCache[FF_VOLUMES][FF_DIRCACHE_ENTRIES];	/* Name lookup tables */
+
+
+static DWORD dc_hash (	/* Get the hash of the name in the directory object */
+	DIR* dp
+)
+{
+	DWORD h = 0x811C9DC5;
+	UINT i;
+#if FF_USE_LFN
+	DWORD wc;
+	const WCHAR *p;
+#endif
+
+
+#if FF_USE_LFN
+	if (!(dp->fn[NSFLAG] & NS_NOLFN)) {	/* Hash the LFN */
+		for (p = dp->obj.fs->lfnbuf; (wc = *p) != 0; p++) {
+			if (wc >= 0x80) {
+				wc = ff_wtoupper(wc);
+			} else if (IsLower(wc)) {
+				wc -= 0x20;
+			}
+			h = (h ^ wc) * 0x01000193;
+		}
+		return h;
+	}
+#endif
+	for (i = 0; i < 11; i++) h = (h ^ dp->fn[i]) * 0x01000193;	/* Hash the SFN */
+	return ~h;
+}
+
+
+static struct ff_dcent* dc_set (	/* Get the set of a name */
+	FATFS* fs,
+	DWORD dcl,
+	DWORD hash
+)
+{
+	return fs->dcache + ((((hash ^ dcl) * 0x9E3779B1) >> 16) % (FF_DIRCACHE_ENTRIES / DC_WAYS)) * DC_WAYS;
+}
+
+
+static void dc_put (	/* Record the object found or created in the directory */
+	DIR* dp,
+	DWORD hash,		/* Hash of the name */
+	DWORD ofs,		/* Offset of the entry block */
+	DWORD end		/* Offset of the SFN entry (file entry at exFAT) */
+)
+{
+	struct ff_dcent *set = dc_set(dp->obj.fs, dp->obj.sclust, hash);
+	UINT i;
+
+
+	for (i = 0; i < DC_WAYS - 1; i++) {	/* Find the entry or take the least recently used one */
+		if (set[i].dcl == dp->obj.sclust && set[i].ofs == ofs) break;
+	}
+	for ( ; i > 0; i--) set[i] = set[i - 1];	/* Put it on the top of the set */
+	set[0].dcl = dp->obj.sclust; set[0].hash = hash;
+	set[0].ofs = ofs; set[0].end = end;
+}
+
+
+#if !FF_FS_READONLY && FF_FS_MINIMIZE == 0
+static void dc_drop (	/* Forget the object at an offset of a directory */
+	FATFS* fs,
+	DWORD dcl,
+	DWORD ofs
+)
+{
+	UINT i;
+
+
+	for (i = 0; i < FF_DIRCACHE_ENTRIES; i++) {
+		if (fs->dcache[i].ofs == ofs && fs->dcache[i].dcl == dcl) fs->dcache[i].ofs = 0xFFFFFFFF;
+	}
+}
+#endif
+
+#endif	/* FF_USE_DIRCACHE */
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Directory handling - Find an object in the directory                  */
 /*-----------------------------------------------------------------------*/
 
-static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
-	DIR* dp					/* Pointer to the directory object with the file name */
+static FRESULT dir_match (	/* FR_OK(0):succeeded, FR_NO_FILE:not found, !=0:error */
+	DIR* dp,				/* Pointer to the directory object with the file name */
+	DWORD ofs,				/* Offset to start the search at */
+	DWORD end				/* Offset of the last entry block to be compared */
 )
 {
 	FRESULT res;
@@ -2429,7 +2944,7 @@ static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 	BYTE a, ord, sum;
 #endif
 
-	res = dir_sdi(dp, 0);			/* Rewind directory object */
+	res = dir_sdi(dp, ofs);			/* Move to the start offset */
 	if (res != FR_OK) return res;
 #if FF_FS_EXFAT
 	if (fs->fs_type == FS_EXFAT) {	/* On the exFAT volume */
@@ -2438,6 +2953,7 @@ static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 		WORD hash = xname_sum(fs->lfnbuf);		/* Hash value of the name to find */
 
 		while ((res = dir_read_file(dp)) == FR_OK) {	/* Read an item */
+			if (dp->blk_ofs > end) { res = FR_NO_FILE; break; }	/* Passed the last item to compare */
 #if FF_MAX_LFN < 255
 			if (fs->dirbuf[XDIR_NumName] > FF_MAX_LFN) continue;			/* Skip comparison if inaccessible object name */
 #endif
@@ -2485,6 +3001,7 @@ static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 		dp->obj.attr = dp->dir[DIR_Attr] & AM_MASK;
 		if (!(dp->dir[DIR_Attr] & AM_VOL) && !mem_cmp(dp->dir, dp->fn, 11)) break;	/* Is it a valid entry? */
 #endif
+		if (dp->dptr >= end) { res = FR_NO_FILE; break; }	/* Passed the last entry to compare */
 		res = dir_next(dp, 0);	/* Next entry */
 	} while (res == FR_OK);
 
@@ -2492,6 +3009,52 @@ static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 }
 
 
+static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
+	DIR* dp					/* Pointer to the directory object with the file name */
+)
+{
+#if FF_USE_DIRCACHE
+	FRESULT res;
+	struct ff_dcent *set, ent;
+	DWORD hash = dc_hash(dp);
+	UINT i;
+
+
+	set = dc_set(dp->obj.fs, dp->obj.sclust, hash);
+	for (i = 0; i < DC_WAYS; i++) {	/* Try the positions recorded for the name */
+		if (set[i].ofs == 0xFFFFFFFF || set[i].dcl != dp->obj.sclust || set[i].hash != hash) continue;
+		ent = set[i];
+		res = dir_match(dp, ent.ofs, ent.end);
+		if (res == FR_OK) {			/* Hit; move the entry to the top of the set */
+			for ( ; i > 0; i--) set[i] = set[i - 1];
+			set[0] = ent;
+			return FR_OK;
+		}
+		if (res == FR_DISK_ERR) return res;
+		set[i].ofs = 0xFFFFFFFF;	/* Discard the stale entry */
+	}
+	res = dir_match(dp, 0, 0xFFFFFFFF);	/* Scan the directory */
+	if (res == FR_OK) {					/* Record the position of the object */
+#if FF_FS_EXFAT
+		if (dp->obj.fs->fs_type == FS_EXFAT) {
+			dc_put(dp, hash, dp->blk_ofs, dp->blk_ofs);
+		} else
+#endif
+		{
+#if FF_USE_LFN
+			dc_put(dp, hash, (dp->blk_ofs != 0xFFFFFFFF) ? dp->blk_ofs : dp->dptr, dp->dptr);
+#else
+			dc_put(dp, hash, dp->dptr, dp->dptr);
+#endif
+		}
+	}
+	return res;
+#else
+	return dir_match(dp, 0, 0xFFFFFFFF);	/* Scan the directory */
+#endif
+}
+
+
 
 
 #if !FF_FS_READONLY
@@ -2541,6 +3104,9 @@ static FRESULT dir_register (	/* FR_OK:succeeded, FR_DENIED:no free entry or too
 		}
 
 		create_xdir(fs->dirbuf, fs->lfnbuf);	/* Create on-memory directory block to be written later */
+#if FF_USE_DIRCACHE
+		dc_put(dp, dc_hash(dp), dp->blk_ofs, dp->blk_ofs);
+#endif
 		return FR_OK;
 	}
 #endif
@@ -2592,6 +3158,15 @@ static FRESULT dir_register (	/* FR_OK:succeeded, FR_DENIED:no free entry or too
 			fs->wflag = 1;
 		}
 	}
+#if FF_USE_DIRCACHE
+	if (res == FR_OK) {		/* Record the new object */
+#if FF_USE_LFN
+		dc_put(dp, dc_hash(dp), (sn[NSFLAG] & NS_LFN) ? dp->dptr - SZDIRE * ((nlen + 12) / 13) : dp->dptr, dp->dptr);
+#else
+		dc_put(dp, dc_hash(dp), dp->dptr, dp->dptr);
+#endif
+	}
+#endif
 
 	return res;
 }
@@ -2614,6 +3189,9 @@ static FRESULT dir_remove (	/* FR_OK:Succeeded, FR_DISK_ERR:A disk error */
 #if FF_USE_LFN		/* LFN configuration */
 	DWORD last = dp->dptr;
 
+#if FF_USE_DIRCACHE
+	dc_drop(fs, dp->obj.sclust, (dp->blk_ofs == 0xFFFFFFFF) ? dp->dptr : dp->blk_ofs);
+#endif
 	res = (dp->blk_ofs == 0xFFFFFFFF) ? FR_OK : dir_sdi(dp, dp->blk_ofs);	/* Goto top of the entry block if LFN is exist */
 	if (res == FR_OK) {
 		do {
@@ -2632,6 +3210,9 @@ static FRESULT dir_remove (	/* FR_OK:Succeeded, FR_DISK_ERR:A disk error */
 	}
 #else			/* Non LFN configuration */
 
+#if FF_USE_DIRCACHE
+	dc_drop(fs, dp->obj.sclust, dp->dptr);
+#endif
 	res = move_window(fs, dp->sect);
 	if (res == FR_OK) {
 		dp->dir[DIR_Name] = DDEM;	/* Mark the entry 'deleted'.*/
@@ -3421,6 +4002,13 @@ static FRESULT find_volume (	/* FR_OK(0): successful, !=0: an error occurred */
 
 	fs->fs_type = fmt;		/* FAT sub-type */
 	fs->id = ++Fsid;		/* Volume mount ID */
+#if FF_USE_FREEMAP
+	fs->fmap = 0;			/* Free cluster map is built on first use */
+#endif
+#if FF_USE_DIRCACHE
+	fs->dcache = DirCache[vol];	/* Name lookup table starts empty */
+	mem_set(fs->dcache, 0xFF, sizeof DirCache[0]);
+#endif
 #if FF_USE_LFN == 1
 	fs->lfnbuf = LfnBuf;	/* Static LFN working buffer */
 #if FF_FS_EXFAT
@@ -3508,6 +4096,9 @@ FRESULT f_mount (
 #if FF_FS_LOCK != 0
 		clear_lock(cfs);
 #endif
+#if FF_FASTSEEK_AUTO
+		xmap_release(0, cfs);			/* Release cluster maps of the volume */
+#endif
 #if FF_FS_REENTRANT						/* Discard sync object of the current volume */
 		if (!ff_del_syncobj(cfs->sobj)) return FR_INT_ERR;
 #endif
@@ -3675,6 +4266,9 @@ FRESULT f_open (
 			}
 #if FF_USE_FASTSEEK
 			fp->cltbl = 0;			/* Disable fast seek mode */
+#endif
+#if FF_FASTSEEK_AUTO
+			xmap_release(fp, 0);	/* Drop a map left by a previous use of the object */
 #endif
 			fp->obj.fs = fs;	 	/* Validate the file object */
 			fp->obj.id = fs->id;
@@ -3775,8 +4369,14 @@ FRESULT f_read (
 			if (cc > 0) {						/* Read maximum contiguous sectors directly */
 				if (csect + cc > fs->csize) {	/* Clip at cluster boundary */
 					cc = fs->csize - csect;
+#if FF_USE_DIRECT
+					if (IS_DIRECT(rbuff)) cc += direct_run(fp, btr / SS(fs) - cc, 0);	/* Carry on over contiguous clusters */
+#endif
 				}
 				if (disk_read(fs->pdrv, rbuff, sect, cc) != RES_OK) ABORT(fs, FR_DISK_ERR);
+#if FF_USE_DIRECT
+				IoStat.direct += (QWORD)SS(fs) * cc; IoStat.xfers++;
+#endif
 #if !FF_FS_READONLY && FF_FS_MINIMIZE <= 2		/* Replace one of the read sectors with cached data if it contains a dirty sector */
 #if FF_FS_TINY
 				if (fs->wflag && fs->winsect - sect < cc) {
@@ -3806,6 +4406,9 @@ FRESULT f_read (
 		}
 		rcnt = SS(fs) - (UINT)fp->fptr % SS(fs);	/* Number of bytes left in the sector */
 		if (rcnt > btr) rcnt = btr;					/* Clip it by btr if needed */
+#if FF_USE_DIRECT
+		IoStat.bounce += rcnt;
+#endif
 #if FF_FS_TINY
 		if (move_window(fs, fp->sect) != FR_OK) ABORT(fs, FR_DISK_ERR);	/* Move sector window */
 		mem_cpy(rbuff, fs->win + fp->fptr % SS(fs), rcnt);	/* Extract partial sector */
@@ -3890,8 +4493,14 @@ FRESULT f_write (
 			if (cc > 0) {					/* Write maximum contiguous sectors directly */
 				if (csect + cc > fs->csize) {	/* Clip at cluster boundary */
 					cc = fs->csize - csect;
+#if FF_USE_DIRECT
+					if (IS_DIRECT(wbuff)) cc += direct_run(fp, btw / SS(fs) - cc, 1);	/* Carry on over contiguous clusters */
+#endif
 				}
 				if (disk_write(fs->pdrv, wbuff, sect, cc) != RES_OK) ABORT(fs, FR_DISK_ERR);
+#if FF_USE_DIRECT
+				IoStat.direct += (QWORD)SS(fs) * cc; IoStat.xfers++;
+#endif
 #if FF_FS_MINIMIZE <= 2
 #if FF_FS_TINY
 				if (fs->winsect - sect < cc) {	/* Refill sector cache if it gets invalidated by the direct write */
@@ -3924,6 +4533,9 @@ FRESULT f_write (
 		}
 		wcnt = SS(fs) - (UINT)fp->fptr % SS(fs);	/* Number of bytes left in the sector */
 		if (wcnt > btw) wcnt = btw;					/* Clip it by btw if needed */
+#if FF_USE_DIRECT
+		IoStat.bounce += wcnt;
+#endif
 #if FF_FS_TINY
 		if (move_window(fs, fp->sect) != FR_OK) ABORT(fs, FR_DISK_ERR);	/* Move sector window */
 		mem_cpy(fs->win + fp->fptr % SS(fs), wbuff, wcnt);	/* Fit data to the sector */
@@ -4041,6 +4653,9 @@ FRESULT f_close (
 	{
 		res = validate(&fp->obj, &fs);	/* Lock volume */
 		if (res == FR_OK) {
+#if FF_FASTSEEK_AUTO
+			xmap_release(fp, 0);		/* Release the cluster map */
+#endif
 #if FF_FS_LOCK != 0
 			res = dec_lock(fp->obj.lockid);		/* Decrement file open counter */
 			if (res == FR_OK) fp->obj.fs = 0;	/* Invalidate file object */
@@ -4253,6 +4868,8 @@ FRESULT f_lseek (
 	FSIZE_t ifptr;
 #if FF_USE_FASTSEEK
 	DWORD cl, pcl, ncl, tcl, dsc, tlen, ulen, *tbl;
+#elif FF_FASTSEEK_AUTO
+	DWORD ncl, tcl;
 #endif
 
 	res = validate(&fp->obj, &fs);		/* Check validity of the file object */
@@ -4345,6 +4962,19 @@ FRESULT f_lseek (
 #endif
 				fp->clust = clst;
 			}
+#if FF_FASTSEEK_AUTO
+			if (clst != 0 && ofs > 2 * (FSIZE_t)bcs) {	/* Jump over the chain with the cluster map */
+				ncl = (DWORD)((fp->fptr + ofs - 1) / bcs);	/* Order of the target cluster */
+				tcl = xmap_clust(fp, &ncl);
+				if (tcl == 1) ABORT(fs, FR_INT_ERR);
+				if (tcl == 0xFFFFFFFF) ABORT(fs, FR_DISK_ERR);
+				if (tcl >= 2 && (FSIZE_t)ncl * bcs > fp->fptr) {
+					ofs -= (FSIZE_t)ncl * bcs - fp->fptr;
+					fp->fptr = (FSIZE_t)ncl * bcs;
+					fp->clust = clst = tcl;
+				}
+			}
+#endif
 			if (clst != 0) {
 				while (ofs > bcs) {						/* Cluster following loop */
 					ofs -= bcs; fp->fptr += bcs;
@@ -4639,6 +5269,13 @@ FRESULT f_getfree (
 	res = find_volume(&path, &fs, 0);
 	if (res == FR_OK) {
 		*fatfs = fs;				/* Return ptr to the fs object */
+#if FF_USE_FREEMAP
+		/* Building the free cluster map validates free_clst */
+		if (fs->free_clst > fs->n_fatent - 2) res = freemap_build(fs);
+		if (res != FR_OK) {
+			*nclst = 0;
+		} else
+#endif
 		/* If free_clst is valid, return it without full FAT scan */
 		if (fs->free_clst <= fs->n_fatent - 2) {
 			*nclst = fs->free_clst;
@@ -4739,6 +5376,9 @@ FRESULT f_truncate (
 		}
 		fp->obj.objsize = fp->fptr;	/* Set file size to current read/write point */
 		fp->flag |= FA_MODIFIED;
+#if FF_FASTSEEK_AUTO
+		xmap_release(fp, 0);	/* The chain has changed */
+#endif
 #if !FF_FS_TINY
 		if (res == FR_OK && (fp->flag & FA_DIRTY)) {
 			if (disk_write(fs->pdrv, fp->buf, fp->sect, 1) != RES_OK) {
@@ -5400,18 +6040,29 @@ FRESULT f_expand (
 	} else
 #endif
 	{
-		scl = clst = stcl; ncl = 0;
-		for (;;) {	/* Find a contiguous cluster block */
-			n = get_fat(&fp->obj, clst);
-			if (++clst >= fs->n_fatent) clst = 2;
-			if (n == 1) { res = FR_INT_ERR; break; }
-			if (n == 0xFFFFFFFF) { res = FR_DISK_ERR; break; }
-			if (n == 0) {	/* Is it a free cluster? */
-				if (++ncl == tcl) break;	/* Break if a contiguous cluster block is found */
-			} else {
-				scl = clst; ncl = 0;		/* Not a free cluster */
+#if FF_USE_FREEMAP
+		res = freemap_build(fs);
+		if (res == FR_OK && fs->fmap) {	/* Find a contiguous cluster block with the free cluster map */
+			scl = freemap_find(fs, stcl, tcl);
+			if (scl == 0) res = FR_DENIED;
+			if (scl == 1) res = FR_INT_ERR;
+			if (scl == 0xFFFFFFFF) res = FR_DISK_ERR;
+		} else if (res == FR_OK)
+#endif
+		{
+			scl = clst = stcl; ncl = 0;
+			for (;;) {	/* Find a contiguous cluster block */
+				n = get_fat(&fp->obj, clst);
+				if (++clst >= fs->n_fatent) clst = 2;
+				if (n == 1) { res = FR_INT_ERR; break; }
+				if (n == 0xFFFFFFFF) { res = FR_DISK_ERR; break; }
+				if (n == 0) {	/* Is it a free cluster? */
+					if (++ncl == tcl) break;	/* Break if a contiguous cluster block is found */
+				} else {
+					scl = clst; ncl = 0;		/* Not a free cluster */
+				}
+				if (clst == stcl) { res = FR_DENIED; break; }	/* No contiguous cluster? */
 			}
-			if (clst == stcl) { res = FR_DENIED; break; }	/* No contiguous cluster? */
 		}
 		if (res == FR_OK) {	/* A contiguous free area is found */
 			if (opt) {		/* Allocate it now */
@@ -6554,4 +7205,4 @@ FRESULT f_setcp (
 }
 #endif	/* FF_CODE_PAGE == 0 */
 
-#endif /* (defined FILE_SYSTEM_INTERFACE_SD) || (defined FILE_SYSTEM_INTERFACE_RAM) */
+#endif /* FILE_SYSTEM_INTERFACE_SD || FILE_SYSTEM_INTERFACE_RAM || FILE_SYSTEM_INTERFACE_HOST */
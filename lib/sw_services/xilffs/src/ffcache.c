@@ -0,0 +1,438 @@
+/******************************************************************************
+*
+* Copyright (C) 2018 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file ffcache.c
+*		Sector cache between the FatFs module and the disk I/O layer.
+*
+*		When FF_USE_CACHE is enabled, every sector transfer of ff.c
+*		goes through this module. Single sector transfers are served
+*		from three set associative pools with LRU replacement, one for
+*		FAT sectors, one for directory and other window sectors and
+*		one for file data, so that walking FAT chains and scanning
+*		directories does not evict each other. Multi-sector transfers
+*		go straight to the disk and are kept coherent with the cached
+*		copies.
+*
+*		Writes are cached (write-back). Dirty sectors are written to
+*		the disk when they are evicted and when FatFs issues CTRL_SYNC,
+*		i.e. on f_sync(), f_close() and the other functions that
+*		synchronize the volume.
+*
+*		The pools are shared by all drives and are not protected for
+*		concurrent use from several threads.
+*
+* @note
+*
+******************************************************************************/
+#include "xparameters.h"
+#if (defined FILE_SYSTEM_INTERFACE_SD) || (defined FILE_SYSTEM_INTERFACE_RAM) || \
+	(defined FILE_SYSTEM_INTERFACE_HOST)
+#include "ff.h"
+#include "diskio.h"
+
+#if FF_USE_CACHE
+#include <string.h>
+
+#if FF_CACHE_WAYS < 1
+#error FF_CACHE_WAYS must be at least 1
+#endif
+#if FF_CACHE_FAT_SECTORS < 1 || FF_CACHE_DIR_SECTORS < 1 || FF_CACHE_DATA_SECTORS < 1
+#error Every sector cache pool needs at least one sector
+#endif
+
+/* Associativity of a pool of n sectors */
+#define POOL_WAYS(n)	(((n) < FF_CACHE_WAYS) ? (n) : FF_CACHE_WAYS)
+
+#if (FF_CACHE_FAT_SECTORS % POOL_WAYS(FF_CACHE_FAT_SECTORS)) || \
+	(FF_CACHE_DIR_SECTORS % POOL_WAYS(FF_CACHE_DIR_SECTORS)) || \
+	(FF_CACHE_DATA_SECTORS % POOL_WAYS(FF_CACHE_DATA_SECTORS))
+#error Sector cache pool sizes must be multiples of FF_CACHE_WAYS
+#endif
+
+#define CACHE_VALID	0x01U
+#define CACHE_DIRTY	0x02U
+
+#ifdef __ICCARM__
+#define CACHE_ALIGN
+#elif defined (__aarch64__)
+#define CACHE_ALIGN	__attribute__ ((aligned(64)))
+#else
+#define CACHE_ALIGN	__attribute__ ((aligned(32)))
+#endif
+
+typedef struct {
+	DWORD	sect;		/* Sector number held in the line */
+	DWORD	stamp;		/* Last use, for LRU replacement */
+	BYTE	pdrv;		/* Physical drive of the sector */
+	BYTE	flags;		/* CACHE_VALID, CACHE_DIRTY */
+} CACHE_TAG;
+
+typedef struct {
+	CACHE_TAG*	tag;
+	BYTE*		buf;	/* Line data, FF_MAX_SS bytes per line */
+	UINT		lines;
+	UINT		ways;
+	FF_CACHE_STAT	stat;
+} CACHE_POOL;
+
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+#endif
+static BYTE FatBuf[FF_CACHE_FAT_SECTORS * FF_MAX_SS] CACHE_ALIGN;
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+#endif
+static BYTE DirBuf[FF_CACHE_DIR_SECTORS * FF_MAX_SS] CACHE_ALIGN;
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+#endif
+static BYTE DataBuf[FF_CACHE_DATA_SECTORS * FF_MAX_SS] CACHE_ALIGN;
+
+static CACHE_TAG FatTag[FF_CACHE_FAT_SECTORS];
+static CACHE_TAG DirTag[FF_CACHE_DIR_SECTORS];
+static CACHE_TAG DataTag[FF_CACHE_DATA_SECTORS];
+
+static CACHE_POOL Pool[FF_CACHE_POOLS] = {
+	{ FatTag, FatBuf, FF_CACHE_FAT_SECTORS,
+	  POOL_WAYS(FF_CACHE_FAT_SECTORS), { 0U } },
+	{ DirTag, DirBuf, FF_CACHE_DIR_SECTORS,
+	  POOL_WAYS(FF_CACHE_DIR_SECTORS), { 0U } },
+	{ DataTag, DataBuf, FF_CACHE_DATA_SECTORS,
+	  POOL_WAYS(FF_CACHE_DATA_SECTORS), { 0U } }
+};
+
+static DWORD Stamp;
+
+
+/*-----------------------------------------------------------------------*/
+/* Locate a sector in any pool, returns the line or -1                   */
+/*-----------------------------------------------------------------------*/
+
+static int cache_find (
+	BYTE pdrv,
+	DWORD sector,
+	CACHE_POOL** pool
+)
+{
+	CACHE_POOL* p;
+	UINT i, w, set;
+
+	/* A sector lives in at most one pool, whichever loaded it first */
+	for (i = 0; i < FF_CACHE_POOLS; i++) {
+		p = &Pool[i];
+		set = (UINT)(sector % (p->lines / p->ways)) * p->ways;
+		for (w = set; w < set + p->ways; w++) {
+			if ((p->tag[w].flags & CACHE_VALID) != 0U &&
+					p->tag[w].sect == sector && p->tag[w].pdrv == pdrv) {
+				*pool = p;
+				return (int)w;
+			}
+		}
+	}
+	return -1;
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Write a dirty line back to the disk                                   */
+/*-----------------------------------------------------------------------*/
+
+#if !FF_FS_READONLY
+static DRESULT cache_clean (
+	CACHE_POOL* p,
+	UINT line
+)
+{
+	CACHE_TAG* t = &p->tag[line];
+
+	if ((t->flags & CACHE_DIRTY) != 0U) {
+		if (disk_write(t->pdrv, p->buf + line * FF_MAX_SS, t->sect, 1) != RES_OK) {
+			return RES_ERROR;
+		}
+		t->flags &= (BYTE)~CACHE_DIRTY;
+		p->stat.writeback++;
+	}
+	return RES_OK;
+}
+#endif
+
+
+/*-----------------------------------------------------------------------*/
+/* Pick the least recently used line of the sector's set in a pool       */
+/*-----------------------------------------------------------------------*/
+
+static int cache_victim (
+	CACHE_POOL* p,
+	DWORD sector
+)
+{
+	UINT w, set, lru;
+
+	set = (UINT)(sector % (p->lines / p->ways)) * p->ways;
+	lru = set;
+	for (w = set; w < set + p->ways; w++) {
+		if ((p->tag[w].flags & CACHE_VALID) == 0U) {
+			return (int)w;
+		}
+		if ((DWORD)(Stamp - p->tag[w].stamp) > (DWORD)(Stamp - p->tag[lru].stamp)) {
+			lru = w;
+		}
+	}
+#if !FF_FS_READONLY
+	if (cache_clean(p, lru) != RES_OK) {
+		return -1;
+	}
+#endif
+	p->tag[lru].flags = 0U;
+	return (int)lru;
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Read sector(s) through the cache                                      */
+/*-----------------------------------------------------------------------*/
+
+DRESULT ff_cache_read (
+	BYTE pdrv,		/* Physical drive number */
+	BYTE pool,		/* Pool for the sector if it is not cached (FF_CACHE_xxx) */
+	BYTE* buff,		/* Data buffer to store read data */
+	DWORD sector,	/* Start sector number */
+	UINT count		/* Number of sectors to read */
+)
+{
+	CACHE_POOL* p;
+	DRESULT res;
+	UINT i;
+	int line;
+
+	if (count != 1U) {
+		/* Bulk transfer straight from the disk, then overlay dirty lines */
+		res = disk_read(pdrv, buff, sector, count);
+		if (res == RES_OK) {
+			for (p = Pool; p < &Pool[FF_CACHE_POOLS]; p++) {
+				for (i = 0; i < p->lines; i++) {
+					if ((p->tag[i].flags & CACHE_DIRTY) != 0U &&
+							p->tag[i].pdrv == pdrv &&
+							p->tag[i].sect - sector < count) {
+						memcpy(buff + (p->tag[i].sect - sector) * FF_MAX_SS,
+								p->buf + i * FF_MAX_SS, FF_MAX_SS);
+					}
+				}
+			}
+		}
+		return res;
+	}
+
+	line = cache_find(pdrv, sector, &p);
+	if (line >= 0) {
+		Pool[pool].stat.hit++;
+	} else {
+		Pool[pool].stat.miss++;
+		p = &Pool[pool];
+		line = cache_victim(p, sector);
+		if (line < 0) {
+			return RES_ERROR;
+		}
+		res = disk_read(pdrv, p->buf + (UINT)line * FF_MAX_SS, sector, 1);
+		if (res != RES_OK) {
+			return res;
+		}
+		p->tag[line].sect = sector;
+		p->tag[line].pdrv = pdrv;
+		p->tag[line].flags = CACHE_VALID;
+	}
+	p->tag[line].stamp = ++Stamp;
+	memcpy(buff, p->buf + (UINT)line * FF_MAX_SS, FF_MAX_SS);
+
+	return RES_OK;
+}
+
+
+#if !FF_FS_READONLY
+/*-----------------------------------------------------------------------*/
+/* Write sector(s) through the cache                                     */
+/*-----------------------------------------------------------------------*/
+
+DRESULT ff_cache_write (
+	BYTE pdrv,			/* Physical drive number */
+	BYTE pool,			/* Pool for the sector if it is not cached (FF_CACHE_xxx) */
+	const BYTE* buff,	/* Data to be written */
+	DWORD sector,		/* Start sector number */
+	UINT count			/* Number of sectors to write */
+)
+{
+	CACHE_POOL* p;
+	DRESULT res;
+	UINT i;
+	int line;
+
+	if (count != 1U) {
+		/* Bulk transfer straight to the disk, cached copies are now clean */
+		res = disk_write(pdrv, buff, sector, count);
+		if (res == RES_OK) {
+			for (p = Pool; p < &Pool[FF_CACHE_POOLS]; p++) {
+				for (i = 0; i < p->lines; i++) {
+					if ((p->tag[i].flags & CACHE_VALID) != 0U &&
+							p->tag[i].pdrv == pdrv &&
+							p->tag[i].sect - sector < count) {
+						memcpy(p->buf + i * FF_MAX_SS,
+								buff + (p->tag[i].sect - sector) * FF_MAX_SS, FF_MAX_SS);
+						p->tag[i].flags = CACHE_VALID;
+					}
+				}
+			}
+		}
+		return res;
+	}
+
+	line = cache_find(pdrv, sector, &p);
+	if (line >= 0) {
+		Pool[pool].stat.hit++;
+	} else {
+		/* Whole sector is overwritten, no need to read it first */
+		Pool[pool].stat.miss++;
+		p = &Pool[pool];
+		line = cache_victim(p, sector);
+		if (line < 0) {
+			return RES_ERROR;
+		}
+		p->tag[line].sect = sector;
+		p->tag[line].pdrv = pdrv;
+	}
+	memcpy(p->buf + (UINT)line * FF_MAX_SS, buff, FF_MAX_SS);
+	p->tag[line].flags = CACHE_VALID | CACHE_DIRTY;
+	p->tag[line].stamp = ++Stamp;
+
+	return RES_OK;
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Write all dirty sectors of a drive back to the disk                   */
+/*-----------------------------------------------------------------------*/
+
+DRESULT ff_cache_flush (
+	BYTE pdrv		/* Physical drive number */
+)
+{
+	CACHE_POOL* p;
+	DRESULT res = RES_OK;
+	UINT i;
+
+	for (p = Pool; p < &Pool[FF_CACHE_POOLS]; p++) {
+		for (i = 0; i < p->lines; i++) {
+			if (p->tag[i].pdrv == pdrv && cache_clean(p, i) != RES_OK) {
+				res = RES_ERROR;
+			}
+		}
+	}
+	return res;
+}
+#endif
+
+
+/*-----------------------------------------------------------------------*/
+/* Drop all sectors of a drive, dirty or not                             */
+/*-----------------------------------------------------------------------*/
+
+void ff_cache_invalidate (
+	BYTE pdrv		/* Physical drive number */
+)
+{
+	CACHE_POOL* p;
+	UINT i;
+
+	for (p = Pool; p < &Pool[FF_CACHE_POOLS]; p++) {
+		for (i = 0; i < p->lines; i++) {
+			if (p->tag[i].pdrv == pdrv) {
+				p->tag[i].flags = 0U;
+			}
+		}
+	}
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Initialize the drive, dropping the sectors of a re-inserted medium    */
+/*-----------------------------------------------------------------------*/
+
+DSTATUS ff_cache_initialize (
+	BYTE pdrv		/* Physical drive number */
+)
+{
+	if ((disk_status(pdrv) & STA_NOINIT) != 0U) {
+		ff_cache_invalidate(pdrv);
+	}
+	return disk_initialize(pdrv);
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Disk control, flushing the cache on CTRL_SYNC                         */
+/*-----------------------------------------------------------------------*/
+
+DRESULT ff_cache_ioctl (
+	BYTE pdrv,		/* Physical drive number */
+	BYTE cmd,		/* Control code */
+	void* buff		/* Buffer to send/receive control data */
+)
+{
+#if !FF_FS_READONLY
+	if (cmd == (BYTE)CTRL_SYNC && ff_cache_flush(pdrv) != RES_OK) {
+		return RES_ERROR;
+	}
+#endif
+	return disk_ioctl(pdrv, cmd, buff);
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Get (and optionally clear) the hit/miss counters of a pool            */
+/*-----------------------------------------------------------------------*/
+
+void ff_cache_stat (
+	BYTE pool,				/* FF_CACHE_FAT, FF_CACHE_DIR or FF_CACHE_DATA */
+	FF_CACHE_STAT* stat,	/* Returns the counters (can be null) */
+	BYTE reset				/* 1: Clear the counters */
+)
+{
+	if (pool >= FF_CACHE_POOLS) {
+		return;
+	}
+	if (stat != NULL) {
+		*stat = Pool[pool].stat;
+	}
+	if (reset != 0U) {
+		memset(&Pool[pool].stat, 0, sizeof(FF_CACHE_STAT));
+	}
+}
+
+#endif /* FF_USE_CACHE */
+#endif
@@ -37,6 +37,16 @@ DRESULT disk_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
 
+/* Sector cache between FatFs and the functions above (ffcache.c) */
+#if FF_USE_CACHE
+DSTATUS ff_cache_initialize (BYTE pdrv);
+DRESULT ff_cache_read (BYTE pdrv, BYTE pool, BYTE* buff, DWORD sector, UINT count);
+DRESULT ff_cache_write (BYTE pdrv, BYTE pool, const BYTE* buff, DWORD sector, UINT count);
+DRESULT ff_cache_ioctl (BYTE pdrv, BYTE cmd, void* buff);
+DRESULT ff_cache_flush (BYTE pdrv);
+void ff_cache_invalidate (BYTE pdrv);
+#endif
+
 
 /* Disk Status Bits (DSTATUS) */
 
@@ -120,6 +120,13 @@ typedef struct {
 	DWORD	last_clst;		/* Last allocated cluster */
 	DWORD	free_clst;		/* Number of free clusters */
 #endif
+#if FF_USE_FREEMAP
+	DWORD*	fmap;			/* Free clusters in each cluster group (0:not built) */
+	DWORD	fmap_gcl;		/* Number of clusters in a group */
+#endif
+#if FF_USE_DIRCACHE
+	struct ff_dcent*	dcache;	/* Name lookup table of the volume */
+#endif
 #if FF_FS_RPATH
 	DWORD	cdir;			/* Current directory start cluster (0:root) */
 #if FF_FS_EXFAT
@@ -188,6 +195,9 @@ typedef struct {
 #if FF_USE_FASTSEEK
 	DWORD*	cltbl;			/* Pointer to the cluster link map table (nulled on open, set by application) */
 #endif
+#if FF_FASTSEEK_AUTO
+	struct ff_xmap*	xmap;	/* Pointer to the automatic cluster map (nulled on open) */
+#endif
 #if !FF_FS_TINY
 #ifdef __ICCARM__
 #pragma data_alignment = 32
@@ -348,6 +358,33 @@ void ff_rel_grant (FF_SYNC_t sobj);		/* Unlock sync object */
 int ff_del_syncobj (FF_SYNC_t sobj);	/* Delete a sync object */
 #endif
 
+/* Sector cache (defined in ffcache.c) */
+#if FF_USE_CACHE
+typedef struct {
+	DWORD	hit;		/* Sector found in the cache */
+	DWORD	miss;		/* Sector loaded into (or allocated in) the pool */
+	DWORD	writeback;	/* Dirty sectors written to the disk */
+} FF_CACHE_STAT;
+
+#define FF_CACHE_FAT	0	/* Pool for FAT sectors */
+#define FF_CACHE_DIR	1	/* Pool for directory and other window sectors */
+#define FF_CACHE_DATA	2	/* Pool for file data sectors */
+#define FF_CACHE_POOLS	3
+
+void ff_cache_stat (BYTE pool, FF_CACHE_STAT* stat, BYTE reset);	/* Get/clear hit and miss counters */
+#endif
+
+/* Direct transfer counters */
+#if FF_USE_DIRECT
+typedef struct {
+	QWORD	direct;		/* Bytes transferred between the disk and the caller's buffer */
+	QWORD	bounce;		/* Bytes copied through the sector buffer of the file or volume */
+	DWORD	xfers;		/* Number of direct multi-sector disk transfers */
+} FF_IO_STAT;
+
+void ff_io_stat (FF_IO_STAT* stat, BYTE reset);	/* Get/clear direct and bounce counters */
+#endif
+
 
 
 
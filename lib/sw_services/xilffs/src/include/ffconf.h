@@ -66,6 +66,54 @@ extern "C" {
 /* This option switches fast seek function. (0:Disable or 1:Enable) */
 
 
+#ifdef FILE_SYSTEM_FASTSEEK_AUTO
+#define FF_FASTSEEK_AUTO	1	/* 1:Enable */
+#else
+#define FF_FASTSEEK_AUTO	0	/* 0:Disable */
+#endif
+#ifdef FILE_SYSTEM_FASTSEEK_MAPS
+#define FF_FASTSEEK_MAPS	FILE_SYSTEM_FASTSEEK_MAPS
+#else
+#define FF_FASTSEEK_MAPS	4
+#endif
+#ifdef FILE_SYSTEM_FASTSEEK_EXTENTS
+#define FF_FASTSEEK_EXTENTS	FILE_SYSTEM_FASTSEEK_EXTENTS
+#else
+#define FF_FASTSEEK_EXTENTS	128
+#endif
+#define FF_FASTSEEK_MIN_CLST	64
+/* The FF_FASTSEEK_AUTO option switches automatic fast seek. (0:Disable or 1:Enable)
+/  When enabled, the first f_lseek() that has to follow the cluster chain of a file
+/  of FF_FASTSEEK_MIN_CLST clusters or more records the chain as a list of extents
+/  (runs of contiguous clusters). Following seeks in that file look the target
+/  cluster up in the list instead of following the FAT. The lists are taken from a
+/  pool of FF_FASTSEEK_MAPS maps of up to FF_FASTSEEK_EXTENTS extents each and are
+/  released by f_close(). Files that are opened while the pool is in use, or file
+/  areas beyond the last recorded extent, are sought as before. This option works
+/  independently of FF_USE_FASTSEEK, a cluster link map table set by the
+/  application takes precedence. */
+
+
+#ifdef FILE_SYSTEM_USE_DIRECT
+#define FF_USE_DIRECT	1	/* 1:Enable */
+#else
+#define FF_USE_DIRECT	0	/* 0:Disable */
+#endif
+#ifdef FILE_SYSTEM_DIRECT_ALIGN
+#define FF_DIRECT_ALIGN	FILE_SYSTEM_DIRECT_ALIGN
+#else
+#define FF_DIRECT_ALIGN	64
+#endif
+/* The FF_USE_DIRECT option switches multi-cluster direct transfer. (0:Disable or 1:Enable)
+/  f_read() and f_write() move whole sectors between the disk and the caller's
+/  buffer without copying. Without this option such a transfer stops at every
+/  cluster boundary. When enabled and the buffer is aligned to FF_DIRECT_ALIGN
+/  bytes (the data cache line size, so DMA cache maintenance does not touch
+/  neighbouring data), the transfer goes on over the following clusters while
+/  they are contiguous on the disk. ff_io_stat() reports how many bytes were
+/  transferred directly and how many were copied through the sector buffer. */
+
+
 #define FF_USE_EXPAND	0
 /* This option switches f_expand function. (0:Disable or 1:Enable) */
 
@@ -193,6 +241,26 @@ extern "C" {
 */
 
 
+#ifdef FILE_SYSTEM_USE_DIRCACHE
+#define FF_USE_DIRCACHE	1	/* 1:Enable */
+#else
+#define FF_USE_DIRCACHE	0	/* 0:Disable */
+#endif
+#ifdef FILE_SYSTEM_DIRCACHE_ENTRIES
+#define FF_DIRCACHE_ENTRIES	FILE_SYSTEM_DIRCACHE_ENTRIES
+#else
+#define FF_DIRCACHE_ENTRIES	512
+#endif
+/* The FF_USE_DIRCACHE option switches the name lookup cache. (0:Disable or 1:Enable)
+/  When enabled, the position of each object found or created in a directory is
+/  recorded under a hash of its name, and later look-ups of the name (f_open,
+/  f_stat, path following and so on) go to that position instead of scanning the
+/  directory from the top. Each volume has a table of FF_DIRCACHE_ENTRIES entries
+/  (a multiple of 4) taking 16 bytes each, older entries are replaced first. A
+/  recorded position is used only after the entry there is checked against the
+/  name, names that are not in the table are searched as before. */
+
+
 /*---------------------------------------------------------------------------/
 / Drive/Volume Configurations
 /---------------------------------------------------------------------------*/
@@ -276,6 +344,66 @@ extern "C" {
 */
 
 
+#if (defined FILE_SYSTEM_USE_FREEMAP) && !FF_FS_READONLY
+#define FF_USE_FREEMAP	1	/* 1:Enable */
+#else
+#define FF_USE_FREEMAP	0	/* 0:Disable */
+#endif
+#ifdef FILE_SYSTEM_FREEMAP_GROUPS
+#define FF_FREEMAP_GROUPS	FILE_SYSTEM_FREEMAP_GROUPS
+#else
+#define FF_FREEMAP_GROUPS	2048
+#endif
+#define FF_FREEMAP_BURST	8
+/* The FF_USE_FREEMAP option switches the free cluster map. (0:Disable or 1:Enable)
+/  When enabled, the number of free clusters in each group of FAT sectors (bitmap
+/  sectors at exFAT) is kept in memory. Cluster allocation skips groups without
+/  free clusters, f_expand() finds contiguous blocks by whole groups, and
+/  f_getfree() returns the exact count without a FAT scan. The map is built on
+/  first use after mount by reading the FAT in bursts of FF_FREEMAP_BURST sectors;
+/  an application can call f_getfree() after f_mount() to build it up front.
+/  The map takes FF_VOLUMES * FF_FREEMAP_GROUPS * 4 bytes, large volumes use
+/  groups of several sectors. The scan buffer takes FF_FREEMAP_BURST * FF_MAX_SS
+/  bytes, once per volume when FF_FS_REENTRANT is enabled. It has no effect on FAT12 volumes and at read-only
+/  configuration. */
+
+
+#ifdef FILE_SYSTEM_USE_CACHE
+#define FF_USE_CACHE	1	/* 1:Enable */
+#else
+#define FF_USE_CACHE	0	/* 0:Disable */
+#endif
+#ifdef FILE_SYSTEM_CACHE_FAT_SECTORS
+#define FF_CACHE_FAT_SECTORS	FILE_SYSTEM_CACHE_FAT_SECTORS
+#else
+#define FF_CACHE_FAT_SECTORS	32
+#endif
+#ifdef FILE_SYSTEM_CACHE_DIR_SECTORS
+#define FF_CACHE_DIR_SECTORS	FILE_SYSTEM_CACHE_DIR_SECTORS
+#else
+#define FF_CACHE_DIR_SECTORS	32
+#endif
+#ifdef FILE_SYSTEM_CACHE_DATA_SECTORS
+#define FF_CACHE_DATA_SECTORS	FILE_SYSTEM_CACHE_DATA_SECTORS
+#else
+#define FF_CACHE_DATA_SECTORS	8
+#endif
+#ifdef FILE_SYSTEM_CACHE_WAYS
+#define FF_CACHE_WAYS	FILE_SYSTEM_CACHE_WAYS
+#else
+#define FF_CACHE_WAYS	4
+#endif
+/* The FF_USE_CACHE option switches the sector cache in ffcache.c (0:Disable or
+/  1:Enable). When enabled, single sector transfers are served from three LRU
+/  pools of FF_CACHE_FAT_SECTORS, FF_CACHE_DIR_SECTORS and FF_CACHE_DATA_SECTORS
+/  sectors for FAT, directory and file data sectors. Each pool is FF_CACHE_WAYS
+/  way set associative, so its size must be a multiple of FF_CACHE_WAYS.
+/  Written sectors are kept in the cache until they are evicted or the volume is
+/  synchronized (f_sync, f_close and so on). The cache takes
+/  (FF_CACHE_FAT_SECTORS + FF_CACHE_DIR_SECTORS + FF_CACHE_DATA_SECTORS) * FF_MAX_SS
+/  bytes of memory. */
+
+
 
 /*---------------------------------------------------------------------------/
 / System Configurations
@@ -0,0 +1,691 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file authbench.c
+*		Benchmark of the ZynqMP FSBL partition authentication and
+*		decryption on the software backend of xilsecure, see
+*		xsecure_sw.h.
+*
+*		The program first checks the backend against the SHA3-384,
+*		Keccak-384 and AES-256-GCM test vectors and an RSA-4096 sign
+*		and verify round trip, and reports the time of an RSA-4096
+*		signature verification with XSecure_RsaVerify(). For each
+*		image size it then builds a
+*		partition with an authentication certificate signed with a
+*		test key (SPK ID eFUSE revocation enabled) and a bootgen
+*		style encrypted partition with key rolling, verifies that
+*		XFsbl_Authentication() accepts the partition and rejects a
+*		modified one, and measures:
+*		- auth: XFsbl_Authentication() of the partition, SPK and
+*		  partition signature verification included
+*		- sha3: XSecure_Sha3Digest() of the partition data
+*		- aes: XSecure_AesDecrypt() of the encrypted partition to
+*		  memory
+*		- pcap: XSecure_AesDecrypt() of the encrypted partition read
+*		  through DeviceCopy in ping-pong chunks to the PCAP
+*
+*		Every result is reported in MB/s as the best of several runs,
+*		the time of auth also in milliseconds as it includes the
+*		fixed cost of the two RSA operations. Build the program once
+*		per AES implementation to compare them, see the Makefile.
+*
+*		The same test key is used as PPK and SPK.
+*
+* <pre>
+* usage: authbench [-n <runs>]
+* </pre>
+*
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "xil_types.h"
+#include "xil_io.h"
+#include "xplatform_info.h"
+#include "xsecure_sha.h"
+#include "xsecure_aes.h"
+#include "xsecure_rsa.h"
+#include "xsecure_sw.h"
+#include "xfsbl_authentication.h"
+
+#define BENCH_RUNS		3
+#define BENCH_SIGS		16	/* Signatures per RSA run */
+#define BENCH_MIN_SIZE	(64U * 1024U)
+#define BENCH_MAX_SIZE	(16U * 1024U * 1024U)
+#define BENCH_KEY_BLOCK	(64U * 1024U)	/* Key rolling block length */
+#define BENCH_CHUNK		(32U * 1024U)	/* DeviceCopy chunk length */
+#define BENCH_FLASH_BASE	0x1000U	/* Device address of the image */
+#define BENCH_SPK_ID	5U
+#define BENCH_RSA_SIZE	XSECURE_RSA_4096_KEY_SIZE
+#define BENCH_HASH_LEN	XFSBL_HASH_TYPE_SHA3
+#define BENCH_AC_SIZE	XFSBL_AUTH_CERT_MIN_SIZE
+#define BENCH_ENC_SIZE(Len) ((Len) + 64U + \
+			((((Len) + BENCH_KEY_BLOCK - 1U) / BENCH_KEY_BLOCK) * 64U))
+
+/* RSA-4096 test key, e = 65537 */
+static const u8 TestKeyMod[512] = {
+	0xC0U, 0xB4U, 0x69U, 0x3AU, 0x17U, 0x3EU, 0xB7U, 0x5DU, 0x99U, 0x91U,
+	0x11U, 0x36U, 0xDFU, 0xB1U, 0x6EU, 0x40U, 0xC2U, 0x35U, 0x2AU, 0x55U,
+	0x46U, 0xEAU, 0x34U, 0x74U, 0xB1U, 0x51U, 0xD0U, 0x2CU, 0x7AU, 0x79U,
+	0x1AU, 0x76U, 0xBDU, 0xA7U, 0xD8U, 0xA2U, 0xC4U, 0x10U, 0xF4U, 0x5BU,
+	0x7BU, 0x20U, 0xCCU, 0x87U, 0xC4U, 0xB1U, 0xC3U, 0xD5U, 0x08U, 0x6EU,
+	0xE6U, 0xA5U, 0x4BU, 0x0EU, 0x6BU, 0xF3U, 0xF5U, 0xCEU, 0x6FU, 0xCDU,
+	0xB0U, 0xEEU, 0xFEU, 0x2AU, 0x4FU, 0x80U, 0x82U, 0x89U, 0x73U, 0x1EU,
+	0xE6U, 0x08U, 0x17U, 0xCEU, 0x32U, 0x49U, 0x9FU, 0x7DU, 0x2CU, 0xE2U,
+	0x71U, 0xFDU, 0xA6U, 0xA7U, 0x26U, 0xD5U, 0x90U, 0xBEU, 0x9BU, 0xA9U,
+	0xBDU, 0xD3U, 0x7CU, 0x66U, 0x49U, 0x6CU, 0x01U, 0x26U, 0xE3U, 0xCAU,
+	0x51U, 0x49U, 0xAAU, 0xCDU, 0x12U, 0x99U, 0x2DU, 0xACU, 0x4CU, 0x4DU,
+	0x7BU, 0x9CU, 0x83U, 0x9EU, 0x61U, 0xDBU, 0x4CU, 0x2FU, 0xA5U, 0xB4U,
+	0xBEU, 0x3BU, 0x63U, 0x09U, 0xC6U, 0xE7U, 0x62U, 0x5CU, 0x6EU, 0xEFU,
+	0xB5U, 0x16U, 0x1BU, 0xC9U, 0xEDU, 0xE9U, 0x6BU, 0x96U, 0xAAU, 0x52U,
+	0x95U, 0x65U, 0x08U, 0xA0U, 0x21U, 0xB1U, 0x34U, 0x97U, 0xB4U, 0x70U,
+	0x4AU, 0xCDU, 0x0DU, 0xE6U, 0x43U, 0x20U, 0x17U, 0xF9U, 0x5BU, 0xD4U,
+	0x87U, 0x83U, 0x3EU, 0xECU, 0x06U, 0xCFU, 0x4BU, 0x99U, 0xC6U, 0x90U,
+	0x71U, 0x15U, 0xFAU, 0xF0U, 0x24U, 0x8CU, 0x39U, 0x6BU, 0x7EU, 0x46U,
+	0x58U, 0x85U, 0x53U, 0x6FU, 0x3AU, 0x3DU, 0x96U, 0x60U, 0x62U, 0x4FU,
+	0x33U, 0x43U, 0xE0U, 0x60U, 0x42U, 0x08U, 0x0FU, 0xBEU, 0xC6U, 0x51U,
+	0x14U, 0xFFU, 0x64U, 0x92U, 0x23U, 0x77U, 0x15U, 0x0FU, 0x4EU, 0x24U,
+	0x93U, 0x53U, 0x4CU, 0x32U, 0x1EU, 0x2DU, 0x0FU, 0x6FU, 0xCDU, 0x8CU,
+	0xA2U, 0xE0U, 0x1FU, 0xA7U, 0xD0U, 0xA8U, 0x96U, 0xEEU, 0x03U, 0x4AU,
+	0xAEU, 0xE9U, 0xEEU, 0xEAU, 0xBAU, 0xB9U, 0x36U, 0x99U, 0x2EU, 0x85U,
+	0x09U, 0xE7U, 0x6CU, 0x6BU, 0x20U, 0xAEU, 0x2AU, 0x36U, 0xA9U, 0xC6U,
+	0x90U, 0x3DU, 0x7AU, 0xA4U, 0x61U, 0xACU, 0x32U, 0x26U, 0xA5U, 0x8EU,
+	0x53U, 0x75U, 0x93U, 0x76U, 0x6AU, 0xB8U, 0x34U, 0xE0U, 0xEBU, 0xEEU,
+	0xE7U, 0x8AU, 0x8EU, 0x8AU, 0xCEU, 0x1AU, 0x04U, 0x0CU, 0x7AU, 0x9CU,
+	0x30U, 0x30U, 0x44U, 0xA5U, 0xBFU, 0x48U, 0xD9U, 0xC7U, 0xCEU, 0x58U,
+	0xCDU, 0x8DU, 0x1DU, 0x56U, 0xF0U, 0x19U, 0x50U, 0xABU, 0xA1U, 0xE5U,
+	0xADU, 0x92U, 0xDAU, 0x65U, 0x7CU, 0xAAU, 0x0EU, 0x40U, 0xB5U, 0x6BU,
+	0x58U, 0x73U, 0x58U, 0xDDU, 0xC2U, 0x6FU, 0x17U, 0xEFU, 0x1AU, 0x60U,
+	0x04U, 0xF5U, 0x9FU, 0xE0U, 0x02U, 0xA3U, 0x3DU, 0x50U, 0x03U, 0xB9U,
+	0x2CU, 0xDAU, 0xC7U, 0xDCU, 0x39U, 0xD2U, 0x16U, 0xB8U, 0x4DU, 0xD6U,
+	0xBFU, 0xCAU, 0x7DU, 0xBCU, 0xF9U, 0xE4U, 0x62U, 0xDDU, 0xFAU, 0x82U,
+	0x04U, 0x98U, 0xEEU, 0x9FU, 0xFEU, 0x5FU, 0x83U, 0xE3U, 0x80U, 0x38U,
+	0x3AU, 0xC4U, 0x33U, 0x6CU, 0x19U, 0xFDU, 0xBAU, 0x75U, 0xCDU, 0xE9U,
+	0xA9U, 0xD9U, 0x7BU, 0xC8U, 0xAEU, 0xD0U, 0x87U, 0x3FU, 0xFBU, 0xD7U,
+	0x04U, 0x95U, 0xCBU, 0xBCU, 0x14U, 0x4FU, 0x23U, 0xF5U, 0xDCU, 0x82U,
+	0xA6U, 0x9EU, 0x42U, 0x16U, 0x6DU, 0x60U, 0x5AU, 0x83U, 0xE4U, 0x08U,
+	0x62U, 0xC5U, 0xE6U, 0x2AU, 0x4FU, 0xE3U, 0x6BU, 0x1BU, 0x67U, 0xB9U,
+	0x6BU, 0x41U, 0x59U, 0x6BU, 0x93U, 0xA9U, 0x51U, 0x3DU, 0xBFU, 0x89U,
+	0x3EU, 0x9CU, 0x87U, 0xA8U, 0xD7U, 0x1FU, 0x51U, 0xC2U, 0x24U, 0xB7U,
+	0x7CU, 0x0DU, 0x68U, 0xE1U, 0xF9U, 0xBFU, 0x1CU, 0xBEU, 0x5CU, 0x64U,
+	0xFDU, 0x0AU, 0x63U, 0xD3U, 0xBBU, 0xA7U, 0x36U, 0xCBU, 0x7CU, 0xC9U,
+	0x38U, 0xEFU, 0xB5U, 0x91U, 0x49U, 0x62U, 0x97U, 0x6FU, 0x06U, 0x3EU,
+	0xF9U, 0xD4U, 0x8AU, 0x6AU, 0x34U, 0x64U, 0x39U, 0xD8U, 0x19U, 0x07U,
+	0x33U, 0xE9U, 0xD4U, 0x42U, 0x76U, 0x3FU, 0xBDU, 0x66U, 0x24U, 0x62U,
+	0x2DU, 0x42U, 0x23U, 0x40U, 0x9EU, 0x67U, 0x72U, 0x35U, 0x8DU, 0x22U,
+	0xFFU, 0x81U, 0x4CU, 0xEBU, 0x47U, 0x18U, 0x24U, 0x5AU, 0xFEU, 0x7AU,
+	0x88U, 0xC3U, 0xE9U, 0x8FU, 0x6CU, 0x12U, 0xEEU, 0x4EU, 0xC0U, 0x57U,
+	0x83U, 0xD9U
+};
+
+static const u8 TestKeyPriv[512] = {
+	0x02U, 0x6AU, 0xC0U, 0xDFU, 0x1FU, 0xA7U, 0x83U, 0xB9U, 0x42U, 0xD1U,
+	0xD4U, 0xFBU, 0x71U, 0x36U, 0xD2U, 0x81U, 0x31U, 0x6EU, 0x65U, 0x47U,
+	0x88U, 0x8AU, 0x2BU, 0x7AU, 0x43U, 0x37U, 0x19U, 0x7BU, 0x55U, 0x55U,
+	0xEBU, 0x85U, 0x0DU, 0xBFU, 0xEBU, 0x31U, 0xAFU, 0x6FU, 0xDFU, 0x00U,
+	0xBEU, 0xBCU, 0x9CU, 0x94U, 0x1FU, 0x5DU, 0x73U, 0x6DU, 0x5AU, 0x9BU,
+	0xB9U, 0x7CU, 0xDDU, 0x42U, 0x23U, 0x0CU, 0x7EU, 0x4AU, 0xC6U, 0x90U,
+	0x37U, 0xE5U, 0xE7U, 0x7EU, 0x34U, 0x5DU, 0x12U, 0x46U, 0x13U, 0x11U,
+	0x92U, 0x25U, 0x0BU, 0xD7U, 0x64U, 0x3EU, 0x14U, 0x28U, 0x07U, 0xC6U,
+	0x17U, 0x53U, 0xEDU, 0x21U, 0x2FU, 0x95U, 0x82U, 0x29U, 0x41U, 0xDEU,
+	0x91U, 0x28U, 0xF3U, 0xE8U, 0x7CU, 0x87U, 0x44U, 0x44U, 0x6EU, 0x9AU,
+	0xFDU, 0x06U, 0x05U, 0x84U, 0x68U, 0xF5U, 0x4EU, 0xE3U, 0x58U, 0x59U,
+	0xA8U, 0x71U, 0x40U, 0x1DU, 0x5EU, 0x70U, 0xD7U, 0xB5U, 0xC9U, 0x48U,
+	0x49U, 0x12U, 0x89U, 0x9DU, 0x77U, 0xC7U, 0x33U, 0x2EU, 0xA1U, 0x9DU,
+	0x94U, 0x11U, 0xE0U, 0xEBU, 0x59U, 0x76U, 0x92U, 0x08U, 0xE3U, 0xBEU,
+	0x01U, 0x6DU, 0xB0U, 0xFCU, 0x01U, 0x30U, 0x2DU, 0xCEU, 0xB1U, 0x4EU,
+	0xAFU, 0x41U, 0x7FU, 0x29U, 0x22U, 0x32U, 0x66U, 0xDAU, 0x93U, 0xD2U,
+	0x48U, 0x98U, 0xD6U, 0xD3U, 0x33U, 0x0AU, 0xAAU, 0x92U, 0x15U, 0x31U,
+	0x7EU, 0x99U, 0x9DU, 0xFAU, 0x21U, 0x1BU, 0x39U, 0x25U, 0x26U, 0x02U,
+	0x4FU, 0xDDU, 0xECU, 0x3BU, 0xFAU, 0xE9U, 0x06U, 0xD7U, 0xD2U, 0xA3U,
+	0xD7U, 0xAAU, 0xC4U, 0x47U, 0xB0U, 0xCCU, 0x55U, 0x16U, 0x39U, 0x7AU,
+	0x8EU, 0xDEU, 0xDDU, 0x2EU, 0x10U, 0x0FU, 0xD0U, 0x4DU, 0xCEU, 0xD7U,
+	0x1AU, 0x99U, 0xF2U, 0xDCU, 0xB6U, 0x10U, 0x2EU, 0x9FU, 0x62U, 0x5EU,
+	0x9FU, 0x34U, 0x5CU, 0x71U, 0x48U, 0x66U, 0xB4U, 0xEDU, 0xEBU, 0x50U,
+	0xA6U, 0x7CU, 0xFCU, 0xA8U, 0x29U, 0x0BU, 0x65U, 0xA9U, 0xEAU, 0x31U,
+	0x74U, 0xFCU, 0x58U, 0x19U, 0xC7U, 0xE1U, 0x27U, 0x5AU, 0x64U, 0x2AU,
+	0xBFU, 0x68U, 0x65U, 0xFFU, 0x65U, 0xD2U, 0x33U, 0x83U, 0xA1U, 0xDFU,
+	0xBEU, 0x88U, 0x39U, 0x59U, 0x9CU, 0x00U, 0x97U, 0x17U, 0xCFU, 0x50U,
+	0x36U, 0xA5U, 0x2BU, 0x6FU, 0x26U, 0x7BU, 0xE4U, 0xECU, 0x87U, 0xD1U,
+	0x82U, 0x9EU, 0x06U, 0x3EU, 0xFDU, 0x53U, 0x13U, 0x26U, 0x58U, 0x2DU,
+	0x32U, 0x3EU, 0x27U, 0x93U, 0x52U, 0x71U, 0xA9U, 0xF9U, 0x9EU, 0xDAU,
+	0xC2U, 0xDBU, 0xE8U, 0xB4U, 0x76U, 0x0AU, 0x81U, 0xE3U, 0x1BU, 0x0BU,
+	0x05U, 0xA9U, 0xCFU, 0x81U, 0xAFU, 0x67U, 0x8DU, 0xC3U, 0x3DU, 0x96U,
+	0x58U, 0x16U, 0x40U, 0x75U, 0xEEU, 0xA7U, 0xB0U, 0xC9U, 0x9FU, 0x37U,
+	0xFCU, 0xC2U, 0x3DU, 0x0FU, 0x77U, 0x39U, 0x14U, 0x7FU, 0x4BU, 0x1FU,
+	0x0CU, 0x52U, 0x91U, 0x6DU, 0x40U, 0xC8U, 0xC9U, 0x6EU, 0x19U, 0x9FU,
+	0x12U, 0x7FU, 0x92U, 0x87U, 0xABU, 0x59U, 0xA4U, 0xB6U, 0x6FU, 0x7DU,
+	0x84U, 0x8EU, 0x5DU, 0x48U, 0x62U, 0x3EU, 0x81U, 0x1FU, 0x0FU, 0xA1U,
+	0x19U, 0x0BU, 0xB9U, 0x3EU, 0x93U, 0xDBU, 0x98U, 0x70U, 0x6CU, 0x80U,
+	0xE8U, 0xA2U, 0xB4U, 0x87U, 0xC5U, 0x26U, 0xD4U, 0xEEU, 0x24U, 0x70U,
+	0xB4U, 0x5EU, 0x7AU, 0xEFU, 0x44U, 0xE0U, 0x9EU, 0x12U, 0xCBU, 0x0AU,
+	0x13U, 0x88U, 0x4BU, 0x7AU, 0xAAU, 0x23U, 0xDDU, 0x9BU, 0x36U, 0x54U,
+	0xB5U, 0xF3U, 0x95U, 0xE4U, 0x96U, 0x80U, 0xA3U, 0x6BU, 0x25U, 0x9FU,
+	0x40U, 0x02U, 0xEEU, 0x9EU, 0x20U, 0x3FU, 0xC0U, 0x5CU, 0x96U, 0x9BU,
+	0x97U, 0x62U, 0xD4U, 0xDEU, 0x93U, 0x26U, 0x0BU, 0x0CU, 0x39U, 0xD1U,
+	0x71U, 0x7EU, 0xE1U, 0xD3U, 0x92U, 0xD4U, 0x87U, 0x08U, 0x15U, 0x16U,
+	0x4BU, 0x52U, 0xB9U, 0x4EU, 0xE5U, 0x79U, 0xA2U, 0x87U, 0xBCU, 0x16U,
+	0xECU, 0xCEU, 0x24U, 0xC2U, 0xFAU, 0xF9U, 0x18U, 0xCBU, 0x26U, 0x7DU,
+	0xCEU, 0x04U, 0xD5U, 0x91U, 0xDDU, 0xFEU, 0x2BU, 0x81U, 0x85U, 0xF1U,
+	0xD3U, 0x1BU, 0x4CU, 0x46U, 0xBDU, 0x3FU, 0xA4U, 0xA8U, 0xFFU, 0xF9U,
+	0x38U, 0x70U, 0x68U, 0x89U, 0x65U, 0x4DU, 0x14U, 0x05U, 0x5AU, 0x74U,
+	0x6CU, 0xC6U, 0x81U, 0x50U, 0xFDU, 0xAAU, 0xA6U, 0x77U, 0x8EU, 0xB6U,
+	0xC3U, 0xF9U
+};
+
+/* PKCS #1 v1.5 DigestInfo of SHA3-384, silicon 2.0 and later */
+static const u8 TPadSha3[19] = {
+	0x30U, 0x41U, 0x30U, 0x0DU, 0x06U, 0x09U, 0x60U, 0x86U, 0x48U, 0x01U,
+	0x65U, 0x03U, 0x04U, 0x02U, 0x09U, 0x05U, 0x00U, 0x04U, 0x30U
+};
+
+static const u8 PublicExp[4] = { 0x00U, 0x01U, 0x00U, 0x01U };
+
+/* eFUSE PPK, loaded by the boot header authentication on the target */
+extern u8 EfusePpkKey[XFSBL_PPK_SIZE];
+
+static XCsuDma BenchDma;
+static XSecure_Sha3 BenchSha3;
+static XSecure_Aes BenchAes;
+static XFsblPs FsblInstance;
+
+static u8 *Flash;		/* Encrypted image read through DeviceCopy */
+static const u8 *PcapRef;	/* Expected PCAP data */
+static u32 PcapPos;
+static int PcapErr;
+
+void XFsbl_PrintArray(u32 DebugType, const u8 Buf[], u32 Len, const char *Str)
+{
+	(void)DebugType;
+	(void)Buf;
+	(void)Len;
+	(void)Str;
+}
+
+void *XFsbl_MemCpy(void *DestPtr, const void *SrcPtr, u32 Len)
+{
+	return memcpy(DestPtr, SrcPtr, Len);
+}
+
+static u64 Ticks(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+static void Hex(const char *Str, u8 *Out, int Len)
+{
+	int Idx;
+
+	for (Idx = 0; Idx < Len; Idx++) {
+		sscanf(&Str[2 * Idx], "%2hhx", &Out[Idx]);
+	}
+}
+
+static int Check(const char *Name, const u8 *Got, const char *Expected, int Len)
+{
+	u8 Exp[64];
+
+	Hex(Expected, Exp, Len);
+	if (memcmp(Got, Exp, Len) != 0) {
+		printf("FAIL %s\n", Name);
+		return 1;
+	}
+	return 0;
+}
+
+static void Fill(u8 *Buf, u32 Len)
+{
+	u32 Idx;
+
+	for (Idx = 0; Idx < Len; Idx++) {
+		Buf[Idx] = (u8)rand();
+	}
+}
+
+static void Sha3(const u8 *Data, u32 Len, XSecure_Sha3PadType Pad, u8 *Hash)
+{
+	XSecure_Sha3Initialize(&BenchSha3, &BenchDma);
+	XSecure_Sha3PadSelection(&BenchSha3, Pad);
+	XSecure_Sha3Digest(&BenchSha3, Data, Len, Hash);
+}
+
+static u32 DeviceCopy(u32 SrcAddress, UINTPTR DestAddress, u32 Length)
+{
+	memcpy((void *)DestAddress, Flash + (SrcAddress - BENCH_FLASH_BASE),
+	       Length);
+	return XST_SUCCESS;
+}
+
+static void PcapSink(const u8 *Data, u32 Size)
+{
+	if (PcapRef != NULL && memcmp(Data, PcapRef + PcapPos, Size) != 0) {
+		PcapErr = 1;
+	}
+	PcapPos += Size;
+}
+
+/* PKCS #1 v1.5 signature of a SHA3-384 hash with the private test key */
+static int Sign(const u8 *Hash, u8 *Sig)
+{
+	XSecure_Rsa Rsa;
+	u8 Block[BENCH_RSA_SIZE];
+	u32 Pad = BENCH_RSA_SIZE - 3U - sizeof(TPadSha3) - BENCH_HASH_LEN;
+
+	Block[0] = 0x00U;
+	Block[1] = 0x01U;
+	memset(&Block[2], 0xFF, Pad);
+	Block[2 + Pad] = 0x00U;
+	memcpy(&Block[3 + Pad], TPadSha3, sizeof(TPadSha3));
+	memcpy(&Block[3 + Pad + sizeof(TPadSha3)], Hash, BENCH_HASH_LEN);
+
+	XSecure_RsaInitialize(&Rsa, (u8 *)TestKeyMod, NULL, (u8 *)TestKeyPriv);
+	return XSecure_RsaPrivateDecrypt(&Rsa, Block, BENCH_RSA_SIZE, Sig);
+}
+
+/*
+ * Partition of Len bytes followed by its authentication certificate, the
+ * eFUSE PPK is loaded as the boot header authentication would.
+ */
+static int BuildPartition(u8 *Part, u32 Len)
+{
+	u8 *Ac = Part + Len;
+	u8 Hash[BENCH_HASH_LEN];
+	u32 Word;
+
+	memset(Ac, 0, BENCH_AC_SIZE);
+	Word = (u32)XFSBL_SPKID_EFUSE << XFSBL_AH_ATTR_SPK_ID_FUSE_SEL_SHIFT;
+	memcpy(Ac, &Word, sizeof(Word));
+	Word = BENCH_SPK_ID;
+	memcpy(Ac + XFSBL_SPKID_AC_ALIGN, &Word, sizeof(Word));
+
+	memcpy(Ac + XFSBL_AUTH_CERT_PPK_OFFSET, TestKeyMod, BENCH_RSA_SIZE);
+	memcpy(Ac + XFSBL_AUTH_CERT_PPK_OFFSET + XFSBL_PPK_MOD_SIZE +
+	       XFSBL_PPK_MOD_EXT_SIZE, PublicExp, sizeof(PublicExp));
+	memcpy(Ac + XFSBL_AUTH_CERT_SPK_OFFSET, TestKeyMod, BENCH_RSA_SIZE);
+	memcpy(Ac + XFSBL_AUTH_CERT_SPK_OFFSET + XFSBL_SPK_MOD_SIZE +
+	       XFSBL_SPK_MOD_EXT_SIZE, PublicExp, sizeof(PublicExp));
+	memcpy(EfusePpkKey, Ac + XFSBL_AUTH_CERT_PPK_OFFSET, XFSBL_PPK_SIZE);
+
+	/* SPK signature, Keccak padding for the SPK ID eFUSE */
+	XSecure_Sha3Initialize(&BenchSha3, &BenchDma);
+	XSecure_Sha3PadSelection(&BenchSha3, XSECURE_CSU_KECCAK_SHA3);
+	XSecure_Sha3Start(&BenchSha3);
+	XSecure_Sha3Update(&BenchSha3, Ac, XFSBL_AUTH_HEADER_SIZE);
+	XSecure_Sha3Update(&BenchSha3, Ac + XFSBL_AUTH_CERT_SPK_OFFSET,
+			   XFSBL_SPK_SIZE);
+	XSecure_Sha3Finish(&BenchSha3, Hash);
+	if (Sign(Hash, Ac + XFSBL_AUTH_CERT_SPK_SIG_OFFSET) != XST_SUCCESS) {
+		return 1;
+	}
+
+	/* Partition signature over the data and the AC without it */
+	XSecure_Sha3Initialize(&BenchSha3, &BenchDma);
+	XSecure_Sha3Start(&BenchSha3);
+	XSecure_Sha3Update(&BenchSha3, Part, Len);
+	XSecure_Sha3Update(&BenchSha3, Ac, BENCH_AC_SIZE - XFSBL_FSBL_SIG_SIZE);
+	XSecure_Sha3Finish(&BenchSha3, Hash);
+	return Sign(Hash, Ac + BENCH_AC_SIZE - XFSBL_FSBL_SIG_SIZE) != XST_SUCCESS;
+}
+
+static u32 Authenticate(u8 *Part, u32 Len)
+{
+	return XFsbl_Authentication(&FsblInstance, (u64)(UINTPTR)Part,
+				    Len + BENCH_AC_SIZE,
+				    (u64)(UINTPTR)(Part + Len), 0U);
+}
+
+/*
+ * Bootgen style encryption: a secure header under the device key followed
+ * by blocks of BENCH_KEY_BLOCK bytes, each one encrypted together with the
+ * key, IV and length of the next block under a fresh key.
+ */
+static u32 BuildEncrypted(u8 *Img, const u8 *Plain, u32 Len, u32 *DevIv)
+{
+	u32 Key[8], Iv[4], NextKey[8], NextIv[4];
+	u8 Hdr[XSECURE_SECURE_HDR_SIZE];
+	u32 Pos = 0U, Off, BlkLen, NextLen;
+
+	Fill((u8 *)NextKey, sizeof(NextKey));
+	Fill((u8 *)NextIv, sizeof(NextIv));
+	BlkLen = (Len < BENCH_KEY_BLOCK) ? Len : BENCH_KEY_BLOCK;
+	NextIv[3] = BlkLen / 4U;
+	memcpy(Hdr, NextKey, sizeof(NextKey));
+	memcpy(Hdr + sizeof(NextKey), NextIv, sizeof(NextIv));
+
+	XSecure_AesInitialize(&BenchAes, &BenchDma, XSECURE_CSU_AES_KEY_SRC_DEV,
+			      DevIv, NULL);
+	XSecure_AesEncryptData(&BenchAes, Img, Hdr, sizeof(Hdr));
+	Off = sizeof(Hdr) + XSECURE_SECURE_GCM_TAG_SIZE;
+
+	while (Pos < Len) {
+		memcpy(Key, NextKey, sizeof(Key));
+		memcpy(Iv, NextIv, sizeof(Iv));
+		BlkLen = Iv[3] * 4U;
+		NextLen = Len - Pos - BlkLen;
+		if (NextLen > BENCH_KEY_BLOCK) {
+			NextLen = BENCH_KEY_BLOCK;
+		}
+
+		/* The header of the last block has a zero length */
+		memset(NextKey, 0, sizeof(NextKey));
+		memset(NextIv, 0, sizeof(NextIv));
+		if (NextLen != 0U) {
+			Fill((u8 *)NextKey, sizeof(NextKey));
+			Fill((u8 *)NextIv, sizeof(NextIv));
+			NextIv[3] = NextLen / 4U;
+		}
+		memcpy(Hdr, NextKey, sizeof(NextKey));
+		memcpy(Hdr + sizeof(NextKey), NextIv, sizeof(NextIv));
+
+		XSecure_AesInitialize(&BenchAes, &BenchDma,
+				      XSECURE_CSU_AES_KEY_SRC_KUP, Iv, Key);
+		XSecure_AesEncryptInit(&BenchAes, Img + Off, BlkLen + sizeof(Hdr));
+		XSecure_AesEncryptUpdate(&BenchAes, Plain + Pos, BlkLen);
+		XSecure_AesEncryptUpdate(&BenchAes, Hdr, sizeof(Hdr));
+
+		Pos += BlkLen;
+		Off += BlkLen + sizeof(Hdr) + XSECURE_SECURE_GCM_TAG_SIZE;
+	}
+
+	return Off;
+}
+
+static s32 Decrypt(u8 *Dst, const u8 *Src, u32 Len, u32 *DevIv, int Chunked)
+{
+	static u8 Ping[BENCH_CHUNK], Pong[BENCH_CHUNK];
+
+	XSecure_AesInitialize(&BenchAes, &BenchDma, XSECURE_CSU_AES_KEY_SRC_DEV,
+			      DevIv, NULL);
+	if (Chunked) {
+		XSecure_AesSetChunking(&BenchAes, XSECURE_CSU_AES_CHUNKING_ENABLED);
+		XSecure_AesSetChunkConfig(&BenchAes, Ping, BENCH_CHUNK, DeviceCopy);
+		XSecure_AesSetChunkPingPong(&BenchAes, Pong);
+		XSecure_AesSetChunkTimer(&BenchAes, Ticks);
+		Src = (const u8 *)(UINTPTR)BENCH_FLASH_BASE;
+		Dst = (u8 *)(UINTPTR)XSECURE_DESTINATION_PCAP_ADDR;
+		PcapPos = 0U;
+	}
+	return XSecure_AesDecrypt(&BenchAes, Dst, Src, Len);
+}
+
+static int SelfTest(u8 *Buf, u8 *Out)
+{
+	u8 Hash[48], Ref[48], Tag[16];
+	u32 Key[8], Iv[4];
+	u32 Idx, Len;
+	int Err = 0;
+
+	/* FIPS 202 and Keccak team test vectors */
+	Sha3((const u8 *)"abc", 3U, XSECURE_CSU_NIST_SHA3, Hash);
+	Err |= Check("SHA3-384", Hash,
+	    "ec01498288516fc926459f58e2c6ad8df9b473cb0fc08c25"
+	    "96da7cf0e49be4b298d88cea927ac7f539f1edf228376d25", 48);
+	Sha3((const u8 *)"abc", 3U, XSECURE_CSU_KECCAK_SHA3, Hash);
+	Err |= Check("Keccak-384", Hash,
+	    "f7df1165f033337be098e7d288ad6a2f74409d7a60b49c36"
+	    "642218de161b1f99f8c681e4afaf31a34db29fb763e3c28e", 48);
+
+	/* Updates at random lengths against a single update */
+	srand(1);
+	Fill(Buf, 4096U);
+	Sha3(Buf, 4096U, XSECURE_CSU_NIST_SHA3, Ref);
+	XSecure_Sha3Initialize(&BenchSha3, &BenchDma);
+	XSecure_Sha3Start(&BenchSha3);
+	for (Idx = 0U; Idx < 4096U; Idx += Len) {
+		Len = 1U + (u32)rand() % 300U;
+		if (Len > 4096U - Idx) {
+			Len = 4096U - Idx;
+		}
+		XSecure_Sha3Update(&BenchSha3, Buf + Idx, Len);
+	}
+	XSecure_Sha3Finish(&BenchSha3, Hash);
+	if (memcmp(Hash, Ref, sizeof(Hash)) != 0) {
+		printf("FAIL SHA3 update\n");
+		Err = 1;
+	}
+
+	/* GCM specification test case 15 */
+	Hex("feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308",
+	    (u8 *)Key, 32);
+	Hex("cafebabefacedbaddecaf88800000000", (u8 *)Iv, 16);
+	Hex("d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+	    "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255",
+	    Buf, 64);
+	XSecure_AesInitialize(&BenchAes, &BenchDma, XSECURE_CSU_AES_KEY_SRC_KUP,
+			      Iv, Key);
+	XSecure_AesEncryptData(&BenchAes, Out, Buf, 64U);
+	Err |= Check("GCM test case 15", Out,
+	    "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+	    "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662898015ad"
+	    "b094dac5d93471bdec1a502270e3cc6c", 80);
+
+	/* Split updates, decryption and a modified tag */
+	XSecure_AesEncryptInit(&BenchAes, Out + 100, 64U);
+	XSecure_AesEncryptUpdate(&BenchAes, Buf, 20U);
+	XSecure_AesEncryptUpdate(&BenchAes, Buf + 20, 44U);
+	if (memcmp(Out, Out + 100, 80U) != 0) {
+		printf("FAIL GCM update\n");
+		Err = 1;
+	}
+	if (XSecure_AesDecryptData(&BenchAes, Out + 200, Out, 64U, Out + 64) !=
+	    XST_SUCCESS || memcmp(Out + 200, Buf, 64U) != 0) {
+		printf("FAIL GCM decrypt\n");
+		Err = 1;
+	}
+	memcpy(Tag, Out + 64, sizeof(Tag));
+	Tag[15] ^= 1U;
+	if (XSecure_AesDecryptData(&BenchAes, Out + 200, Out, 64U, Tag) !=
+	    XSECURE_CSU_AES_GCM_TAG_MISMATCH || Out[200] != 0U) {
+		printf("FAIL GCM tag mismatch\n");
+		Err = 1;
+	}
+
+	/* RSA sign and verify */
+	Fill(Hash, sizeof(Hash));
+	if (Sign(Hash, Buf) != XST_SUCCESS) {
+		printf("FAIL RSA sign\n");
+		Err = 1;
+	}
+	else {
+		XSecure_Rsa Rsa;
+
+		XSecure_RsaInitialize(&Rsa, (u8 *)TestKeyMod, NULL,
+				      (u8 *)PublicExp);
+		if (XSecure_RsaPublicEncrypt(&Rsa, Buf, BENCH_RSA_SIZE, Out) !=
+		    XST_SUCCESS ||
+		    XSecure_RsaSignVerification(Out, Hash, BENCH_HASH_LEN) !=
+		    XST_SUCCESS) {
+			printf("FAIL RSA verify\n");
+			Err = 1;
+		}
+
+		if (XSecure_RsaVerify(&Rsa, Buf, Hash, BENCH_HASH_LEN, Out) !=
+		    XST_SUCCESS) {
+			printf("FAIL RSA verify signature\n");
+			Err = 1;
+		}
+		Hash[0] ^= 1U;
+		if (XSecure_RsaVerify(&Rsa, Buf, Hash, BENCH_HASH_LEN, Out) !=
+		    XSECURE_RSA_SIGN_VERIFY_ERROR) {
+			printf("FAIL RSA verify signature mismatch\n");
+			Err = 1;
+		}
+		Hash[0] ^= 1U;
+	}
+
+	return Err;
+}
+
+int main(int argc, char *argv[])
+{
+	u8 *Part, *Enc, *Out;
+	u32 DevIv[4];
+	u32 Size, EncLen, Status;
+	u64 Start, Best[4];
+	int Runs = BENCH_RUNS, Run, Idx;
+
+	if (argc == 3 && strcmp(argv[1], "-n") == 0) {
+		Runs = atoi(argv[2]);
+	}
+	if (Runs < 1 || argc == 2 || argc > 3) {
+		printf("usage: authbench [-n <runs>]\n");
+		return 2;
+	}
+
+	Part = malloc(BENCH_MAX_SIZE + BENCH_AC_SIZE);
+	Enc = malloc(BENCH_ENC_SIZE(BENCH_MAX_SIZE));
+	Out = malloc(BENCH_MAX_SIZE);
+	if (Part == NULL || Enc == NULL || Out == NULL) {
+		printf("out of memory\n");
+		return 1;
+	}
+
+	/* Silicon 2.0, RSA authentication and SPK revocation by SPK ID */
+	Xil_Out32(XPLAT_PS_VERSION_ADDRESS, XPS_VERSION_2);
+	Xil_Out32(EFUSE_SEC_CTRL, EFUSE_SEC_CTRL_RSA_EN_MASK);
+	Xil_Out32(EFUSE_SPKID, BENCH_SPK_ID);
+	Fill((u8 *)DevIv, sizeof(DevIv));
+	Fill(Out, 32U);
+	XSecure_SwSetDeviceKey(Out);
+	XSecure_SwSetPcapSink(PcapSink);
+
+	if (SelfTest(Part, Out) != 0) {
+		return 1;
+	}
+
+	/* RSA-4096 verification */
+	Fill(Out, BENCH_HASH_LEN);
+	Sign(Out, Part);
+	Best[0] = ~0ULL;
+	for (Run = 0; Run < Runs; Run++) {
+		XSecure_Rsa Rsa;
+
+		Start = Ticks();
+		XSecure_RsaInitialize(&Rsa, (u8 *)TestKeyMod, NULL,
+				      (u8 *)PublicExp);
+		for (Idx = 0; Idx < BENCH_SIGS; Idx++) {
+			XSecure_RsaVerify(&Rsa, Part, Out, BENCH_HASH_LEN,
+					  Part + BENCH_RSA_SIZE);
+		}
+		Start = Ticks() - Start;
+		if (Start < Best[0]) Best[0] = Start;
+	}
+	printf("rsa verify %.1f us per signature\n",
+	       (double)Best[0] / BENCH_SIGS / 1e3);
+
+	printf("aes %s\n", XSecure_SwAesImpl());
+	printf("%10s %10s %10s %10s %10s %10s\n", "size", "auth ms", "auth MB/s",
+	       "sha3 MB/s", "aes MB/s", "pcap MB/s");
+
+	for (Size = BENCH_MIN_SIZE; Size <= BENCH_MAX_SIZE; Size *= 4U) {
+		Fill(Part, Size);
+		if (BuildPartition(Part, Size) != 0) {
+			printf("FAIL signing, %u bytes\n", Size);
+			return 1;
+		}
+		EncLen = BuildEncrypted(Enc, Part, Size, DevIv);
+		Flash = Enc;
+
+		/* Accepted as built, rejected when modified or revoked */
+		Status = Authenticate(Part, Size);
+		Part[Size / 2U] ^= 1U;
+		if (Status != XFSBL_SUCCESS ||
+		    Authenticate(Part, Size) != XFSBL_ERROR_PART_SIGNATURE) {
+			printf("FAIL authentication, %u bytes\n", Size);
+			return 1;
+		}
+		Part[Size / 2U] ^= 1U;
+		Xil_Out32(EFUSE_SPKID, BENCH_SPK_ID + 1U);
+		Status = Authenticate(Part, Size);
+		Xil_Out32(EFUSE_SPKID, BENCH_SPK_ID);
+		if (Status != XFSBL_ERROR_SPKID_VERIFICATION) {
+			printf("FAIL SPK revocation, %u bytes\n", Size);
+			return 1;
+		}
+
+		/* Decryption to memory and to the PCAP */
+		PcapRef = Part;
+		PcapErr = 0;
+		if (Decrypt(Out, Enc, Size, DevIv, 0) != XST_SUCCESS ||
+		    memcmp(Out, Part, Size) != 0 ||
+		    Decrypt(Out, Enc, Size, DevIv, 1) != XST_SUCCESS ||
+		    PcapErr != 0 || PcapPos != Size) {
+			printf("FAIL decryption, %u bytes\n", Size);
+			return 1;
+		}
+		Enc[EncLen / 2U] ^= 1U;
+		if (Decrypt(Out, Enc, Size, DevIv, 0) !=
+		    XSECURE_CSU_AES_GCM_TAG_MISMATCH || Out[0] != 0U) {
+			printf("FAIL decryption of a modified image, %u bytes\n",
+			       Size);
+			return 1;
+		}
+		Enc[EncLen / 2U] ^= 1U;
+		PcapRef = NULL;
+
+		for (Idx = 0; Idx < 4; Idx++) {
+			Best[Idx] = ~0ULL;
+		}
+		for (Run = 0; Run < Runs; Run++) {
+			Start = Ticks();
+			Authenticate(Part, Size);
+			Start = Ticks() - Start;
+			if (Start < Best[0]) Best[0] = Start;
+
+			Start = Ticks();
+			Sha3(Part, Size, XSECURE_CSU_NIST_SHA3, Out);
+			Start = Ticks() - Start;
+			if (Start < Best[1]) Best[1] = Start;
+
+			Start = Ticks();
+			Decrypt(Out, Enc, Size, DevIv, 0);
+			Start = Ticks() - Start;
+			if (Start < Best[2]) Best[2] = Start;
+
+			Start = Ticks();
+			Decrypt(Out, Enc, Size, DevIv, 1);
+			Start = Ticks() - Start;
+			if (Start < Best[3]) Best[3] = Start;
+		}
+
+		printf("%7u KB %10.2f %10.1f %10.1f %10.1f %10.1f\n",
+		       Size / 1024U, (double)Best[0] / 1e6,
+		       (double)Size * 1e3 / Best[0],
+		       (double)Size * 1e3 / Best[1],
+		       (double)Size * 1e3 / Best[2],
+		       (double)Size * 1e3 / Best[3]);
+	}
+
+	return 0;
+}
@@ -0,0 +1,311 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file chunktest.c
+*		Test of the chunk copy and decryption order of
+*		XSecure_AesChunkDecrypt() in the ZynqMP xsecure_aes.c, the
+*		driver source and not the software backend of authbench.
+*
+*		The CSU DMA is mocked: XCsuDma_Transfer() starts a transfer
+*		from a read buffer and XCsuDma_WaitForDoneTimeout() completes
+*		it, appending the buffer to the data seen by the AES engine.
+*		DeviceCopy copies from a random device image. For random
+*		lengths and chunk sizes, with one read buffer and with
+*		ping-pong buffers, the test checks that
+*		- the AES engine sees the device image in order
+*		- no copy writes the buffer of a transfer in flight and no
+*		  transfer is started while another one is in flight
+*		- a failing copy returns XSECURE_CSU_AES_DEVICE_COPY_ERROR
+*		  without leaving a transfer in flight, after passing on
+*		  only the chunks copied before it
+*		- a length of 0 returns XST_FAILURE
+*
+*		Build with NDEBUG, as the length check is an assert
+*		otherwise.
+*
+* <pre>
+* usage: chunktest [-n <cases>] [-s <seed>]
+* </pre>
+*
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The static chunk functions are tested, so the driver source is included */
+#include "xsecure_aes.c"
+
+#define TEST_CASES		2000U
+#define TEST_MAX_LEN	(256U * 1024U)
+#define TEST_MAX_CHUNK	(16U * 1024U)
+#define TEST_DEV_BASE	0x10000U	/* Device address of the image */
+
+static u8 Image[TEST_MAX_LEN];
+static u8 Seen[TEST_MAX_LEN];	/* Data passed to the AES engine */
+static u32 SeenLen;
+static u8 Ping[TEST_MAX_CHUNK];
+static u8 Pong[TEST_MAX_CHUNK];
+static u8 Snapshot[TEST_MAX_CHUNK];	/* Read buffer at transfer start */
+
+static UINTPTR DmaAddr;
+static u32 DmaLen;
+static u32 DmaBusy;
+static u32 ChunkSize;
+static u32 CopyCount;
+static u32 FailAt;	/* Copy that fails, 0 for none */
+static u32 Errors;
+
+#define TEST_ERROR(...)	do { fprintf(stderr, __VA_ARGS__); Errors++; } while (0)
+
+/* Register access: only the PCAP status is read, and it is always idle */
+u32 Xil_In32(UINTPTR Addr)
+{
+	(void)Addr;
+	return 0xFFFFFFFFU;
+}
+
+void Xil_Out32(UINTPTR Addr, u32 Value)
+{
+	(void)Addr;
+	(void)Value;
+}
+
+void XSecure_ReleaseReset(u32 BaseAddress, u32 Offset)
+{
+	(void)BaseAddress;
+	(void)Offset;
+}
+
+void XSecure_SssInitialize(XSecure_Sss *InstancePtr)
+{
+	(void)InstancePtr;
+}
+
+u32 XSecure_SssAes(XSecure_Sss *InstancePtr, XSecure_SssSrc InputSrc,
+		XSecure_SssSrc OutputSrc)
+{
+	(void)InstancePtr;
+	(void)InputSrc;
+	(void)OutputSrc;
+	return XST_SUCCESS;
+}
+
+void XCsuDma_GetConfig(XCsuDma *InstancePtr, XCsuDma_Channel Channel,
+		XCsuDma_Configure *ConfigurValues)
+{
+	(void)InstancePtr;
+	(void)Channel;
+	(void)memset(ConfigurValues, 0, sizeof(*ConfigurValues));
+}
+
+void XCsuDma_SetConfig(XCsuDma *InstancePtr, XCsuDma_Channel Channel,
+		XCsuDma_Configure *ConfigurValues)
+{
+	(void)InstancePtr;
+	(void)Channel;
+	(void)ConfigurValues;
+}
+
+void XCsuDma_IntrClear(XCsuDma *InstancePtr, XCsuDma_Channel Channel, u32 Mask)
+{
+	(void)InstancePtr;
+	(void)Channel;
+	(void)Mask;
+}
+
+void XCsuDma_Transfer(XCsuDma *InstancePtr, XCsuDma_Channel Channel,
+		UINTPTR Addr, u32 Size, u8 EnDataLast)
+{
+	(void)InstancePtr;
+	(void)EnDataLast;
+
+	if (Channel != XCSUDMA_SRC_CHANNEL) {
+		TEST_ERROR("transfer on channel %d\n", (int)Channel);
+	}
+	if (DmaBusy != 0U) {
+		TEST_ERROR("transfer started while another one is in flight\n");
+	}
+	if ((Size * 4U > ChunkSize) ||
+	    ((Addr != (UINTPTR)Ping) && (Addr != (UINTPTR)Pong))) {
+		TEST_ERROR("transfer of %u words outside the read buffers\n", Size);
+		return;
+	}
+	DmaAddr = Addr;
+	DmaLen = Size * 4U;
+	DmaBusy = 1U;
+	(void)memcpy(Snapshot, (const void *)Addr, DmaLen);
+}
+
+u32 XCsuDma_WaitForDoneTimeout(XCsuDma *InstancePtr, XCsuDma_Channel Channel)
+{
+	(void)InstancePtr;
+	(void)Channel;
+
+	if (DmaBusy == 0U) {
+		TEST_ERROR("wait without a transfer in flight\n");
+		return XST_SUCCESS;
+	}
+	if (memcmp(Snapshot, (const void *)DmaAddr, DmaLen) != 0) {
+		TEST_ERROR("read buffer changed during the transfer\n");
+	}
+	if (SeenLen + DmaLen <= TEST_MAX_LEN) {
+		(void)memcpy(Seen + SeenLen, Snapshot, DmaLen);
+	}
+	SeenLen += DmaLen;
+	DmaBusy = 0U;
+
+	return XST_SUCCESS;
+}
+
+static u32 TestDeviceCopy(u32 SrcAddress, UINTPTR DestAddress, u32 Length)
+{
+	u32 Offset = SrcAddress - TEST_DEV_BASE;
+
+	CopyCount++;
+	if (CopyCount == FailAt) {
+		return XST_FAILURE;
+	}
+	if ((Length > ChunkSize) ||
+	    (((DestAddress != (UINTPTR)Ping) && (DestAddress != (UINTPTR)Pong)))) {
+		TEST_ERROR("copy of %u bytes outside the read buffers\n", Length);
+		return XST_FAILURE;
+	}
+	if ((DmaBusy != 0U) && (DestAddress < DmaAddr + DmaLen) &&
+	    (DmaAddr < DestAddress + Length)) {
+		TEST_ERROR("copy to the buffer of the transfer in flight\n");
+	}
+	if ((Offset > TEST_MAX_LEN) || (Length > TEST_MAX_LEN - Offset)) {
+		TEST_ERROR("copy from 0x%x outside the image\n", SrcAddress);
+		return XST_FAILURE;
+	}
+	(void)memcpy((void *)DestAddress, Image + Offset, Length);
+
+	return XST_SUCCESS;
+}
+
+static s32 TestRun(XSecure_Aes *Aes, u32 Len, u32 Chunk, u32 PingPong,
+		u32 Fail)
+{
+	ChunkSize = Chunk;
+	CopyCount = 0U;
+	FailAt = Fail;
+	SeenLen = 0U;
+	DmaBusy = 0U;
+	XSecure_AesSetChunkConfig(Aes, Ping, Chunk, TestDeviceCopy);
+	XSecure_AesSetChunkPingPong(Aes, (PingPong != 0U) ? Pong : NULL);
+	(void)memset(&Aes->ChunkStats, 0, sizeof(Aes->ChunkStats));
+
+	return XSecure_AesChunkDecrypt(Aes, (const u8 *)(UINTPTR)TEST_DEV_BASE,
+					Len);
+}
+
+int main(int argc, char **argv)
+{
+	XSecure_Aes Aes;
+	XCsuDma CsuDma;
+	u32 Cases = TEST_CASES;
+	u32 Seed = 1U;
+	u32 Case, Len, Chunk, Chunks, PingPong, Fail;
+	s32 Status;
+	int Opt;
+
+	for (Opt = 1; Opt + 1 < argc; Opt += 2) {
+		if (strcmp(argv[Opt], "-n") == 0) {
+			Cases = (u32)strtoul(argv[Opt + 1], NULL, 0);
+		} else if (strcmp(argv[Opt], "-s") == 0) {
+			Seed = (u32)strtoul(argv[Opt + 1], NULL, 0);
+		} else {
+			break;
+		}
+	}
+	if (Opt != argc) {
+		fprintf(stderr, "usage: chunktest [-n <cases>] [-s <seed>]\n");
+		return 2;
+	}
+
+	srand(Seed);
+	for (Len = 0U; Len < TEST_MAX_LEN; Len++) {
+		Image[Len] = (u8)rand();
+	}
+	(void)memset(&Aes, 0, sizeof(Aes));
+	(void)memset(&CsuDma, 0, sizeof(CsuDma));
+	Aes.CsuDmaPtr = &CsuDma;
+
+	for (Case = 0U; Case < Cases; Case++) {
+		Len = 4U * (1U + ((u32)rand() % (TEST_MAX_LEN / 4U)));
+		if ((Case & 3U) == 0U) {
+			Len = 4U * (1U + ((u32)rand() % 64U));
+		}
+		Chunk = 4U * (1U + ((u32)rand() % (TEST_MAX_CHUNK / 4U)));
+		if ((Case & 7U) == 1U) {
+			Chunk = Len;	/* One chunk */
+		}
+		if (Chunk > TEST_MAX_CHUNK) {
+			Chunk = TEST_MAX_CHUNK;
+		}
+		Chunks = (Len + Chunk - 1U) / Chunk;
+		PingPong = Case & 1U;
+
+		Status = TestRun(&Aes, Len, Chunk, PingPong, 0U);
+		if ((Status != XST_SUCCESS) || (SeenLen != Len) ||
+		    (memcmp(Seen, Image, Len) != 0) ||
+		    (Aes.ChunkStats.ChunkCount != Chunks) ||
+		    (CopyCount != Chunks) || (DmaBusy != 0U)) {
+			TEST_ERROR("len %u chunk %u ping-pong %u: status %d, "
+				"%u of %u bytes, %u chunks, %u copies\n",
+				Len, Chunk, PingPong, (int)Status, SeenLen, Len,
+				Aes.ChunkStats.ChunkCount, CopyCount);
+		}
+
+		Fail = 1U + ((u32)rand() % Chunks);
+		Status = TestRun(&Aes, Len, Chunk, PingPong, Fail);
+		if ((Status != XSECURE_CSU_AES_DEVICE_COPY_ERROR) ||
+		    (SeenLen != (Fail - 1U) * Chunk) ||
+		    (memcmp(Seen, Image, SeenLen) != 0) || (DmaBusy != 0U)) {
+			TEST_ERROR("len %u chunk %u ping-pong %u copy %u fails: "
+				"status %d, %u bytes passed on\n", Len, Chunk,
+				PingPong, Fail, (int)Status, SeenLen);
+		}
+
+		if (Errors > 10U) {
+			break;
+		}
+	}
+
+	Status = TestRun(&Aes, 0U, 64U, 1U, 0U);
+	if ((Status != XST_FAILURE) || (SeenLen != 0U) || (CopyCount != 0U)) {
+		TEST_ERROR("length 0: status %d, %u copies\n", (int)Status,
+			CopyCount);
+	}
+
+	printf("chunktest: %u cases, %u errors\n", Case, Errors);
+
+	return (Errors == 0U) ? 0 : 1;
+}
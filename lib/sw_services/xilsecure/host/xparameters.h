@@ -0,0 +1,49 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xparameters.h
+*		Hardware parameters of the Linux host build: a ZynqMP with PS
+*		DDR and the CSU DMA, as needed by xilsecure and the FSBL
+*		authentication code.
+*
+******************************************************************************/
+#ifndef XPARAMETERS_H
+#define XPARAMETERS_H
+
+#define XPAR_XCSUDMA_NUM_INSTANCES		1U
+#define XPAR_PSU_CSUDMA_DEVICE_ID		0U
+#define XPAR_PSU_CSUDMA_BASEADDR		0xFFC80000U
+#define XPAR_PSU_CSUDMA_DMATYPE		0U
+#define XPAR_XCSUDMA_0_DEVICE_ID		XPAR_PSU_CSUDMA_DEVICE_ID
+
+#define XPAR_PSU_DDR_0_S_AXI_BASEADDR		0x00000000U
+#define XPAR_PSU_DDR_0_S_AXI_HIGHADDR		0x7FFFFFFFU
+
+#endif
@@ -0,0 +1,57 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xplatform_info.h
+*		Platform information of the Linux host build. The PS version
+*		is read from the emulated CSU_VERSION register, see
+*		xsecure_sw_io.c.
+*
+******************************************************************************/
+#ifndef XPLATFORM_INFO_H
+#define XPLATFORM_INFO_H
+
+#include "xil_types.h"
+
+#define XPAR_CSU_BASEADDR		0xFFCA0000U
+#define XPAR_CSU_VER_OFFSET		0x00000044U
+#define XPLAT_PS_VERSION_ADDRESS	(XPAR_CSU_BASEADDR + \
+						XPAR_CSU_VER_OFFSET)
+
+#define XPLAT_ZYNQ_ULTRA_MP		0x1
+
+#define XPS_VERSION_1			0x0
+#define XPS_VERSION_2			0x1
+#define XPS_VERSION_INFO_MASK		(0xF)
+#define XPS_VERSION_INFO_SHIFT		0x0U
+
+u32 XGetPlatform_Info(void);
+u32 XGetPSVersion_Info(void);
+
+#endif
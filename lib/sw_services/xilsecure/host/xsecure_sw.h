@@ -0,0 +1,89 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsecure_sw.h
+*
+* Software emulation backend of the ZynqMP xilsecure library for a Linux
+* host build.
+*
+* The backend implements the APIs of xsecure_sha.h, xsecure_aes.h and
+* xsecure_rsa_core.h in portable C, in place of xsecure_sha.c, xsecure_aes.c
+* and xsecure_rsa_core.c. The instance structures and the headers are the
+* ones of the BSP, so code written against xilsecure (xsecure_rsa.c,
+* xsecure_utils.c, the FSBL authentication and decryption code) builds on
+* the host unchanged. Like the CSU, each engine exists once, a second
+* instance of a driver reuses the same engine state.
+*
+* - SHA3: Keccak-f[1600] with the 104 byte block of SHA3-384. The driver
+*   padding (NIST or Keccak) is applied in software as on the target.
+* - AES: AES-256-GCM with a 96-bit IV. XSecure_AesDecrypt() follows the
+*   key rolling format of bootgen, including chunking through DeviceCopy
+*   and the chunk statistics. Data written to XSECURE_DESTINATION_PCAP_ADDR
+*   is passed to the PCAP sink, see XSecure_SwSetPcapSink(). When the host
+*   compiler targets AES-NI and PCLMULQDQ (-maes -mpclmul), the block
+*   cipher and GHASH use them.
+* - RSA: Montgomery exponentiation for every key size of the RSA core.
+*   ModExt (R^2 mod N) is accepted and not needed.
+*
+* Registers (eFUSE, CSU) are emulated by Xil_In32()/Xil_Out32() of the host
+* xil_io.h for 32-bit addresses from XSECURE_SW_REG_BASE, a register that
+* was not written reads as zero. Other addresses are host memory.
+*
+******************************************************************************/
+#ifndef XSECURE_SW_H
+#define XSECURE_SW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+/** Lowest address handled by the register emulation */
+#define XSECURE_SW_REG_BASE		(0xF0000000U)
+
+/***************** Macros (Inline Functions) Definitions *********************/
+/** Addresses of the emulated registers, anything else is host memory */
+#define XSECURE_SW_IS_REG(Addr)	(((Addr) >= XSECURE_SW_REG_BASE) && \
+					((u64)(Addr) <= 0xFFFFFFFFU))
+
+/************************** Function Prototypes ******************************/
+void XSecure_SwSetDeviceKey(const u8 *Key);
+void XSecure_SwSetPcapSink(void (*Sink)(const u8 *Data, u32 Size));
+const char *XSecure_SwAesImpl(void);
+void XSecure_SwRegReset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XSECURE_SW_H */
@@ -0,0 +1,1740 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsecure_sw_aes.c
+*
+* Software emulation of the CSU AES-GCM engine, implementing the API of
+* xsecure_aes.h for the Linux host build, see xsecure_sw.h.
+*
+* The engine state (loaded key, counter, GHASH accumulator) is kept here and
+* the KUP and IV registers are the emulated registers, so the key rolling of
+* XSecure_AesDecrypt() passes the key and IV of the next block through them
+* as on the target. Chunked decryption copies and decrypts the chunks one
+* after the other, the time spent decrypting a chunk is accounted as
+* WaitTime in the chunk statistics.
+*
+* The block cipher uses AES-NI and GHASH uses PCLMULQDQ when the compiler
+* targets them (-maes -mpclmul -mssse3), otherwise a table based AES and a
+* 4-bit table GHASH are used.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xsecure_aes.h"
+#include "xsecure_sw.h"
+
+#if defined (__AES__) && defined (__PCLMUL__) && defined (__SSSE3__)
+#define XSECURE_SW_AESNI
+#include <immintrin.h>
+#endif
+
+/************************** Constant Definitions *****************************/
+#define XSECURE_SW_AES_ROUNDS		(14U)	/**< AES-256 */
+#define XSECURE_SW_AES_BLOCK_LEN	(16U)
+#define XSECURE_SW_AES_KEY_WORDS	(8U)
+#define XSECURE_SW_AES_IV_LEN		(12U)
+#define XSECURE_SW_AES_PARALLEL		(4U)	/**< Blocks per CTR step */
+#define XSECURE_SW_PCAP_STAGE_LEN	(4096U)
+
+#define XSECURE_SW_AES_DECRYPT		(0U)
+#define XSECURE_SW_AES_ENCRYPT		(1U)
+
+/**************************** Type Definitions *******************************/
+/** State of the emulated AES-GCM engine */
+typedef struct {
+	u32 RoundKey[4U * (XSECURE_SW_AES_ROUNDS + 1U)]; /**< Key schedule */
+#ifdef XSECURE_SW_AESNI
+	__m128i RoundKeyNi[XSECURE_SW_AES_ROUNDS + 1U]; /**< Key schedule */
+	__m128i HashKeyRev; /**< H, byte reversed */
+#endif
+	u64 HashTblLo[16]; /**< 4-bit GHASH table of H, low halves */
+	u64 HashTblHi[16]; /**< 4-bit GHASH table of H, high halves */
+	u8 Ctr[XSECURE_SW_AES_BLOCK_LEN]; /**< Next counter block */
+	u8 EncJ0[XSECURE_SW_AES_BLOCK_LEN]; /**< Encrypted J0 for the tag */
+	u8 Hash[XSECURE_SW_AES_BLOCK_LEN]; /**< GHASH accumulator */
+	u8 KeyStream[XSECURE_SW_AES_BLOCK_LEN]; /**< Of the partial block */
+	u8 Block[XSECURE_SW_AES_BLOCK_LEN]; /**< Ciphertext partial block */
+	u32 PartialLen; /**< Bytes in Block */
+	u64 TextLen; /**< Bytes processed since the IV was loaded */
+	u8 *Out; /**< Output of the DMA destination channel */
+} XSecure_SwAesEngine;
+
+/************************** Function Prototypes ******************************/
+static void XSecure_SwAesTables(void);
+static void XSecure_SwAesExpandKey(const u8 *Key);
+static void XSecure_SwAesEncryptBlock(const u8 *In, u8 *Out);
+static void XSecure_SwAesCtr(u8 *KeyStream, u32 Blocks);
+static void XSecure_SwGhashKey(const u8 *HashKey);
+static void XSecure_SwGhash(const u8 *Block);
+static void XSecure_SwAesStart(const u32 *Iv);
+static void XSecure_SwAesGcm(const u8 *In, u8 *Out, u32 Len, u32 Encrypt);
+static void XSecure_SwAesRun(const u8 *In, u8 *Out, u32 Len, u32 Encrypt);
+static void XSecure_SwAesTag(u8 *Tag);
+static u32 XSecure_SwAesTagCheck(const u8 *Tag);
+static void XSecure_SwGetWords(UINTPTR Addr, u8 *Dst, u32 Words);
+static void XSecure_SwPutWords(UINTPTR Addr, const u8 *Src, u32 Words);
+static u32 XSecure_Zeroize(u8 *DataPtr, u32 Length);
+static s32 XSecure_AesChunkCopy(XSecure_Aes *InstancePtr, u32 SrcAddress,
+		u8 *Buffer, u32 Length);
+static s32 XSecure_AesChunkWait(XSecure_Aes *InstancePtr, const u8 *Buffer,
+		u32 Length);
+
+/************************** Variable Definitions *****************************/
+static u8 XSecure_SwSbox[256];
+static u32 XSecure_SwTe[256];
+
+#ifndef XSECURE_SW_AESNI
+/* Reduction of the 4 bits shifted out of GHASH, see XSecure_SwGhash() */
+static const u64 XSecure_SwGhashRem[16] = {
+	0x0000U, 0x1C20U, 0x3840U, 0x2460U, 0x7080U, 0x6CA0U, 0x48C0U, 0x54E0U,
+	0xE100U, 0xFD20U, 0xD940U, 0xC560U, 0x9180U, 0x8DA0U, 0xA9C0U, 0xB5E0U
+};
+#endif
+
+static XSecure_SwAesEngine AesEngine;
+static u8 DeviceKey[XSECURE_SW_AES_KEY_WORDS * 4U];
+static void (*PcapSink)(const u8 *Data, u32 Size);
+
+/***************** Macros (Inline Functions) Definitions *********************/
+#define XSECURE_SW_ROR32(Val, Shift) \
+	(((Val) >> (Shift)) | ((Val) << (32U - (Shift))))
+
+#define XSECURE_SW_GET_BE32(Ptr) \
+	(((u32)(Ptr)[0] << 24) | ((u32)(Ptr)[1] << 16) | \
+	 ((u32)(Ptr)[2] << 8) | (u32)(Ptr)[3])
+
+#define XSECURE_SW_PUT_BE32(Ptr, Val) \
+	do { \
+		(Ptr)[0] = (u8)((Val) >> 24); \
+		(Ptr)[1] = (u8)((Val) >> 16); \
+		(Ptr)[2] = (u8)((Val) >> 8); \
+		(Ptr)[3] = (u8)(Val); \
+	} while (0)
+
+#define XSECURE_SW_PCAP_DST(Ptr) \
+	((Ptr) == (u8 *)(UINTPTR)XSECURE_DESTINATION_PCAP_ADDR)
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+ * Sets the device key used for XSECURE_CSU_AES_KEY_SRC_DEV, the key which
+ * is stored in eFUSE or BBRAM on the target.
+ *
+ * @param	Key	32 byte key, in the byte order of the bootgen key file.
+ *
+ ******************************************************************************/
+void XSecure_SwSetDeviceKey(const u8 *Key)
+{
+	(void)memcpy(DeviceKey, Key, sizeof(DeviceKey));
+}
+
+/*****************************************************************************/
+/**
+ * Sets the function receiving the data decrypted to
+ * XSECURE_DESTINATION_PCAP_ADDR. Without a sink the data is dropped.
+ *
+ * @param	Sink	Function called with each piece of decrypted data,
+ *		or NULL.
+ *
+ ******************************************************************************/
+void XSecure_SwSetPcapSink(void (*Sink)(const u8 *Data, u32 Size))
+{
+	PcapSink = Sink;
+}
+
+/*****************************************************************************/
+/**
+ * Returns the name of the AES and GHASH implementation of the build.
+ *
+ * @return	"aesni" or "portable"
+ *
+ ******************************************************************************/
+const char *XSecure_SwAesImpl(void)
+{
+#ifdef XSECURE_SW_AESNI
+	return "aesni";
+#else
+	return "portable";
+#endif
+}
+
+/*****************************************************************************/
+/**
+ * Computes the S-box and the round table of the AES encryption.
+ *
+ ******************************************************************************/
+static void XSecure_SwAesTables(void)
+{
+	u8 P = 1U;
+	u8 Q = 1U;
+	u8 Val;
+	u8 Dbl;
+	u32 Index;
+
+	if (XSecure_SwSbox[0] != 0U) {
+		return;
+	}
+
+	/* P runs through the field, Q through the inverses */
+	do {
+		P = (u8)(P ^ (u8)(P << 1) ^ (((P & 0x80U) != 0U) ? 0x1BU : 0U));
+		Q ^= (u8)(Q << 1);
+		Q ^= (u8)(Q << 2);
+		Q ^= (u8)(Q << 4);
+		if ((Q & 0x80U) != 0U) {
+			Q ^= 0x09U;
+		}
+		Val = (u8)(Q ^ (u8)((Q << 1) | (Q >> 7)) ^
+			(u8)((Q << 2) | (Q >> 6)) ^ (u8)((Q << 3) | (Q >> 5)) ^
+			(u8)((Q << 4) | (Q >> 4)));
+		XSecure_SwSbox[P] = (u8)(Val ^ 0x63U);
+	} while (P != 1U);
+	XSecure_SwSbox[0] = 0x63U;
+
+	for (Index = 0U; Index < 256U; Index++) {
+		Val = XSecure_SwSbox[Index];
+		Dbl = (u8)((u8)(Val << 1) ^ (((Val & 0x80U) != 0U) ? 0x1BU : 0U));
+		XSecure_SwTe[Index] = ((u32)Dbl << 24) | ((u32)Val << 16) |
+			((u32)Val << 8) | (u32)(u8)(Dbl ^ Val);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Loads an AES-256 key into the engine.
+ *
+ * @param	Key	32 byte key.
+ *
+ ******************************************************************************/
+static void XSecure_SwAesExpandKey(const u8 *Key)
+{
+	u32 *RoundKey = AesEngine.RoundKey;
+	u32 Rcon = 1U;
+	u32 Index;
+	u32 Tmp;
+
+	XSecure_SwAesTables();
+
+	for (Index = 0U; Index < XSECURE_SW_AES_KEY_WORDS; Index++) {
+		RoundKey[Index] = XSECURE_SW_GET_BE32(&Key[Index * 4U]);
+	}
+	for (; Index < (4U * (XSECURE_SW_AES_ROUNDS + 1U)); Index++) {
+		Tmp = RoundKey[Index - 1U];
+		if ((Index % XSECURE_SW_AES_KEY_WORDS) == 0U) {
+			Tmp = ((u32)XSecure_SwSbox[(Tmp >> 16) & 0xFFU] << 24) ^
+				((u32)XSecure_SwSbox[(Tmp >> 8) & 0xFFU] << 16) ^
+				((u32)XSecure_SwSbox[Tmp & 0xFFU] << 8) ^
+				(u32)XSecure_SwSbox[Tmp >> 24] ^ (Rcon << 24);
+			Rcon = (Rcon << 1) ^ (((Rcon & 0x80U) != 0U) ? 0x11BU : 0U);
+		}
+		else if ((Index % XSECURE_SW_AES_KEY_WORDS) == 4U) {
+			Tmp = ((u32)XSecure_SwSbox[Tmp >> 24] << 24) ^
+				((u32)XSecure_SwSbox[(Tmp >> 16) & 0xFFU] << 16) ^
+				((u32)XSecure_SwSbox[(Tmp >> 8) & 0xFFU] << 8) ^
+				(u32)XSecure_SwSbox[Tmp & 0xFFU];
+		}
+		RoundKey[Index] = RoundKey[Index - XSECURE_SW_AES_KEY_WORDS] ^ Tmp;
+	}
+
+#ifdef XSECURE_SW_AESNI
+	for (Index = 0U; Index <= XSECURE_SW_AES_ROUNDS; Index++) {
+		u8 Bytes[XSECURE_SW_AES_BLOCK_LEN];
+		u32 Word;
+
+		for (Word = 0U; Word < 4U; Word++) {
+			XSECURE_SW_PUT_BE32(&Bytes[Word * 4U],
+					RoundKey[(Index * 4U) + Word]);
+		}
+		AesEngine.RoundKeyNi[Index] =
+			_mm_loadu_si128((const __m128i *)Bytes);
+	}
+#endif
+}
+
+/*****************************************************************************/
+/**
+ * Encrypts one block with the loaded key.
+ *
+ * @param	In	Plain text block.
+ * @param	Out	Cipher text block, may be In.
+ *
+ ******************************************************************************/
+static void XSecure_SwAesEncryptBlock(const u8 *In, u8 *Out)
+{
+#ifdef XSECURE_SW_AESNI
+	__m128i State = _mm_loadu_si128((const __m128i *)In);
+	u32 Round;
+
+	State = _mm_xor_si128(State, AesEngine.RoundKeyNi[0]);
+	for (Round = 1U; Round < XSECURE_SW_AES_ROUNDS; Round++) {
+		State = _mm_aesenc_si128(State, AesEngine.RoundKeyNi[Round]);
+	}
+	State = _mm_aesenclast_si128(State,
+			AesEngine.RoundKeyNi[XSECURE_SW_AES_ROUNDS]);
+	_mm_storeu_si128((__m128i *)Out, State);
+#else
+	const u32 *RoundKey = AesEngine.RoundKey;
+	const u32 *Te = XSecure_SwTe;
+	const u8 *Sbox = XSecure_SwSbox;
+	u32 S0, S1, S2, S3;
+	u32 T0, T1, T2, T3;
+	u32 Round;
+
+	S0 = XSECURE_SW_GET_BE32(&In[0]) ^ RoundKey[0];
+	S1 = XSECURE_SW_GET_BE32(&In[4]) ^ RoundKey[1];
+	S2 = XSECURE_SW_GET_BE32(&In[8]) ^ RoundKey[2];
+	S3 = XSECURE_SW_GET_BE32(&In[12]) ^ RoundKey[3];
+
+	for (Round = 1U; Round < XSECURE_SW_AES_ROUNDS; Round++) {
+		RoundKey += 4;
+		T0 = Te[S0 >> 24] ^ XSECURE_SW_ROR32(Te[(S1 >> 16) & 0xFFU], 8U) ^
+			XSECURE_SW_ROR32(Te[(S2 >> 8) & 0xFFU], 16U) ^
+			XSECURE_SW_ROR32(Te[S3 & 0xFFU], 24U) ^ RoundKey[0];
+		T1 = Te[S1 >> 24] ^ XSECURE_SW_ROR32(Te[(S2 >> 16) & 0xFFU], 8U) ^
+			XSECURE_SW_ROR32(Te[(S3 >> 8) & 0xFFU], 16U) ^
+			XSECURE_SW_ROR32(Te[S0 & 0xFFU], 24U) ^ RoundKey[1];
+		T2 = Te[S2 >> 24] ^ XSECURE_SW_ROR32(Te[(S3 >> 16) & 0xFFU], 8U) ^
+			XSECURE_SW_ROR32(Te[(S0 >> 8) & 0xFFU], 16U) ^
+			XSECURE_SW_ROR32(Te[S1 & 0xFFU], 24U) ^ RoundKey[2];
+		T3 = Te[S3 >> 24] ^ XSECURE_SW_ROR32(Te[(S0 >> 16) & 0xFFU], 8U) ^
+			XSECURE_SW_ROR32(Te[(S1 >> 8) & 0xFFU], 16U) ^
+			XSECURE_SW_ROR32(Te[S2 & 0xFFU], 24U) ^ RoundKey[3];
+		S0 = T0;
+		S1 = T1;
+		S2 = T2;
+		S3 = T3;
+	}
+
+	RoundKey += 4;
+	T0 = ((u32)Sbox[S0 >> 24] << 24) ^ ((u32)Sbox[(S1 >> 16) & 0xFFU] << 16) ^
+		((u32)Sbox[(S2 >> 8) & 0xFFU] << 8) ^ (u32)Sbox[S3 & 0xFFU] ^
+		RoundKey[0];
+	T1 = ((u32)Sbox[S1 >> 24] << 24) ^ ((u32)Sbox[(S2 >> 16) & 0xFFU] << 16) ^
+		((u32)Sbox[(S3 >> 8) & 0xFFU] << 8) ^ (u32)Sbox[S0 & 0xFFU] ^
+		RoundKey[1];
+	T2 = ((u32)Sbox[S2 >> 24] << 24) ^ ((u32)Sbox[(S3 >> 16) & 0xFFU] << 16) ^
+		((u32)Sbox[(S0 >> 8) & 0xFFU] << 8) ^ (u32)Sbox[S1 & 0xFFU] ^
+		RoundKey[2];
+	T3 = ((u32)Sbox[S3 >> 24] << 24) ^ ((u32)Sbox[(S0 >> 16) & 0xFFU] << 16) ^
+		((u32)Sbox[(S1 >> 8) & 0xFFU] << 8) ^ (u32)Sbox[S2 & 0xFFU] ^
+		RoundKey[3];
+
+	XSECURE_SW_PUT_BE32(&Out[0], T0);
+	XSECURE_SW_PUT_BE32(&Out[4], T1);
+	XSECURE_SW_PUT_BE32(&Out[8], T2);
+	XSECURE_SW_PUT_BE32(&Out[12], T3);
+#endif
+}
+
+/*****************************************************************************/
+/**
+ * Generates the key stream of the next counter blocks.
+ *
+ * @param	KeyStream	Buffer for Blocks blocks of key stream.
+ * @param	Blocks		Number of blocks, at most XSECURE_SW_AES_PARALLEL.
+ *
+ ******************************************************************************/
+static void XSecure_SwAesCtr(u8 *KeyStream, u32 Blocks)
+{
+	u8 *Ctr = AesEngine.Ctr;
+	u32 Count;
+	u32 Index;
+
+#ifdef XSECURE_SW_AESNI
+	if (Blocks == XSECURE_SW_AES_PARALLEL) {
+		__m128i State[XSECURE_SW_AES_PARALLEL];
+		u32 Round;
+
+		for (Index = 0U; Index < XSECURE_SW_AES_PARALLEL; Index++) {
+			State[Index] = _mm_xor_si128(
+				_mm_loadu_si128((const __m128i *)Ctr),
+				AesEngine.RoundKeyNi[0]);
+			Count = XSECURE_SW_GET_BE32(&Ctr[12]) + 1U;
+			XSECURE_SW_PUT_BE32(&Ctr[12], Count);
+		}
+		for (Round = 1U; Round < XSECURE_SW_AES_ROUNDS; Round++) {
+			for (Index = 0U; Index < XSECURE_SW_AES_PARALLEL; Index++) {
+				State[Index] = _mm_aesenc_si128(State[Index],
+						AesEngine.RoundKeyNi[Round]);
+			}
+		}
+		for (Index = 0U; Index < XSECURE_SW_AES_PARALLEL; Index++) {
+			_mm_storeu_si128(
+				(__m128i *)&KeyStream[Index * XSECURE_SW_AES_BLOCK_LEN],
+				_mm_aesenclast_si128(State[Index],
+				AesEngine.RoundKeyNi[XSECURE_SW_AES_ROUNDS]));
+		}
+		return;
+	}
+#endif
+
+	for (Index = 0U; Index < Blocks; Index++) {
+		XSecure_SwAesEncryptBlock(Ctr,
+				&KeyStream[Index * XSECURE_SW_AES_BLOCK_LEN]);
+		/* GCM increments the low 32 bits of the counter */
+		Count = XSECURE_SW_GET_BE32(&Ctr[12]) + 1U;
+		XSECURE_SW_PUT_BE32(&Ctr[12], Count);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Sets the GHASH key H.
+ *
+ * @param	HashKey	H, the encrypted zero block.
+ *
+ ******************************************************************************/
+static void XSecure_SwGhashKey(const u8 *HashKey)
+{
+	u64 Hi = ((u64)XSECURE_SW_GET_BE32(&HashKey[0]) << 32) |
+		XSECURE_SW_GET_BE32(&HashKey[4]);
+	u64 Lo = ((u64)XSECURE_SW_GET_BE32(&HashKey[8]) << 32) |
+		XSECURE_SW_GET_BE32(&HashKey[12]);
+	u32 Index;
+	u32 Sub;
+	u64 Carry;
+
+	/* HashTbl[i] = i * H, with the bit order of GCM */
+	AesEngine.HashTblHi[0] = 0U;
+	AesEngine.HashTblLo[0] = 0U;
+	AesEngine.HashTblHi[8] = Hi;
+	AesEngine.HashTblLo[8] = Lo;
+	for (Index = 4U; Index > 0U; Index >>= 1) {
+		Carry = (Lo & 1U) * 0xE1000000U;
+		Lo = (Hi << 63) | (Lo >> 1);
+		Hi = (Hi >> 1) ^ (Carry << 32);
+		AesEngine.HashTblHi[Index] = Hi;
+		AesEngine.HashTblLo[Index] = Lo;
+	}
+	for (Index = 2U; Index <= 8U; Index <<= 1) {
+		for (Sub = 1U; Sub < Index; Sub++) {
+			AesEngine.HashTblHi[Index + Sub] =
+				AesEngine.HashTblHi[Index] ^ AesEngine.HashTblHi[Sub];
+			AesEngine.HashTblLo[Index + Sub] =
+				AesEngine.HashTblLo[Index] ^ AesEngine.HashTblLo[Sub];
+		}
+	}
+
+#ifdef XSECURE_SW_AESNI
+	AesEngine.HashKeyRev = _mm_shuffle_epi8(
+		_mm_loadu_si128((const __m128i *)HashKey),
+		_mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+#endif
+}
+
+#ifdef XSECURE_SW_AESNI
+/*****************************************************************************/
+/**
+ * Multiplies two byte reversed elements of the GCM field, see the Intel
+ * carry-less multiplication white paper.
+ *
+ ******************************************************************************/
+static __m128i XSecure_SwGfMul(__m128i A, __m128i B)
+{
+	__m128i Lo = _mm_clmulepi64_si128(A, B, 0x00);
+	__m128i Mid = _mm_xor_si128(_mm_clmulepi64_si128(A, B, 0x10),
+			_mm_clmulepi64_si128(A, B, 0x01));
+	__m128i Hi = _mm_clmulepi64_si128(A, B, 0x11);
+	__m128i T1;
+	__m128i T2;
+	__m128i T3;
+
+	Lo = _mm_xor_si128(Lo, _mm_slli_si128(Mid, 8));
+	Hi = _mm_xor_si128(Hi, _mm_srli_si128(Mid, 8));
+
+	/* Shift the 256-bit product left by one, GCM is bit reflected */
+	T1 = _mm_srli_epi32(Lo, 31);
+	T2 = _mm_srli_epi32(Hi, 31);
+	Lo = _mm_slli_epi32(Lo, 1);
+	Hi = _mm_slli_epi32(Hi, 1);
+	T3 = _mm_srli_si128(T1, 12);
+	T2 = _mm_slli_si128(T2, 4);
+	T1 = _mm_slli_si128(T1, 4);
+	Lo = _mm_or_si128(Lo, T1);
+	Hi = _mm_or_si128(_mm_or_si128(Hi, T2), T3);
+
+	/* Reduce modulo x^128 + x^7 + x^2 + x + 1 */
+	T1 = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(Lo, 31),
+			_mm_slli_epi32(Lo, 30)), _mm_slli_epi32(Lo, 25));
+	T2 = _mm_srli_si128(T1, 4);
+	T1 = _mm_slli_si128(T1, 12);
+	Lo = _mm_xor_si128(Lo, T1);
+	T3 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(Lo, 1),
+			_mm_srli_epi32(Lo, 2)), _mm_srli_epi32(Lo, 7));
+	T3 = _mm_xor_si128(T3, T2);
+	Lo = _mm_xor_si128(Lo, T3);
+
+	return _mm_xor_si128(Hi, Lo);
+}
+#endif
+
+/*****************************************************************************/
+/**
+ * Updates the GHASH accumulator with one block of cipher text.
+ *
+ * @param	Block	16 bytes of cipher text.
+ *
+ ******************************************************************************/
+static void XSecure_SwGhash(const u8 *Block)
+{
+#ifdef XSECURE_SW_AESNI
+	const __m128i Rev = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+			12, 13, 14, 15);
+	__m128i Acc = _mm_xor_si128(
+		_mm_loadu_si128((const __m128i *)AesEngine.Hash),
+		_mm_loadu_si128((const __m128i *)Block));
+
+	Acc = XSecure_SwGfMul(_mm_shuffle_epi8(Acc, Rev), AesEngine.HashKeyRev);
+	_mm_storeu_si128((__m128i *)AesEngine.Hash, _mm_shuffle_epi8(Acc, Rev));
+#else
+	u8 X[XSECURE_SW_AES_BLOCK_LEN];
+	u64 Hi;
+	u64 Lo;
+	u32 Rem;
+	u32 Nibble;
+	s32 Index;
+
+	for (Index = 0; Index < (s32)XSECURE_SW_AES_BLOCK_LEN; Index++) {
+		X[Index] = AesEngine.Hash[Index] ^ Block[Index];
+	}
+
+	Nibble = X[15] & 0xFU;
+	Hi = AesEngine.HashTblHi[Nibble];
+	Lo = AesEngine.HashTblLo[Nibble];
+
+	for (Index = 15; Index >= 0; Index--) {
+		if (Index != 15) {
+			Nibble = X[Index] & 0xFU;
+			Rem = (u32)(Lo & 0xFU);
+			Lo = (Hi << 60) | (Lo >> 4);
+			Hi = (Hi >> 4) ^ (XSecure_SwGhashRem[Rem] << 48);
+			Hi ^= AesEngine.HashTblHi[Nibble];
+			Lo ^= AesEngine.HashTblLo[Nibble];
+		}
+		Nibble = (u32)X[Index] >> 4;
+		Rem = (u32)(Lo & 0xFU);
+		Lo = (Hi << 60) | (Lo >> 4);
+		Hi = (Hi >> 4) ^ (XSecure_SwGhashRem[Rem] << 48);
+		Hi ^= AesEngine.HashTblHi[Nibble];
+		Lo ^= AesEngine.HashTblLo[Nibble];
+	}
+
+	XSECURE_SW_PUT_BE32(&AesEngine.Hash[0], (u32)(Hi >> 32));
+	XSECURE_SW_PUT_BE32(&AesEngine.Hash[4], (u32)Hi);
+	XSECURE_SW_PUT_BE32(&AesEngine.Hash[8], (u32)(Lo >> 32));
+	XSECURE_SW_PUT_BE32(&AesEngine.Hash[12], (u32)Lo);
+#endif
+}
+
+/*****************************************************************************/
+/**
+ * Reads words of the emulated registers or of memory, most significant byte
+ * first, as the AES engine sees them.
+ *
+ * @param	Addr	Address of the first word.
+ * @param	Dst	Buffer for the bytes.
+ * @param	Words	Number of words.
+ *
+ ******************************************************************************/
+static void XSecure_SwGetWords(UINTPTR Addr, u8 *Dst, u32 Words)
+{
+	u32 Index;
+	u32 Val;
+
+	if (!XSECURE_SW_IS_REG(Addr)) {
+		(void)memcpy(Dst, (const void *)Addr, Words * 4U);
+		return;
+	}
+
+	for (Index = 0U; Index < Words; Index++) {
+		Val = XSecure_In32(Addr + (Index * 4U));
+		XSECURE_SW_PUT_BE32(&Dst[Index * 4U], Val);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Writes words of the emulated registers, most significant byte first.
+ *
+ * @param	Addr	Address of the first register.
+ * @param	Src	Bytes to be written.
+ * @param	Words	Number of registers.
+ *
+ ******************************************************************************/
+static void XSecure_SwPutWords(UINTPTR Addr, const u8 *Src, u32 Words)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < Words; Index++) {
+		XSecure_Out32(Addr + (Index * 4U),
+			XSECURE_SW_GET_BE32(&Src[Index * 4U]));
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Starts a message with the loaded key, as the push of the IV does.
+ *
+ * @param	Iv	IV in memory or the IV registers of the engine.
+ *
+ ******************************************************************************/
+static void XSecure_SwAesStart(const u32 *Iv)
+{
+	u8 Zero[XSECURE_SW_AES_BLOCK_LEN] = {0U};
+	u8 HashKey[XSECURE_SW_AES_BLOCK_LEN];
+
+	XSecure_SwAesEncryptBlock(Zero, HashKey);
+	XSecure_SwGhashKey(HashKey);
+
+	/* J0 = IV || 1, the text is encrypted from J0 + 1 */
+	XSecure_SwGetWords((UINTPTR)Iv, AesEngine.Ctr,
+			XSECURE_SW_AES_IV_LEN / 4U);
+	XSECURE_SW_PUT_BE32(&AesEngine.Ctr[12], 1U);
+	XSecure_SwAesCtr(AesEngine.EncJ0, 1U);
+
+	(void)memset(AesEngine.Hash, 0, sizeof(AesEngine.Hash));
+	AesEngine.PartialLen = 0U;
+	AesEngine.TextLen = 0U;
+}
+
+/*****************************************************************************/
+/**
+ * Encrypts or decrypts data of the current message.
+ *
+ * @param	In	Input data.
+ * @param	Out	Output data, may be In.
+ * @param	Len	Length of the data in bytes.
+ * @param	Encrypt	XSECURE_SW_AES_ENCRYPT or XSECURE_SW_AES_DECRYPT.
+ *
+ ******************************************************************************/
+static void XSecure_SwAesGcm(const u8 *In, u8 *Out, u32 Len, u32 Encrypt)
+{
+	XSecure_SwAesEngine *Engine = &AesEngine;
+	u8 KeyStream[XSECURE_SW_AES_PARALLEL * XSECURE_SW_AES_BLOCK_LEN];
+	u8 Cipher[XSECURE_SW_AES_PARALLEL * XSECURE_SW_AES_BLOCK_LEN];
+	u32 Blocks;
+	u32 Size;
+	u32 Index;
+	u8 Byte;
+
+	while (Len > 0U) {
+		if ((Engine->PartialLen == 0U) && (Len >= XSECURE_SW_AES_BLOCK_LEN)) {
+			Blocks = Len / XSECURE_SW_AES_BLOCK_LEN;
+			if (Blocks > XSECURE_SW_AES_PARALLEL) {
+				Blocks = XSECURE_SW_AES_PARALLEL;
+			}
+			Size = Blocks * XSECURE_SW_AES_BLOCK_LEN;
+			XSecure_SwAesCtr(KeyStream, Blocks);
+			for (Index = 0U; Index < Size; Index++) {
+				Byte = In[Index] ^ KeyStream[Index];
+				Cipher[Index] = (Encrypt == XSECURE_SW_AES_ENCRYPT) ?
+						Byte : In[Index];
+				Out[Index] = Byte;
+			}
+			for (Index = 0U; Index < Size;
+					Index += XSECURE_SW_AES_BLOCK_LEN) {
+				XSecure_SwGhash(&Cipher[Index]);
+			}
+		}
+		else {
+			/* Byte wise up to the next block boundary */
+			if (Engine->PartialLen == 0U) {
+				XSecure_SwAesCtr(Engine->KeyStream, 1U);
+			}
+			Size = 1U;
+			Byte = In[0] ^ Engine->KeyStream[Engine->PartialLen];
+			Engine->Block[Engine->PartialLen] =
+				(Encrypt == XSECURE_SW_AES_ENCRYPT) ? Byte : In[0];
+			Out[0] = Byte;
+			Engine->PartialLen++;
+			if (Engine->PartialLen == XSECURE_SW_AES_BLOCK_LEN) {
+				XSecure_SwGhash(Engine->Block);
+				Engine->PartialLen = 0U;
+			}
+		}
+		In += Size;
+		Out += Size;
+		Len -= Size;
+		Engine->TextLen += Size;
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Encrypts or decrypts data of the current message to memory or to the
+ * PCAP sink.
+ *
+ * @param	In	Input data.
+ * @param	Out	Output data or XSECURE_DESTINATION_PCAP_ADDR.
+ * @param	Len	Length of the data in bytes.
+ * @param	Encrypt	XSECURE_SW_AES_ENCRYPT or XSECURE_SW_AES_DECRYPT.
+ *
+ ******************************************************************************/
+static void XSecure_SwAesRun(const u8 *In, u8 *Out, u32 Len, u32 Encrypt)
+{
+	u8 Stage[XSECURE_SW_PCAP_STAGE_LEN];
+	u32 Size;
+
+	if (!XSECURE_SW_PCAP_DST(Out)) {
+		XSecure_SwAesGcm(In, Out, Len, Encrypt);
+		return;
+	}
+
+	while (Len > 0U) {
+		Size = (Len > XSECURE_SW_PCAP_STAGE_LEN) ?
+			XSECURE_SW_PCAP_STAGE_LEN : Len;
+		XSecure_SwAesGcm(In, Stage, Size, Encrypt);
+		if (PcapSink != NULL) {
+			PcapSink(Stage, Size);
+		}
+		In += Size;
+		Len -= Size;
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Completes the message and computes the GCM tag.
+ *
+ * @param	Tag	Buffer for the 16 byte tag.
+ *
+ ******************************************************************************/
+static void XSecure_SwAesTag(u8 *Tag)
+{
+	XSecure_SwAesEngine *Engine = &AesEngine;
+	u8 LenBlock[XSECURE_SW_AES_BLOCK_LEN] = {0U};
+	u64 Bits = Engine->TextLen * 8U;
+	u32 Index;
+
+	if (Engine->PartialLen != 0U) {
+		(void)memset(&Engine->Block[Engine->PartialLen], 0,
+			XSECURE_SW_AES_BLOCK_LEN - Engine->PartialLen);
+		XSecure_SwGhash(Engine->Block);
+		Engine->PartialLen = 0U;
+	}
+
+	/* No additional authenticated data */
+	XSECURE_SW_PUT_BE32(&LenBlock[8], (u32)(Bits >> 32));
+	XSECURE_SW_PUT_BE32(&LenBlock[12], (u32)Bits);
+	XSecure_SwGhash(LenBlock);
+
+	for (Index = 0U; Index < XSECURE_SW_AES_BLOCK_LEN; Index++) {
+		Tag[Index] = Engine->Hash[Index] ^ Engine->EncJ0[Index];
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Completes the message and compares the GCM tag.
+ *
+ * @param	Tag	Expected tag.
+ *
+ * @return	XST_SUCCESS if the tag matches, XST_FAILURE otherwise
+ *
+ ******************************************************************************/
+static u32 XSecure_SwAesTagCheck(const u8 *Tag)
+{
+	u8 Calc[XSECURE_SW_AES_BLOCK_LEN];
+	u8 Diff = 0U;
+	u32 Index;
+
+	XSecure_SwAesTag(Calc);
+	for (Index = 0U; Index < XSECURE_SW_AES_BLOCK_LEN; Index++) {
+		Diff |= (u8)(Calc[Index] ^ Tag[Index]);
+	}
+
+	return (Diff == 0U) ? (u32)XST_SUCCESS : (u32)XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function initializes the instance pointer.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ * @param	CsuDmaPtr	Pointer to the XCsuDma instance.
+ * @param	KeySel		Key source for decryption, can be KUP/device key
+ *		- XSECURE_CSU_AES_KEY_SRC_KUP :For KUP key
+ *		- XSECURE_CSU_AES_KEY_SRC_DEV :For Device Key
+ * @param	Iv		Pointer to the Initialization Vector
+ *		for decryption
+ * @param	Key		Pointer to Aes decryption key in case KUP
+ *		key is used.
+ * 		Passes `Null` if device key is to be used.
+ *
+ * @return	XST_SUCCESS if initialization was successful.
+ *
+ ******************************************************************************/
+s32 XSecure_AesInitialize(XSecure_Aes *InstancePtr, XCsuDma *CsuDmaPtr,
+				u32 KeySel, u32* IvPtr,  u32* KeyPtr)
+{
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(CsuDmaPtr != NULL);
+	Xil_AssertNonvoid(IvPtr != NULL);
+	Xil_AssertNonvoid((KeySel == XSECURE_CSU_AES_KEY_SRC_KUP) ||
+			(KeySel == XSECURE_CSU_AES_KEY_SRC_DEV));
+	if (KeySel == XSECURE_CSU_AES_KEY_SRC_KUP) {
+		Xil_AssertNonvoid(KeyPtr != NULL);
+	}
+
+	InstancePtr->BaseAddress = XSECURE_CSU_AES_BASE;
+	InstancePtr->CsuDmaPtr = CsuDmaPtr;
+	InstancePtr->KeySel = KeySel;
+	InstancePtr->Iv = IvPtr;
+	InstancePtr->Key = KeyPtr;
+	InstancePtr->IsChunkingEnabled = XSECURE_CSU_AES_CHUNKING_DISABLED;
+	InstancePtr->ReadBufferPong = NULL;
+	InstancePtr->GetTime = NULL;
+	(void)memset(&InstancePtr->ChunkStats, 0,
+			sizeof(InstancePtr->ChunkStats));
+	InstancePtr->AesState = XSECURE_AES_INITIALIZED;
+
+	XSecure_SssInitialize(&(InstancePtr->SssInstance));
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * Writes the key of the instance to the KUP registers, when the KUP key is
+ * selected, and loads the selected key.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ *
+ * @return	XST_SUCCESS
+ *
+ ******************************************************************************/
+static u32 XSecure_SwAesLoadKey(XSecure_Aes *InstancePtr)
+{
+	u32 Count;
+
+	if (InstancePtr->KeySel != XSECURE_CSU_AES_KEY_SRC_DEV) {
+		for (Count = 0U; Count < XSECURE_SW_AES_KEY_WORDS; Count++) {
+			/* Helion AES block expects the key in big-endian. */
+			XSecure_Out32(InstancePtr->BaseAddress +
+				XSECURE_CSU_AES_KUP_0_OFFSET + (Count * 4U),
+				Xil_Htonl(InstancePtr->Key[Count]));
+		}
+	}
+
+	return XSecure_AesKeySelNLoad(InstancePtr);
+}
+
+/*****************************************************************************/
+/**
+ *
+ * @brief
+ * This funcion is used to initialize the AES engine for encryption.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ * @param	EncData		Pointer of a buffer in which encrypted data
+ *		along with GCM TAG will be stored. Buffer size should be
+ *		Size of data plus 16 bytes.
+ * @param	Size		A 32 bit variable, which holds the size of
+ *		the input data to be encrypted.
+ *
+ * @return	XST_SUCCESS
+ *
+ ******************************************************************************/
+u32 XSecure_AesEncryptInit(XSecure_Aes *InstancePtr, u8 *EncData, u32 Size)
+{
+	u32 Status;
+
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Size != (u32)0x0);
+	Xil_AssertNonvoid(InstancePtr->AesState != XSECURE_AES_UNINITIALIZED);
+
+	/* Clear AES contents by reseting it. */
+	XSecure_AesReset(InstancePtr);
+
+	Status = XSecure_SwAesLoadKey(InstancePtr);
+	if (Status != (u32)XST_SUCCESS) {
+		goto END;
+	}
+
+	XSecure_SwAesStart(InstancePtr->Iv);
+	AesEngine.Out = EncData;
+
+	/* Update the size of data */
+	InstancePtr->SizeofData = Size;
+	InstancePtr->AesState = XSECURE_AES_ENCRYPT_INITIALIZED;
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function is used to update the AES engine with provided data for
+ * encryption.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ * @param	Data	Pointer to the data for which encryption should be
+ * 		performed.
+ * @param	Size	A 32 bit variable, which holds the size of the input
+ *		data in bytes.
+ *
+ * @return	XST_SUCCESS
+ *
+ * @note	When Size of the data equals to size of the remaining data
+ *		to be processed that data will be treated as final data and
+ *		the GCM tag is written after the encrypted data.
+ *
+ ******************************************************************************/
+u32 XSecure_AesEncryptUpdate(XSecure_Aes *InstancePtr, const u8 *Data, u32 Size)
+{
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Size <= InstancePtr->SizeofData);
+	Xil_AssertNonvoid(InstancePtr->AesState == XSECURE_AES_ENCRYPT_INITIALIZED);
+
+	XSecure_SwAesRun(Data, AesEngine.Out, Size, XSECURE_SW_AES_ENCRYPT);
+	AesEngine.Out += Size;
+
+	if (Size == InstancePtr->SizeofData) {
+		XSecure_SwAesTag(AesEngine.Out);
+	}
+
+	/* Update the size of instance */
+	InstancePtr->SizeofData = InstancePtr->SizeofData - Size;
+
+	return (u32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This Function encrypts the data provided by using the AES engine.
+ *
+ * @param	InstancePtr	A pointer to the XSecure_Aes instance.
+ * @param	Dst	A pointer to a buffer where encrypted data along with
+ *		GCM tag will be stored. The Size of buffer provided should be
+ *		Size of the data plus 16 bytes
+ * @param	Src	A pointer to input data for encryption.
+ * @param	Len	Size of input data in bytes
+ *
+ * @return	XST_SUCCESS
+ *
+ ******************************************************************************/
+u32 XSecure_AesEncryptData(XSecure_Aes *InstancePtr, u8 *Dst, const u8 *Src,
+			u32 Len)
+{
+	u32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Len != 0U);
+
+	Status = XSecure_AesEncryptInit(InstancePtr, Dst, Len);
+	if (Status != (u32)XST_SUCCESS) {
+		goto END;
+	}
+	Status = XSecure_AesEncryptUpdate(InstancePtr, Src, Len);
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function initializes the AES engine for decryption.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ * @param	DecData		Pointer in which decrypted data will be stored.
+ * @param	Size		Expected size of the data in bytes.
+ * @param	GcmTagAddr	Pointer to the GCM tag which needs to be
+ *		verified during decryption of the data.
+ *
+ * @return	XST_SUCCESS
+ *
+ ******************************************************************************/
+u32 XSecure_AesDecryptInit(XSecure_Aes *InstancePtr, u8 * DecData,
+		u32 Size, u8 *GcmTagAddr)
+{
+	u32 Status;
+
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(((Size/4U) != 0x00U) && ((Size%4U) == 0x00U));
+	Xil_AssertNonvoid(GcmTagAddr != NULL);
+	Xil_AssertNonvoid(InstancePtr->AesState != XSECURE_AES_UNINITIALIZED);
+
+	/* Clear AES contents by reseting it. */
+	XSecure_AesReset(InstancePtr);
+
+	Status = XSecure_SwAesLoadKey(InstancePtr);
+	if (Status != (u32)XST_SUCCESS) {
+		goto END;
+	}
+
+	XSecure_SwAesStart(InstancePtr->Iv);
+	AesEngine.Out = DecData;
+
+	InstancePtr->GcmTagAddr = (u32 *)GcmTagAddr;
+	InstancePtr->SizeofData = Size;
+	InstancePtr->TotalSizeOfData = Size;
+	InstancePtr->Destination = DecData;
+	InstancePtr->AesState = XSECURE_AES_DECRYPT_INITIALIZED;
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function is used to update the AES engine for decryption with provided
+ * data
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ * @param	EncData		Pointer to the encrypted data which needs to be
+ *		decrypted.
+ * @param	Size		Expected size of data to be decrypted in bytes.
+ *
+ * @return	Final call of this API returns the status of GCM tag matching.
+ *		- XSECURE_CSU_AES_GCM_TAG_MISMATCH: If GCM tag is mismatched
+ *		- XST_SUCCESS: If GCM tag is matching.
+ *
+ * @note	When Size of the data equals to size of the remaining data
+ *		that data will be treated as final data. On a tag mismatch the
+ *		decrypted data is zeroized.
+ *
+ ******************************************************************************/
+s32 XSecure_AesDecryptUpdate(XSecure_Aes *InstancePtr, u8 *EncData, u32 Size)
+{
+	u32 GcmStatus;
+
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Size <= InstancePtr->SizeofData);
+	Xil_AssertNonvoid(InstancePtr->AesState == XSECURE_AES_DECRYPT_INITIALIZED);
+
+	XSecure_SwAesRun(EncData, AesEngine.Out, Size, XSECURE_SW_AES_DECRYPT);
+	if (!XSECURE_SW_PCAP_DST(AesEngine.Out)) {
+		AesEngine.Out += Size;
+	}
+
+	/* If this is the last update for the data */
+	if (InstancePtr->SizeofData == Size) {
+		GcmStatus = XSecure_SwAesTagCheck(
+				(const u8 *)InstancePtr->GcmTagAddr);
+		if (GcmStatus != (u32)XST_SUCCESS) {
+			if (!XSECURE_SW_PCAP_DST(InstancePtr->Destination)) {
+				/* Zeroize the decrypted data*/
+				GcmStatus = XSecure_Zeroize(
+						InstancePtr->Destination,
+						InstancePtr->TotalSizeOfData);
+				if (GcmStatus != (u32)XST_SUCCESS) {
+					goto END;
+				}
+			}
+			GcmStatus = XSECURE_CSU_AES_GCM_TAG_MISMATCH;
+			goto END;
+		}
+	}
+
+	/* Update the size of data */
+	InstancePtr->SizeofData = InstancePtr->SizeofData - Size;
+	GcmStatus = (u32)XST_SUCCESS;
+END:
+	return (s32)GcmStatus;
+}
+
+/*****************************************************************************/
+/*
+ * @brief
+ * This function is used to zeroize the memory
+ *
+ * @param	DataPtr Pointer to the memory which need to be zeroized.
+ * @param	Length	Length of the data.
+ *
+ * @return	- XSECURE_CSU_AES_ZEROIZATION_ERROR: If Zeroization is not
+ *		  Successfull.
+ *		- XST_SUCCESS: If Zeroization is Scuccesfull.
+ *
+ ******************************************************************************/
+static u32 XSecure_Zeroize(u8 *DataPtr, u32 Length)
+{
+	u32 Index;
+	u32 Status = (u32)XST_FAILURE;
+
+	/* Clear the decrypted data */
+	(void)memset(DataPtr, 0, Length);
+
+	/* Read it back to verify*/
+	for (Index = 0U; Index < Length; Index++) {
+		if (DataPtr[Index] != 0x00U) {
+			Status = (u32)XSECURE_CSU_AES_ZEROIZATION_ERROR;
+			goto END;
+		}
+	}
+	Status = (u32)XST_SUCCESS;
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function decrypts the encrypted data provided and updates the
+ * DecData buffer with decrypted data
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ * @param	DecData		Pointer to a buffer in which decrypted data will
+ *		be stored.
+ * @param	EncData		Pointer to the encrypted data which needs to be
+ *		decrypted.
+ * @param	Size		Size of data to be	decrypted in bytes.
+ * @param	GcmTagAddr	Pointer to the GCM tag.
+ *
+ * @return	This API returns the status of GCM tag matching.
+ *		- XSECURE_CSU_AES_GCM_TAG_MISMATCH: If GCM tag was mismatched
+ *		- XST_SUCCESS: If GCM tag was matched.
+ *
+ ******************************************************************************/
+s32 XSecure_AesDecryptData(XSecure_Aes *InstancePtr, u8 * DecData, u8 *EncData,
+		u32 Size, u8 * GcmTagAddr)
+{
+	s32 Status;
+
+	Status = (s32)XSecure_AesDecryptInit(InstancePtr, DecData, Size, GcmTagAddr);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	Status = XSecure_AesDecryptUpdate(InstancePtr, EncData, Size);
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This API enables/disables data chunking.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Aes instance.
+ * @param	Chunking 	Used to enable or disable data chunking.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void XSecure_AesSetChunking(XSecure_Aes *InstancePtr, u8 Chunking)
+{
+	/* Assert validates the input arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid((Chunking == XSECURE_CSU_AES_CHUNKING_ENABLED) ||
+			(Chunking == XSECURE_CSU_AES_CHUNKING_DISABLED));
+
+	InstancePtr->IsChunkingEnabled = Chunking;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function sets the configuration for Data Chunking.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ * @param	ReadBuffer	Buffer where the data will be written
+ *		after copying.
+ * @param	ChunkSize	Length of the buffer in bytes.
+ * @param	DeviceCopy 	Function pointer to copy data from the device
+ *		to buffer.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void XSecure_AesSetChunkConfig(XSecure_Aes *InstancePtr, u8 *ReadBuffer,
+				u32 ChunkSize, u32(*DeviceCopy)(u32, UINTPTR, u32))
+{
+	/* Assert validates the input arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(DeviceCopy != NULL);
+	Xil_AssertVoid(ChunkSize != 0U);
+	/* Chunk Size has to be multiple of words */
+	Xil_AssertVoid((ChunkSize % 4U) == 0U);
+
+	InstancePtr->ReadBuffer = ReadBuffer;
+	InstancePtr->ChunkSize = ChunkSize;
+	InstancePtr->DeviceCopy = DeviceCopy;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function sets a second read buffer for data chunking. The emulated
+ * engine decrypts a chunk before the next one is copied, the buffers are
+ * used alternately as on the target.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ * @param	ReadBufferPong	Second buffer of the chunk size, or NULL.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void XSecure_AesSetChunkPingPong(XSecure_Aes *InstancePtr,
+				u8 *ReadBufferPong)
+{
+	/* Assert validates the input arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	InstancePtr->ReadBufferPong = ReadBufferPong;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function sets the time source used to measure the copy and
+ * decryption time of each chunk.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ * @param	GetTime		Function returning the current time in ticks,
+ *		NULL to disable the time measurement.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void XSecure_AesSetChunkTimer(XSecure_Aes *InstancePtr, u64 (*GetTime)(void))
+{
+	/* Assert validates the input arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	InstancePtr->GetTime = GetTime;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function waits for AES completion. The emulated engine is done when
+ * a request returns.
+ *
+ * @param	InstancePtr Pointer to the XSecure_Aes instance.
+ *
+ * @return	XST_SUCCESS
+ *
+ ******************************************************************************/
+u32 XSecure_AesWaitForDone(XSecure_Aes *InstancePtr)
+{
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return (u32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function resets the AES engine.
+ *
+ * @param	InstancePtr is a pointer to the XSecure_Aes instance.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void XSecure_AesReset(XSecure_Aes *InstancePtr)
+{
+	/* Assert validates the input arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	(void)memset(&AesEngine, 0, sizeof(AesEngine));
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function resets the AES key storage registers and the loaded key.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ *
+ * @return	XST_SUCCESS
+ *
+ ******************************************************************************/
+u32 XSecure_AesKeyZero(XSecure_Aes *InstancePtr)
+{
+	u8 Zero[XSECURE_SW_AES_KEY_WORDS * 4U] = {0U};
+
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	XSecure_SwPutWords(InstancePtr->BaseAddress +
+			XSECURE_CSU_AES_KUP_0_OFFSET, Zero,
+			XSECURE_SW_AES_KEY_WORDS);
+	(void)memset(AesEngine.RoundKey, 0, sizeof(AesEngine.RoundKey));
+#ifdef XSECURE_SW_AESNI
+	(void)memset(AesEngine.RoundKeyNi, 0, sizeof(AesEngine.RoundKeyNi));
+#endif
+
+	return (u32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function loads the AES key from the selected key source, the device
+ * key set by XSecure_SwSetDeviceKey() or the KUP registers.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ *
+ * @return	XST_SUCCESS
+ *
+ ******************************************************************************/
+u32 XSecure_AesKeySelNLoad(XSecure_Aes *InstancePtr)
+{
+	u8 Key[XSECURE_SW_AES_KEY_WORDS * 4U];
+
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	if (InstancePtr->KeySel == XSECURE_CSU_AES_KEY_SRC_DEV) {
+		(void)memcpy(Key, DeviceKey, sizeof(Key));
+	}
+	else {
+		XSecure_SwGetWords(InstancePtr->BaseAddress +
+				XSECURE_CSU_AES_KUP_0_OFFSET, Key,
+				XSECURE_SW_AES_KEY_WORDS);
+	}
+	XSecure_SwAesExpandKey(Key);
+	(void)memset(Key, 0, sizeof(Key));
+
+	return (u32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * @brief
+ * This is a helper function to copy one chunk from the device to a read
+ * buffer and account the copy time.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Aes instance.
+ * @param	SrcAddress 	Address of the chunk in the device.
+ * @param	Buffer 	Read buffer the chunk is copied to.
+ * @param	Length 	Length of the chunk in bytes.
+ *
+ * @return	returns XST_SUCCESS if the chunk is copied or
+ *		XSECURE_CSU_AES_DEVICE_COPY_ERROR
+ *
+ ******************************************************************************/
+static s32 XSecure_AesChunkCopy(XSecure_Aes *InstancePtr, u32 SrcAddress,
+		u8 *Buffer, u32 Length)
+{
+	s32 Status;
+	u64 Time = 0U;
+
+	if (InstancePtr->GetTime != NULL) {
+		Time = InstancePtr->GetTime();
+	}
+
+	Status = (s32)InstancePtr->DeviceCopy(SrcAddress, (UINTPTR)Buffer,
+						Length);
+	if (XST_SUCCESS != Status) {
+		Status = (s32)XSECURE_CSU_AES_DEVICE_COPY_ERROR;
+		goto END;
+	}
+
+	if (InstancePtr->GetTime != NULL) {
+		Time = InstancePtr->GetTime() - Time;
+		InstancePtr->ChunkStats.ReadTime += Time;
+		if (Time > InstancePtr->ChunkStats.MaxReadTime) {
+			InstancePtr->ChunkStats.MaxReadTime = Time;
+		}
+	}
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * @brief
+ * This is a helper function to decrypt one chunk to the PCAP and account the
+ * time as the wait for the chunk.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Aes instance.
+ * @param	Buffer 	Read buffer holding the chunk.
+ * @param	Length 	Length of the chunk in bytes.
+ *
+ * @return	XST_SUCCESS
+ *
+ ******************************************************************************/
+static s32 XSecure_AesChunkWait(XSecure_Aes *InstancePtr, const u8 *Buffer,
+		u32 Length)
+{
+	u64 Time = 0U;
+
+	if (InstancePtr->GetTime != NULL) {
+		Time = InstancePtr->GetTime();
+	}
+
+	XSecure_SwAesRun(Buffer,
+		(u8 *)(UINTPTR)XSECURE_DESTINATION_PCAP_ADDR, Length,
+		XSECURE_SW_AES_DECRYPT);
+
+	InstancePtr->ChunkStats.ChunkCount++;
+	if (InstancePtr->GetTime != NULL) {
+		Time = InstancePtr->GetTime() - Time;
+		InstancePtr->ChunkStats.WaitTime += Time;
+		if (Time > InstancePtr->ChunkStats.MaxWaitTime) {
+			InstancePtr->ChunkStats.MaxWaitTime = Time;
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * @brief
+ * This is a helper function to decrypt chunked bitstream block and route to
+ * PCAP.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Aes instance.
+ * @param	Src 	Device address of the encrypted bitstream block start.
+ * @param	Len 	Length of bitstream data block in bytes.
+ *
+ * @return	returns XST_SUCCESS if bitstream block is decrypted by AES,
+ *		XST_FAILURE if Len is 0.
+ *
+ ******************************************************************************/
+static s32 XSecure_AesChunkDecrypt(XSecure_Aes *InstancePtr, const u8 *Src,
+					u32 Len)
+{
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Len != 0U);
+	Xil_AssertNonvoid((InstancePtr->ChunkSize) != 0U);
+
+	s32 Status;
+	u8 *Buffer[2U];
+	u32 BufferIndex = 0U;
+	u32 Offset = 0U;
+	u32 Size;
+	u32 NextSize;
+	u32 StartAddrByte = (u32)(INTPTR)Src;
+
+	/* Nothing to decrypt is a failure, as with the assert compiled out */
+	if (Len == 0U) {
+		Status = XST_FAILURE;
+		goto END;
+	}
+
+	Buffer[0U] = InstancePtr->ReadBuffer;
+	Buffer[1U] = InstancePtr->ReadBufferPong;
+
+	Size = Len;
+	if (Size > InstancePtr->ChunkSize) {
+		Size = InstancePtr->ChunkSize;
+	}
+	Status = XSecure_AesChunkCopy(InstancePtr, StartAddrByte, Buffer[0U],
+					Size);
+	if (XST_SUCCESS != Status) {
+		goto END;
+	}
+
+	while (Offset < Len)
+	{
+		Status = XSecure_AesChunkWait(InstancePtr, Buffer[BufferIndex],
+						Size);
+		if (XST_SUCCESS != Status) {
+			goto END;
+		}
+
+		NextSize = Len - Offset - Size;
+		if (NextSize > InstancePtr->ChunkSize) {
+			NextSize = InstancePtr->ChunkSize;
+		}
+
+		if (NextSize != 0U) {
+			if (Buffer[1U] != NULL) {
+				BufferIndex ^= 1U;
+			}
+			Status = XSecure_AesChunkCopy(InstancePtr,
+					StartAddrByte + Offset + Size,
+					Buffer[BufferIndex], NextSize);
+			if (XST_SUCCESS != Status) {
+				goto END;
+			}
+		}
+
+		Offset += Size;
+		Size = NextSize;
+	}
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function decrypts a block of a bootgen image and the secure header
+ * following it, which holds the key and IV of the next block. They are
+ * written to the KUP and IV registers.
+ *
+ * @param	InstancePtr Pointer to the XSecure_Aes instance.
+ * @param	Dst 	Pointer to location where decrypted data will be written
+ * @param	Src 	Pointer to encrypted input data
+ * @param	Tag 	Pointer to the GCM tag used for authentication
+ * @param	Len 	Length of the output data expected after decryption.
+ * @param	Flag 	Denotes whether the block is Secure header or data block
+ *					0 : Secure Header
+ *					1 : Data Block / image
+ * @return	returns XST_SUCCESS if GCM tag matching was successful
+ *
+ ******************************************************************************/
+s32 XSecure_AesDecryptBlk(XSecure_Aes *InstancePtr, u8 *Dst,
+			const u8 *Src, const u8 *Tag, u32 Len, u32 Flag)
+{
+	s32 Status;
+	u8 Header[XSECURE_SECURE_HDR_SIZE];
+	const u8 *HeaderSrc;
+	const u8 *TagSrc;
+	u32 StartAddrByte = (u32)(INTPTR)Src;
+
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Tag != NULL);
+	Xil_AssertNonvoid(InstancePtr->AesState != XSECURE_AES_UNINITIALIZED);
+
+	/* Start the message. */
+	XSecure_SwAesStart(InstancePtr->Iv);
+
+	if (Flag != XSECURE_CSU_AES_BLK_TYPE_SECURE_HEADER)
+	{
+		if (InstancePtr->IsChunkingEnabled
+			== XSECURE_CSU_AES_CHUNKING_DISABLED)
+		{
+			XSecure_SwAesRun(Src, Dst, Len, XSECURE_SW_AES_DECRYPT);
+		}
+		else
+		{
+			/* Copy all the chunks to OCM, decrypt & send to PCAP */
+			Status = XSecure_AesChunkDecrypt(InstancePtr, Src, Len);
+			if (XST_SUCCESS != Status)
+			{
+				goto END;
+			}
+			/* update address to point to incoming secure header */
+			StartAddrByte += Len;
+		}
+	}
+
+	/* The Secure header/footer holding next blocks KEY and IV. */
+	if (InstancePtr->IsChunkingEnabled == XSECURE_CSU_AES_CHUNKING_ENABLED)
+	{
+		/* Copy the secure header and GCM tag from flash to OCM */
+		Status = (s32)InstancePtr->DeviceCopy(StartAddrByte,
+				(UINTPTR)(InstancePtr->ReadBuffer),
+				(XSECURE_SECURE_HDR_SIZE
+				+ XSECURE_SECURE_GCM_TAG_SIZE));
+
+		if (XST_SUCCESS != Status)
+		{
+			Status = (s32)XSECURE_CSU_AES_DEVICE_COPY_ERROR;
+			goto END;
+		}
+		HeaderSrc = InstancePtr->ReadBuffer;
+		TagSrc = InstancePtr->ReadBuffer + XSECURE_SECURE_HDR_SIZE;
+	}
+	else
+	{
+		HeaderSrc = Src + Len;
+		TagSrc = Tag;
+	}
+
+	XSecure_SwAesGcm(HeaderSrc, Header, XSECURE_SECURE_HDR_SIZE,
+			XSECURE_SW_AES_DECRYPT);
+	XSecure_SwPutWords(InstancePtr->BaseAddress +
+			XSECURE_CSU_AES_KUP_0_OFFSET, Header,
+			XSECURE_SW_AES_KEY_WORDS);
+	XSecure_SwPutWords(InstancePtr->BaseAddress +
+			XSECURE_CSU_AES_IV_0_OFFSET,
+			&Header[XSECURE_SW_AES_KEY_WORDS * 4U],
+			XSECURE_SECURE_GCM_TAG_SIZE / 4U);
+	(void)memset(Header, 0, sizeof(Header));
+
+	if (XSecure_SwAesTagCheck(TagSrc) != (u32)XST_SUCCESS)
+	{
+		Status = (s32)XSECURE_CSU_AES_GCM_TAG_MISMATCH;
+		goto END;
+	}
+	Status = XST_SUCCESS;
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * @brief
+ * This function will handle the AES-GCM Decryption of a partition encrypted
+ * by bootgen, with a single key or with key rolling.
+ *
+ *	Secure header -->	Dummy AES Key of 32byte +
+ *						Block 0 IV of 12byte +
+ *						DLC for Block 0 of 4byte +
+ *						GCM tag of 16byte(Un-Enc).
+ *	Block N --> Boot Image Data for Block N of n size +
+ *				Block N+1 AES key of 32byte +
+ *				Block N+1 IV of 12byte +
+ *				GCM tag for Block N of 16byte(Un-Enc).
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Aes instance.
+ * @param	Dst 	Pointer to location where decrypted data will be
+ *			written.
+ * @param	Src 	Pointer to encrypted data source location
+ * @param	Length	Expected total length of decrypted image expected.
+ *
+ * @return	returns XST_SUCCESS if successful, or the relevant errorcode.
+ *
+ ******************************************************************************/
+s32 XSecure_AesDecrypt(XSecure_Aes *InstancePtr, u8 *Dst, const u8 *Src,
+			u32 Length)
+{
+	u32 Status;
+	u32 CurrentImgLen = 0x0U;
+	u32 NextBlkLen = 0x0U;
+	u32 PrevBlkLen = 0x0U;
+	u8 *DestAddr;
+	u8 *SrcAddr;
+	u8 *GcmTagAddr;
+	u32 BlockType;
+	u32 KeyClearStatus;
+	u32 DecryptStatus;
+
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Length != 0U);
+	/* Chunking is only for bitstream partitions */
+	Xil_AssertNonvoid((XSECURE_SW_PCAP_DST(Dst)
+				|| (InstancePtr->IsChunkingEnabled
+					== XSECURE_CSU_AES_CHUNKING_DISABLED)));
+	Xil_AssertNonvoid(InstancePtr->AesState != XSECURE_AES_UNINITIALIZED);
+
+	(void)memset(&InstancePtr->ChunkStats, 0,
+			sizeof(InstancePtr->ChunkStats));
+
+	DestAddr = Dst;
+	SrcAddr = (u8 *)Src;
+	GcmTagAddr = SrcAddr + XSECURE_SECURE_HDR_SIZE;
+
+	/* Clear AES contents by reseting it. */
+	XSecure_AesReset(InstancePtr);
+
+	Status = XSecure_SwAesLoadKey(InstancePtr);
+	if (Status != (u32)XST_SUCCESS) {
+		goto ENDF;
+	}
+
+	/* First block is always secure header */
+	BlockType = XSECURE_CSU_AES_BLK_TYPE_SECURE_HEADER;
+	do
+	{
+		PrevBlkLen = NextBlkLen;
+
+		/* Start decryption of Secure-Header/Block/Footer. */
+		Status = (u32)XSecure_AesDecryptBlk(InstancePtr, DestAddr,
+						(const u8 *)SrcAddr,
+						((const u8 *)GcmTagAddr),
+						NextBlkLen, BlockType);
+		if (Status != (u32)XST_SUCCESS)
+		{
+			goto ENDF;
+		}
+
+		/*
+		 * Find the size of next block to be decrypted.
+		 * Size is in 32-bit words so mul it with 4
+		 */
+		NextBlkLen = Xil_Htonl(XSecure_ReadReg(InstancePtr->BaseAddress,
+					XSECURE_CSU_AES_IV_3_OFFSET)) * 4U;
+
+		/* Update the current image size. */
+		CurrentImgLen += NextBlkLen;
+
+		if (0U == NextBlkLen)
+		{
+			if (CurrentImgLen != Length)
+			{
+				Status = (u32)XSECURE_CSU_AES_IMAGE_LEN_MISMATCH;
+			}
+			goto ENDF;
+		}
+
+		if (CurrentImgLen > Length)
+		{
+			Status = (u32)XSECURE_CSU_AES_IMAGE_LEN_MISMATCH;
+			goto ENDF;
+		}
+
+		BlockType = XSECURE_CSU_AES_BLK_TYPE_DATA_BLOCK;
+
+		if (!XSECURE_SW_PCAP_DST(Dst))
+		{
+			DestAddr += PrevBlkLen;
+		}
+		SrcAddr = (GcmTagAddr + XSECURE_SECURE_GCM_TAG_SIZE);
+
+		/* The next blocks are decrypted with the key of the KUP */
+		InstancePtr->KeySel = XSECURE_CSU_AES_KEY_SRC_KUP;
+		Status = XSecure_AesKeySelNLoad(InstancePtr);
+		if (Status != (u32)XST_SUCCESS) {
+			goto ENDF;
+		}
+		/* Point IV to the CSU IV register. */
+		InstancePtr->Iv = (u32 *)(InstancePtr->BaseAddress +
+					(UINTPTR)XSECURE_CSU_AES_IV_0_OFFSET);
+
+		/* Update the GcmTagAddr to get GCM-TAG for next block. */
+		GcmTagAddr = SrcAddr + NextBlkLen + XSECURE_SECURE_HDR_SIZE;
+
+	} while(1);
+
+ENDF:
+	if ((Status != (u32)XST_SUCCESS) && !XSECURE_SW_PCAP_DST(Dst)) {
+		DecryptStatus = Status;
+		/* Zeroize the decrypted data*/
+		Status = XSecure_Zeroize(Dst, Length);
+		if (Status != (u32)XST_SUCCESS) {
+			Status = (u32)XSECURE_CSU_AES_ZEROIZATION_ERROR |
+					DecryptStatus;
+		}
+		else {
+			Status = DecryptStatus;
+		}
+	}
+	KeyClearStatus = XSecure_AesKeyZero(InstancePtr);
+	if (KeyClearStatus != (u32)XST_SUCCESS) {
+		Status = Status | KeyClearStatus;
+	}
+
+	return (s32)Status;
+}
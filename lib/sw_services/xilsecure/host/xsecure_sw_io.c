@@ -0,0 +1,200 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsecure_sw_io.c
+*
+* Register emulation and platform functions of the xilsecure software
+* backend, see xsecure_sw.h.
+*
+* The registers are kept in a small open addressing table, the eFUSE and
+* CSU registers read by the FSBL are set up by the host program with
+* Xil_Out32().
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "xil_io.h"
+#include "xplatform_info.h"
+#include "xtime_l.h"
+#include "xsecure_sw.h"
+
+/************************** Constant Definitions *****************************/
+#define XSECURE_SW_REG_COUNT	(1024U)	/**< Power of two */
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u32 Addr; /**< Word address, 0 for an unused entry */
+	u32 Value;
+} XSecure_SwReg;
+
+/************************** Variable Definitions *****************************/
+static XSecure_SwReg SwRegs[XSECURE_SW_REG_COUNT];
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+ * Returns the entry of an emulated register.
+ *
+ * @param	Addr	Register address.
+ * @param	Create	TRUE to add the register if it is not in the table.
+ *
+ * @return	Entry of the register, or NULL if it was never written and
+ *		Create is FALSE.
+ *
+ ******************************************************************************/
+static XSecure_SwReg *XSecure_SwRegLookup(UINTPTR Addr, u32 Create)
+{
+	u32 WordAddr = (u32)Addr & ~3U;
+	u32 Index = (WordAddr >> 2) * 2654435761U;
+	u32 Count;
+	XSecure_SwReg *Reg = NULL;
+
+	for (Count = 0U; Count < XSECURE_SW_REG_COUNT; Count++) {
+		Index &= XSECURE_SW_REG_COUNT - 1U;
+		if (SwRegs[Index].Addr == WordAddr) {
+			Reg = &SwRegs[Index];
+			break;
+		}
+		if (SwRegs[Index].Addr == 0U) {
+			if (Create == TRUE) {
+				SwRegs[Index].Addr = WordAddr;
+				Reg = &SwRegs[Index];
+			}
+			break;
+		}
+		Index++;
+	}
+	if ((Reg == NULL) && (Create == TRUE)) {
+		fprintf(stderr, "xsecure_sw: register table full\n");
+		abort();
+	}
+
+	return Reg;
+}
+
+/*****************************************************************************/
+/**
+ * Clears all the emulated registers.
+ *
+ ******************************************************************************/
+void XSecure_SwRegReset(void)
+{
+	(void)memset(SwRegs, 0, sizeof(SwRegs));
+}
+
+u32 Xil_In32(UINTPTR Addr)
+{
+	const XSecure_SwReg *Reg;
+
+	if (!XSECURE_SW_IS_REG(Addr)) {
+		return *(volatile u32 *)Addr;
+	}
+	Reg = XSecure_SwRegLookup(Addr, FALSE);
+
+	return (Reg != NULL) ? Reg->Value : 0U;
+}
+
+void Xil_Out32(UINTPTR Addr, u32 Value)
+{
+	if (!XSECURE_SW_IS_REG(Addr)) {
+		*(volatile u32 *)Addr = Value;
+	}
+	else {
+		XSecure_SwRegLookup(Addr, TRUE)->Value = Value;
+	}
+}
+
+u16 Xil_In16(UINTPTR Addr)
+{
+	if (!XSECURE_SW_IS_REG(Addr)) {
+		return *(volatile u16 *)Addr;
+	}
+
+	return (u16)(Xil_In32(Addr) >> ((Addr & 2U) * 8U));
+}
+
+u8 Xil_In8(UINTPTR Addr)
+{
+	if (!XSECURE_SW_IS_REG(Addr)) {
+		return *(volatile u8 *)Addr;
+	}
+
+	return (u8)(Xil_In32(Addr) >> ((Addr & 3U) * 8U));
+}
+
+void Xil_Out16(UINTPTR Addr, u16 Value)
+{
+	u32 Shift = (Addr & 2U) * 8U;
+
+	if (!XSECURE_SW_IS_REG(Addr)) {
+		*(volatile u16 *)Addr = Value;
+	}
+	else {
+		Xil_Out32(Addr, (Xil_In32(Addr) & ~(0xFFFFU << Shift)) |
+				((u32)Value << Shift));
+	}
+}
+
+void Xil_Out8(UINTPTR Addr, u8 Value)
+{
+	u32 Shift = (Addr & 3U) * 8U;
+
+	if (!XSECURE_SW_IS_REG(Addr)) {
+		*(volatile u8 *)Addr = Value;
+	}
+	else {
+		Xil_Out32(Addr, (Xil_In32(Addr) & ~(0xFFU << Shift)) |
+				((u32)Value << Shift));
+	}
+}
+
+u32 XGetPlatform_Info(void)
+{
+	return XPLAT_ZYNQ_ULTRA_MP;
+}
+
+u32 XGetPSVersion_Info(void)
+{
+	return (Xil_In32(XPLAT_PS_VERSION_ADDRESS) & XPS_VERSION_INFO_MASK) >>
+			XPS_VERSION_INFO_SHIFT;
+}
+
+void XTime_GetTime(XTime *Xtime_Global)
+{
+	struct timespec Ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &Ts);
+	*Xtime_Global = ((u64)Ts.tv_sec * COUNTS_PER_SECOND) + (u64)Ts.tv_nsec;
+}
@@ -0,0 +1,351 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsecure_sw_rsa_core.c
+*
+* Software emulation of the CSU RSA core, implementing the API of
+* xsecure_rsa_core.h for the Linux host build, see xsecure_sw.h.
+*
+* The modular exponentiation uses Montgomery multiplication (CIOS) on 32-bit
+* limbs. R^2 mod N is derived from the modulus, so the ModExt of the
+* instance is not used. An even modulus, or one shorter than the key size,
+* makes the operation fail.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xsecure_rsa_core.h"
+#include "xsecure_rsa_hw.h"
+#include "xsecure_sw.h"
+
+/************************** Constant Definitions *****************************/
+#define XSECURE_SW_RSA_MAX_WORDS	(XSECURE_RSA_4096_SIZE_WORDS)
+
+/**************************** Type Definitions *******************************/
+/** Modulus of an operation, as little endian 32-bit limbs */
+typedef struct {
+	u32 N[XSECURE_SW_RSA_MAX_WORDS];
+	u32 NInv; /**< -N^-1 mod 2^32 */
+	u32 Words;
+} XSecure_SwRsaMod;
+
+/************************** Function Prototypes ******************************/
+static void XSecure_SwRsaLoad(u32 *Dst, const u8 *Src, u32 Bytes, u32 Words);
+static void XSecure_SwRsaStore(u8 *Dst, const u32 *Src, u32 Words);
+static void XSecure_SwRsaSubN(const XSecure_SwRsaMod *Mod, u32 *Val,
+		u32 Carry);
+static void XSecure_SwRsaMontMul(const XSecure_SwRsaMod *Mod, u32 *Res,
+		const u32 *A, const u32 *B);
+static void XSecure_SwRsaRR(const XSecure_SwRsaMod *Mod, u32 *RR);
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+ * Converts a big endian number to little endian limbs.
+ *
+ * @param	Dst	Limbs, Words of them.
+ * @param	Src	Big endian number.
+ * @param	Bytes	Length of Src in bytes, at most Words * 4.
+ * @param	Words	Number of limbs.
+ *
+ ******************************************************************************/
+static void XSecure_SwRsaLoad(u32 *Dst, const u8 *Src, u32 Bytes, u32 Words)
+{
+	u32 Index;
+
+	(void)memset(Dst, 0, Words * 4U);
+	for (Index = 0U; Index < Bytes; Index++) {
+		Dst[Index / 4U] |= (u32)Src[Bytes - 1U - Index] <<
+			((Index % 4U) * 8U);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Converts little endian limbs to a big endian number.
+ *
+ * @param	Dst	Big endian number of Words * 4 bytes.
+ * @param	Src	Limbs.
+ * @param	Words	Number of limbs.
+ *
+ ******************************************************************************/
+static void XSecure_SwRsaStore(u8 *Dst, const u32 *Src, u32 Words)
+{
+	u32 Index;
+	u32 Bytes = Words * 4U;
+
+	for (Index = 0U; Index < Bytes; Index++) {
+		Dst[Bytes - 1U - Index] = (u8)(Src[Index / 4U] >>
+				((Index % 4U) * 8U));
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Subtracts the modulus if Carry:Val is not below it.
+ *
+ * @param	Mod	Modulus.
+ * @param	Val	Value, Mod->Words limbs, reduced in place.
+ * @param	Carry	Limb above Val.
+ *
+ ******************************************************************************/
+static void XSecure_SwRsaSubN(const XSecure_SwRsaMod *Mod, u32 *Val, u32 Carry)
+{
+	u32 Diff[XSECURE_SW_RSA_MAX_WORDS];
+	u64 Borrow = 0U;
+	u64 Tmp;
+	u32 Index;
+
+	for (Index = 0U; Index < Mod->Words; Index++) {
+		Tmp = (u64)Val[Index] - Mod->N[Index] - Borrow;
+		Diff[Index] = (u32)Tmp;
+		Borrow = (Tmp >> 32) & 1U;
+	}
+	if ((Carry != 0U) || (Borrow == 0U)) {
+		(void)memcpy(Val, Diff, Mod->Words * 4U);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Montgomery multiplication, Res = A * B / R mod N with R = 2^(32 * Words).
+ *
+ * @param	Mod	Modulus.
+ * @param	Res	Result, may be A or B.
+ * @param	A	First factor, below R.
+ * @param	B	Second factor, below N.
+ *
+ ******************************************************************************/
+static void XSecure_SwRsaMontMul(const XSecure_SwRsaMod *Mod, u32 *Res,
+		const u32 *A, const u32 *B)
+{
+	u32 Tmp[XSECURE_SW_RSA_MAX_WORDS + 2U];
+	u32 Words = Mod->Words;
+	u64 Acc;
+	u32 Carry;
+	u32 Factor;
+	u32 Outer;
+	u32 Index;
+
+	(void)memset(Tmp, 0, (Words + 2U) * 4U);
+
+	for (Outer = 0U; Outer < Words; Outer++) {
+		/* Tmp += A * B[Outer] */
+		Carry = 0U;
+		for (Index = 0U; Index < Words; Index++) {
+			Acc = (u64)A[Index] * B[Outer] + Tmp[Index] + Carry;
+			Tmp[Index] = (u32)Acc;
+			Carry = (u32)(Acc >> 32);
+		}
+		Acc = (u64)Tmp[Words] + Carry;
+		Tmp[Words] = (u32)Acc;
+		Tmp[Words + 1U] = (u32)(Acc >> 32);
+
+		/* Tmp = (Tmp + Factor * N) / 2^32 */
+		Factor = Tmp[0] * Mod->NInv;
+		Acc = (u64)Factor * Mod->N[0] + Tmp[0];
+		Carry = (u32)(Acc >> 32);
+		for (Index = 1U; Index < Words; Index++) {
+			Acc = (u64)Factor * Mod->N[Index] + Tmp[Index] + Carry;
+			Tmp[Index - 1U] = (u32)Acc;
+			Carry = (u32)(Acc >> 32);
+		}
+		Acc = (u64)Tmp[Words] + Carry;
+		Tmp[Words - 1U] = (u32)Acc;
+		Tmp[Words] = Tmp[Words + 1U] + (u32)(Acc >> 32);
+	}
+
+	XSecure_SwRsaSubN(Mod, Tmp, Tmp[Words]);
+	(void)memcpy(Res, Tmp, Words * 4U);
+}
+
+/*****************************************************************************/
+/**
+ * Computes R^2 mod N. R * 2^Odd mod N is built by doubling, with Odd the
+ * odd part of the bit length of R, and then squared into R^2 mod N.
+ *
+ * @param	Mod	Modulus.
+ * @param	RR	Buffer for R^2 mod N.
+ *
+ ******************************************************************************/
+static void XSecure_SwRsaRR(const XSecure_SwRsaMod *Mod, u32 *RR)
+{
+	u32 Words = Mod->Words;
+	u32 Bits = Words * 32U;
+	u32 Squares = 0U;
+	u32 Carry;
+	u32 Index;
+	u32 Count;
+
+	while ((Bits & 1U) == 0U) {
+		Bits >>= 1;
+		Squares++;
+	}
+
+	/* R mod N = (2^(32 * Words) - N) mod N, N has its top limb set */
+	Carry = 1U;
+	for (Index = 0U; Index < Words; Index++) {
+		u64 Tmp = (u64)(u32)~Mod->N[Index] + Carry;
+		RR[Index] = (u32)Tmp;
+		Carry = (u32)(Tmp >> 32);
+	}
+	XSecure_SwRsaSubN(Mod, RR, 0U);
+
+	for (Count = 0U; Count < Bits; Count++) {
+		Carry = RR[Words - 1U] >> 31;
+		for (Index = Words - 1U; Index > 0U; Index--) {
+			RR[Index] = (RR[Index] << 1) | (RR[Index - 1U] >> 31);
+		}
+		RR[0] <<= 1;
+		XSecure_SwRsaSubN(Mod, RR, Carry);
+	}
+
+	/* Each square doubles the power of two above R */
+	for (Count = 0U; Count < Squares; Count++) {
+		XSecure_SwRsaMontMul(Mod, RR, RR, RR);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+* This function stores the base address of RSA core registers.
+*
+* @param	InstancePtr	Pointer to the XSecure_Rsa instance.
+*
+* @return	XST_SUCCESS on success.
+*
+******************************************************************************/
+u32 XSecure_RsaCfgInitialize(XSecure_Rsa *InstancePtr)
+{
+	InstancePtr->BaseAddress = XSECURE_CSU_RSA_BASE;
+
+	return (u32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+* This function handles the all RSA operations with provided inputs.
+*
+* @param	InstancePtr	Pointer to the XSecure_Rsa instance.
+* @param	Input		Pointer to the buffer which contains the input
+*		data to be decrypted.
+* @param	Result		Pointer to the buffer where resultant decrypted
+*		data to be stored.
+* @param	EncDecFlag	XSECURE_RSA_SIGN_ENC for the 32-bit public
+*		exponent, XSECURE_RSA_SIGN_DEC for an exponent of Size bytes.
+* @param	Size		Key size in bytes.
+*
+* @return	XST_SUCCESS on success, XST_FAILURE for an even modulus or
+*		one shorter than Size.
+*
+******************************************************************************/
+u32 XSecure_RsaOperation(XSecure_Rsa *InstancePtr, u8 *Input,
+			u8 *Result, u8 EncDecFlag, u32 Size)
+{
+	static XSecure_SwRsaMod Mod;
+	u32 Base[XSECURE_SW_RSA_MAX_WORDS];
+	u32 Acc[XSECURE_SW_RSA_MAX_WORDS];
+	u32 One[XSECURE_SW_RSA_MAX_WORDS];
+	u32 ExpoLen;
+	u32 Index;
+	u32 Inv;
+	s32 Bit;
+	u8 Started = FALSE;
+	u32 Status = (u32)XST_FAILURE;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Input != NULL);
+	Xil_AssertNonvoid(Result != NULL);
+	Xil_AssertNonvoid((EncDecFlag == XSECURE_RSA_SIGN_ENC) ||
+			(EncDecFlag == XSECURE_RSA_SIGN_DEC));
+	Xil_AssertNonvoid((Size == XSECURE_RSA_512_KEY_SIZE) ||
+			(Size == XSECURE_RSA_576_KEY_SIZE) ||
+			(Size == XSECURE_RSA_704_KEY_SIZE) ||
+			(Size == XSECURE_RSA_768_KEY_SIZE) ||
+			(Size == XSECURE_RSA_992_KEY_SIZE) ||
+			(Size == XSECURE_RSA_1024_KEY_SIZE) ||
+			(Size == XSECURE_RSA_1152_KEY_SIZE) ||
+			(Size == XSECURE_RSA_1408_KEY_SIZE) ||
+			(Size == XSECURE_RSA_1536_KEY_SIZE) ||
+			(Size == XSECURE_RSA_1984_KEY_SIZE) ||
+			(Size == XSECURE_RSA_2048_KEY_SIZE) ||
+			(Size == XSECURE_RSA_3072_KEY_SIZE) ||
+			(Size == XSECURE_RSA_4096_KEY_SIZE));
+
+	InstancePtr->EncDec = EncDecFlag;
+	InstancePtr->SizeInWords = Size/4U;
+	Mod.Words = InstancePtr->SizeInWords;
+
+	XSecure_SwRsaLoad(Mod.N, InstancePtr->Mod, Size, Mod.Words);
+	if (((Mod.N[0] & 1U) == 0U) || ((Mod.N[Mod.Words - 1U] >> 31) == 0U)) {
+		goto END;
+	}
+
+	/* Newton iteration, each step doubles the correct low bits */
+	Inv = Mod.N[0];
+	for (Index = 0U; Index < 4U; Index++) {
+		Inv *= 2U - (Mod.N[0] * Inv);
+	}
+	Mod.NInv = (u32)0U - Inv;
+
+	/* Base = Input * R mod N, Acc = R mod N */
+	XSecure_SwRsaRR(&Mod, Acc);
+	XSecure_SwRsaLoad(Base, Input, Size, Mod.Words);
+	XSecure_SwRsaMontMul(&Mod, Base, Base, Acc);
+	(void)memset(One, 0, Mod.Words * 4U);
+	One[0] = 1U;
+	XSecure_SwRsaMontMul(&Mod, Acc, Acc, One);
+
+	ExpoLen = (EncDecFlag == XSECURE_RSA_SIGN_ENC) ? 4U : Size;
+	for (Index = 0U; Index < ExpoLen; Index++) {
+		for (Bit = 7; Bit >= 0; Bit--) {
+			if (Started == TRUE) {
+				XSecure_SwRsaMontMul(&Mod, Acc, Acc, Acc);
+			}
+			if (((InstancePtr->ModExpo[Index] >> Bit) & 1U) != 0U) {
+				XSecure_SwRsaMontMul(&Mod, Acc, Acc, Base);
+				Started = TRUE;
+			}
+		}
+	}
+
+	/* Back from the Montgomery domain */
+	XSecure_SwRsaMontMul(&Mod, Acc, Acc, One);
+	XSecure_SwRsaStore(Result, Acc, Mod.Words);
+
+	(void)memset(Base, 0, sizeof(Base));
+	(void)memset(Acc, 0, sizeof(Acc));
+	Status = (u32)XST_SUCCESS;
+END:
+	return Status;
+}
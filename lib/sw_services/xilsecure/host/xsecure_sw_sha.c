@@ -0,0 +1,613 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsecure_sw_sha.c
+*
+* Software emulation of the CSU SHA3 engine, implementing the API of
+* xsecure_sha.h for the Linux host build, see xsecure_sw.h.
+*
+* The engine absorbs the data stream in blocks of 104 bytes, as the CSU
+* does. The driver functions pad the message in the same way as
+* xsecure_sha.c, so NIST SHA3-384 and Keccak-384 give the digests of the
+* target. Transfers complete immediately, XSecure_Sha3SgStart() hashes the
+* whole list and XSecure_Sha3SgPoll() never reports XST_DEVICE_BUSY.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xsecure_sha.h"
+#include "xsecure_sw.h"
+
+/************************** Constant Definitions *****************************/
+#define XSECURE_CSU_SHA3_HASH_LENGTH_IN_BYTES	(48U)
+
+/* Keccak and Nist padding masks */
+#define XSECURE_CSU_SHA3_START_KECCAK_PADDING_MASK    (0x01U)
+#define XSECURE_CSU_SHA3_END_KECCAK_PADDING_MASK      (0x80U)
+#define XSECURE_CSU_SHA3_START_NIST_PADDING_MASK      (0x06U)
+#define XSECURE_CSU_SHA3_END_NIST_PADDING_MASK        (0x80U)
+
+#define XSECURE_SW_KECCAK_ROUNDS	(24U)
+
+/**************************** Type Definitions *******************************/
+/** State of the emulated SHA3 engine */
+typedef struct {
+	u64 Lane[25]; /**< Keccak-f[1600] state */
+	u8 Block[XSECURE_SHA3_BLOCK_LEN]; /**< Received part of a block */
+	u32 BlockLen; /**< Bytes in Block */
+} XSecure_SwSha3Engine;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+#define XSECURE_SW_ROL64(Val, Shift) \
+	(((Val) << (Shift)) | ((Val) >> ((64U - (Shift)) & 63U)))
+
+/************************** Function Prototypes ******************************/
+static void XSecure_SwKeccakF1600(u64 *Lane);
+static void XSecure_SwSha3Absorb(const u8 *Data, u32 Size);
+static void XSecure_SwSha3Pad(u8 *Dst, u32 Len, u8 Start, u8 End);
+
+/************************** Variable Definitions *****************************/
+static const u64 XSecure_SwKeccakRc[XSECURE_SW_KECCAK_ROUNDS] = {
+	0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL,
+	0x8000000080008000ULL, 0x000000000000808BULL, 0x0000000080000001ULL,
+	0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008AULL,
+	0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+	0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL,
+	0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+	0x000000000000800AULL, 0x800000008000000AULL, 0x8000000080008081ULL,
+	0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+/* Rotation and destination lane of the combined rho and pi steps */
+static const u8 XSecure_SwKeccakRho[24] = {
+	1U, 3U, 6U, 10U, 15U, 21U, 28U, 36U, 45U, 55U, 2U, 14U,
+	27U, 41U, 56U, 8U, 25U, 43U, 62U, 18U, 39U, 61U, 20U, 44U
+};
+
+static const u8 XSecure_SwKeccakPi[24] = {
+	10U, 7U, 11U, 17U, 18U, 3U, 5U, 16U, 8U, 21U, 24U, 4U,
+	15U, 23U, 19U, 13U, 12U, 2U, 20U, 14U, 22U, 9U, 6U, 1U
+};
+
+static XSecure_SwSha3Engine Sha3Engine;
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+ * Keccak-f[1600] permutation.
+ *
+ * @param	Lane	The 25 lanes of the state.
+ *
+ ******************************************************************************/
+static void XSecure_SwKeccakF1600(u64 *Lane)
+{
+	u64 Col[5];
+	u64 Tmp;
+	u64 Cur;
+	u32 Round;
+	u32 Index;
+	u32 Row;
+
+	for (Round = 0U; Round < XSECURE_SW_KECCAK_ROUNDS; Round++) {
+		/* Theta */
+		for (Index = 0U; Index < 5U; Index++) {
+			Col[Index] = Lane[Index] ^ Lane[Index + 5U] ^
+				Lane[Index + 10U] ^ Lane[Index + 15U] ^
+				Lane[Index + 20U];
+		}
+		for (Index = 0U; Index < 5U; Index++) {
+			Tmp = Col[(Index + 4U) % 5U] ^
+				XSECURE_SW_ROL64(Col[(Index + 1U) % 5U], 1U);
+			for (Row = 0U; Row < 25U; Row += 5U) {
+				Lane[Row + Index] ^= Tmp;
+			}
+		}
+
+		/* Rho and pi */
+		Cur = Lane[1];
+		for (Index = 0U; Index < 24U; Index++) {
+			Tmp = Lane[XSecure_SwKeccakPi[Index]];
+			Lane[XSecure_SwKeccakPi[Index]] =
+				XSECURE_SW_ROL64(Cur, XSecure_SwKeccakRho[Index]);
+			Cur = Tmp;
+		}
+
+		/* Chi */
+		for (Row = 0U; Row < 25U; Row += 5U) {
+			for (Index = 0U; Index < 5U; Index++) {
+				Col[Index] = Lane[Row + Index];
+			}
+			for (Index = 0U; Index < 5U; Index++) {
+				Lane[Row + Index] ^= (~Col[(Index + 1U) % 5U]) &
+					Col[(Index + 2U) % 5U];
+			}
+		}
+
+		/* Iota */
+		Lane[0] ^= XSecure_SwKeccakRc[Round];
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Absorbs a byte stream into the emulated engine, as the CSU DMA feeds it.
+ *
+ * @param	Data	Data to be absorbed.
+ * @param	Size	Size of the data in bytes.
+ *
+ ******************************************************************************/
+static void XSecure_SwSha3Absorb(const u8 *Data, u32 Size)
+{
+	XSecure_SwSha3Engine *Engine = &Sha3Engine;
+	u32 Len;
+	u32 Index;
+	u64 Word;
+	u32 Byte;
+
+	while (Size > 0U) {
+		Len = XSECURE_SHA3_BLOCK_LEN - Engine->BlockLen;
+		if (Len > Size) {
+			Len = Size;
+		}
+
+		if ((Engine->BlockLen == 0U) && (Len == XSECURE_SHA3_BLOCK_LEN)) {
+			/* Whole block straight from the source */
+			for (Index = 0U; Index < (XSECURE_SHA3_BLOCK_LEN / 8U);
+					Index++) {
+				Word = 0U;
+				for (Byte = 0U; Byte < 8U; Byte++) {
+					Word |= (u64)Data[(Index * 8U) + Byte] <<
+						(Byte * 8U);
+				}
+				Engine->Lane[Index] ^= Word;
+			}
+			XSecure_SwKeccakF1600(Engine->Lane);
+		}
+		else {
+			(void)memcpy(&Engine->Block[Engine->BlockLen], Data, Len);
+			Engine->BlockLen += Len;
+			if (Engine->BlockLen == XSECURE_SHA3_BLOCK_LEN) {
+				Engine->BlockLen = 0U;
+				XSecure_SwSha3Absorb(Engine->Block,
+						XSECURE_SHA3_BLOCK_LEN);
+			}
+		}
+
+		Data += Len;
+		Size -= Len;
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Fills the padding of the last block, as XSecure_Sha3NistPadd() and
+ * XSecure_Sha3KeccakPadd() of xsecure_sha.c.
+ *
+ * @param	Dst	Buffer for the padding.
+ * @param	Len	Length of the padding in bytes.
+ * @param	Start	Mask of the first padding byte.
+ * @param	End	Mask of the last padding byte.
+ *
+ ******************************************************************************/
+static void XSecure_SwSha3Pad(u8 *Dst, u32 Len, u8 Start, u8 End)
+{
+	(void)memset(Dst, 0, Len);
+	Dst[0] = Start;
+	Dst[Len - 1U] |= End;
+}
+
+/****************************************************************************/
+/**
+* @brief
+* This function initializes a specific Xsecure_Sha3 instance so that it is
+* ready to be used.
+*
+* @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+* @param	CsuDmaPtr 	Pointer to the XCsuDma instance.
+*
+* @return	XST_SUCCESS if initialization was successful
+*
+* @note		By default uses NIST SHA3 padding, to change to KECCAK
+*		padding call XSecure_Sha3PadSelection() after
+*		XSecure_Sha3Initialize().
+*
+*****************************************************************************/
+s32 XSecure_Sha3Initialize(XSecure_Sha3 *InstancePtr, XCsuDma* CsuDmaPtr)
+{
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(CsuDmaPtr != NULL);
+
+	InstancePtr->BaseAddress = XSECURE_CSU_SHA3_BASE;
+	InstancePtr->Sha3Len = 0U;
+	InstancePtr->CsuDmaPtr = CsuDmaPtr;
+	InstancePtr->Sha3PadType = XSECURE_CSU_NIST_SHA3;
+	InstancePtr->IsLastUpdate = FALSE;
+	InstancePtr->PartialLen = 0U;
+	InstancePtr->SgList = NULL;
+	InstancePtr->SgCount = 0U;
+	InstancePtr->SgIndex = 0U;
+	InstancePtr->SgOffset = 0U;
+	InstancePtr->SgDmaBusy = FALSE;
+
+	XSecure_SssInitialize(&(InstancePtr->SssInstance));
+
+	InstancePtr->Sha3State = XSECURE_SHA3_INITIALIZED;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function provides an option to select the SHA-3 padding type to be used
+ * while calculating the hash.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Sha3 instance.
+ * @param	Sha3Type 	Type of the sha3 padding to be used.
+ * 			 - For NIST SHA-3 padding - XSECURE_CSU_NIST_SHA3
+ * 			 - For KECCAK SHA-3 padding - XSECURE_CSU_KECCAK_SHA3
+ *
+ * @return	XST_SUCCESS, or XST_FAILURE if data was already hashed.
+ *
+ ******************************************************************************/
+s32 XSecure_Sha3PadSelection(XSecure_Sha3 *InstancePtr,
+		XSecure_Sha3PadType Sha3PadType)
+{
+	s32 Status;
+
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid((Sha3PadType == XSECURE_CSU_NIST_SHA3)
+			|| (Sha3PadType == XSECURE_CSU_KECCAK_SHA3));
+	Xil_AssertNonvoid((InstancePtr->Sha3State == XSECURE_SHA3_INITIALIZED) ||
+			(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED));
+
+	/* If operation is in between can't be modified */
+	if (InstancePtr->Sha3Len != 0x00U) {
+		Status = (s32)XST_FAILURE;
+		goto END;
+	}
+	InstancePtr->Sha3PadType = Sha3PadType;
+	Status = XST_SUCCESS;
+END:
+	return Status;
+}
+
+/****************************************************************************/
+/**
+ * @brief
+ * This function is to notify this is the last update of data where sha padding
+ * is also been included along with the data in the next update call.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ *
+ * @return	XST_SUCCESS
+ *
+ *****************************************************************************/
+s32 XSecure_Sha3LastUpdate(XSecure_Sha3 *InstancePtr)
+{
+	InstancePtr->IsLastUpdate = TRUE;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function resets the SHA3 engine and starts a new hash.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ *
+ ******************************************************************************/
+void XSecure_Sha3Start(XSecure_Sha3 *InstancePtr)
+{
+	/* Asserts validate the input arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->Sha3State == XSECURE_SHA3_INITIALIZED);
+
+	InstancePtr->Sha3Len = 0U;
+	InstancePtr->PartialLen = 0U;
+	InstancePtr->SgList = NULL;
+	InstancePtr->SgCount = 0U;
+	InstancePtr->SgIndex = 0U;
+	InstancePtr->SgOffset = 0U;
+	InstancePtr->SgDmaBusy = FALSE;
+
+	(void)memset(&Sha3Engine, 0, sizeof(Sha3Engine));
+	InstancePtr->Sha3State = XSECURE_SHA3_ENGINE_STARTED;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function updates hash for new input data block.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ * @param	Data 		Pointer to the input data for hashing.
+ * @param	Size 		Size of the input data in bytes.
+ *
+ * @return	XST_SUCCESS
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3Update(XSecure_Sha3 *InstancePtr, const u8 *Data,
+						const u32 Size)
+{
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Size > (u32)0x00U);
+	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED);
+	Xil_AssertNonvoid(InstancePtr->SgDmaBusy == FALSE);
+
+	InstancePtr->Sha3Len += Size;
+	XSecure_SwSha3Absorb(Data, Size);
+	InstancePtr->IsLastUpdate = FALSE;
+
+	return (u32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function hashes a scatter gather list of segments. The emulated
+ * transfers complete before the function returns.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ * @param	SgList 		Pointer to the list of segments to be hashed.
+ * @param	SgCount 	Number of segments in the list.
+ *
+ * @return	- XST_SUCCESS if the list is hashed
+ *		- XST_DEVICE_BUSY if a previous list is not completed
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3SgStart(XSecure_Sha3 *InstancePtr,
+		const XSecure_Sha3Segment *SgList, u32 SgCount)
+{
+	u32 Status;
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(SgList != NULL);
+	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED);
+
+	if (InstancePtr->SgDmaBusy == TRUE) {
+		Status = (u32)XST_DEVICE_BUSY;
+		goto END;
+	}
+
+	InstancePtr->SgList = SgList;
+	InstancePtr->SgCount = SgCount;
+	for (InstancePtr->SgIndex = 0U; InstancePtr->SgIndex < SgCount;
+			InstancePtr->SgIndex++) {
+		InstancePtr->Sha3Len += SgList[InstancePtr->SgIndex].Size;
+		XSecure_SwSha3Absorb(
+			(const u8 *)SgList[InstancePtr->SgIndex].Addr,
+			SgList[InstancePtr->SgIndex].Size);
+	}
+	InstancePtr->SgOffset = 0U;
+	InstancePtr->IsLastUpdate = FALSE;
+	Status = (u32)XST_SUCCESS;
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function checks the transfer of a scatter gather list.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ *
+ * @return	XST_SUCCESS, the emulated transfers are always done
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3SgPoll(XSecure_Sha3 *InstancePtr)
+{
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return (u32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function waits till all the segments of the list submitted by
+ * XSecure_Sha3SgStart() are transferred.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ *
+ * @return	XST_SUCCESS
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3SgWait(XSecure_Sha3 *InstancePtr)
+{
+	return XSecure_Sha3SgPoll(InstancePtr);
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function updates hash for a scatter gather list of segments.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ * @param	SgList 		Pointer to the list of segments to be hashed.
+ * @param	SgCount 	Number of segments in the list.
+ *
+ * @return	- XST_SUCCESS if all the segments of the list are hashed
+ *		- XST_DEVICE_BUSY if a previous list is not completed
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3SgUpdate(XSecure_Sha3 *InstancePtr,
+		const XSecure_Sha3Segment *SgList, u32 SgCount)
+{
+	u32 Status;
+
+	Status = XSecure_Sha3SgStart(InstancePtr, SgList, SgCount);
+	if (Status != (u32)XST_SUCCESS) {
+		goto END;
+	}
+	Status = XSecure_Sha3SgWait(InstancePtr);
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function waits till SHA3 completes its action.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ *
+ * @return	XST_SUCCESS
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3WaitForDone(XSecure_Sha3 *InstancePtr)
+{
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return (u32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function sends the padding and reads the hash.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Sha3 instance.
+ * @param	Hash		Pointer to location where resulting hash will
+ *		be written, or NULL
+ *
+ * @return	XST_SUCCESS, or XST_FAILURE for an invalid padding type
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3Finish(XSecure_Sha3 *InstancePtr, u8 *Hash)
+{
+	u8 Padding[XSECURE_SHA3_BLOCK_LEN];
+	u32 PartialLen;
+	u32 Status;
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Hash != NULL);
+	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED);
+	Xil_AssertNonvoid(InstancePtr->SgDmaBusy == FALSE);
+
+	PartialLen = InstancePtr->Sha3Len % XSECURE_SHA3_BLOCK_LEN;
+
+	PartialLen = (PartialLen == 0U)?(XSECURE_SHA3_BLOCK_LEN) :
+		(XSECURE_SHA3_BLOCK_LEN - PartialLen);
+
+	if (InstancePtr->Sha3PadType == XSECURE_CSU_NIST_SHA3) {
+		XSecure_SwSha3Pad(Padding, PartialLen,
+				XSECURE_CSU_SHA3_START_NIST_PADDING_MASK,
+				XSECURE_CSU_SHA3_END_NIST_PADDING_MASK);
+	}
+	else if (InstancePtr->Sha3PadType == XSECURE_CSU_KECCAK_SHA3) {
+		XSecure_SwSha3Pad(Padding, PartialLen,
+				XSECURE_CSU_SHA3_START_KECCAK_PADDING_MASK,
+				XSECURE_CSU_SHA3_END_KECCAK_PADDING_MASK);
+	}
+	else {
+		Status = XST_FAILURE;
+		goto END;
+	}
+
+	XSecure_SwSha3Absorb(Padding, PartialLen);
+
+	if (Hash != NULL) {
+		XSecure_Sha3_ReadHash(InstancePtr, Hash);
+	}
+	Status = (u32)XST_SUCCESS;
+END:
+	InstancePtr->Sha3State = XSECURE_SHA3_INITIALIZED;
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function calculates the SHA-3 digest on the given input data.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Sha3 instance.
+ * @param	In		Pointer to the input data for hashing
+ * @param	Size		Size of the input data
+ * @param	Out		Pointer to location where resulting hash will
+ *		be written.
+ *
+ * @return	XST_SUCCESS, or the error of XSecure_Sha3Finish()
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3Digest(XSecure_Sha3 *InstancePtr, const u8 *In, const u32 Size,
+								u8 *Out)
+{
+	u32 Status;
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Size > (u32)0x00U);
+	Xil_AssertNonvoid(Out != NULL);
+
+	XSecure_Sha3Start(InstancePtr);
+	Status = XSecure_Sha3Update(InstancePtr, In, Size);
+	if (Status != (u32)XST_SUCCESS){
+		goto END;
+	}
+	Status = XSecure_Sha3Finish(InstancePtr, Out);
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * Reads the SHA3 hash from the engine state. It can be called between
+ * updates as well.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Sha3 instance.
+ * @param	Hash		Pointer to a buffer in which read hash will be
+ *		stored.
+ *
+ ******************************************************************************/
+void XSecure_Sha3_ReadHash(XSecure_Sha3 *InstancePtr, u8 *Hash)
+{
+	u32 Index;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(Hash != NULL);
+
+	for (Index = 0U; Index < XSECURE_CSU_SHA3_HASH_LENGTH_IN_BYTES;
+			Index++) {
+		Hash[Index] = (u8)(Sha3Engine.Lane[Index / 8U] >>
+				((Index % 8U) * 8U));
+	}
+}
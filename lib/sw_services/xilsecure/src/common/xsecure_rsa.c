@@ -345,3 +345,54 @@ s32 XSecure_RsaPrivateDecrypt(XSecure_Rsa *InstancePtr, u8 *Input, u32 Size,
 
 	return Status;
 }
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function verifies a PKCS#1 v1.5 signature with the public key of
+ * XSecure_RsaInitialize().
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Rsa instance.
+ * @param	Signature	Pointer to the signature, of key size.
+ * @param	Hash		Pointer to the hash of the signed data.
+ * @param	HashLen		Length of Hash used, 48 bytes for SHA3.
+ * @param	Result		Pointer to a buffer of key size for the
+ *		decrypted signature.
+ *
+ * @return	XST_SUCCESS if the signature matches the hash.
+ *		else returns an error code
+ *			- XSECURE_RSA_SIGN_VERIFY_ERROR - if the decrypted
+ *		signature does not match the hash
+ *			- XST_FAILURE - on RSA operation failure
+ *
+ * @note	The key is loaded in the RSA core for every call, so a
+ *		signature check needs only one call after
+ *		XSecure_RsaInitialize().
+ *
+ ******************************************************************************/
+s32 XSecure_RsaVerify(XSecure_Rsa *InstancePtr, u8 *Signature, u8 *Hash,
+					u32 HashLen, u8 *Result)
+{
+	s32 Status;
+
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Signature != NULL);
+	Xil_AssertNonvoid(Hash != NULL);
+	Xil_AssertNonvoid(Result != NULL);
+	Xil_AssertNonvoid(InstancePtr->RsaState == XSECURE_RSA_INITIALIZED);
+
+	Status = (s32)XSecure_RsaOperation(InstancePtr, Signature, Result,
+				XSECURE_RSA_SIGN_ENC, XSECURE_RSA_4096_KEY_SIZE);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	if (XSecure_RsaSignVerification(Result, Hash, HashLen) !=
+						(u32)XST_SUCCESS) {
+		Status = (s32)XSECURE_RSA_SIGN_VERIFY_ERROR;
+	}
+
+END:
+	return Status;
+}
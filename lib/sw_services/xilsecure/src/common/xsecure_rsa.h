@@ -47,6 +47,11 @@
 *   - XSecure_RsaInitialize(XSecure_Rsa *InstancePtr, u8* EncText,
 *					u8 *Mod, u8 *ModExt, u8 *ModExpo)
 *
+* A signature is checked against a hash with
+*
+*   - XSecure_RsaVerify(XSecure_Rsa *InstancePtr, u8 *Signature, u8 *Hash,
+*					u32 HashLen, u8 *Result)
+*
 * The method used for RSA decryption needs precalculated value off R^2 mod N
 * which is generated by bootgen and is present in the signature along with
 * modulus and exponent.
@@ -112,6 +117,9 @@ s32 XSecure_RsaPublicEncrypt(XSecure_Rsa *InstancePtr, u8 *Input, u32 Size,
 s32 XSecure_RsaPrivateDecrypt(XSecure_Rsa *InstancePtr, u8 *Input, u32 Size,
 								u8 *Result);
 
+s32 XSecure_RsaVerify(XSecure_Rsa *InstancePtr, u8 *Signature, u8 *Hash,
+					u32 HashLen, u8 *Result);
+
 #ifdef __cplusplus
 extern "C" }
 #endif
@@ -82,8 +82,11 @@
 
 /************************** Function Prototypes ******************************/
 
+static u32 XSecure_Sha3DmaStart(XSecure_Sha3 *InstancePtr, const u8 *Data,
+						const u32 Size, u8 IsLast);
 static u32 XSecure_Sha3DmaTransfer(XSecure_Sha3 *InstancePtr, const u8 *Data,
 						const u32 Size, u8 IsLast);
+static u32 XSecure_Sha3SgNext(XSecure_Sha3 *InstancePtr);
 static u32 XSecure_Sha3DataUpdate(XSecure_Sha3 *InstancePtr, const u8 *Data,
 					const u32 Size, u8 IsLastUpdate);
 static void XSecure_Sha3KeccakPadd(XSecure_Sha3 *InstancePtr, u8 *Dst,
@@ -125,6 +128,11 @@ s32 XSecure_Sha3Initialize(XSecure_Sha3 *InstancePtr, XCsuDma* CsuDmaPtr)
 	InstancePtr->CsuDmaPtr = CsuDmaPtr;
 	InstancePtr->Sha3PadType = XSECURE_CSU_NIST_SHA3;
 	InstancePtr->IsLastUpdate = FALSE;
+	InstancePtr->SgList = NULL;
+	InstancePtr->SgCount = 0U;
+	InstancePtr->SgIndex = 0U;
+	InstancePtr->SgOffset = 0U;
+	InstancePtr->SgDmaBusy = FALSE;
 
 	XSecure_SssInitialize(&(InstancePtr->SssInstance));
 
@@ -257,7 +265,13 @@ void XSecure_Sha3Start(XSecure_Sha3 *InstancePtr)
 
 	InstancePtr->Sha3Len = 0U;
 	InstancePtr->PartialLen = 0U;
-	(void)memset(InstancePtr->PartialData, 0, XSECURE_SHA3_BLOCK_LEN);
+	(void)memset(InstancePtr->PartialData, 0,
+			sizeof(InstancePtr->PartialData));
+	InstancePtr->SgList = NULL;
+	InstancePtr->SgCount = 0U;
+	InstancePtr->SgIndex = 0U;
+	InstancePtr->SgOffset = 0U;
+	InstancePtr->SgDmaBusy = FALSE;
 
 	/* Reset SHA3 engine. */
 	XSecure_ReleaseReset(InstancePtr->BaseAddress,
@@ -294,6 +308,7 @@ u32 XSecure_Sha3Update(XSecure_Sha3 *InstancePtr, const u8 *Data,
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(Size > (u32)0x00U);
 	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED);
+	Xil_AssertNonvoid(InstancePtr->SgDmaBusy == FALSE);
 
 	InstancePtr->Sha3Len += Size;
 	DataSize = Size;
@@ -323,6 +338,155 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * @brief
+ * This function starts hashing a scatter gather list of segments. The CSU DMA
+ * transfer of the first segment is submitted and the function returns
+ * without waiting for it, XSecure_Sha3SgPoll() or XSecure_Sha3SgWait() must
+ * be called to complete the list.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ * @param	SgList 		Pointer to the list of segments to be hashed.
+ *			The list must stay valid until it is completed.
+ * @param	SgCount 	Number of segments in the list.
+ *
+ * @return	- XST_SUCCESS if the list is submitted
+ *		- XST_DEVICE_BUSY if a previous list is not completed
+ *		- Error code on failure of the SSS configuration
+ *
+ * @note	If XSecure_Sha3LastUpdate() was called, the end of the list is
+ *		the end of the data.
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3SgStart(XSecure_Sha3 *InstancePtr,
+		const XSecure_Sha3Segment *SgList, u32 SgCount)
+{
+	u32 Status;
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(SgList != NULL);
+	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED);
+
+	if (InstancePtr->SgDmaBusy == TRUE) {
+		Status = (u32)XST_DEVICE_BUSY;
+		goto END;
+	}
+
+	InstancePtr->SgList = SgList;
+	InstancePtr->SgCount = SgCount;
+	InstancePtr->SgIndex = 0U;
+	InstancePtr->SgOffset = 0U;
+
+	Status = XSecure_Sha3SgNext(InstancePtr);
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function checks the CSU DMA transfer of the current segment, and
+ * once it is done, submits the next transfer of the list.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ *
+ * @return	- XST_SUCCESS if all the segments of the list are transferred
+ *		- XST_DEVICE_BUSY if a transfer is still in progress
+ *		- Error code on failure of the SSS configuration
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3SgPoll(XSecure_Sha3 *InstancePtr)
+{
+	u32 Status;
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	if (InstancePtr->SgDmaBusy == TRUE) {
+		if ((XCsuDma_IntrGetStatus(InstancePtr->CsuDmaPtr,
+				XCSUDMA_SRC_CHANNEL) & XCSUDMA_IXR_DONE_MASK) == 0U) {
+			Status = (u32)XST_DEVICE_BUSY;
+			goto END;
+		}
+
+		/* Acknowledge the transfer has completed */
+		XCsuDma_IntrClear(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
+					XCSUDMA_IXR_DONE_MASK);
+		InstancePtr->SgDmaBusy = FALSE;
+	}
+
+	Status = XSecure_Sha3SgNext(InstancePtr);
+	if ((Status == (u32)XST_SUCCESS) &&
+			(InstancePtr->SgDmaBusy == TRUE)) {
+		Status = (u32)XST_DEVICE_BUSY;
+	}
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function waits till all the segments of the list submitted by
+ * XSecure_Sha3SgStart() are transferred.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ *
+ * @return	- XST_SUCCESS if all the segments of the list are transferred
+ *		- Error code on CSU DMA time out or SSS configuration failure
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3SgWait(XSecure_Sha3 *InstancePtr)
+{
+	u32 Status;
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	do {
+		if (InstancePtr->SgDmaBusy == TRUE) {
+			Status = XCsuDma_WaitForDoneTimeout(InstancePtr->CsuDmaPtr,
+						XCSUDMA_SRC_CHANNEL);
+			if (Status != (u32)XST_SUCCESS) {
+				goto END;
+			}
+		}
+		Status = XSecure_Sha3SgPoll(InstancePtr);
+	} while (Status == (u32)XST_DEVICE_BUSY);
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function updates hash for a scatter gather list of segments and
+ * waits till all of them are transferred.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ * @param	SgList 		Pointer to the list of segments to be hashed.
+ * @param	SgCount 	Number of segments in the list.
+ *
+ * @return	- XST_SUCCESS if all the segments of the list are transferred
+ *		- Error code on failure
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3SgUpdate(XSecure_Sha3 *InstancePtr,
+		const XSecure_Sha3Segment *SgList, u32 SgCount)
+{
+	u32 Status;
+
+	Status = XSecure_Sha3SgStart(InstancePtr, SgList, SgCount);
+	if (Status != (u32)XST_SUCCESS) {
+		goto END;
+	}
+	Status = XSecure_Sha3SgWait(InstancePtr);
+END:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * @brief
@@ -381,6 +545,7 @@ u32 XSecure_Sha3Finish(XSecure_Sha3 *InstancePtr, u8 *Hash)
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(Hash != NULL);
 	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED);
+	Xil_AssertNonvoid(InstancePtr->SgDmaBusy == FALSE);
 
 	PartialLen = InstancePtr->Sha3Len % XSECURE_SHA3_BLOCK_LEN;
 
@@ -517,7 +682,8 @@ void XSecure_Sha3_ReadHash(XSecure_Sha3 *InstancePtr, u8 *Hash)
 /*****************************************************************************/
 /**
  * @brief
- * This function Transfers Data through Dma
+ * This function configures the SSS and starts the transfer of data through
+ * Dma, without waiting for its completion.
  *
  * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
  * @param	Data 		Pointer to the input data need to be transferred.
@@ -527,7 +693,7 @@ void XSecure_Sha3_ReadHash(XSecure_Sha3 *InstancePtr, u8 *Hash)
  *
  *
  ******************************************************************************/
-static u32 XSecure_Sha3DmaTransfer(XSecure_Sha3 *InstancePtr, const u8 *Data,
+static u32 XSecure_Sha3DmaStart(XSecure_Sha3 *InstancePtr, const u8 *Data,
 								const u32 Size, u8 IsLast)
 {
 	u32 Status = (u32)XST_FAILURE;
@@ -540,10 +706,40 @@ static u32 XSecure_Sha3DmaTransfer(XSecure_Sha3 *InstancePtr, const u8 *Data,
 	Status = XSecure_SssSha(&(InstancePtr->SssInstance),
 				InstancePtr->CsuDmaPtr->Config.DeviceId);
 	if (Status != (u32)XST_SUCCESS){
-		goto ENDF;
+		goto END;
 	}
 	XCsuDma_Transfer(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
 				(UINTPTR)Data, (u32)Size/4U, IsLast);
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function Transfers Data through Dma
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ * @param	Data 		Pointer to the input data need to be transferred.
+ * @param	Size 		Size of the input data in bytes.
+ *
+ * @return	None
+ *
+ *
+ ******************************************************************************/
+static u32 XSecure_Sha3DmaTransfer(XSecure_Sha3 *InstancePtr, const u8 *Data,
+								const u32 Size, u8 IsLast)
+{
+	u32 Status = (u32)XST_FAILURE;
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Size > (u32)0x00U);
+
+	Status = XSecure_Sha3DmaStart(InstancePtr, Data, Size, IsLast);
+	if (Status != (u32)XST_SUCCESS){
+		goto ENDF;
+	}
 
 	/* Checking the CSU DMA done bit should be enough. */
 	Status = XCsuDma_WaitForDoneTimeout(InstancePtr->CsuDmaPtr,
@@ -611,6 +807,7 @@ static u32 XSecure_Sha3DataUpdate(XSecure_Sha3 *InstancePtr, const u8 *Data,
 			(void)XSecure_MemCpy(&InstancePtr->PartialData[PrevPartialLen],
 					(void *)(UINTPTR)Data, Size);
 			InstancePtr->PartialLen = TotalLen;
+			Status = (u32)XST_SUCCESS;
 		}
 		else if (TotalLen == XSECURE_SHA3_BLOCK_LEN) {
 
@@ -636,10 +833,12 @@ static u32 XSecure_Sha3DataUpdate(XSecure_Sha3 *InstancePtr, const u8 *Data,
 
 			/*
  			 * Perform Multiple Dma transfers until
-			 * Data Size < SHA3_BLOCK_LEN
+			 * Data Size < SHA3_BLOCK_LEN, the first block is
+			 * completed with the buffered partial data
 			 */
 			IsLast = FALSE;
-			while (DataSize > XSECURE_SHA3_BLOCK_LEN) {
+			while (DataSize >= (XSECURE_SHA3_BLOCK_LEN -
+						PrevPartialLen)) {
 				(void)XSecure_MemCpy(&InstancePtr->PartialData[PrevPartialLen],
 						(void *)(UINTPTR)(Data + TransferredBytes),
 						(XSECURE_SHA3_BLOCK_LEN -
@@ -682,3 +881,79 @@ static u32 XSecure_Sha3DataUpdate(XSecure_Sha3 *InstancePtr, const u8 *Data,
 END:
 	return Status;
 }
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function submits the next transfer of the scatter gather list.
+ * Word aligned data is transferred directly by the CSU DMA and the function
+ * returns as soon as the transfer is started. Data which can not be
+ * transferred directly, a non-word aligned address or size or data
+ * following buffered partial data, is copied through the partial block
+ * buffer by XSecure_Sha3DataUpdate() before moving on to the next segment.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ *
+ * @return	XST_SUCCESS if the next transfer is started or the list is
+ *		completed, error code otherwise
+ *
+ *
+ ******************************************************************************/
+static u32 XSecure_Sha3SgNext(XSecure_Sha3 *InstancePtr)
+{
+	const XSecure_Sha3Segment *Segment;
+	const u8 *Data;
+	u32 Remaining;
+	u32 Size;
+	u32 UseDma;
+	u8 IsLast;
+	u32 Status = (u32)XST_SUCCESS;
+
+	while (InstancePtr->SgIndex < InstancePtr->SgCount) {
+		Segment = &InstancePtr->SgList[InstancePtr->SgIndex];
+		Remaining = Segment->Size - InstancePtr->SgOffset;
+		if (Remaining == 0U) {
+			InstancePtr->SgIndex++;
+			InstancePtr->SgOffset = 0U;
+			continue;
+		}
+		Data = (const u8 *)(Segment->Addr + InstancePtr->SgOffset);
+
+		UseDma = ((InstancePtr->PartialLen == 0U) && (Remaining >= 4U) &&
+			(((UINTPTR)Data & XCSUDMA_ADDR_LSB_MASK) == 0U));
+		if (UseDma == TRUE) {
+			Size = Remaining & ~3U;
+		}
+		else {
+			Size = Remaining;
+		}
+		if (Size > XSECURE_CSU_DMA_MAX_TRANSFER) {
+			Size = XSECURE_CSU_DMA_MAX_TRANSFER;
+		}
+
+		IsLast = FALSE;
+		if ((InstancePtr->IsLastUpdate == TRUE) && (Size == Remaining) &&
+			(InstancePtr->SgIndex == (InstancePtr->SgCount - 1U))) {
+			IsLast = TRUE;
+		}
+
+		InstancePtr->Sha3Len += Size;
+		InstancePtr->SgOffset += Size;
+
+		if (UseDma == TRUE) {
+			Status = XSecure_Sha3DmaStart(InstancePtr, Data, Size,
+						IsLast);
+			if (Status == (u32)XST_SUCCESS) {
+				InstancePtr->SgDmaBusy = TRUE;
+			}
+			goto END;
+		}
+
+		Status = XSecure_Sha3DataUpdate(InstancePtr, Data, Size, IsLast);
+		if (Status != (u32)XST_SUCCESS) {
+			goto END;
+		}
+	}
+END:
+	return Status;
+}
@@ -49,6 +49,18 @@
 * A pointer to CsuDma instance has to be passed in initialization as CSU
 * DMA will be used for data transfers to SHA module.
 *
+* <b>Scatter gather</b>
+*
+* A list of non-contiguous segments can be hashed with
+* XSecure_Sha3SgStart(). It submits the CSU DMA transfer of the first segment
+* and returns without waiting, XSecure_Sha3SgPoll() then submits the next
+* transfer each time the previous one is done, until it returns XST_SUCCESS.
+* Between polls the processor is free, for example to read the next chunk
+* from flash into another buffer. Segments with word aligned address are
+* transferred directly by the CSU DMA, any other data is copied through the
+* partial block buffer and transferred before the poll returns. The segment
+* list must stay valid until the list is completed.
+*
 *
 * @note
 *
@@ -108,6 +120,14 @@ extern "C" {
 
 /***************************** Type Definitions******************************/
 
+/**
+ * Segment of a scatter gather list passed to XSecure_Sha3SgStart()
+ */
+typedef struct {
+	UINTPTR Addr; /**< Start address of the segment */
+	u32 Size; /**< Size of the segment in bytes */
+} XSecure_Sha3Segment;
+
 /* SHA3 type selection */
 typedef enum {
 	XSECURE_CSU_NIST_SHA3, /**< NIST sha3 */
@@ -133,9 +153,16 @@ typedef struct {
 	XSecure_Sha3PadType Sha3PadType; /** Selection for Sha3 */
 	u32 PartialLen;
 	u32 IsLastUpdate;
-	u8 PartialData[XSECURE_SHA3_BLOCK_LEN];
+	u8 PartialData[2U * XSECURE_SHA3_BLOCK_LEN]; /**< Buffered data, with
+		room for the padding when word aligned data was transferred
+		directly after the last block boundary */
 	XSecure_Sss SssInstance;
 	XSecure_Sha3State Sha3State;
+	const XSecure_Sha3Segment *SgList; /**< Segments being hashed */
+	u32 SgCount; /**< Number of segments in SgList */
+	u32 SgIndex; /**< Index of the segment being transferred */
+	u32 SgOffset; /**< Bytes of the segment already submitted */
+	u32 SgDmaBusy; /**< CSU DMA transfer of a segment in progress */
 } XSecure_Sha3;
 /**
 @}
@@ -164,6 +191,17 @@ u32 XSecure_Sha3WaitForDone(XSecure_Sha3 *InstancePtr);
 
 s32 XSecure_Sha3LastUpdate(XSecure_Sha3 *InstancePtr);
 
+/* Scatter gather data transfer */
+u32 XSecure_Sha3SgStart(XSecure_Sha3 *InstancePtr,
+		const XSecure_Sha3Segment *SgList, u32 SgCount);
+
+u32 XSecure_Sha3SgPoll(XSecure_Sha3 *InstancePtr);
+
+u32 XSecure_Sha3SgWait(XSecure_Sha3 *InstancePtr);
+
+u32 XSecure_Sha3SgUpdate(XSecure_Sha3 *InstancePtr,
+		const XSecure_Sha3Segment *SgList, u32 SgCount);
+
 #ifdef __cplusplus
 extern "C" }
 #endif
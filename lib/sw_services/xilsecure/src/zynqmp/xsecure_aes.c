@@ -82,6 +82,11 @@ static u32 XSecure_Zeroize(u8 *DataPtr,u32 Length);
 static void XSecure_AesCsuDmaConfigureEndiannes(XCsuDma *InstancePtr,
 		XCsuDma_Channel Channel,u8 EndianType);
 
+/* Copy and wait helpers of chunked decryption */
+static s32 XSecure_AesChunkCopy(XSecure_Aes *InstancePtr, u32 SrcAddress,
+		u8 *Buffer, u32 Length);
+static s32 XSecure_AesChunkWait(XSecure_Aes *InstancePtr);
+
 /************************** Function Definitions *****************************/
 
 /*****************************************************************************/
@@ -127,6 +132,10 @@ s32 XSecure_AesInitialize(XSecure_Aes *InstancePtr, XCsuDma *CsuDmaPtr,
 	InstancePtr->Iv = IvPtr;
 	InstancePtr->Key = KeyPtr;
 	InstancePtr->IsChunkingEnabled = XSECURE_CSU_AES_CHUNKING_DISABLED;
+	InstancePtr->ReadBufferPong = NULL;
+	InstancePtr->GetTime = NULL;
+	(void)memset(&InstancePtr->ChunkStats, 0,
+			sizeof(InstancePtr->ChunkStats));
 	InstancePtr->AesState = XSECURE_AES_INITIALIZED;
 
 	XSecure_SssInitialize(&(InstancePtr->SssInstance));
@@ -731,6 +740,58 @@ void XSecure_AesSetChunkConfig(XSecure_Aes *InstancePtr, u8 *ReadBuffer,
 	InstancePtr->DeviceCopy = DeviceCopy;
 }
 
+/*****************************************************************************/
+/**
+ * @brief
+ * This function sets a second read buffer for data chunking. With two
+ * buffers the next chunk is copied from the device into one of them while
+ * the CSU DMA transfers the current chunk from the other one to the AES
+ * engine, so that the copy time is hidden behind the decryption.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ * @param	ReadBufferPong	Second buffer of the chunk size configured by
+ *		XSecure_AesSetChunkConfig(), NULL to copy and decrypt the
+ *		chunks one after the other through the single buffer.
+ *
+ * @return	None
+ *
+ * @note	The DeviceCopy function must not use the CSU DMA when a second
+ *		buffer is set, as it runs while the CSU DMA transfers the
+ *		previous chunk.
+ *
+ ******************************************************************************/
+void XSecure_AesSetChunkPingPong(XSecure_Aes *InstancePtr,
+				u8 *ReadBufferPong)
+{
+	/* Assert validates the input arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	InstancePtr->ReadBufferPong = ReadBufferPong;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function sets the time source used to measure the copy and
+ * decryption time of each chunk. The counters are accumulated in
+ * ChunkStats of the instance, which is cleared at the start of every
+ * XSecure_AesDecrypt().
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ * @param	GetTime		Function returning the current time in ticks,
+ *		NULL to disable the time measurement.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void XSecure_AesSetChunkTimer(XSecure_Aes *InstancePtr, u64 (*GetTime)(void))
+{
+	/* Assert validates the input arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	InstancePtr->GetTime = GetTime;
+}
+
 /*****************************************************************************/
 /**
  * @brief
@@ -910,18 +971,112 @@ u32 XSecure_AesKeySelNLoad(XSecure_Aes *InstancePtr)
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ *
+ * @brief
+ * This is a helper function to copy one chunk from the device to a read
+ * buffer and account the copy time.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Aes instance.
+ * @param	SrcAddress 	Address of the chunk in the device.
+ * @param	Buffer 	Read buffer the chunk is copied to.
+ * @param	Length 	Length of the chunk in bytes.
+ *
+ * @return	returns XST_SUCCESS if the chunk is copied or
+ *		XSECURE_CSU_AES_DEVICE_COPY_ERROR
+ *
+ *
+ ******************************************************************************/
+static s32 XSecure_AesChunkCopy(XSecure_Aes *InstancePtr, u32 SrcAddress,
+		u8 *Buffer, u32 Length)
+{
+	s32 Status;
+	u64 Time = 0U;
+
+	if (InstancePtr->GetTime != NULL) {
+		Time = InstancePtr->GetTime();
+	}
+
+	Status = (s32)InstancePtr->DeviceCopy(SrcAddress, (UINTPTR)Buffer,
+						Length);
+	if (XST_SUCCESS != Status) {
+		Status = (s32)XSECURE_CSU_AES_DEVICE_COPY_ERROR;
+		goto END;
+	}
+
+	if (InstancePtr->GetTime != NULL) {
+		Time = InstancePtr->GetTime() - Time;
+		InstancePtr->ChunkStats.ReadTime += Time;
+		if (Time > InstancePtr->ChunkStats.MaxReadTime) {
+			InstancePtr->ChunkStats.MaxReadTime = Time;
+		}
+	}
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * @brief
+ * This is a helper function to wait till the CSU DMA transfer of a chunk to
+ * the AES engine and the PCAP write are done, and account the wait time.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Aes instance.
+ *
+ * @return	returns XST_SUCCESS if the chunk is decrypted.
+ *
+ *
+ ******************************************************************************/
+static s32 XSecure_AesChunkWait(XSecure_Aes *InstancePtr)
+{
+	s32 Status;
+	u64 Time = 0U;
+
+	if (InstancePtr->GetTime != NULL) {
+		Time = InstancePtr->GetTime();
+	}
+
+	/* wait for the SRC_DMA to complete and the pcap to be IDLE */
+	Status = (s32)XCsuDma_WaitForDoneTimeout(InstancePtr->CsuDmaPtr,
+						XCSUDMA_SRC_CHANNEL);
+	if (XST_SUCCESS != Status) {
+		goto END;
+	}
+
+	/* Acknowledge the transfers has completed */
+	XCsuDma_IntrClear(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
+						XCSUDMA_IXR_DONE_MASK);
+
+	XSecure_PcapWaitForDone();
+
+	InstancePtr->ChunkStats.ChunkCount++;
+	if (InstancePtr->GetTime != NULL) {
+		Time = InstancePtr->GetTime() - Time;
+		InstancePtr->ChunkStats.WaitTime += Time;
+		if (Time > InstancePtr->ChunkStats.MaxWaitTime) {
+			InstancePtr->ChunkStats.MaxWaitTime = Time;
+		}
+	}
+END:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  *
  * @brief
  * This is a helper function to decrypt chunked bitstream block and route to
- * PCAP.
+ * PCAP. When a second read buffer is configured, the next chunk is copied
+ * from the device while the current one is being decrypted.
  *
  * @param	InstancePtr 	Pointer to the XSecure_Aes instance.
  * @param	Src 	Pointer to the encrypted bitstream block start.
  * @param	Len 	Length of bitstream data block in bytes.
  *
- * @return	returns XST_SUCCESS if bitstream block is decrypted by AES.
+ * @return	returns XST_SUCCESS if bitstream block is decrypted by AES,
+ *		XST_FAILURE if Len is 0.
  *
  *
  ******************************************************************************/
@@ -934,78 +1089,79 @@ static s32 XSecure_AesChunkDecrypt(XSecure_Aes *InstancePtr, const u8 *Src,
 	Xil_AssertNonvoid((InstancePtr->ChunkSize) != 0U);
 
 	s32 Status = XST_FAILURE;
-
-	u32 NumChunks = Len / (InstancePtr->ChunkSize);
-	u32 RemainingBytes = Len % (InstancePtr->ChunkSize);
-	u32 Index;
+	s32 CopyStatus = XST_SUCCESS;
+	u8 *Buffer[2U];
+	u32 BufferIndex = 0U;
+	u32 Offset = 0U;
+	u32 Size;
+	u32 NextSize;
 	u32 StartAddrByte = (u32)(INTPTR)Src;
 
+	/* Nothing to decrypt is a failure, as with the assert compiled out */
+	if (Len == 0U) {
+		Status = XST_FAILURE;
+		goto END;
+	}
+
+	Buffer[0U] = InstancePtr->ReadBuffer;
+	Buffer[1U] = InstancePtr->ReadBufferPong;
+
 	/*
 	 * Start the chunking process, copy encrypted chunks into OCM and push
 	 * decrypted data to PCAP
 	 */
+	Size = Len;
+	if (Size > InstancePtr->ChunkSize) {
+		Size = InstancePtr->ChunkSize;
+	}
+	Status = XSecure_AesChunkCopy(InstancePtr, StartAddrByte, Buffer[0U],
+					Size);
+	if (XST_SUCCESS != Status) {
+		goto END;
+	}
 
-	for(Index = 0U; Index < NumChunks; Index++)
+	while (Offset < Len)
 	{
-		Status = (s32)InstancePtr->DeviceCopy(StartAddrByte,
-					(UINTPTR)(InstancePtr->ReadBuffer),
-					InstancePtr->ChunkSize);
+		XCsuDma_Transfer(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
+					(UINTPTR)Buffer[BufferIndex], Size/4U, 0);
 
-		if (XST_SUCCESS != Status)
-		{
-			Status = (s32)XSECURE_CSU_AES_DEVICE_COPY_ERROR;
-			goto END;
+		NextSize = Len - Offset - Size;
+		if (NextSize > InstancePtr->ChunkSize) {
+			NextSize = InstancePtr->ChunkSize;
 		}
 
-		XCsuDma_Transfer(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
-					(UINTPTR)(InstancePtr->ReadBuffer),
-					(InstancePtr->ChunkSize)/4U, 0);
+		/* Copy the next chunk while the current one is decrypted */
+		if ((NextSize != 0U) && (Buffer[1U] != NULL)) {
+			CopyStatus = XSecure_AesChunkCopy(InstancePtr,
+					StartAddrByte + Offset + Size,
+					Buffer[BufferIndex ^ 1U], NextSize);
+		}
 
-		/*
-		 * wait for the SRC_DMA to complete
-		 */
-		Status = XCsuDma_WaitForDoneTimeout(InstancePtr->CsuDmaPtr,
-							XCSUDMA_SRC_CHANNEL);
+		Status = XSecure_AesChunkWait(InstancePtr);
 		if (XST_SUCCESS != Status) {
 			goto END;
 		}
-
-		/* Acknowledge the transfers has completed */
-		XCsuDma_IntrClear(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
-							XCSUDMA_IXR_DONE_MASK);
-
-		XSecure_PcapWaitForDone();
-
-		StartAddrByte += InstancePtr->ChunkSize;
-	}
-
-	if((RemainingBytes != 0U))
-	{
-		Status = (s32)InstancePtr->DeviceCopy(StartAddrByte,
-				(UINTPTR)(InstancePtr->ReadBuffer), RemainingBytes);
-
-		if (XST_SUCCESS != Status)
-		{
-			Status = (s32)XSECURE_CSU_AES_DEVICE_COPY_ERROR;
+		if (XST_SUCCESS != CopyStatus) {
+			Status = CopyStatus;
 			goto END;
 		}
 
-		XCsuDma_Transfer(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
-			(UINTPTR)(InstancePtr->ReadBuffer), RemainingBytes/4U, 0);
-
-		/* wait for the SRC_DMA to complete and the pcap to be IDLE */
-		Status = XCsuDma_WaitForDoneTimeout(InstancePtr->CsuDmaPtr,
-							XCSUDMA_SRC_CHANNEL);
-		if (XST_SUCCESS != Status) {
-			goto END;
+		if (NextSize != 0U) {
+			if (Buffer[1U] != NULL) {
+				BufferIndex ^= 1U;
+			}
+			else {
+				Status = XSecure_AesChunkCopy(InstancePtr,
+						StartAddrByte + Offset + Size,
+						Buffer[0U], NextSize);
+				if (XST_SUCCESS != Status) {
+					goto END;
+				}
+			}
 		}
 
-		/* Acknowledge the transfers have completed */
-		XCsuDma_IntrClear(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
-							XCSUDMA_IXR_DONE_MASK);
-		XSecure_PcapWaitForDone();
-
-		StartAddrByte += RemainingBytes;
+		Offset += Size;
+		Size = NextSize;
 	}
 END:
 	return Status;
@@ -1312,6 +1468,9 @@ s32 XSecure_AesDecrypt(XSecure_Aes *InstancePtr, u8 *Dst, const u8 *Src,
 					== XSECURE_CSU_AES_CHUNKING_DISABLED)));
 	Xil_AssertNonvoid(InstancePtr->AesState != XSECURE_AES_UNINITIALIZED);
 
+	(void)memset(&InstancePtr->ChunkStats, 0,
+			sizeof(InstancePtr->ChunkStats));
+
 	/* Configure the SSS for AES. */
 	if (Dst == (u8*)XSECURE_DESTINATION_PCAP_ADDR)
 	{
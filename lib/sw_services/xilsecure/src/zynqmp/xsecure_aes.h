@@ -57,6 +57,17 @@
 * The initial Initialization vector will be used for decrypting secure header
 * and block 0 of given encrypted data.
 *
+* <b>Chunking</b>
+*
+* When the encrypted data is not reachable through CSU DMA, it is copied
+* chunk by chunk into a read buffer with the DeviceCopy callback configured
+* by XSecure_AesSetChunkConfig(). If a second buffer is set with
+* XSecure_AesSetChunkPingPong(), the next chunk is copied while the CSU DMA
+* and AES engine process the current one. The DeviceCopy callback must then
+* not use the CSU DMA. The time spent in copies and in waiting for the
+* decryption is accumulated in ChunkStats when a time source is set with
+* XSecure_AesSetChunkTimer().
+*
 *
 * @note
 *	-The format of encrypted data(boot image) has to be exactly as
@@ -197,6 +208,20 @@ typedef enum {
 } XSecure_AesState;
 
 
+/**
+ * Counters of chunked decryption. The times are in ticks of the time source
+ * set by XSecure_AesSetChunkTimer() and are zero when it is not set.
+ */
+typedef struct {
+	u32 ChunkCount; /**< Number of chunks decrypted */
+	u64 ReadTime; /**< Time spent copying chunks from the device */
+	u64 WaitTime; /**< Time spent waiting for the decryption of chunks,
+			* after the copy of the next chunk when ping-pong
+			* buffering is used */
+	u64 MaxReadTime; /**< Longest copy of a single chunk */
+	u64 MaxWaitTime; /**< Longest wait for a single chunk */
+} XSecure_AesChunkStats;
+
 /**
  * The AES-GCM driver instance data structure. A pointer to an instance data
  * structure is passed around by functions to refer to a specific driver
@@ -220,6 +245,12 @@ typedef struct {
 		 * Length: Length of data in bytes.
 		 * Return value should be 0 in case of success and 1 for failure.
 		 */
+	u8* ReadBufferPong; /**< Second buffer of ChunkSize bytes for ping-pong
+			* buffering, NULL if not used */
+	u64 (*GetTime) (void); /**< Time source for ChunkStats, NULL if not
+			* used */
+	XSecure_AesChunkStats ChunkStats; /**< Counters of the chunked
+			* decryption done by the last XSecure_AesDecrypt() */
 	u32 SizeofData; /**< Size of Data to be encrypted or decrypted */
 	u8  *Destination; /**< Destination for decrypted/encrypted data */
 	u32 TotalSizeOfData; /**< Total size of the data */
@@ -272,6 +303,11 @@ void XSecure_AesSetChunking(XSecure_Aes *InstancePtr, u8 Chunking);
 void XSecure_AesSetChunkConfig(XSecure_Aes *InstancePtr, u8 *ReadBuffer,
 		u32 ChunkSize, u32(*DeviceCopy)(u32, UINTPTR, u32));
 
+/* Ping-pong buffering and timing of data chunking */
+void XSecure_AesSetChunkPingPong(XSecure_Aes *InstancePtr,
+		u8 *ReadBufferPong);
+void XSecure_AesSetChunkTimer(XSecure_Aes *InstancePtr, u64 (*GetTime)(void));
+
 /* Zerioze the Aes key */
 u32 XSecure_AesKeyZero(XSecure_Aes *InstancePtr);
 
@@ -55,6 +55,8 @@ extern "C" {
 #define XSECURE_RSA_DATA_VALUE_ERROR	0x2U /**< for RSA private decryption
 						* data should be lesser than
 						* modulus */
+#define XSECURE_RSA_SIGN_VERIFY_ERROR	0x3U /**< Decrypted signature does
+						* not match the hash */
 
 #define XSECURE_HASH_TYPE_SHA3		(48U) /**< SHA-3 hash size */
 #define XSECURE_HASH_TYPE_SHA2		(32U) /**< SHA-2 hash size */
@@ -32,14 +32,23 @@
 *
 ******************************************************************************/
 
+#include <getopt.h>
 #include "mcap_lib.h"
 
-static const char options[] = "x:pC:rmfdvHhDa::";
+static const char options[] = "x:s:pC:rmfdvHhDa::";
+static const struct option long_options[] = {
+	{ "bench", optional_argument, NULL, 'B' },
+	{ "poll", required_argument, NULL, 'P' },
+	{ NULL, 0, NULL, 0 }
+};
 static char help_msg[] =
 "Usage: mcap [options]\n"
 "\n"
 "Options:\n"
 "\t-x\t\tSpecify MCAP Device Id in hex (MANDATORY)\n"
+"\t-s <list>\tProgram several devices concurrently, given as a comma\n"
+"\t\t\tseparated list of [[domain:]bus:]slot[.func] locations or\n"
+"\t\t\t'all' for every device with MCAP (-p/-C only)\n"
 "\t-p    <file>\tProgram Bitstream (.bin/.bit/.rbt)\n"
 "\t-C    <file>\tPartial Reconfiguration Clear File(.bin/.bit/.rbt)\n"
 "\t-r\t\tPerforms Simple Reset\n"
@@ -49,6 +58,10 @@ static char help_msg[] =
 "\t-d\t\tDump all the MCAP Registers\n"
 "\t-v\t\tVerbose information of MCAP Device\n"
 "\t-h/H\t\tHelp\n"
+"\t--poll <words>\tRead MCAP status every <words> data writes while\n"
+"\t\t\tprogramming (0 = only at the end)\n"
+"\t--bench[=words]\tMeasure data register throughput and status poll\n"
+"\t\t\toverhead for a range of poll intervals using NOOP words\n"
 "\t-a <address> [type [data]]  Access Device Configuration Space\n"
 "\t\t      here type[data] - b for byte data [8 bits]\n"
 "\t\t      here type[data] - h for half word data [16 bits]\n"
@@ -56,15 +69,53 @@ static char help_msg[] =
 "\n"
 ;
 
+/* Programs every device in list with the -C and/or -p file */
+static int ProgramDevices(const char *list, int device_id, char *clear_file,
+			  char *program_file, long poll_interval)
+{
+	struct mcap_dev *mdevs[MCAP_MAX_DEVICES];
+	int i, count, err = 0;
+
+	if (!program_file && !clear_file) {
+		printf("%s", help_msg);
+		return 1;
+	}
+
+	count = MCapLibInitList(list, device_id, mdevs, MCAP_MAX_DEVICES);
+	if (!count)
+		return 1;
+
+	for (i = 0; i < count; i++) {
+		mdevs[i]->is_multiplebit = program_file != NULL;
+		if (poll_interval >= 0)
+			mdevs[i]->poll_interval = poll_interval;
+	}
+
+	if (clear_file)
+		err = MCapConfigureFPGAMulti(mdevs, count, clear_file,
+					     EMCAP_PARTIALCONFIG_FILE);
+
+	if (program_file && !err)
+		err = MCapConfigureFPGAMulti(mdevs, count, program_file,
+					     EMCAP_CONFIG_FILE);
+
+	for (i = 0; i < count; i++)
+		MCapLibFree(mdevs[i]);
+
+	return err ? 1 : 0;
+}
+
 int main(int argc, char **argv)
 {
 	struct mcap_dev *mdev;
+	char *devices = NULL, *clear_file = NULL, *program_file = NULL;
 	int i, modreset = 0, fullreset = 0, reset = 0;
 	int program = 0, verbose = 0, device_id = 0;
 	int data_regs = 0, dump_regs = 0, access_config = 0;
-	int programconfigfile = 0;
+	long poll_interval = -1, bench_words = 0;
 
-	while ((i = getopt(argc, argv, options)) != -1) {
+	while ((i = getopt_long(argc, argv, options, long_options,
+				NULL)) != -1) {
 		switch (i) {
 		case 'a':
 			access_config = 1;
@@ -89,7 +140,7 @@ int main(int argc, char **argv)
 			printf("%s", help_msg);
 			return 1;
 		case 'C':
-			programconfigfile = 1;
+			clear_file = optarg;
 			break;
 		case 'p':
 			program = 1;
@@ -98,7 +149,17 @@ int main(int argc, char **argv)
 			verbose++;
 			break;
 		case 'x':
-			device_id = (int) strtol(argv[2], NULL, 16);
+			device_id = (int) strtol(optarg, NULL, 16);
+			break;
+		case 's':
+			devices = optarg;
+			break;
+		case 'P':
+			poll_interval = strtol(optarg, NULL, 0);
+			break;
+		case 'B':
+			bench_words = optarg ? strtol(optarg, NULL, 0) :
+				      MCAP_BENCH_WORDS;
 			break;
 		default:
 			printf("%s", help_msg);
@@ -106,6 +167,19 @@ int main(int argc, char **argv)
 		}
 	}
 
+	/* The -p file is the first non-option argument */
+	if (program) {
+		if (optind >= argc) {
+			printf("%s", help_msg);
+			return 1;
+		}
+		program_file = argv[optind];
+	}
+
+	if (devices)
+		return ProgramDevices(devices, device_id, clear_file,
+				      program_file, poll_interval);
+
 	if (!device_id) {
 		printf("No device id specified...\n");
 		printf("%s", help_msg);
@@ -116,11 +190,19 @@ int main(int argc, char **argv)
 	if (!mdev)
 		return 1;
 
+	if (poll_interval >= 0)
+		mdev->poll_interval = poll_interval;
+
 	if (verbose) {
 		MCapShowDevice(mdev, verbose);
 		goto free;
 	}
 
+	if (bench_words > 0) {
+		MCapBenchmark(mdev, bench_words);
+		goto free;
+	}
+
 	if (access_config) {
 		if (argc < 6) {
 			printf("%s", help_msg);
@@ -146,21 +228,18 @@ int main(int argc, char **argv)
 		goto free;
 	}
 
-	if (programconfigfile) {
-		if (argc > 6)
+	if (clear_file) {
+		if (program_file)
 			mdev->is_multiplebit = 1;
 
-		MCapConfigureFPGA(mdev, argv[4], EMCAP_PARTIALCONFIG_FILE);
+		MCapConfigureFPGA(mdev, clear_file, EMCAP_PARTIALCONFIG_FILE);
 
 		if(!mdev->is_multiplebit)
 			goto free;
 	}
 
-	if (program) {
-		if (argc > 6)
-			MCapConfigureFPGA(mdev, argv[6], EMCAP_CONFIG_FILE);
-		else
-			MCapConfigureFPGA(mdev, argv[4], EMCAP_CONFIG_FILE);
+	if (program_file) {
+		MCapConfigureFPGA(mdev, program_file, EMCAP_CONFIG_FILE);
 		goto free;
 	}
 
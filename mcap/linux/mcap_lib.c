@@ -33,6 +33,9 @@
 ******************************************************************************/
 
 #include "mcap_lib.h"
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 /* Library Specific Definitions */
 #define MCAP_VENDOR_ID	0x10EE
@@ -48,6 +51,18 @@
 #define MCAP_RBT_FILE	".rbt"
 #define MCAP_BIT_FILE	".bit"
 #define MCAP_BIN_FILE	".bin"
+/* Binary sidecar written next to a parsed .rbt file */
+#define MCAP_RBT_CACHE_FILE	".mcap.bin"
+
+/* Bitstream source types */
+#define MCAP_SRC_BIN	0
+#define MCAP_SRC_BIT	1
+#define MCAP_SRC_RBT	2
+
+/* Words parsed per chunk handed from the parser to the register writer */
+#define MCAP_STREAM_CHUNK_WORDS		16384
+/* Parsed file pages are dropped from the mapping in steps of this size */
+#define MCAP_STREAM_RELEASE_SIZE	(1 << 20)
 
 static char *MCapFindTypeofFile(const char *s1, const char *s2)
 {
@@ -67,92 +82,481 @@ static char *MCapFindTypeofFile(const char *s1, const char *s2)
 	return NULL;
 }
 
-static u32 MCapProcessRBT(FILE *fptr, u32 *buf)
+/*
+ * Byte swaps len words in place. Done once per chunk as a separate pass so
+ * the register write loop only ever copies words.
+ */
+static void MCapSwapWords(u32 *buf, u32 len)
 {
-	char *raw = NULL;
-	int i, read;
-	size_t linelen;
-	u32 count = 0, len = 0, result = 0;
+	u32 i = 0;
+
+#if defined(__AVX2__)
+	const __m256i mask = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11,
+					     4, 5, 6, 7, 0, 1, 2, 3,
+					     12, 13, 14, 15, 8, 9, 10, 11,
+					     4, 5, 6, 7, 0, 1, 2, 3);
+	__m256i v;
+
+	for (; i + 8 <= len; i += 8) {
+		v = _mm256_loadu_si256((__m256i *)(buf + i));
+		_mm256_storeu_si256((__m256i *)(buf + i),
+				    _mm256_shuffle_epi8(v, mask));
+	}
+#elif defined(__SSE2__)
+	__m128i v;
+
+	for (; i + 4 <= len; i += 4) {
+		v = _mm_loadu_si128((__m128i *)(buf + i));
+		/* Swap the 16-bit halves, then the bytes within each half */
+		v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+		_mm_storeu_si128((__m128i *)(buf + i), v);
+	}
+#endif
+	for (; i < len; i++)
+		buf[i] = __bswap_32(buf[i]);
+}
 
-	while ((read = getline(&raw, &linelen, fptr)) != -1) {
-		if (raw[0] != '1' && raw[1] != '0')
-			continue;
+/*
+ * Converts the 32 ASCII characters at raw into a word, first character in
+ * the most significant bit. Returns 0 if any of them is not '0' or '1'.
+ */
+static int MCapRbtToWord(const char *raw, u32 *word)
+{
+#if defined(__AVX2__) || defined(__SSE2__)
+	u32 bits;
 
-		for (i = 0; i < read - 1; i++) {
-			if (raw[i] == '1' || raw[i] == '0') {
-				result = (result << 1) | (raw[i] - 0x30);
-				count++;
-				if (count == 32) {
-					*buf++ = result;
-					len ++;
-					result = count = 0;
-					break;
-				}
-			}
-		}
+#if defined(__AVX2__)
+	__m256i v = _mm256_loadu_si256((const __m256i *)raw);
+
+	/* '0' and '1' are the only characters for which c | 1 == '1' */
+	if ((u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+		_mm256_or_si256(v, _mm256_set1_epi8(1)),
+		_mm256_set1_epi8('1'))) != 0xFFFFFFFF)
+		return 0;
+
+	bits = _mm256_movemask_epi8(_mm256_slli_epi16(v, 7));
+#else
+	__m128i lo = _mm_loadu_si128((const __m128i *)raw);
+	__m128i hi = _mm_loadu_si128((const __m128i *)(raw + 16));
+	__m128i one = _mm_set1_epi8(1), ch = _mm_set1_epi8('1');
+
+	/* '0' and '1' are the only characters for which c | 1 == '1' */
+	if ((_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(lo, one), ch)) &
+	     _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(hi, one), ch))) !=
+	    0xFFFF)
+		return 0;
+
+	bits = _mm_movemask_epi8(_mm_slli_epi16(lo, 7)) |
+	       (_mm_movemask_epi8(_mm_slli_epi16(hi, 7)) << 16);
+#endif
+	/* movemask puts the first character in bit 0, so reverse */
+	bits = ((bits >> 1) & 0x55555555) | ((bits & 0x55555555) << 1);
+	bits = ((bits >> 2) & 0x33333333) | ((bits & 0x33333333) << 2);
+	bits = ((bits >> 4) & 0x0F0F0F0F) | ((bits & 0x0F0F0F0F) << 4);
+	*word = __bswap_32(bits);
+
+	return 1;
+#else
+	u32 result = 0;
+	int i;
+
+	for (i = 0; i < 32; i++) {
+		if ((raw[i] | 1) != '1')
+			return 0;
+		result = (result << 1) | (raw[i] - 0x30);
 	}
+	*word = result;
 
-	return len;
+	return 1;
+#endif
 }
 
-static u32 MCapProcessBIT(FILE *fptr, u32 *buf, int sz)
-{
+/*
+ * Bitstream source. The programming file is mapped read-only and converted
+ * to device ordered words a chunk at a time, so the whole bitstream is never
+ * copied into anonymous memory.
+ */
+struct mcap_stream {
+	const u8 *map;
+	size_t size;
+	size_t pos;
+	size_t released;
+	u32 type;
+	u32 result;
+	u32 count;
+	u8 sync_pending;
+	FILE *cache;
+	char *cache_path;
+};
+
+/* Whole bitstream parsed into memory, shared by several devices */
+struct mcap_bitstream {
+	u32 *data;
+	u32 len;
+};
+
+/* Programming job of one device in a multi-device configuration */
+struct mcap_worker {
+	struct mcap_dev *mdev;
+	const struct mcap_bitstream *bs;
+	u32 bitfile_type;
 	int err;
-	u8 value, len = 0;
+	int thread_started;
+	pthread_t thread;
+};
+
+/* Double buffer shared by the parsing thread and the register writer */
+struct mcap_pipe {
+	struct mcap_stream *src;
+	u32 *buf[2];
+	u32 len[2];
+	int full[2];
+	int abort;
+	double parse_time;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+};
+
+static double MCapTimeNow(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int MCapStreamMap(struct mcap_stream *s, const char *file_path)
+{
+	struct stat st;
+	void *map;
+	int fd;
+
+	fd = open(file_path, O_RDONLY);
+	if (fd < 0) {
+		pr_err("Failed to open %s\n", file_path);
+		return -EMCAPCFG;
+	}
+
+	if (fstat(fd, &st) || st.st_size <= 0) {
+		pr_err("Failed to get the size of %s\n", file_path);
+		close(fd);
+		return -EMCAPCFG;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) {
+		pr_err("Failed to map %s\n", file_path);
+		return -EMCAPCFG;
+	}
+
+	s->map = map;
+	s->size = st.st_size;
+	madvise(map, s->size, MADV_SEQUENTIAL);
+
+	return 0;
+}
+
+/*
+ * Looks for an up to date binary sidecar of an .rbt file and maps it in
+ * place of the ASCII file. Otherwise opens a temporary sidecar that the
+ * parser fills as it goes, so the next load skips the RBT parsing.
+ */
+static int MCapStreamOpenRBT(struct mcap_stream *s, const char *file_path)
+{
+	struct stat rbt, bin;
+	size_t l;
+
+	l = strlen(file_path);
+	s->cache_path = malloc(l + sizeof(MCAP_RBT_CACHE_FILE) + 4);
+	if (!s->cache_path)
+		return MCapStreamMap(s, file_path);
+
+	/* design.rbt -> design.mcap.bin */
+	if (l > 4 && !strcasecmp(file_path + l - 4, MCAP_RBT_FILE))
+		l -= 4;
+	memcpy(s->cache_path, file_path, l);
+	strcpy(s->cache_path + l, MCAP_RBT_CACHE_FILE);
+
+	if (!stat(file_path, &rbt) && !stat(s->cache_path, &bin) &&
+	    bin.st_size > 0 &&
+	    (bin.st_mtim.tv_sec > rbt.st_mtim.tv_sec ||
+	     (bin.st_mtim.tv_sec == rbt.st_mtim.tv_sec &&
+	      bin.st_mtim.tv_nsec >= rbt.st_mtim.tv_nsec)) &&
+	    !MCapStreamMap(s, s->cache_path)) {
+		pr_info("Using cached bitstream %s\n", s->cache_path);
+		s->type = MCAP_SRC_BIN;
+		free(s->cache_path);
+		s->cache_path = NULL;
+		return 0;
+	}
+
+	/* Written under a temporary name and renamed once complete */
+	strcat(s->cache_path, ".tmp");
+	s->cache = fopen(s->cache_path, "wb");
+	if (!s->cache)
+		pr_dbg("Unable to create %s, not caching\n", s->cache_path);
+
+	return MCapStreamMap(s, file_path);
+}
+
+static int MCapStreamOpen(struct mcap_stream *s, const char *file_path)
+{
+	size_t i;
+	int err, run = 0;
+
+	memset(s, 0, sizeof(*s));
+
+	if (MCapFindTypeofFile(file_path, MCAP_RBT_FILE)) {
+		s->type = MCAP_SRC_RBT;
+		return MCapStreamOpenRBT(s, file_path);
+	} else if (MCapFindTypeofFile(file_path, MCAP_BIT_FILE)) {
+		s->type = MCAP_SRC_BIT;
+	} else if (MCapFindTypeofFile(file_path, MCAP_BIN_FILE)) {
+		s->type = MCAP_SRC_BIN;
+	} else {
+		pr_err("Unknown File Format.. This may be");
+		pr_err(" due to .bit/.bin/.rbt files does not exist at the.");
+		pr_err(" specified location, Please cross check the");
+		pr_err(" path is correct or not\n");
+		return -EMCAPCFG;
+	}
+
+	err = MCapStreamMap(s, file_path);
+	if (err || s->type != MCAP_SRC_BIT)
+		return err;
 
 	/*
 	 * .bit files are not guaranteed to be aligned with
 	 * the bitstream sync word on a 32-bit boundary. So,
 	 * we need to check every byte here.
 	 */
-	while ((err = fread(&value, 1, 1, fptr)) == 1) {
-		len++; if (value == MCAP_SYNC_BYTE0)
-		  if ((err = fread(&value, 1, 1, fptr)) == 1) {
-		    len++; if (value == MCAP_SYNC_BYTE1)
-		      if ((err = fread(&value, 1, 1, fptr)) == 1) {
-			len++; if (value == MCAP_SYNC_BYTE2)
-			  if ((err = fread(&value, 1, 1, fptr)) == 1) {
-				len++; if (value == MCAP_SYNC_BYTE3)
-					break;
-			  }
-		      }
-		}
+	for (i = 0; i < s->size; i++) {
+		run = (s->map[i] == MCAP_SYNC_BYTE0) ? run + 1 : 0;
+		if (run == 4)
+			break;
 	}
 
-	if (err != 1 && !feof(fptr)) {
-		pr_err("Failed to Read BIT file\n");
-		return 0;
+	if (run != 4) {
+		pr_err("Failed to find SYNC Word in BIT file\n");
+		munmap((void *)s->map, s->size);
+		s->map = NULL;
+		return -EMCAPCFG;
 	}
 
-	if (err != 1 && feof(fptr)) {
-		pr_err("Failed to find SYNC Word in BIT file\n");
-		return 0;
+	s->pos = i + 1;
+	s->sync_pending = 1;
+
+	return 0;
+}
+
+static void MCapStreamClose(struct mcap_stream *s)
+{
+	if (s->map)
+		munmap((void *)s->map, s->size);
+	s->map = NULL;
+
+	/* A sidecar still open here is incomplete */
+	if (s->cache) {
+		fclose(s->cache);
+		unlink(s->cache_path);
 	}
+	s->cache = NULL;
+	free(s->cache_path);
+	s->cache_path = NULL;
+}
 
-	*buf++ = __bswap_32(MCAP_SYNC_DWORD);
+/* Appends parsed RBT words to the sidecar in .bin (big endian) layout */
+static void MCapStreamCache(struct mcap_stream *s, u32 *buf, u32 len)
+{
+	char *path;
+	int err;
 
-	while ((err = fread(buf, sz - len, 1, fptr)) == 1)
-		;
+	if (len) {
+		MCapSwapWords(buf, len);
+		err = fwrite(buf, sizeof(u32), len, s->cache) != len;
+		MCapSwapWords(buf, len);
+		if (err) {
+			pr_dbg("Failed to write %s, not caching\n",
+			       s->cache_path);
+			fclose(s->cache);
+			s->cache = NULL;
+			unlink(s->cache_path);
+		}
+		return;
+	}
 
-	if (err != 1 && !feof(fptr)) {
-		pr_err("Failed to Read BIT file\n");
-		return 0;
+	/* End of file, publish the sidecar under its final name */
+	err = fclose(s->cache);
+	s->cache = NULL;
+	path = strdup(s->cache_path);
+	if (!err && path) {
+		path[strlen(path) - 4] = '\0';
+		err = rename(s->cache_path, path);
+		if (!err)
+			pr_info("Cached bitstream as %s\n", path);
 	}
+	if (err || !path)
+		unlink(s->cache_path);
+	free(path);
+}
+
+static u32 MCapStreamReadRBT(struct mcap_stream *s, u32 *buf, u32 max)
+{
+	const char *raw;
+	const char *eol;
+	size_t i, read;
+	u32 len = 0;
+
+	while (len < max && s->pos < s->size) {
+		raw = (const char *)s->map + s->pos;
+
+		/* Fast path for the usual line of exactly 32 bits */
+		if (!s->count && s->size - s->pos > 32 &&
+		    (raw[32] == '\n' || raw[32] == '\r') &&
+		    MCapRbtToWord(raw, &buf[len])) {
+			len++;
+			s->pos += (raw[32] == '\r' && s->size - s->pos > 33 &&
+				   raw[33] == '\n') ? 34 : 33;
+			continue;
+		}
 
-	return (sz - len)/4 + 1;
+		eol = memchr(raw, '\n', s->size - s->pos);
+		read = eol ? (size_t)(eol - raw) : s->size - s->pos;
+		s->pos += eol ? read + 1 : read;
+
+		if (!read || (raw[0] != '1' && raw[0] != '0'))
+			continue;
+
+		for (i = 0; i < read; i++) {
+			if (raw[i] == '1' || raw[i] == '0') {
+				s->result = (s->result << 1) | (raw[i] - 0x30);
+				s->count++;
+				if (s->count == 32) {
+					buf[len++] = s->result;
+					s->result = s->count = 0;
+					break;
+				}
+			}
+		}
+	}
+
+	return len;
 }
 
-static u32 MCapProcessBIN(FILE *fptr, u32 *buf, int sz)
+static u32 MCapStreamReadBIN(struct mcap_stream *s, u32 *buf, u32 max)
 {
-	int err;
+	u32 len = 0, words;
 
-	err = fread(buf, sz, 1, fptr);
-	if (err != 1 && !feof(fptr)) {
-		pr_err("Failed to Read BIN file\n");
-		return 0;
+	if (s->sync_pending) {
+		buf[len++] = MCAP_SYNC_DWORD;
+		s->sync_pending = 0;
+	}
+
+	words = (s->size - s->pos) / 4;
+	if (words > max - len)
+		words = max - len;
+
+	/* Configuration data is big endian in .bit/.bin files */
+	memcpy(buf + len, s->map + s->pos, words * 4);
+	MCapSwapWords(buf + len, words);
+	s->pos += words * 4;
+
+	return len + words;
+}
+
+/*
+ * Fills buf with up to max words in the order they are written to the
+ * MCAP data register. Returns 0 once the file is exhausted.
+ */
+static u32 MCapStreamRead(struct mcap_stream *s, u32 *buf, u32 max)
+{
+	size_t done;
+	u32 len;
+
+	if (s->type == MCAP_SRC_RBT)
+		len = MCapStreamReadRBT(s, buf, max);
+	else
+		len = MCapStreamReadBIN(s, buf, max);
+
+	if (s->cache)
+		MCapStreamCache(s, buf, len);
+
+	/* Drop the pages already parsed so RSS stays at a few chunks */
+	done = s->pos & ~((size_t)sysconf(_SC_PAGESIZE) - 1);
+	if (done - s->released >= MCAP_STREAM_RELEASE_SIZE) {
+		madvise((void *)(s->map + s->released), done - s->released,
+			MADV_DONTNEED);
+		s->released = done;
 	}
 
-	return sz/4;
+	return len;
+}
+
+static void *MCapStreamProducer(void *arg)
+{
+	struct mcap_pipe *p = arg;
+	double start;
+	int idx = 0;
+	u32 len;
+
+	do {
+		pthread_mutex_lock(&p->lock);
+		while (p->full[idx] && !p->abort)
+			pthread_cond_wait(&p->cond, &p->lock);
+		pthread_mutex_unlock(&p->lock);
+
+		if (p->abort)
+			break;
+
+		start = MCapTimeNow();
+		len = MCapStreamRead(p->src, p->buf[idx],
+				     MCAP_STREAM_CHUNK_WORDS);
+		p->parse_time += MCapTimeNow() - start;
+
+		pthread_mutex_lock(&p->lock);
+		p->len[idx] = len;
+		p->full[idx] = 1;
+		pthread_cond_broadcast(&p->cond);
+		pthread_mutex_unlock(&p->lock);
+
+		idx ^= 1;
+	} while (len);
+
+	return NULL;
+}
+
+/* Waits for the producer to hand over the chunk in slot idx */
+static u32 MCapPipeGet(struct mcap_pipe *p, int idx, double *stall)
+{
+	double start = MCapTimeNow();
+
+	pthread_mutex_lock(&p->lock);
+	while (!p->full[idx])
+		pthread_cond_wait(&p->cond, &p->lock);
+	pthread_mutex_unlock(&p->lock);
+
+	*stall += MCapTimeNow() - start;
+
+	return p->len[idx];
+}
+
+static void MCapPipePut(struct mcap_pipe *p, int idx)
+{
+	pthread_mutex_lock(&p->lock);
+	p->full[idx] = 0;
+	pthread_cond_broadcast(&p->cond);
+	pthread_mutex_unlock(&p->lock);
+}
+
+static void MCapPipeAbort(struct mcap_pipe *p)
+{
+	pthread_mutex_lock(&p->lock);
+	p->abort = 1;
+	pthread_cond_broadcast(&p->cond);
+	pthread_mutex_unlock(&p->lock);
 }
 
 static int MCapDoBusWalk(struct mcap_dev *mdev)
@@ -222,125 +626,123 @@ static int Checkforcompletion(struct mcap_dev *mdev)
 	return 0;
 }
 
-static int MCapWritePartialBitStream(struct mcap_dev *mdev, u32 *data,
-					int len, u8 bswap)
+static int MCapWriteBitStreamBegin(struct mcap_dev *mdev, u32 *restore,
+				   u32 bitfile_type)
 {
-	u32 set, restore;
-	int err, count = 0, i;
-
-	if (!data || !len) {
-		pr_err("Invalid Arguments\n");
-		return -EMCAPWRITE;
-	}
+	u32 set;
+	int err;
 
-	err = MCapClearRequestByConfigure(mdev, &restore);
+	err = MCapClearRequestByConfigure(mdev, restore);
 	if (err)
 		return err;
 
 	if (IsErrSet(mdev) || IsRegReadComplete(mdev) ||
 		IsFifoOverflow(mdev)) {
 		pr_err("Failed to initialize configuring FPGA\n");
-		MCapRegWrite(mdev, MCAP_CONTROL, restore);
+		MCapRegWrite(mdev, MCAP_CONTROL, *restore);
 		return -EMCAPWRITE;
 	}
 
-	/* Set 'Mode', 'In Use by PCIe' and 'Data Reg Protect' bits */
-	set = MCapRegRead(mdev, MCAP_CONTROL);
-	set |= MCAP_CTRL_MODE_MASK | MCAP_CTRL_IN_USE_MASK |
-		MCAP_CTRL_DATA_REG_PROT_MASK;
-
-	/* Clear 'Reset', 'Module Reset' and 'Register Read' bits */
-	set &= ~(MCAP_CTRL_RESET_MASK | MCAP_CTRL_MOD_RESET_MASK |
-		 MCAP_CTRL_REG_READ_MASK | MCAP_CTRL_DESIGN_SWITCH_MASK);
-
-	MCapRegWrite(mdev, MCAP_CONTROL, set);
-
-	/* Write Data */
-	if (!bswap) {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, data[count]);
-	} else {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, __bswap_32(data[count]));
-	}
-
-	for (i = 0 ; i < EMCAP_EOS_LOOP_COUNT; i++) {
-		MCapRegWrite(mdev, MCAP_DATA, EMCAP_NOOP_VAL);
-	}
+	if (bitfile_type == EMCAP_PARTIALCONFIG_FILE ||
+	    !mdev->is_multiplebit) {
+		/* Set 'Mode', 'In Use by PCIe' and 'Data Reg Protect' bits */
+		set = MCapRegRead(mdev, MCAP_CONTROL);
+		set |= MCAP_CTRL_MODE_MASK | MCAP_CTRL_IN_USE_MASK |
+			MCAP_CTRL_DATA_REG_PROT_MASK;
 
-	if (IsErrSet(mdev) || IsFifoOverflow(mdev)) {
-		pr_err("Failed to Write Bitstream\n");
-		MCapRegWrite(mdev, MCAP_CONTROL, restore);
-		MCapFullReset(mdev);
-		return -EMCAPWRITE;
-	}
+		/* Clear 'Reset', 'Module Reset' and 'Register Read' bits */
+		set &= ~(MCAP_CTRL_RESET_MASK | MCAP_CTRL_MOD_RESET_MASK |
+			 MCAP_CTRL_REG_READ_MASK | MCAP_CTRL_DESIGN_SWITCH_MASK);
 
-	if (!mdev->is_multiplebit) {
-		pr_info("Info: A partial reconfiguration clear file (-C) was");
-		pr_info(" loaded without a partial reconfiguration file (-p)");
-		pr_info(" as result the MCAP Control register was not restored");
-		pr_info(" to its original value\n\r");
+		MCapRegWrite(mdev, MCAP_CONTROL, set);
 	}
 
 	return 0;
 }
 
-static int MCapWriteBitStream(struct mcap_dev *mdev, u32 *data,
-			      int len, u8 bswap)
+/*
+ * Writes len words to the MCAP data register in bursts no larger than the
+ * free space of the configuration FIFO. The status register is read every
+ * mdev->poll_interval words, or after every burst while the FIFO has not
+ * drained, to size the next burst and to stop early on an error or FIFO
+ * overflow. A poll interval of 0 writes without reading status.
+ */
+static int MCapWriteData(struct mcap_dev *mdev, const u32 *data, u32 len)
 {
-	u32 set, restore;
-	int err, count = 0;
+	struct mcap_timing *t = &mdev->timing;
+	u32 count = 0, burst = MCAP_FIFO_DEPTH, since_poll = 0, end, sts;
+	double start;
+
+	while (count < len) {
+		end = (len - count > burst) ? count + burst : len;
+		since_poll += end - count;
+		for (; count < end; count++)
+			MCapRegWrite(mdev, MCAP_DATA, data[count]);
 
-	if (!data || !len) {
-		pr_err("Invalid Arguments\n");
-		return -EMCAPWRITE;
-	}
+		if (!mdev->poll_interval || since_poll < mdev->poll_interval)
+			continue;
 
-	err = MCapClearRequestByConfigure(mdev, &restore);
-	if (err)
-		return err;
+		start = MCapTimeNow();
+		sts = MCapRegRead(mdev, MCAP_STATUS);
+		t->poll += MCapTimeNow() - start;
+		t->polls++;
 
-	if (IsErrSet(mdev) || IsRegReadComplete(mdev) ||
-		IsFifoOverflow(mdev)) {
-		pr_err("Failed to initialize configuring FPGA\n");
-		MCapRegWrite(mdev, MCAP_CONTROL, restore);
-		return -EMCAPWRITE;
+		if (sts & (MCAP_STS_ERR_MASK | MCAP_STS_FIFO_OVERFLOW_MASK)) {
+			pr_err("Failed to Write Bitstream at word %u"
+			       " (status 0x%08x)\n", count, sts);
+			return -EMCAPWRITE;
+		}
+
+		burst = MCAP_FIFO_DEPTH -
+			((sts & MCAP_STS_FIFO_OCCUPANCY_MASK) >> 12);
+
+		/* Keep polling each burst until the FIFO has drained */
+		since_poll = (burst < MCAP_FIFO_DEPTH) ?
+			     mdev->poll_interval : 0;
 	}
 
-	if (!mdev->is_multiplebit) {
-		/* Set 'Mode', 'In Use by PCIe' and 'Data Reg Protect' bits */
-		set = MCapRegRead(mdev, MCAP_CONTROL);
-		set |= MCAP_CTRL_MODE_MASK | MCAP_CTRL_IN_USE_MASK |
-			MCAP_CTRL_DATA_REG_PROT_MASK;
+	return 0;
+}
 
-		/* Clear 'Reset', 'Module Reset' and 'Register Read' bits */
-		set &= ~(MCAP_CTRL_RESET_MASK | MCAP_CTRL_MOD_RESET_MASK |
-			 MCAP_CTRL_REG_READ_MASK | MCAP_CTRL_DESIGN_SWITCH_MASK);
+/* Gives the MCAP back after a failed data write */
+static void MCapWriteBitStreamAbort(struct mcap_dev *mdev, u32 restore)
+{
+	MCapRegWrite(mdev, MCAP_CONTROL, restore);
+	MCapFullReset(mdev);
+}
 
-		MCapRegWrite(mdev, MCAP_CONTROL, set);
-	}
+static int MCapWriteBitStreamEnd(struct mcap_dev *mdev, u32 restore,
+				 u32 bitfile_type)
+{
+	int err, i;
 
-	/* Write Data */
-	if (!bswap) {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, data[count]);
+	if (bitfile_type == EMCAP_PARTIALCONFIG_FILE) {
+		for (i = 0 ; i < EMCAP_EOS_LOOP_COUNT; i++) {
+			MCapRegWrite(mdev, MCAP_DATA, EMCAP_NOOP_VAL);
+		}
 	} else {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, __bswap_32(data[count]));
+		/* Check for Completion */
+		err = Checkforcompletion(mdev);
+		if (err)
+			return -EMCAPCFG;
 	}
 
-	/* Check for Completion */
-	err = Checkforcompletion(mdev);
-	if (err)
-		return -EMCAPCFG;
-
 	if (IsErrSet(mdev) || IsFifoOverflow(mdev)) {
 		pr_err("Failed to Write Bitstream\n");
-		MCapRegWrite(mdev, MCAP_CONTROL, restore);
-		MCapFullReset(mdev);
+		MCapWriteBitStreamAbort(mdev, restore);
 		return -EMCAPWRITE;
 	}
 
+	if (bitfile_type == EMCAP_PARTIALCONFIG_FILE) {
+		if (!mdev->is_multiplebit) {
+			pr_info("Info: A partial reconfiguration clear file (-C) was");
+			pr_info(" loaded without a partial reconfiguration file (-p)");
+			pr_info(" as result the MCAP Control register was not restored");
+			pr_info(" to its original value\n\r");
+		}
+		return 0;
+	}
+
 	/* Enable PCIe BAR reads/writes in the PCIe hardblock */
 	restore |= MCAP_CTRL_DESIGN_SWITCH_MASK;
 
@@ -371,6 +773,7 @@ struct mcap_dev *MCapLibInit(int device_id)
 	mdev->pacc = pci_alloc();
 
 	mdev->is_multiplebit = 0;
+	mdev->poll_interval = MCAP_POLL_INTERVAL;
 
 	/* Initialize the PCI library */
 	pci_init(mdev->pacc);
@@ -411,6 +814,125 @@ free_resources:
 	return NULL;
 }
 
+/*
+ * Opens the MCAP device at the given PCI location. Every device gets its
+ * own PCI access handle so that devices can be driven from separate
+ * threads.
+ */
+static struct mcap_dev *MCapLibInitSlot(int domain, int bus, int slot,
+					 int func)
+{
+	struct pci_dev *dev;
+	struct mcap_dev *mdev;
+
+	mdev = calloc(1, sizeof(struct mcap_dev));
+	if (!mdev)
+		return NULL;
+
+	mdev->poll_interval = MCAP_POLL_INTERVAL;
+
+	mdev->pacc = pci_alloc();
+	pci_init(mdev->pacc);
+	pci_scan_bus(mdev->pacc);
+
+	for (dev = mdev->pacc->devices; dev; dev = dev->next) {
+		if (dev->domain == domain && dev->bus == bus &&
+		    dev->dev == slot && dev->func == func) {
+			pci_fill_info(dev, PCI_FILL_IDENT | PCI_FILL_BASES |
+				      PCI_FILL_CLASS);
+			mdev->pdev = dev;
+			break;
+		}
+	}
+
+	if (!mdev->pdev || MCapDoBusWalk(mdev)) {
+		pr_err("No MCAP capability at %04x:%02x:%02x.%d\n",
+		       domain, bus, slot, func);
+		MCapLibFree(mdev);
+		return NULL;
+	}
+
+	return mdev;
+}
+
+/*
+ * Opens up to max Xilinx devices named in list, a comma separated list of
+ * [[domain:]bus:]slot[.func] locations, or "all" for every device with
+ * the MCAP extended capability. A non-zero device_id further restricts
+ * the devices to that device id. Returns the number of devices opened.
+ */
+int MCapLibInitList(const char *list, int device_id, struct mcap_dev **mdevs,
+		    int max)
+{
+	struct pci_access *pacc;
+	struct pci_filter *filters = NULL;
+	struct pci_dev *dev;
+	char *names, *name, *save;
+	int i, nfilters = 0, count = 0, match;
+
+	names = strdup(list);
+	if (!names)
+		return 0;
+
+	pacc = pci_alloc();
+	pci_init(pacc);
+
+	if (strcmp(list, "all")) {
+		filters = calloc(strlen(list) / 2 + 1, sizeof(*filters));
+		if (!filters)
+			goto free_resources;
+
+		for (name = strtok_r(names, ",", &save); name;
+		     name = strtok_r(NULL, ",", &save)) {
+			pci_filter_init(pacc, &filters[nfilters]);
+			if (pci_filter_parse_slot(&filters[nfilters], name)) {
+				pr_err("Invalid device location %s\n", name);
+				goto free_resources;
+			}
+			nfilters++;
+		}
+	}
+
+	pci_scan_bus(pacc);
+
+	for (dev = pacc->devices; dev && count < max; dev = dev->next) {
+		pci_fill_info(dev, PCI_FILL_IDENT);
+
+		if (dev->vendor_id != MCAP_VENDOR_ID ||
+		    (device_id && dev->device_id != device_id))
+			continue;
+
+		if (filters) {
+			for (i = 0, match = 0; i < nfilters && !match; i++)
+				match = pci_filter_match(&filters[i], dev);
+			if (!match)
+				continue;
+		} else if (!pci_find_cap(dev, MCAP_EXT_CAP_ID,
+					 PCI_CAP_EXTENDED)) {
+			continue;
+		}
+
+		mdevs[count] = MCapLibInitSlot(dev->domain, dev->bus,
+					       dev->dev, dev->func);
+		if (!mdevs[count])
+			continue;
+
+		pr_info("Xilinx MCAP device found at %04x:%02x:%02x.%d\n",
+			dev->domain, dev->bus, dev->dev, dev->func);
+		count++;
+	}
+
+	if (!count)
+		pr_err("Xilinx MCAP device not found .. Exiting ...\n");
+
+free_resources:
+	free(filters);
+	free(names);
+	pci_cleanup(pacc);
+
+	return count;
+}
+
 int MCapReset(struct mcap_dev *mdev)
 {
 	u32 set, restore;
@@ -591,70 +1113,339 @@ void MCapDumpRegs(struct mcap_dev *mdev)
 	MCapDumpReadRegs(mdev);
 }
 
+/*
+ * Programs the FPGA from file_path. A parser thread converts the mapped
+ * file into chunks of device ordered words while the calling thread feeds
+ * the previous chunk to the MCAP data register, so file parsing overlaps
+ * the configuration space writes.
+ */
 int MCapConfigureFPGA(struct mcap_dev *mdev, char *file_path, u32 bitfile_type)
 {
-	FILE *fptr;
-	u32 *data;
-	u32 binsz, wrdatasz;
-	int err = 0;
-	u8 bswap = 0;
+	struct mcap_stream src;
+	struct mcap_pipe pipe;
+	struct mcap_timing *t = &mdev->timing;
+	pthread_t producer;
+	double start, phase;
+	u32 restore, len;
+	int err, idx = 0;
+
+	memset(t, 0, sizeof(*t));
+	start = MCapTimeNow();
+
+	err = MCapStreamOpen(&src, file_path);
+	if (err)
+		return err;
+
+	t->map = MCapTimeNow() - start;
+
+	memset(&pipe, 0, sizeof(pipe));
+	pipe.src = &src;
+	pipe.buf[0] = malloc(2 * MCAP_STREAM_CHUNK_WORDS * sizeof(u32));
+	if (!pipe.buf[0]) {
+		err = -EMCAPCFG;
+		goto close_stream;
+	}
+	pipe.buf[1] = pipe.buf[0] + MCAP_STREAM_CHUNK_WORDS;
+	pthread_mutex_init(&pipe.lock, NULL);
+	pthread_cond_init(&pipe.cond, NULL);
+
+	if (pthread_create(&producer, NULL, MCapStreamProducer, &pipe)) {
+		pr_err("Failed to start the bitstream parser\n");
+		err = -EMCAPCFG;
+		goto free_pipe;
+	}
+
+	/* Nothing is sent to the device until the file yields data */
+	len = MCapPipeGet(&pipe, idx, &t->stall);
+	if (!len) {
+		pr_err("Invalid Arguments\n");
+		err = -EMCAPCFG;
+		goto join_producer;
+	}
+
+	err = MCapWriteBitStreamBegin(mdev, &restore, bitfile_type);
+	if (err) {
+		MCapPipeAbort(&pipe);
+		err = -EMCAPCFG;
+		goto join_producer;
+	}
+
+	/* Write Data */
+	do {
+		phase = MCapTimeNow();
+		err = MCapWriteData(mdev, pipe.buf[idx], len);
+		t->write += MCapTimeNow() - phase;
+		if (err) {
+			MCapPipeAbort(&pipe);
+			MCapWriteBitStreamAbort(mdev, restore);
+			err = -EMCAPCFG;
+			goto join_producer;
+		}
+		t->words += len;
 
-	/* Get the size */
-	fptr = fopen(file_path, "rb");
-	if (fptr == NULL)
+		MCapPipePut(&pipe, idx);
+		idx ^= 1;
+		len = MCapPipeGet(&pipe, idx, &t->stall);
+	} while (len);
+
+	phase = MCapTimeNow();
+	err = MCapWriteBitStreamEnd(mdev, restore, bitfile_type);
+	t->complete = MCapTimeNow() - phase;
+	if (err)
+		err = -EMCAPCFG;
+
+join_producer:
+	pthread_join(producer, NULL);
+	t->parse = pipe.parse_time;
+	t->total = MCapTimeNow() - start;
+free_pipe:
+	pthread_cond_destroy(&pipe.cond);
+	pthread_mutex_destroy(&pipe.lock);
+	free(pipe.buf[0]);
+close_stream:
+	MCapStreamClose(&src);
+
+	if (err)
+		return err;
+
+	if (bitfile_type == EMCAP_PARTIALCONFIG_FILE)
+		pr_info("FPGA Partial Configuration Done!!\n");
+	else
+		pr_info("FPGA Configuration Done!!\n");
+
+	MCapShowTiming(mdev);
+
+	return 0;
+}
+
+/* Parses the whole programming file into memory */
+static int MCapLoadBitstream(const char *file_path, struct mcap_bitstream *bs)
+{
+	struct mcap_stream src;
+	size_t size = 0;
+	u32 len, *data;
+	int err;
+
+	memset(bs, 0, sizeof(*bs));
+
+	err = MCapStreamOpen(&src, file_path);
+	if (err)
+		return err;
+
+	do {
+		if (size - bs->len < MCAP_STREAM_CHUNK_WORDS) {
+			/* Exact for .bin/.bit, RBT lines are longer than a word */
+			size = size ? size + size / 2 : src.size / sizeof(u32);
+			size += MCAP_STREAM_CHUNK_WORDS;
+			data = realloc(bs->data, size * sizeof(u32));
+			if (!data) {
+				err = -EMCAPCFG;
+				break;
+			}
+			bs->data = data;
+		}
+
+		len = MCapStreamRead(&src, bs->data + bs->len,
+				     MCAP_STREAM_CHUNK_WORDS);
+		bs->len += len;
+	} while (len);
+
+	MCapStreamClose(&src);
+
+	if (!err && !bs->len) {
+		pr_err("Invalid Arguments\n");
+		err = -EMCAPCFG;
+	}
+
+	if (err) {
+		free(bs->data);
+		bs->data = NULL;
+	}
+
+	return err;
+}
+
+/* Programs the device from a bitstream already in memory */
+static int MCapProgramBuffer(struct mcap_dev *mdev, const u32 *data, u32 len,
+			     u32 bitfile_type)
+{
+	struct mcap_timing *t = &mdev->timing;
+	double start, phase;
+	u32 restore;
+	int err;
+
+	start = MCapTimeNow();
+
+	err = MCapWriteBitStreamBegin(mdev, &restore, bitfile_type);
+	if (err)
 		return -EMCAPCFG;
-	fseek(fptr, 0L, SEEK_END);
-	binsz = ftell(fptr);
-	fseek(fptr, 0L, SEEK_SET);
 
-	/* Allocate the buffer */
-	data = malloc(binsz);
-	if (data == NULL)
+	phase = MCapTimeNow();
+	err = MCapWriteData(mdev, data, len);
+	t->write = MCapTimeNow() - phase;
+	if (err) {
+		MCapWriteBitStreamAbort(mdev, restore);
 		return -EMCAPCFG;
+	}
+	t->words = len;
 
-	/* Process files and Read the data */
-	if (MCapFindTypeofFile(file_path, MCAP_RBT_FILE)) {
+	phase = MCapTimeNow();
+	err = MCapWriteBitStreamEnd(mdev, restore, bitfile_type);
+	t->complete = MCapTimeNow() - phase;
+	t->total = MCapTimeNow() - start;
 
-		/* Read the RBT file */
-		wrdatasz = MCapProcessRBT(fptr, data);
+	return err ? -EMCAPCFG : 0;
+}
 
-	} else if (MCapFindTypeofFile(file_path, MCAP_BIT_FILE)) {
+static void *MCapConfigureWorker(void *arg)
+{
+	struct mcap_worker *w = arg;
 
-		/* Read the BIT file */
-		wrdatasz = MCapProcessBIT(fptr, data, binsz);
-		bswap = 1;
+	w->err = MCapProgramBuffer(w->mdev, w->bs->data, w->bs->len,
+				   w->bitfile_type);
 
-	} else if (MCapFindTypeofFile(file_path, MCAP_BIN_FILE)) {
+	return NULL;
+}
 
-		/* Read the BIN file */
-		wrdatasz = MCapProcessBIN(fptr, data, binsz);
-		bswap = 1;
+/*
+ * Programs count devices with the same file. The file is parsed once and
+ * every device is then written concurrently by its own thread.
+ */
+int MCapConfigureFPGAMulti(struct mcap_dev **mdevs, int count, char *file_path,
+			   u32 bitfile_type)
+{
+	struct mcap_bitstream bs;
+	struct mcap_worker *workers;
+	struct mcap_timing *t;
+	double start, load, wall;
+	int i, err, failed = 0;
 
-	} else {
-		pr_err("Unknown File Format.. This may be");
-		pr_err(" due to .bit/.bin/.rbt files does not exist at the.");
-		pr_err(" specified location, Please cross check the");
-		pr_err(" path is correct or not\n");
-		goto free_resources;
+	start = MCapTimeNow();
+
+	err = MCapLoadBitstream(file_path, &bs);
+	if (err)
+		return err;
+
+	load = MCapTimeNow() - start;
+
+	workers = calloc(count, sizeof(*workers));
+	if (!workers) {
+		free(bs.data);
+		return -EMCAPCFG;
 	}
 
-	/* Program FPGA */
-	if (bitfile_type == EMCAP_PARTIALCONFIG_FILE) {
-		err = MCapWritePartialBitStream(mdev, data, wrdatasz, bswap);
-		if (err)
-			return -EMCAPCFG;
-		pr_info("FPGA Partial Configuration Done!!\n");
-	} else if (bitfile_type == EMCAP_CONFIG_FILE) {
-		err = MCapWriteBitStream(mdev, data, wrdatasz, bswap);
+	start = MCapTimeNow();
+
+	for (i = 0; i < count; i++) {
+		workers[i].mdev = mdevs[i];
+		workers[i].bs = &bs;
+		workers[i].bitfile_type = bitfile_type;
+		memset(&mdevs[i]->timing, 0, sizeof(struct mcap_timing));
+		if (pthread_create(&workers[i].thread, NULL,
+				   MCapConfigureWorker, &workers[i]))
+			MCapConfigureWorker(&workers[i]);
+		else
+			workers[i].thread_started = 1;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (workers[i].thread_started)
+			pthread_join(workers[i].thread, NULL);
+	}
+
+	wall = MCapTimeNow() - start;
+
+	for (i = 0; i < count; i++) {
+		t = &mdevs[i]->timing;
+		t->parse = load;
+		pr_info("%04x:%02x:%02x.%d: %s, write %.3f ms, total %.3f ms,"
+			" %.2f MB/s\n", mdevs[i]->pdev->domain,
+			mdevs[i]->pdev->bus, mdevs[i]->pdev->dev,
+			mdevs[i]->pdev->func,
+			workers[i].err ? "FAILED" : "Done",
+			t->write * 1e3, t->total * 1e3,
+			t->total > 0 ? t->words * 4.0 / t->total / 1e6 : 0);
+		if (workers[i].err)
+			failed++;
+	}
+
+	pr_info("Devices programmed:\t%d of %d\n", count - failed, count);
+	pr_info("Words per device:\t%u\n", bs.len);
+	pr_info("Load time:\t\t%.3f ms\n", load * 1e3);
+	pr_info("Program time:\t\t%.3f ms\n", wall * 1e3);
+	if (wall > 0)
+		pr_info("Aggregate throughput:\t%.2f MB/s\n",
+			(count - failed) * bs.len * 4.0 / wall / 1e6);
+
+	free(workers);
+	free(bs.data);
+
+	return failed ? -EMCAPCFG : 0;
+}
+
+void MCapShowTiming(struct mcap_dev *mdev)
+{
+	struct mcap_timing *t = &mdev->timing;
+
+	pr_info("Words written:\t\t%u\n", t->words);
+	pr_info("Map time:\t\t%.3f ms\n", t->map * 1e3);
+	pr_info("Parse time:\t\t%.3f ms\n", t->parse * 1e3);
+	pr_info("Write time:\t\t%.3f ms\n", t->write * 1e3);
+	pr_info("Parser stall time:\t%.3f ms\n", t->stall * 1e3);
+	pr_info("Status polls:\t\t%u (%.3f ms)\n", t->polls, t->poll * 1e3);
+	pr_info("Completion time:\t%.3f ms\n", t->complete * 1e3);
+	pr_info("Total time:\t\t%.3f ms\n", t->total * 1e3);
+	if (t->total > 0)
+		pr_info("Throughput:\t\t%.2f MB/s\n",
+			t->words * 4.0 / t->total / 1e6);
+}
+
+/*
+ * Measures data register throughput for a range of status poll intervals
+ * by writing NOOP words, which leave the FPGA configuration untouched.
+ */
+int MCapBenchmark(struct mcap_dev *mdev, u32 words)
+{
+	static const u32 intervals[] = { 0, 16, 64, 256, 1024, 4096, 16384 };
+	struct mcap_timing *t = &mdev->timing;
+	u32 *data, restore, i, saved = mdev->poll_interval;
+	double elapsed;
+	int err;
+
+	data = malloc(words * sizeof(u32));
+	if (!data)
+		return -EMCAPWRITE;
+
+	for (i = 0; i < words; i++)
+		data[i] = EMCAP_NOOP_VAL;
+
+	err = MCapWriteBitStreamBegin(mdev, &restore,
+				      EMCAP_PARTIALCONFIG_FILE);
+	if (err)
+		goto free_data;
+
+	pr_info("Poll interval\tWords/s\t\tPolls\tPoll time\tOverhead\n");
+
+	for (i = 0; i < sizeof(intervals) / sizeof(intervals[0]); i++) {
+		memset(t, 0, sizeof(*t));
+		mdev->poll_interval = intervals[i];
+
+		elapsed = MCapTimeNow();
+		err = MCapWriteData(mdev, data, words);
+		elapsed = MCapTimeNow() - elapsed;
 		if (err)
-			return -EMCAPCFG;
-		pr_info("FPGA Configuration Done!!\n");
+			break;
+
+		pr_info("%u\t\t%.0f\t%u\t%.3f ms\t%.1f%%\n", intervals[i],
+			words / elapsed, t->polls, t->poll * 1e3,
+			100.0 * t->poll / elapsed);
 	}
 
-free_resources:
-	if (data)
-		free(data);
-	fclose(fptr);
+	MCapRegWrite(mdev, MCAP_CONTROL, restore);
+	mdev->poll_interval = saved;
+
+free_data:
+	free(data);
 
 	return err;
 }
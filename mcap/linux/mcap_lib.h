@@ -37,6 +37,12 @@
 #include <string.h>
 #include <ctype.h>
 #include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
 
 #include "pci.h"
 #include "lspci.h"
@@ -74,6 +80,15 @@
 /* Maximum FIFO Depth */
 #define MCAP_FIFO_DEPTH		16
 
+/* Default number of data words written between status polls */
+#define MCAP_POLL_INTERVAL	1024
+
+/* Default number of NOOP words written per benchmark pass */
+#define MCAP_BENCH_WORDS	(1 << 20)
+
+/* Maximum number of devices programmed concurrently */
+#define MCAP_MAX_DEVICES	64
+
 /* PCIe Extended Capability Id */
 #define MCAP_EXT_CAP_ID		0xB
 
@@ -106,12 +121,27 @@
 #define pr_info printf
 #define pr_err	printf
 
+/* Per-phase timings of the last configuration, in seconds */
+struct mcap_timing {
+	double map;		/* Opening and mapping the file */
+	double parse;		/* Parser thread busy time */
+	double write;		/* MCAP data register writes */
+	double stall;		/* Writer waiting on the parser */
+	double complete;	/* End of startup / trailing NOOPs */
+	double total;
+	double poll;		/* Status reads during data writes */
+	u32 words;
+	u32 polls;
+};
+
 /* MCAP Device Information */
 struct mcap_dev {
 	struct pci_dev *pdev;
 	struct pci_access *pacc;
 	unsigned int reg_base;
 	u32 is_multiplebit;
+	u32 poll_interval;	/* Data words between status polls, 0 = none */
+	struct mcap_timing timing;
 };
 
 #define MCapRegWrite(mdev, offset, value) \
@@ -150,6 +180,8 @@ struct mcap_dev {
 
 /* Function Prototypes */
 struct mcap_dev *MCapLibInit(int device_id);
+int MCapLibInitList(const char *list, int device_id, struct mcap_dev **mdevs,
+		    int max);
 void MCapLibFree(struct mcap_dev *mdev);
 void MCapDumpRegs(struct mcap_dev *mdev);
 void MCapDumpReadRegs(struct mcap_dev *mdev);
@@ -158,5 +190,9 @@ int MCapModuleReset(struct mcap_dev *mdev);
 int MCapFullReset(struct mcap_dev *mdev);
 int MCapShowDevice(struct mcap_dev *mdev, int verbose);
 int MCapConfigureFPGA(struct mcap_dev *mdev, char *file_path, u32 bitfile_type);
+int MCapConfigureFPGAMulti(struct mcap_dev **mdevs, int count, char *file_path,
+			   u32 bitfile_type);
+void MCapShowTiming(struct mcap_dev *mdev);
+int MCapBenchmark(struct mcap_dev *mdev, u32 words);
 int MCapReadRegisters(struct mcap_dev *mdev, u32 *data);
 int MCapAccessConfigSpace(struct mcap_dev *mdev, int argc, char **argv);